@@ -4,6 +4,8 @@
 // This file is licensed under the MIT license; see LICENSE file in the root of this
 // project for details.
 
+#include <algorithm>
+#include <random>
 #include <string>
 #include <typeinfo>
 #include <vector>
@@ -20,6 +22,7 @@
 #include <common/Exceptions.hpp>
 #include <common/Utils.hpp>
 #include <engine/Window.hpp>
+#include <engine/util/Clock.hpp>
 #include <engine/util/SdlDriver.hpp>
 
 using namespace ctb;
@@ -61,6 +64,31 @@ std::string version() {
 #endif
 }
 
+/// \brief Splits host:port
+///
+/// \param address The address
+/// \param host Output host
+/// \param port Output port
+/// \return bool If the address has a host and a valid port
+bool parseAddress(const std::string& address, std::string& host, uint16_t& port) {
+    auto colon = address.rfind(':');
+    if (colon == 0 || colon == std::string::npos) {
+        return false;
+    }
+    unsigned long value = 0;
+    try {
+        value = std::stoul(address.substr(colon + 1));
+    } catch (const std::exception&) {
+        return false;
+    }
+    if (value == 0 || value > 65535) {
+        return false;
+    }
+    host = address.substr(0, colon);
+    port = static_cast<uint16_t>(value);
+    return true;
+}
+
 /// \brief Parses commandline arguments
 ///
 /// \param argc Argument count
@@ -71,11 +99,87 @@ Status parse(int argc, char** argv, CliConfig& config) {
     bool showHelp = false;
     bool showVersion = false;
     bool noSound = false;
+    std::string seed;
+    uint32_t matches = 0;
+    uint32_t tournament = 0;
+    uint32_t bench16v16 = 0;
+    uint32_t horde = 0;
+    uint32_t hordeRate = 0;
+    float frameBudget = -1.0f;
+    std::string peer;
+    uint32_t netPort = 0;
+    uint32_t latency = 0;
+    uint32_t jitter = 0;
+    float loss = 0.0f;
+    uint32_t servePort = 0;
+    uint32_t benchClients = 0;
+    std::string server;
+    double replayStart = -1;
+    std::string benchInputs;
     auto cli = clara::Help(showHelp) |
                clara::Opt(config.debug)["-d"]["--debug"]("enable debug mode") |
                clara::Opt(noSound)["-s"]["--no-sound"]("disable sound") |
                clara::Opt(showVersion)["-v"]["--version"]("show version information") |
                clara::Opt(config.verbose)["--verbose"]("show more debug information") |
+               clara::Opt(seed, "seed")["--seed"](
+                   "deterministic mode: fixed seed and fixed time steps") |
+               clara::Opt(config.checksumFile, "file")["--checksums"](
+                   "write a state checksum per tick to file") |
+               clara::Opt(matches, "matches")["--simulate"](
+                   "play matches between AI players without window and sound") |
+               clara::Opt(bench16v16, "matches")["--bench-16v16"](
+                   "simulate matches between two teams of 16 AI players with a fixed seed") |
+               clara::Opt(tournament, "matches")["--tournament"](
+                   "play matches between AI players without window and sound on all cores") |
+               clara::Opt(config.tournament.workers, "workers")["--workers"](
+                   "maximum number of tournament matches played at the same time") |
+               clara::Opt(config.simulation.playersPerTeam, "players")["--players"](
+                   "number of AI players per team in simulations") |
+               clara::Opt(config.simulation.maxTicks, "ticks")["--max-ticks"](
+                   "stop a simulated match without winner or a server after this many ticks") |
+               clara::Opt(config.simulation.snapshots)["--snapshots"](
+                   "save and verify a game state snapshot every simulated tick") |
+               clara::Opt(horde, "bots")["--horde"](
+                   "spawn bots every tick up to this many per level and report the frame times "
+                   "by the number of bots") |
+               clara::Opt(hordeRate, "bots")["--horde-rate"](
+                   "number of bots a horde spawns per tick (default 8)") |
+               clara::Opt(frameBudget, "ms")["--frame-budget"](
+                   "lower the quality while frames take longer than this (default 16.7, 0 "
+                   "disables)") |
+               clara::Opt(peer, "host:port")["--net-peer"](
+                   "play against the remote peer at host:port over UDP") |
+               clara::Opt(netPort, "port")["--net-port"]("local UDP port of a network game") |
+               clara::Opt(config.network.host)["--net-host"](
+                   "control the L2R player in a network game, the peer controls R2L") |
+               clara::Opt(config.network.inputDelay, "ticks")["--net-delay"](
+                   "input delay of a network game in ticks (default 2)") |
+               clara::Opt(latency, "ms")["--net-latency"](
+                   "add latency to the sent packets of a network game") |
+               clara::Opt(jitter, "ms")["--net-jitter"](
+                   "add random latency up to this to the sent packets of a network game") |
+               clara::Opt(loss, "percent")["--net-loss"](
+                   "drop this share of the sent packets of a network game") |
+               clara::Opt(servePort, "port")["--serve"](
+                   "run games without window for clients connecting to this UDP port") |
+               clara::Opt(config.server.clients, "clients")["--clients"](
+                   "number of clients of a server, each controls one player (default 2)") |
+               clara::Opt(config.server.snapshotInterval, "ticks")["--snapshot-interval"](
+                   "ticks between two states sent by a server (default 2)") |
+               clara::Opt(benchClients, "clients")["--serve-bench"](
+                   "stream AI games to this many clients in this process as fast as possible") |
+               clara::Opt(server, "host:port")["--connect"](
+                   "play on the server at host:port") |
+               clara::Opt(config.recordFile, "file")["--record"](
+                   "record the played, simulated or served games to a replay file") |
+               clara::Opt(config.replayFile, "file")["--replay"](
+                   "watch the games recorded in a replay file") |
+               clara::Opt(replayStart, "seconds")["--replay-from"](
+                   "start watching the first recorded game at this time") |
+               clara::Opt(config.inputRecordFile, "file")["--record-inputs"](
+                   "record the inputs of the played, simulated or served games to a file") |
+               clara::Opt(benchInputs, "file")["--bench-inputs"](
+                   "simulate the matches of an input recording instead of AI matches") |
                clara::Arg(config.path, "path")("path to the game.xml file");
     auto result = cli.parse(clara::Args(argc, argv));
     if (!result) {
@@ -86,6 +190,160 @@ Status parse(int argc, char** argv, CliConfig& config) {
 
     config.sound = !noSound;
 
+    if (horde > 0) {
+        config.bots.budget = horde;
+        config.bots.perTick = hordeRate > 0 ? hordeRate : 8;
+        // a horde measures the frame times at full quality unless a budget is given
+        config.frameBudget = 0.0f;
+    } else if (hordeRate > 0) {
+        std::cerr << console::red << "Error in command line: --horde-rate needs --horde"
+                  << console::reset << std::endl;
+        return Status::kError;
+    }
+    if (frameBudget >= 0.0f) {
+        config.frameBudget = frameBudget;
+    }
+
+    if (bench16v16 > 0) {
+        if (matches > 0 || !benchInputs.empty()) {
+            std::cerr << console::red
+                      << "Error in command line: --bench-16v16 can't be combined with "
+                         "--simulate or --bench-inputs"
+                      << console::reset << std::endl;
+            return Status::kError;
+        }
+        matches = bench16v16;
+        config.simulation.playersPerTeam = 16;
+        // every run plays the same matches, so the reports are comparable
+        if (seed.empty()) {
+            seed = "16";
+        }
+    }
+
+    if (matches > 0 || !benchInputs.empty()) {
+        if (config.simulation.playersPerTeam == 0 || config.simulation.maxTicks == 0) {
+            std::cerr << console::red
+                      << "Error in command line: --players and --max-ticks have to be positive"
+                      << console::reset << std::endl;
+            return Status::kError;
+        }
+        config.simulate = true;
+        // without --simulate every recorded match is played once
+        config.simulation.matches = matches;
+        config.simulation.inputFile = benchInputs;
+    }
+
+    if (tournament > 0) {
+        if (config.simulation.playersPerTeam == 0 || config.simulation.maxTicks == 0 ||
+            config.simulate || !peer.empty() || servePort > 0 || benchClients > 0 ||
+            !server.empty() || !config.replayFile.empty() || !config.checksumFile.empty() ||
+            !config.recordFile.empty() || !config.inputRecordFile.empty() || horde > 0) {
+            std::cerr << console::red
+                      << "Error in command line: a tournament needs positive --players and "
+                         "--max-ticks and can't be combined with --simulate, --bench-inputs, "
+                         "--net-peer, --serve, --connect, --replay, --checksums, --record, "
+                         "--record-inputs or --horde"
+                      << console::reset << std::endl;
+            return Status::kError;
+        }
+        config.compete = true;
+        config.tournament.matches = tournament;
+        config.tournament.playersPerTeam = config.simulation.playersPerTeam;
+        config.tournament.maxTicks = config.simulation.maxTicks;
+    }
+
+    if (!peer.empty()) {
+        if (!parseAddress(peer, config.network.peerHost, config.network.peerPort) ||
+            netPort == 0 || netPort > 65535 ||
+            config.network.inputDelay > engine::RollbackSession::MAX_INPUT_DELAY || loss < 0.0f ||
+            loss > 100.0f || config.simulate) {
+            std::cerr << console::red
+                      << "Error in command line: a network game needs --net-peer host:port, a "
+                         "--net-port, a --net-delay up to 8, a --net-loss up to 100 and no "
+                         "--simulate"
+                      << console::reset << std::endl;
+            return Status::kError;
+        }
+        config.networked = true;
+        config.network.port = static_cast<uint16_t>(netPort);
+        // the session runs in fixed steps, the conditions are given in ticks
+        config.network.conditions.latency = latency / engine::Clock::FIXED_STEP;
+        config.network.conditions.jitter = jitter / engine::Clock::FIXED_STEP;
+        config.network.conditions.loss = loss / 100.0f;
+        // both peers have to simulate the same games
+        config.deterministic = true;
+    }
+
+    if (servePort > 0 || benchClients > 0) {
+        if (servePort > 65535 || config.server.clients == 0 ||
+            config.server.clients > engine::ServerPlay::MAX_CLIENTS ||
+            benchClients > engine::ServerPlay::MAX_CLIENTS || config.server.snapshotInterval == 0 ||
+            config.simulation.maxTicks == 0 || config.simulate || !peer.empty()) {
+            std::cerr << console::red
+                      << "Error in command line: a server needs a --serve port or --serve-bench, "
+                         "up to 256 --clients, a positive --snapshot-interval and no "
+                         "--simulate or --net-peer"
+                      << console::reset << std::endl;
+            return Status::kError;
+        }
+        config.serve = true;
+        config.server.port = static_cast<uint16_t>(servePort);
+        config.server.benchClients = benchClients;
+        config.server.maxTicks = config.simulation.maxTicks;
+    }
+
+    if (!server.empty()) {
+        if (!parseAddress(server, config.client.host, config.client.port) || config.serve ||
+            config.simulate || !peer.empty()) {
+            std::cerr << console::red
+                      << "Error in command line: --connect needs host:port and can't be combined "
+                         "with --serve, --simulate or --net-peer"
+                      << console::reset << std::endl;
+            return Status::kError;
+        }
+        config.connect = true;
+    }
+
+    if (!config.replayFile.empty() || replayStart >= 0) {
+        if (config.replayFile.empty() || !config.recordFile.empty() || config.serve ||
+            config.connect || config.simulate || !peer.empty()) {
+            std::cerr << console::red
+                      << "Error in command line: --replay needs a file and can't be combined "
+                         "with --record, --serve, --connect, --simulate or --net-peer"
+                      << console::reset << std::endl;
+            return Status::kError;
+        }
+        config.replayStart = std::max(replayStart, 0.0);
+    }
+
+    if ((!config.recordFile.empty() || !config.inputRecordFile.empty()) &&
+        (config.connect || !peer.empty())) {
+        std::cerr << console::red
+                  << "Error in command line: --record and --record-inputs can't be combined "
+                     "with --connect or --net-peer"
+                  << console::reset << std::endl;
+        return Status::kError;
+    }
+    if (!config.inputRecordFile.empty() && !config.replayFile.empty()) {
+        std::cerr << console::red
+                  << "Error in command line: --record-inputs can't be combined with --replay"
+                  << console::reset << std::endl;
+        return Status::kError;
+    }
+
+    if (!seed.empty()) {
+        try {
+            config.seed = static_cast<uint32_t>(std::stoul(seed));
+        } catch (const std::exception&) {
+            std::cerr << console::red << "Error in command line: invalid seed \"" << seed << "\""
+                      << console::reset << std::endl;
+            return Status::kError;
+        }
+        config.deterministic = true;
+    }
+    // the seed is part of the report, so every tournament can be played again
+    config.tournament.seed = config.deterministic ? config.seed : std::random_device{}();
+
     if (showHelp) {
         std::cout << version() << "\n\n" << cli << std::endl;
         return Status::kClose;
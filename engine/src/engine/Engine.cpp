@@ -4,34 +4,87 @@
 // This file is licensed under the MIT license; see LICENSE file in the root of this
 // project for details.
 
+#include <algorithm>
+#include <iostream>
+#include <random>
+
 #include <parser/GameParser.hpp>
 
 #include "common/Exceptions.hpp"
 #include "engine/Engine.hpp"
 #include "engine/Window.hpp"
 #include "engine/core/Game.hpp"
+#include "engine/core/LevelCache.hpp"
+#include "engine/core/PlayerSprites.hpp"
+#include "engine/core/Prefabs.hpp"
+#include "engine/core/SharedTextures.hpp"
+#include "engine/input/AIInput.hpp"
 #include "engine/input/InputManager.hpp"
 #include "engine/menu/Menu.hpp"
 #include "engine/menu/StartMenu.hpp"
+#include "engine/net/ClientPlay.hpp"
+#include "engine/net/NetPlay.hpp"
+#include "engine/replay/InputRecorder.hpp"
+#include "engine/replay/ReplayPlayer.hpp"
+#include "engine/replay/ReplayRecorder.hpp"
+#include "engine/scene/Player.hpp"
+#include "engine/util/Clock.hpp"
 
 namespace ctb {
 namespace engine {
 
-Engine::Engine(const std::string& gamefile)
-    : m_gamefile(gamefile), m_game(nullptr), m_config(nullptr) {
+namespace {
+/// Number of values of AIPolicy
+constexpr uint32_t kPolicyCount = 3;
+}  // namespace
+
+Engine::Engine(const WindowArguments& args)
+    : m_gamefile(args.path),
+      m_game(nullptr),
+      m_config(nullptr),
+      m_levelCache(nullptr),
+      m_botSpawning(args.bots),
+      // games in fixed steps have to play the same on every run and peer, only their looks
+      // may change with the frame times
+      m_governor(args.frameBudget, !Clock::isFixedStep()),
+      m_deterministic(args.deterministic || args.networked),
+      m_seed(args.seed) {
     // Load gameconfig from game
-    m_config = ctb::parser::parseGame(gamefile);
+    m_config = ctb::parser::parseGame(m_gamefile);
 
     // Validate game configuration
     auto info = ctb::parser::validateGameConfig(m_config);
     if (info.status != ctb::parser::GameValidatorStatus::kOk) {
         throw GameValidatorExceptionT(ctb::parser::to_string(info));
     }
+
+    m_levelCache = new LevelCache(m_config);
+    m_playerSprites = new PlayerSprites(m_config);
+    m_sharedTextures = new SharedTextures();
+    m_prefabs = new Prefabs(m_config, *m_sharedTextures);
+
+    if (!args.checksumFile.empty()) {
+        m_checksumTrace.open(args.checksumFile);
+        if (!m_checksumTrace) {
+            throw std::runtime_error("Cannot open checksum file \"" + args.checksumFile + "\".");
+        }
+    }
+    if (!args.recordFile.empty()) {
+        m_recorder = new ReplayRecorder(args.recordFile);
+    }
+    if (!args.inputRecordFile.empty()) {
+        m_inputRecorder = new InputRecorder(args.inputRecordFile);
+    }
 }
 
 void Engine::restart() {
-    delete m_game;
-    m_game = new Game(m_config);
+    delete m_netPlay;
+    m_netPlay = nullptr;
+    delete m_clientPlay;
+    m_clientPlay = nullptr;
+    delete m_replayPlayer;
+    m_replayPlayer = nullptr;
+    newGame();
 
     // Init startmenu
     Menu* menu = new StartMenu(m_config);
@@ -39,9 +92,124 @@ void Engine::restart() {
     Window::getWindow().addMenu(menu);
 }
 
+Game* Engine::newGame() {
+    uint32_t seed = m_deterministic ? m_seed + m_gameCount : std::random_device{}();
+    ++m_gameCount;
+    return newGame(seed);
+}
+
+Game* Engine::newGame(uint32_t seed) {
+    stopGame();
+    if (Window::isVerbose()) {
+        std::cerr << "Starting game with seed " << seed << std::endl;
+    }
+    m_game = new Game(m_config, m_levelCache, seed);
+    if (m_checksumTrace.is_open()) {
+        m_game->setChecksumTrace(&m_checksumTrace);
+    }
+    m_game->setInputRecorder(m_inputRecorder);
+    m_game->setBotSpawning(m_botSpawning);
+    return m_game;
+}
+
+void Engine::stopGame() {
+    if (m_recorder != nullptr) {
+        m_recorder->finish();
+    }
+    delete m_game;
+    m_game = nullptr;
+    // the AI players deregistered from their inputs when they were deleted with the game
+    for (AIInput* input : m_aiInputs) {
+        delete input;
+    }
+    m_aiInputs.clear();
+}
+
+void Engine::fillWithAI(std::vector<Player*>& players) {
+    size_t teamL2R = 0;
+    uint32_t look = 0;
+    for (Player* player : players) {
+        if (player->getTeam() == Team::L2R) {
+            ++teamL2R;
+        }
+        look = std::max(look, player->getConfigIndex() + 1);
+    }
+    size_t teamR2L = players.size() - teamL2R;
+    size_t teamSize = std::max<size_t>(std::max(teamL2R, teamR2L), 1);
+
+    for (Team team : {Team::L2R, Team::R2L}) {
+        size_t& count = team == Team::L2R ? teamL2R : teamR2L;
+        // mix the policies within each team
+        for (uint32_t i = 0; count < teamSize; ++i, ++count) {
+            Player* player = m_playerSprites->createPlayer(team, look++);
+            auto* input = new AIInput(static_cast<AIPolicy>(i % kPolicyCount),
+                                      static_cast<uint32_t>(players.size()));
+            player->registerInput(input);
+            input->setPlayer(player);
+            m_aiInputs.push_back(input);
+            players.push_back(player);
+        }
+    }
+}
+
+void Engine::startNetworkGame(const NetworkArguments& args) {
+    delete m_netPlay;
+    m_netPlay = nullptr;
+    m_netPlay = new NetPlay(*this, args);
+}
+
+void Engine::startClientGame(const ClientArguments& args) {
+    delete m_clientPlay;
+    m_clientPlay = nullptr;
+    m_clientPlay = new ClientPlay(*this, args);
+}
+
+void Engine::startReplay(const std::string& path, double startSeconds) {
+    delete m_replayPlayer;
+    m_replayPlayer = nullptr;
+    m_replayPlayer = new ReplayPlayer(*this, path, startSeconds);
+}
+
+void Engine::recordTick() {
+    if (m_recorder != nullptr && m_game != nullptr) {
+        m_recorder->record(*m_game);
+    }
+}
+
 void Engine::update() {
+    if (m_netPlay != nullptr) {
+        // the remote peer keeps playing, so a network game is never paused
+        m_netPlay->update();
+        m_game->render();
+        return;
+    }
+    if (m_clientPlay != nullptr) {
+        // the game only mirrors the server, it is displayed but never simulated
+        m_clientPlay->update();
+        if (m_game != nullptr) {
+            m_game->render();
+        }
+        return;
+    }
+    if (m_replayPlayer != nullptr) {
+        // the recorded states are displayed without simulating them
+        m_replayPlayer->update();
+        if (m_replayPlayer->isFinished()) {
+            restart();
+        } else {
+            m_game->render();
+        }
+        return;
+    }
+    // like the devices of the window, the AI inputs are polled before the clock steps
+    for (AIInput* input : m_aiInputs) {
+        input->pollInput(nullptr);
+    }
+    Clock::step();
+
     // update game
     m_game->update();
+    recordTick();
 
     // If a menu has to be rendered, make sure the game is nur running.
     Menu* currentMenu = Window::getWindow().getCurrentMenu();
@@ -62,7 +230,21 @@ void Engine::pauseGame(Player* player) {
 
 Engine::~Engine() {
     // Delete all resources
+    delete m_netPlay;
+    delete m_clientPlay;
+    delete m_replayPlayer;
     delete m_game;
+    for (AIInput* input : m_aiInputs) {
+        delete input;
+    }
+    delete m_playerSprites;
+    // ends the recordings of the last game
+    delete m_recorder;
+    delete m_inputRecorder;
+    delete m_levelCache;
+    // after the levels, their bots and weapons use the prefabs and textures
+    delete m_prefabs;
+    delete m_sharedTextures;
     delete m_config;
 }
 
@@ -7,6 +7,8 @@
 #ifndef ENGINE_ENGINE_HPP
 #define ENGINE_ENGINE_HPP
 
+#include <cstdint>
+#include <fstream>
 #include <stack>
 #include <string>
 #include <vector>
@@ -14,6 +16,8 @@
 #include <SDL.h>
 
 #include "engine/Object.hpp"
+#include "engine/core/BotSpawning.hpp"
+#include "engine/core/QualityGovernor.hpp"
 
 namespace ctb {
 namespace parser {
@@ -22,18 +26,111 @@ class GameConfig;
 
 namespace engine {
 
+class AIInput;
+class ClientPlay;
 class Game;
+class InputRecorder;
+class LevelCache;
+class NetPlay;
 class Player;
+class PlayerSprites;
+class Prefabs;
+class ReplayPlayer;
+class ReplayRecorder;
+class SharedTextures;
+struct ClientArguments;
+struct NetworkArguments;
+struct WindowArguments;
 
 class Engine : public Object {
    public:
-    explicit Engine(const std::string& gamefile);
+    /**
+     * @brief Loads and validates the game file given in args
+     *
+     * @param args  the command line arguments
+     */
+    explicit Engine(const WindowArguments& args);
 
     virtual ~Engine();
 
-    /// Resets the game and displays the main menu.
+    /// Resets the game and displays the main menu. Levels built by earlier games are reused.
     void restart();
 
+    /**
+     * @brief Replaces the current game by a new one, without showing any menu
+     *
+     * In deterministic mode the n-th game is seeded with seed + n, so consecutive games differ
+     * but every run of the same command line plays the same games.
+     *
+     * @return the new game
+     */
+    Game* newGame();
+
+    /// Replaces the current game by a new one with the given seed, e.g. the seed of a server
+    Game* newGame(uint32_t seed);
+
+    /// Deletes the current game and the inputs of its AI players
+    void stopGame();
+
+    /**
+     * @brief Adds AI players to the smaller team until both teams have the same number of
+     *        players, at least one. update() polls their inputs until the game is stopped.
+     *
+     * @param players   the players of the next game, the AI players are appended
+     */
+    void fillWithAI(std::vector<Player*>& players);
+
+    /// Returns the sprites the players of all games are created with
+    PlayerSprites& getPlayerSprites() { return *m_playerSprites; }
+
+    /// Returns the textures shared by the bots and weapons of all games
+    SharedTextures& getSharedTextures() { return *m_sharedTextures; }
+
+    /// Returns the bot and weapon types of the game config
+    const Prefabs& getPrefabs() const { return *m_prefabs; }
+
+    /// Returns how many bots the levels of all games spawn
+    const BotSpawning& getBotSpawning() const { return m_botSpawning; }
+
+    /// Returns the governor the window reports its frame times to
+    QualityGovernor& getGovernor() { return m_governor; }
+
+    /// Returns what the games currently render and spawn
+    const Quality& getQuality() const { return m_governor.getQuality(); }
+
+    /**
+     * @brief Replaces the current game by a network game against a remote peer, without
+     *        showing any menu. restart() returns to a local game.
+     *
+     * @param args  the connection
+     */
+    void startNetworkGame(const NetworkArguments& args);
+
+    /**
+     * @brief Replaces the current game by the display of a game on a server, without showing
+     *        any menu. restart() returns to a local game.
+     *
+     * @param args  the server
+     */
+    void startClientGame(const ClientArguments& args);
+
+    /**
+     * @brief Replaces the current game by the display of the recordings of a replay file,
+     *        without showing any menu. The main menu follows the last recording.
+     *
+     * @param path          the replay file
+     * @param startSeconds  the first recording starts at this time of the game
+     *
+     * @throws runtime_error if the file can't be read or was recorded with another game file
+     */
+    void startReplay(const std::string& path, double startSeconds);
+
+    /// Records the last simulated tick of the current game if a replay is recorded
+    void recordTick();
+
+    /// Returns the recorder of the replay file or nullptr if none is recorded
+    ReplayRecorder* getRecorder() const { return m_recorder; }
+
     void update();
 
     std::string getGameFile() const { return m_gamefile; }
@@ -53,8 +150,56 @@ class Engine : public Object {
     /// A pointer to a game object
     Game* m_game;
 
+    /// runs m_game if it is a network game
+    NetPlay* m_netPlay{nullptr};
+
+    /// displays m_game if it is a game on a server
+    ClientPlay* m_clientPlay{nullptr};
+
+    /// displays m_game if it is a recorded game
+    ReplayPlayer* m_replayPlayer{nullptr};
+
+    /// records the simulated games, if a replay file was given
+    ReplayRecorder* m_recorder{nullptr};
+
+    /// records the inputs of the games, if an input recording was given
+    InputRecorder* m_inputRecorder{nullptr};
+
     /// the game config
     ctb::parser::GameConfig* m_config;
+
+    /// built levels, kept between games
+    LevelCache* m_levelCache;
+
+    /// the sheets of the players, kept between games
+    PlayerSprites* m_playerSprites{nullptr};
+
+    /// the textures of the bots and weapons, kept between games
+    SharedTextures* m_sharedTextures{nullptr};
+
+    /// the bot and weapon types, built with the game config
+    Prefabs* m_prefabs{nullptr};
+
+    /// the bot spawning of all games
+    BotSpawning m_botSpawning;
+
+    /// the quality of all games
+    QualityGovernor m_governor;
+
+    /// the inputs of the AI players added by fillWithAI
+    std::vector<AIInput*> m_aiInputs;
+
+    /// Use m_seed for every game instead of a random one
+    bool m_deterministic;
+
+    /// The seed of the first game in deterministic mode
+    uint32_t m_seed;
+
+    /// Number of games created so far
+    uint32_t m_gameCount{0};
+
+    /// Receives the state checksum of every tick, if opened
+    std::ofstream m_checksumTrace;
 };
 
 }  // namespace engine
@@ -0,0 +1,140 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#include <stdexcept>
+
+#include <SDL_image.h>
+#include <gsl/gsl>
+
+#include "engine/EngineContext.hpp"
+#include "engine/Object.hpp"
+#include "engine/audio/SoundManager.hpp"
+#include "engine/gui/Font.hpp"
+#include "engine/util/Exceptions.hpp"
+
+namespace ctb {
+namespace engine {
+
+namespace {
+/// The context bound to this thread, the main context if null
+thread_local EngineContext* boundContext = nullptr;
+}  // namespace
+
+EngineContext::EngineContext() : m_fonts(new std::map<std::string, Font>()) {}
+
+EngineContext& EngineContext::current() {
+    return boundContext != nullptr ? *boundContext : main();
+}
+
+EngineContext& EngineContext::main() {
+    static EngineContext context;
+    return context;
+}
+
+EngineContext::Binding::Binding(EngineContext& context) : m_previous(boundContext) {
+    boundContext = &context;
+}
+
+EngineContext::Binding::~Binding() {
+    boundContext = m_previous;
+}
+
+Engine& EngineContext::getEngine() const {
+    if (m_engine == nullptr) {
+        throw std::logic_error("You have to initialize the Window!");
+    }
+    return *m_engine;
+}
+
+void EngineContext::setRenderer(SDL_Renderer* renderer, int width, int height) {
+    Expects(m_surface == nullptr);
+    m_renderer = renderer;
+    m_width = width;
+    m_height = height;
+}
+
+void EngineContext::createSoftwareRenderer(int width, int height) {
+    Expects(m_renderer == nullptr);
+    m_surface = SDL_CreateRGBSurface(0, width, height, 32, 0, 0, 0, 0);
+    if (m_surface == nullptr) {
+        throw SdlException("SDL could not create the render surface.", SDL_GetError());
+    }
+    m_renderer = SDL_CreateSoftwareRenderer(m_surface);
+    if (m_renderer == nullptr) {
+        throw SdlException("SDL could not generate renderer.", SDL_GetError());
+    }
+    m_width = width;
+    m_height = height;
+}
+
+SDL_Texture* EngineContext::loadTexture(const std::string& path,
+                                        const Uint8 colorKeyRed,
+                                        const Uint8 colorKeyGreen,
+                                        const Uint8 colorKeyBlue) {
+    // Use an image decoded ahead or load it from disk
+    SDL_Surface* surface = nullptr;
+    auto decoded = m_decodedImages.find(path);
+    if (decoded != m_decodedImages.end()) {
+        surface = decoded->second;
+        m_decodedImages.erase(decoded);
+    } else {
+        surface = decodeImage(path);
+    }
+    if (surface == nullptr) {
+        throw SdlException("Error while loading \"" + path + "\".", IMG_GetError());
+    }
+
+    auto defer = gsl::finally([&] { SDL_FreeSurface(surface); });
+
+    // Map transparent color key
+    SDL_SetColorKey(surface, SDL_TRUE,
+                    SDL_MapRGB(surface->format, colorKeyRed, colorKeyGreen, colorKeyBlue));
+
+    // Render SDL2 texture
+    SDL_Texture* texture = SDL_CreateTextureFromSurface(m_renderer, surface);
+    if (texture == nullptr) {
+        throw SdlException("Error while creating texture \"" + path + "\".", SDL_GetError());
+    }
+    return texture;
+}
+
+SDL_Texture* EngineContext::createTexture(SDL_Surface* surface) {
+    Expects(surface != nullptr);
+    SDL_Texture* texture = SDL_CreateTextureFromSurface(m_renderer, surface);
+    if (texture == nullptr) {
+        throw SdlException("Error while creating a texture.", SDL_GetError());
+    }
+    return texture;
+}
+
+SDL_Surface* EngineContext::decodeImage(const std::string& path) {
+    return IMG_Load(path.c_str());
+}
+
+void EngineContext::addDecodedImage(const std::string& path, SDL_Surface* surface) {
+    Expects(surface != nullptr);
+    m_decodedImages.emplace(path, surface);
+}
+
+EngineContext::~EngineContext() {
+    m_garbage.flush();
+    delete m_soundManager;
+    delete m_fonts;
+
+    // images decoded for levels that were never built
+    for (auto& image : m_decodedImages) {
+        SDL_FreeSurface(image.second);
+    }
+
+    // an own renderer destroys the textures created with it
+    if (m_surface != nullptr) {
+        SDL_DestroyRenderer(m_renderer);
+        SDL_FreeSurface(m_surface);
+    }
+}
+
+}  // namespace engine
+}  // namespace ctb
@@ -0,0 +1,171 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_ENGINECONTEXT_HPP
+#define ENGINE_ENGINECONTEXT_HPP
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <SDL.h>
+
+#include "engine/core/DestroyQueue.hpp"
+
+namespace ctb {
+namespace engine {
+
+class Engine;
+class Font;
+class Object;
+class SoundManager;
+
+/**
+ * @brief Everything a game shares with the code around it: the engine, the renderer textures
+ *        are created with, the clock, the garbage collector, the sound manager, the fonts and
+ *        the highscores.
+ *
+ * Every thread has a current context, the static accessors (Clock, GC, SoundManager, Font,
+ * Highscores) and EngineContext::current() resolve through it. A thread uses the main context
+ * of the window until another one is bound with a Binding, so games on different threads with
+ * their own contexts don't share any state.
+ */
+class EngineContext {
+   public:
+    /// Creates a context without engine, renderer and sound manager
+    EngineContext();
+    EngineContext(const EngineContext&) = delete;
+    EngineContext& operator=(const EngineContext&) = delete;
+
+    /// Deletes the queued objects, the sound manager, the fonts and an own renderer
+    ~EngineContext();
+
+    /// Returns the context bound to the calling thread or the main context
+    static EngineContext& current();
+
+    /// Returns the context of the window
+    static EngineContext& main();
+
+    /**
+     * @brief Makes a context the current one of the calling thread until the binding is
+     *        destroyed, then the previous one is current again
+     */
+    class Binding {
+       public:
+        explicit Binding(EngineContext& context);
+        Binding(const Binding&) = delete;
+        Binding& operator=(const Binding&) = delete;
+        ~Binding();
+
+       private:
+        EngineContext* m_previous;
+    };
+
+    /// Returns the engine of this context
+    /// @throws logic_error if it has no engine
+    Engine& getEngine() const;
+
+    /// Sets the engine of this context, the caller keeps its ownership
+    void setEngine(Engine* engine) { m_engine = engine; }
+
+    /// Returns the renderer textures are created with, nullptr if there is none
+    SDL_Renderer* getRenderer() const { return m_renderer; }
+
+    /// Returns the width of the rendered area
+    int getWidth() const { return m_width; }
+
+    /// Returns the height of the rendered area
+    int getHeight() const { return m_height; }
+
+    /// Sets the renderer of a window, the caller keeps its ownership
+    void setRenderer(SDL_Renderer* renderer, int width, int height);
+
+    /**
+     * @brief Creates a software renderer drawing into a surface, for a context without window.
+     *        It can be used on any thread, but only on one at a time.
+     *
+     * @throws SdlException if the renderer can't be created
+     */
+    void createSoftwareRenderer(int width, int height);
+
+    /// \brief Returns a SDL_Texture from the given image, created with the renderer of this
+    ///        context.
+    ///
+    /// \param path Path to the image
+    /// \param colorKeyRed Color key red
+    /// \param colorKeyGreen Color key green
+    /// \param colorKeyBlue Color key blue
+    /// \return SDL_Texture SDL texture
+    SDL_Texture* loadTexture(const std::string& path,
+                             const Uint8 colorKeyRed = 255,
+                             const Uint8 colorKeyGreen = 0,
+                             const Uint8 colorKeyBlue = 255);
+
+    /// \brief Returns a SDL_Texture of a decoded image, created with the renderer of this
+    ///        context. The caller keeps the ownership of the surface.
+    ///
+    /// \param surface the decoded image, its color key is used as transparent color
+    /// \return SDL_Texture SDL texture
+    SDL_Texture* createTexture(SDL_Surface* surface);
+
+    /// \brief Decodes an image without creating a texture. It touches no context, so it can
+    ///        run on a worker thread.
+    ///
+    /// \param path Path to the image
+    /// \return SDL_Surface the decoded image, nullptr if it can't be loaded
+    static SDL_Surface* decodeImage(const std::string& path);
+
+    /// \brief Hands an image decoded by decodeImage to the next loadTexture of the same path, so
+    ///        it only has to create the texture. The context takes ownership of the surface.
+    ///
+    /// \param path Path to the image
+    /// \param surface the decoded image
+    void addDecodedImage(const std::string& path, SDL_Surface* surface);
+
+   private:
+    friend class Clock;
+    friend class Font;
+    friend class GC;
+    friend class Highscores;
+    friend class SoundManager;
+
+    Engine* m_engine{nullptr};
+
+    SDL_Renderer* m_renderer{nullptr};
+    int m_width{0};
+    int m_height{0};
+    /// Render target of an own software renderer
+    SDL_Surface* m_surface{nullptr};
+
+    /// Images decoded ahead of their loadTexture by their path
+    std::multimap<std::string, SDL_Surface*> m_decodedImages;
+
+    /// State of the Clock
+    bool m_fixedStep{false};
+    uint32_t m_ticks{0};
+
+    /// The queue of the GC
+    DestroyQueue<Object> m_garbage;
+
+    /// Set by SoundManager::init
+    SoundManager* m_soundManager{nullptr};
+
+    /// Maps all font names to loaded fonts
+    std::map<std::string, Font>* m_fonts;
+
+    /// The path of the highscore file
+    std::string m_highscorePath;
+
+    /// The highscores, always sorted
+    std::vector<std::pair<std::string, uint64_t>> m_highscores;
+};
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_ENGINECONTEXT_HPP
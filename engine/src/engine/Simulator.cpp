@@ -0,0 +1,390 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif  // NOMINMAX
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#include <gsl/gsl>
+#include <parser/GameConfig.hpp>
+
+#include "engine/Engine.hpp"
+#include "engine/Simulator.hpp"
+#include "engine/core/GC.hpp"
+#include "engine/core/Game.hpp"
+#include "engine/core/Level.hpp"
+#include "engine/core/PlayerSprites.hpp"
+#include "engine/input/AIInput.hpp"
+#include "engine/input/ReplayInput.hpp"
+#include "engine/replay/ReplayRecorder.hpp"
+#include "engine/scene/Player.hpp"
+#include "engine/util/Clock.hpp"
+
+namespace ctb {
+namespace engine {
+
+namespace {
+using SteadyClock = std::chrono::steady_clock;
+
+/// Returns the milliseconds between two time points
+float millis(SteadyClock::time_point from, SteadyClock::time_point to) {
+    return std::chrono::duration<float, std::milli>(to - from).count();
+}
+
+/// Returns the CPU time the calling thread has used in seconds
+double threadCpuSeconds() {
+#ifdef _WIN32
+    FILETIME creation, exit, kernel, user;
+    if (GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user) == 0) {
+        return 0.0;
+    }
+    // both in units of 100ns
+    auto time = [](const FILETIME& t) {
+        return static_cast<double>((static_cast<uint64_t>(t.dwHighDateTime) << 32) |
+                                   t.dwLowDateTime) *
+               1e-7;
+    };
+    return time(kernel) + time(user);
+#else
+    timespec time{};
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) != 0) {
+        return 0.0;
+    }
+    return static_cast<double>(time.tv_sec) + static_cast<double>(time.tv_nsec) * 1e-9;
+#endif
+}
+
+/// Returns the given percentile of the sorted values (nearest rank)
+float percentile(const std::vector<float>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0.0f;
+    }
+    auto rank = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(rank, sorted.size() - 1)];
+}
+
+/// Writes a list of scores as JSON array
+void printScores(std::ostream& out, const std::vector<uint64_t>& scores) {
+    out << '[';
+    for (size_t i = 0; i < scores.size(); ++i) {
+        out << (i > 0 ? ", " : "") << scores[i];
+    }
+    out << ']';
+}
+
+/// Number of values of AIPolicy
+constexpr uint32_t kPolicyCount = 3;
+
+const char* kPhaseNames[Simulator::PHASE_COUNT] = {"input",    "logic", "physics", "gc",
+                                                    "snapshot", "replay"};
+}  // namespace
+
+constexpr uint64_t Simulator::SNAPSHOT_CHECK_INTERVAL;
+
+Simulator::Simulator(Engine& engine, const SimulationArguments& args)
+    : m_engine(engine),
+      m_args(args),
+      m_botLoad(LoadProfile::bucketSizeFor(engine.getBotSpawning().budget)) {
+    Expects(args.playersPerTeam > 0 && args.maxTicks > 0 &&
+            (args.matches > 0 || !args.inputFile.empty()));
+    if (!args.inputFile.empty()) {
+        std::ifstream file(args.inputFile, std::ios::binary);
+        if (!file) {
+            throw std::runtime_error("Cannot open input recording \"" + args.inputFile + "\".");
+        }
+        std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)),
+                                  std::istreambuf_iterator<char>());
+        m_recorded = readInputMatches(data.data(), data.size());
+        if (m_recorded.empty()) {
+            throw std::runtime_error("The input recording has no match.");
+        }
+        uint64_t hash = replayConfigHash(engine.getGameConfig());
+        for (const InputMatch& match : m_recorded) {
+            if (match.configHash != hash) {
+                throw std::runtime_error("The inputs were recorded with another game file.");
+            }
+        }
+    }
+}
+
+void Simulator::run() {
+    // without a number of matches every recorded match is played once
+    size_t matches = m_args.matches > 0 ? m_args.matches : m_recorded.size();
+    for (size_t i = 0; i < matches; ++i) {
+        runMatch();
+    }
+    stopGame();
+}
+
+void Simulator::runMatch() {
+    const InputMatch* recorded = nullptr;
+    if (!m_recorded.empty()) {
+        recorded = &m_recorded[m_results.size() % m_recorded.size()];
+    }
+
+    // the players of the previous game are deleted together with it
+    Game* game = recorded != nullptr ? m_engine.newGame(recorded->seed) : m_engine.newGame();
+    deleteInputs();
+    if (recorded != nullptr) {
+        // the timers of the game are compared to the clock
+        Clock::restore(recorded->clock);
+        game->startGame(createPlayers(*recorded));
+        play(game, recorded->ticks, recorded);
+    } else {
+        // mix the policies within each team
+        std::vector<AIPolicy> policies;
+        for (uint32_t i = 0; i < m_args.playersPerTeam; ++i) {
+            policies.push_back(static_cast<AIPolicy>(i % kPolicyCount));
+        }
+        game->startGame(createPlayers(policies, policies));
+        play(game, m_args.maxTicks, nullptr);
+    }
+}
+
+const Simulator::MatchResult& Simulator::playMatch(uint32_t seed,
+                                                   const std::vector<AIPolicy>& policiesL2R,
+                                                   const std::vector<AIPolicy>& policiesR2L) {
+    Expects(!policiesL2R.empty() && !policiesR2L.empty());
+    Game* game = m_engine.newGame(seed);
+    deleteInputs();
+    game->startGame(createPlayers(policiesL2R, policiesR2L));
+    play(game, m_args.maxTicks, nullptr);
+    return m_results.back();
+}
+
+void Simulator::play(Game* game, uint64_t maxTicks, const InputMatch* recorded) {
+    const auto start = SteadyClock::now();
+    const double startCpu = threadCpuSeconds();
+    uint64_t ticks = 0;
+    while (!game->isFinished() && ticks < maxTicks) {
+        Level* level = game->getCurrentLevel();
+        uint32_t steps = level->getWorld()->getStats().steps;
+        size_t bots = level->getBots().size();
+
+        // the inputs are polled before the clock steps, like in the main loop of the window
+        auto t0 = SteadyClock::now();
+        for (Input* input : m_inputs) {
+            input->pollInput(nullptr);
+        }
+        auto t1 = SteadyClock::now();
+        Clock::step();
+        game->update();
+        auto t2 = SteadyClock::now();
+        GC::execute();
+        auto t3 = SteadyClock::now();
+
+        // the step time is measured by Box2D, the rest of the update is game logic
+        float physics = 0.0f;
+        if (game->getCurrentLevel() == level && level->getWorld()->getStats().steps != steps) {
+            physics = level->getWorld()->getStats().last.step;
+        }
+        float update = millis(t1, t2);
+        physics = std::min(physics, update);
+        if (m_args.tickTimes) {
+            m_phaseTimes[PHASE_INPUT].push_back(millis(t0, t1));
+            m_phaseTimes[PHASE_LOGIC].push_back(update - physics);
+            m_phaseTimes[PHASE_PHYSICS].push_back(physics);
+            m_phaseTimes[PHASE_GC].push_back(millis(t2, t3));
+            m_botLoad.add(bots, millis(t0, t3));
+        }
+
+        if (m_args.snapshots) {
+            snapshot(game, ticks);
+        }
+        if (m_engine.getRecorder() != nullptr) {
+            auto t4 = SteadyClock::now();
+            m_engine.recordTick();
+            if (m_args.tickTimes) {
+                m_phaseTimes[PHASE_REPLAY].push_back(millis(t4, SteadyClock::now()));
+            }
+        }
+        recordPeaks(game);
+        ++ticks;
+    }
+    double seconds = std::chrono::duration<double>(SteadyClock::now() - start).count();
+    double cpuSeconds = threadCpuSeconds() - startCpu;
+
+    MatchResult result{game->getSeed(), ticks, seconds, cpuSeconds, "none", {}, {}, false};
+    if (recorded != nullptr) {
+        result.desync =
+            game->getTick() != recorded->ticks || game->checksum() != recorded->checksum;
+    }
+    if (game->isFinished()) {
+        result.winner = game->getWinner() == Team::L2R ? "L2R" : "R2L";
+    }
+    for (Player* player : game->getL2RPlayers()) {
+        result.scoresL2R.push_back(player->getScore());
+    }
+    for (Player* player : game->getR2LPlayers()) {
+        result.scoresR2L.push_back(player->getScore());
+    }
+    m_results.push_back(result);
+    m_totalTicks += ticks;
+    m_totalSeconds += seconds;
+}
+
+std::vector<Player*> Simulator::createPlayers(const std::vector<AIPolicy>& policiesL2R,
+                                              const std::vector<AIPolicy>& policiesR2L) {
+    std::vector<Player*> players;
+    for (Team team : {Team::L2R, Team::R2L}) {
+        for (AIPolicy policy : team == Team::L2R ? policiesL2R : policiesR2L) {
+            // every player gets its own look, with palette swaps beyond the player configs
+            Player* player = m_engine.getPlayerSprites().createPlayer(
+                team, static_cast<uint32_t>(players.size()));
+
+            // spread the decisions of the players over the ticks
+            auto* input = new AIInput(policy, static_cast<uint32_t>(players.size()));
+            player->registerInput(input);
+            input->setPlayer(player);
+            m_inputs.push_back(input);
+            players.push_back(player);
+        }
+    }
+    return players;
+}
+
+std::vector<Player*> Simulator::createPlayers(const InputMatch& match) {
+    std::vector<Player*> players;
+    for (const InputPlayer& recorded : match.players) {
+        Team team = recorded.team == 0 ? Team::L2R : Team::R2L;
+        Player* player = m_engine.getPlayerSprites().createPlayer(team, recorded.configIndex);
+        auto* input = new ReplayInput(match, static_cast<uint8_t>(players.size()));
+        player->registerInput(input);
+        m_inputs.push_back(input);
+        players.push_back(player);
+    }
+    return players;
+}
+
+void Simulator::recordPeaks(Game* game) {
+    Level* level = game->getCurrentLevel();
+    size_t entities = game->getL2RPlayers().size() + game->getR2LPlayers().size() +
+                      level->getBots().size() + level->getWeapons().size();
+    m_peakEntities = std::max(m_peakEntities, entities);
+    m_peakBodies = std::max(m_peakBodies, level->getWorld()->getWorld()->GetBodyCount());
+}
+
+void Simulator::snapshot(Game* game, uint64_t tick) {
+    auto start = SteadyClock::now();
+    game->saveSnapshot(m_snapshot);
+    if (m_args.tickTimes) {
+        m_phaseTimes[PHASE_SNAPSHOT].push_back(millis(start, SteadyClock::now()));
+    }
+    m_peakSnapshotBytes = std::max(m_peakSnapshotBytes, m_snapshot.size());
+
+    if (tick % SNAPSHOT_CHECK_INTERVAL == 0) {
+        game->restoreSnapshot(m_snapshot);
+        game->saveSnapshot(m_snapshotCheck);
+        if (m_snapshotCheck != m_snapshot) {
+            ++m_snapshotMismatches;
+        }
+    }
+}
+
+void Simulator::deleteInputs() {
+    for (Input* input : m_inputs) {
+        delete input;
+    }
+    m_inputs.clear();
+}
+
+void Simulator::stopGame() {
+    m_engine.stopGame();
+    deleteInputs();
+}
+
+void Simulator::printSummary(std::ostream& out) const {
+    double seconds = std::max(m_totalSeconds, 1e-9);
+    out << "{\n";
+    out << "  \"matches\": " << m_results.size() << ",\n";
+    out << "  \"playersPerTeam\": " << m_args.playersPerTeam << ",\n";
+    out << "  \"ticks\": " << m_totalTicks << ",\n";
+    out << "  \"seconds\": " << m_totalSeconds << ",\n";
+    out << "  \"ticksPerSecond\": " << static_cast<double>(m_totalTicks) / seconds << ",\n";
+    out << "  \"matchesPerMinute\": " << static_cast<double>(m_results.size()) * 60.0 / seconds
+        << ",\n";
+
+    out << "  \"phases\": {\n";
+    for (int phase = 0; phase < PHASE_COUNT; ++phase) {
+        std::vector<float> sorted = m_phaseTimes[phase];
+        std::sort(sorted.begin(), sorted.end());
+        out << "    \"" << kPhaseNames[phase] << "\": {\"p50\": " << percentile(sorted, 0.5)
+            << ", \"p95\": " << percentile(sorted, 0.95)
+            << ", \"p99\": " << percentile(sorted, 0.99)
+            << ", \"max\": " << (sorted.empty() ? 0.0f : sorted.back()) << "}"
+            << (phase + 1 < PHASE_COUNT ? ",\n" : "\n");
+    }
+    out << "  },\n";
+
+    out << "  \"peaks\": {\"entities\": " << m_peakEntities << ", \"bodies\": " << m_peakBodies
+        << "},\n";
+
+    // the tick times by the number of bots in the level, how a horde slows the game down
+    out << "  \"bots\": {\"budget\": " << m_engine.getBotSpawning().budget
+        << ", \"perTick\": " << m_engine.getBotSpawning().perTick << ", \"tickTimes\": ";
+    m_botLoad.print(out);
+    out << "},\n";
+
+    if (m_args.snapshots) {
+        out << "  \"snapshots\": {\"bytes\": " << m_peakSnapshotBytes
+            << ", \"mismatches\": " << m_snapshotMismatches << "},\n";
+    }
+
+    if (ReplayRecorder* recorder = m_engine.getRecorder()) {
+        // the size of a match of ten minutes and the share of the recording in the run time
+        double minutes = static_cast<double>(m_totalTicks * Clock::FIXED_STEP) / 60000.0;
+        out << "  \"replay\": {\"bytes\": " << recorder->getBytes()
+            << ", \"frames\": " << recorder->getFrames()
+            << ", \"keyframes\": " << recorder->getKeyframes() << ", \"bytesPer10Minutes\": "
+            << static_cast<double>(recorder->getBytes()) * 10.0 / std::max(minutes, 1e-9)
+            << ", \"overheadPercent\": " << recorder->getSeconds() * 100.0 / seconds << "},\n";
+    }
+
+    if (!m_recorded.empty()) {
+        // a desync means the workload differs from the recorded one
+        auto desyncs = std::count_if(m_results.begin(), m_results.end(),
+                                     [](const MatchResult& result) { return result.desync; });
+        out << "  \"inputs\": {\"recordedMatches\": " << m_recorded.size()
+            << ", \"desyncs\": " << desyncs << "},\n";
+    }
+
+    out << "  \"results\": [\n";
+    for (size_t i = 0; i < m_results.size(); ++i) {
+        const MatchResult& result = m_results[i];
+        out << "    {\"seed\": " << result.seed << ", \"ticks\": " << result.ticks
+            << ", \"seconds\": " << result.seconds << ", \"cpuSeconds\": " << result.cpuSeconds
+            << ", \"winner\": \"" << result.winner
+            << "\", \"scores\": {\"L2R\": ";
+        printScores(out, result.scoresL2R);
+        out << ", \"R2L\": ";
+        printScores(out, result.scoresR2L);
+        out << "}";
+        if (!m_recorded.empty()) {
+            out << ", \"desync\": " << (result.desync ? "true" : "false");
+        }
+        out << "}" << (i + 1 < m_results.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n";
+    out << "}" << std::endl;
+}
+
+Simulator::~Simulator() {
+    stopGame();
+}
+
+}  // namespace engine
+}  // namespace ctb
@@ -0,0 +1,176 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_SIMULATOR_HPP
+#define ENGINE_SIMULATOR_HPP
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "engine/replay/InputRecording.hpp"
+#include "engine/util/LoadProfile.hpp"
+
+namespace ctb {
+namespace engine {
+
+class Engine;
+class Game;
+class Input;
+class Player;
+enum class AIPolicy;
+enum class Team;
+
+/// Arguments of a headless simulation
+struct SimulationArguments {
+    /// Number of matches to play
+    uint32_t matches{1};
+    /// Number of AI players per team
+    uint32_t playersPerTeam{2};
+    /// A match without winner is stopped after this many ticks
+    uint64_t maxTicks{60 * 60 * 40};
+    /// Saves a snapshot every tick and verifies regularly that restoring it is lossless
+    bool snapshots{false};
+    /// Keeps the duration of every tick per phase for the summary
+    bool tickTimes{true};
+    /// Input recording whose matches are played in turn instead of AI matches, if not empty
+    std::string inputFile{};
+};
+
+/**
+ * @brief Plays complete matches between AI players as fast as possible, without rendering,
+ *        sound or human input, and collects throughput statistics.
+ *
+ * With an input recording the recorded matches are simulated again by ReplayInputs instead,
+ * so the workload is the same in every run, independent of the AI.
+ */
+class Simulator {
+   public:
+    /**
+     * @brief Constructor
+     *
+     * @param engine    the engine to create the games with
+     * @param args      what to simulate
+     *
+     * @throws runtime_error if the input recording can't be read or was recorded with another
+     *         game file
+     */
+    Simulator(Engine& engine, const SimulationArguments& args);
+
+    /// Destructor
+    ~Simulator();
+
+    /// The result of one match
+    struct MatchResult {
+        uint32_t seed;
+        uint64_t ticks;
+        double seconds;
+        /// CPU time the thread playing the match spent on it
+        double cpuSeconds;
+        /// "L2R", "R2L" or "none" if the tick limit was reached
+        std::string winner;
+        std::vector<uint64_t> scoresL2R;
+        std::vector<uint64_t> scoresR2L;
+        /// if a recorded match ended with another state than recorded
+        bool desync;
+    };
+
+    /// Plays all matches
+    void run();
+
+    /**
+     * @brief Plays a single AI match, independent of the matches and the input recording of
+     *        the arguments
+     *
+     * @param seed          seed of the game, it also decides the order of the levels
+     * @param policiesL2R   the policy of every L2R player
+     * @param policiesR2L   the policy of every R2L player
+     * @return the result of the match, it is also part of the summary
+     */
+    const MatchResult& playMatch(uint32_t seed,
+                                 const std::vector<AIPolicy>& policiesL2R,
+                                 const std::vector<AIPolicy>& policiesR2L);
+
+    /// Writes the summary of all played matches as JSON to out
+    void printSummary(std::ostream& out) const;
+
+    /// The phases a tick is split into for the timing statistics
+    enum Phase {
+        PHASE_INPUT,
+        PHASE_LOGIC,
+        PHASE_PHYSICS,
+        PHASE_GC,
+        PHASE_SNAPSHOT,
+        PHASE_REPLAY,
+        PHASE_COUNT
+    };
+
+    /// Number of ticks between two round trip checks of the snapshots
+    static constexpr uint64_t SNAPSHOT_CHECK_INTERVAL = 100;
+
+   private:
+    /// Plays the next match of the arguments
+    void runMatch();
+
+    /// Plays a started game until it is finished or maxTicks are played and records its result
+    void play(Game* game, uint64_t maxTicks, const InputMatch* recorded);
+
+    /// Creates the AI players of one match, one for every policy
+    std::vector<Player*> createPlayers(const std::vector<AIPolicy>& policiesL2R,
+                                       const std::vector<AIPolicy>& policiesR2L);
+
+    /// Creates the players of a recorded match
+    std::vector<Player*> createPlayers(const InputMatch& match);
+
+    /// Deletes the inputs of the last match, its players must be deleted already
+    void deleteInputs();
+
+    /// Stops the running game and deletes its inputs
+    void stopGame();
+
+    /// Records the entity and body counts of the current level of game
+    void recordPeaks(Game* game);
+
+    /// Saves a snapshot of game and every SNAPSHOT_CHECK_INTERVAL ticks restores it and
+    /// compares it to a second snapshot
+    void snapshot(Game* game, uint64_t tick);
+
+    Engine& m_engine;
+    SimulationArguments m_args;
+
+    /// the inputs of the players of the current match
+    std::vector<Input*> m_inputs;
+
+    /// the matches of the input recording
+    std::vector<InputMatch> m_recorded;
+
+    std::vector<MatchResult> m_results;
+
+    /// duration of every tick per phase in ms, empty without tickTimes
+    std::vector<float> m_phaseTimes[PHASE_COUNT];
+
+    /// duration of every tick by the number of bots in the current level, empty without
+    /// tickTimes
+    LoadProfile m_botLoad;
+
+    uint64_t m_totalTicks{0};
+    double m_totalSeconds{0};
+    size_t m_peakEntities{0};
+    int32_t m_peakBodies{0};
+
+    /// the last snapshot and the one taken after restoring it, reused to avoid allocations
+    std::vector<uint8_t> m_snapshot;
+    std::vector<uint8_t> m_snapshotCheck;
+    size_t m_peakSnapshotBytes{0};
+    /// number of round trip checks that produced a different snapshot
+    uint32_t m_snapshotMismatches{0};
+};
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_SIMULATOR_HPP
@@ -0,0 +1,290 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iterator>
+#include <map>
+#include <numeric>
+#include <thread>
+
+#include <gsl/gsl>
+#include <parser/GameConfig.hpp>
+
+#include "engine/Engine.hpp"
+#include "engine/EngineContext.hpp"
+#include "engine/Tournament.hpp"
+#include "engine/Window.hpp"
+#include "engine/audio/SoundManager.hpp"
+#include "engine/core/GC.hpp"
+#include "engine/gui/Font.hpp"
+#include "engine/input/AIInput.hpp"
+#include "engine/util/Clock.hpp"
+
+namespace ctb {
+namespace engine {
+
+namespace {
+using SteadyClock = std::chrono::steady_clock;
+
+/// Returns the given percentile of the sorted values (nearest rank)
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    auto rank = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(rank, sorted.size() - 1)];
+}
+
+/// Writes the mean, percentiles and maximum of the values as JSON object
+void printDistribution(std::ostream& out, std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    double sum = std::accumulate(values.begin(), values.end(), 0.0);
+    out << "{\"mean\": " << sum / std::max(static_cast<double>(values.size()), 1.0)
+        << ", \"p5\": " << percentile(values, 0.05) << ", \"p25\": " << percentile(values, 0.25)
+        << ", \"p50\": " << percentile(values, 0.5) << ", \"p75\": " << percentile(values, 0.75)
+        << ", \"p95\": " << percentile(values, 0.95)
+        << ", \"max\": " << (values.empty() ? 0.0 : values.back()) << "}";
+}
+
+/// Returns the sum of the scores of a team
+double teamScore(const std::vector<uint64_t>& scores) {
+    return static_cast<double>(std::accumulate(scores.begin(), scores.end(), uint64_t{0}));
+}
+
+/// The first letters of the values of AIPolicy
+const char kPolicyLetters[] = {'S', 'C', 'D'};
+
+/// The matches of a lineup, on both sides
+struct LineupStats {
+    uint32_t matches{0};
+    uint32_t wins{0};
+    uint32_t draws{0};
+};
+}  // namespace
+
+Tournament::Tournament(const std::string& gameFile, const TournamentArguments& args)
+    : m_gameFile(gameFile),
+      m_args(args),
+      m_workers(args.workers),
+      m_width(EngineContext::main().getWidth()),
+      m_height(EngineContext::main().getHeight()),
+      m_matches(args.matches) {
+    Expects(args.matches > 0 && args.playersPerTeam > 0 && args.maxTicks > 0 && m_width > 0 &&
+            m_height > 0);
+    if (m_workers == 0) {
+        m_workers = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    m_workers = std::min(m_workers, args.matches);
+}
+
+void Tournament::run() {
+    const auto start = SteadyClock::now();
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < m_workers; ++i) {
+        threads.emplace_back(&Tournament::work, this, i);
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    m_seconds = std::chrono::duration<double>(SteadyClock::now() - start).count();
+
+    if (m_error) {
+        std::rethrow_exception(m_error);
+    }
+}
+
+void Tournament::work(uint32_t worker) {
+    try {
+        // everything a match touches belongs to this worker
+        EngineContext context;
+        EngineContext::Binding binding(context);
+        context.createSoftwareRenderer(m_width, m_height);
+        Clock::setFixedStep(true);
+
+        WindowArguments engineArgs;
+        engineArgs.path = m_gameFile;
+        Engine engine(engineArgs);
+        context.setEngine(&engine);
+        SoundManager::init(engine.getGameConfig(), false);
+        Font::loadFonts(engine.getGameConfig()->getFontsFolder());
+
+        {
+            SimulationArguments simulation;
+            simulation.playersPerTeam = m_args.playersPerTeam;
+            simulation.maxTicks = m_args.maxTicks;
+            // the durations of all ticks of a long tournament would take gigabytes
+            simulation.tickTimes = false;
+            Simulator simulator(engine, simulation);
+
+            const uint64_t lineups = getLineupCount();
+            for (uint32_t i = m_next++; i < m_args.matches; i = m_next++) {
+                // the next lineup of the R2L team after every lineup of the L2R team
+                uint64_t pair = i % (lineups * lineups);
+                Match& match = m_matches[i];
+                match.lineupL2R = static_cast<uint32_t>(pair % lineups);
+                match.lineupR2L = static_cast<uint32_t>(pair / lineups);
+                match.worker = worker;
+                match.result = simulator.playMatch(m_args.seed + i, getLineup(match.lineupL2R),
+                                                   getLineup(match.lineupR2L));
+            }
+        }
+        // the objects of the last game still need the engine when they are deleted
+        GC::execute();
+        context.setEngine(nullptr);
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(m_errorMutex);
+        if (!m_error) {
+            m_error = std::current_exception();
+        }
+        // the other workers stop after their current match
+        m_next = m_args.matches;
+    }
+}
+
+uint32_t Tournament::getLineupCount() const {
+    const uint32_t players = m_args.playersPerTeam;
+    return (players + 1) * (players + 2) / 2;
+}
+
+std::vector<AIPolicy> Tournament::getLineup(uint32_t lineup) const {
+    // ordered by the number of players seeking the flag, then by the number of chasers
+    const uint32_t players = m_args.playersPerTeam;
+    uint32_t seekers = players;
+    while (lineup > players - seekers) {
+        lineup -= players - seekers + 1;
+        --seekers;
+    }
+    uint32_t chasers = players - seekers - lineup;
+
+    std::vector<AIPolicy> policies(players, AIPolicy::DefendDoor);
+    std::fill_n(policies.begin(), seekers, AIPolicy::SeekFlag);
+    std::fill_n(policies.begin() + seekers, chasers, AIPolicy::ChaseCarrier);
+    return policies;
+}
+
+std::string Tournament::getLineupName(uint32_t lineup) const {
+    std::string name;
+    for (AIPolicy policy : getLineup(lineup)) {
+        name += kPolicyLetters[static_cast<int>(policy)];
+    }
+    return name;
+}
+
+void Tournament::printSummary(std::ostream& out) const {
+    double seconds = std::max(m_seconds, 1e-9);
+    uint64_t ticks = 0;
+    double matchSeconds = 0;
+    double cpuSeconds = 0;
+    uint32_t winsL2R = 0;
+    uint32_t winsR2L = 0;
+    std::vector<double> matchCpu;
+    std::vector<double> playerScores;
+    std::vector<double> teamScores;
+    std::vector<double> margins;
+    std::map<uint32_t, LineupStats> lineups;
+    std::vector<uint32_t> workerMatches(m_workers, 0);
+    std::vector<double> workerCpu(m_workers, 0.0);
+    for (const Match& match : m_matches) {
+        const Simulator::MatchResult& result = match.result;
+        ticks += result.ticks;
+        matchSeconds += result.seconds;
+        cpuSeconds += result.cpuSeconds;
+        matchCpu.push_back(result.cpuSeconds);
+        ++workerMatches[match.worker];
+        workerCpu[match.worker] += result.cpuSeconds;
+
+        for (const std::vector<uint64_t>* scores : {&result.scoresL2R, &result.scoresR2L}) {
+            for (uint64_t score : *scores) {
+                playerScores.push_back(static_cast<double>(score));
+            }
+            teamScores.push_back(teamScore(*scores));
+        }
+        margins.push_back(std::abs(teamScore(result.scoresL2R) - teamScore(result.scoresR2L)));
+
+        LineupStats& l2r = lineups[match.lineupL2R];
+        LineupStats& r2l = lineups[match.lineupR2L];
+        ++l2r.matches;
+        ++r2l.matches;
+        if (result.winner == "L2R") {
+            ++winsL2R;
+            ++l2r.wins;
+        } else if (result.winner == "R2L") {
+            ++winsR2L;
+            ++r2l.wins;
+        } else {
+            ++l2r.draws;
+            ++r2l.draws;
+        }
+    }
+    auto matches = static_cast<double>(m_matches.size());
+
+    out << "{\n";
+    out << "  \"matches\": " << m_matches.size() << ",\n";
+    out << "  \"workers\": " << m_workers << ",\n";
+    out << "  \"playersPerTeam\": " << m_args.playersPerTeam << ",\n";
+    out << "  \"seed\": " << m_args.seed << ",\n";
+    out << "  \"ticks\": " << ticks << ",\n";
+    out << "  \"seconds\": " << m_seconds << ",\n";
+    out << "  \"matchesPerHour\": " << matches * 3600.0 / seconds << ",\n";
+    out << "  \"ticksPerSecond\": " << static_cast<double>(ticks) / seconds << ",\n";
+    // the share of the wall time the workers spent playing and computing, near 1 if the
+    // matches scale with the workers
+    out << "  \"cpu\": {\"seconds\": " << cpuSeconds << ", \"matchSeconds\": " << matchSeconds
+        << ", \"utilization\": " << cpuSeconds / (seconds * m_workers)
+        << ", \"microsPerTick\": " << cpuSeconds * 1e6 / std::max(static_cast<double>(ticks), 1.0)
+        << ", \"perMatch\": ";
+    printDistribution(out, matchCpu);
+    out << "},\n";
+    out << "  \"perWorker\": [";
+    for (uint32_t i = 0; i < m_workers; ++i) {
+        out << (i > 0 ? ", " : "") << "{\"matches\": " << workerMatches[i]
+            << ", \"cpuSeconds\": " << workerCpu[i] << "}";
+    }
+    out << "],\n";
+
+    out << "  \"wins\": {\"L2R\": " << winsL2R << ", \"R2L\": " << winsR2L
+        << ", \"none\": " << m_matches.size() - winsL2R - winsR2L
+        << ", \"L2RRate\": " << winsL2R / matches << ", \"R2LRate\": " << winsR2L / matches
+        << "},\n";
+    // S, C and D stand for the players seeking the flag, chasing carriers and defending the door
+    out << "  \"lineups\": {\n";
+    for (auto it = lineups.begin(); it != lineups.end(); ++it) {
+        const LineupStats& stats = it->second;
+        out << "    \"" << getLineupName(it->first) << "\": {\"matches\": " << stats.matches
+            << ", \"wins\": " << stats.wins << ", \"draws\": " << stats.draws
+            << ", \"winRate\": " << static_cast<double>(stats.wins) / stats.matches << "}"
+            << (std::next(it) != lineups.end() ? ",\n" : "\n");
+    }
+    out << "  },\n";
+    out << "  \"scores\": {\"player\": ";
+    printDistribution(out, playerScores);
+    out << ",\n             \"team\": ";
+    printDistribution(out, teamScores);
+    out << ",\n             \"margin\": ";
+    printDistribution(out, margins);
+    out << "},\n";
+
+    out << "  \"results\": [\n";
+    for (size_t i = 0; i < m_matches.size(); ++i) {
+        const Match& match = m_matches[i];
+        const Simulator::MatchResult& result = match.result;
+        out << "    {\"seed\": " << result.seed << ", \"lineups\": {\"L2R\": \""
+            << getLineupName(match.lineupL2R) << "\", \"R2L\": \""
+            << getLineupName(match.lineupR2L) << "\"}, \"worker\": " << match.worker
+            << ", \"ticks\": " << result.ticks << ", \"seconds\": " << result.seconds
+            << ", \"cpuSeconds\": " << result.cpuSeconds << ", \"winner\": \"" << result.winner
+            << "\", \"scores\": {\"L2R\": " << teamScore(result.scoresL2R)
+            << ", \"R2L\": " << teamScore(result.scoresR2L) << "}}"
+            << (i + 1 < m_matches.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n";
+    out << "}" << std::endl;
+}
+
+}  // namespace engine
+}  // namespace ctb
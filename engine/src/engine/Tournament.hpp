@@ -0,0 +1,113 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_TOURNAMENT_HPP
+#define ENGINE_TOURNAMENT_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "engine/Simulator.hpp"
+
+namespace ctb {
+namespace engine {
+
+/// Arguments of a tournament
+struct TournamentArguments {
+    /// Number of matches to play
+    uint32_t matches{1};
+    /// Maximum number of matches played at the same time, one per hardware thread if 0
+    uint32_t workers{0};
+    /// Number of AI players per team
+    uint32_t playersPerTeam{2};
+    /// A match without winner is stopped after this many ticks
+    uint64_t maxTicks{60 * 60 * 40};
+    /// Seed of the first match, the n-th match uses the seed plus n
+    uint32_t seed{0};
+};
+
+/**
+ * @brief Plays many independent headless AI matches on a pool of worker threads and reports
+ *        the win rates, the score distribution and the performance of all of them.
+ *
+ * Every worker has its own EngineContext, engine and Simulator, so the workers share nothing
+ * but the next match to play. The seed of a match decides its level order, and the matches
+ * cycle through all pairs of team lineups, so every lineup plays against every other one on
+ * both sides.
+ */
+class Tournament {
+   public:
+    /**
+     * @brief Constructor
+     *
+     * @param gameFile  path of the game file every worker loads
+     * @param args      what to play
+     */
+    Tournament(const std::string& gameFile, const TournamentArguments& args);
+
+    /**
+     * @brief Plays all matches
+     *
+     * @throws the first exception of a worker, the other workers stop after their match
+     */
+    void run();
+
+    /// Writes the report of all played matches as JSON to out
+    void printSummary(std::ostream& out) const;
+
+   private:
+    /// A played match
+    struct Match {
+        uint32_t lineupL2R{0};
+        uint32_t lineupR2L{0};
+        /// the worker that played it
+        uint32_t worker{0};
+        Simulator::MatchResult result{};
+    };
+
+    /// Plays matches until all are taken, runs on a worker thread
+    void work(uint32_t worker);
+
+    /// Returns the number of different lineups, i.e. how many players of a team play which
+    /// policy
+    uint32_t getLineupCount() const;
+
+    /// Returns the policy of every player of a team with the given lineup
+    std::vector<AIPolicy> getLineup(uint32_t lineup) const;
+
+    /// Returns the name of a lineup, the first letter of every policy
+    std::string getLineupName(uint32_t lineup) const;
+
+    std::string m_gameFile;
+    TournamentArguments m_args;
+    uint32_t m_workers;
+
+    /// size of the software renderers of the workers
+    int m_width;
+    int m_height;
+
+    /// the next match a worker takes
+    std::atomic<uint32_t> m_next{0};
+
+    /// all matches, every worker writes only the ones it took
+    std::vector<Match> m_matches;
+
+    /// the first exception of a worker
+    std::exception_ptr m_error;
+    std::mutex m_errorMutex;
+
+    double m_seconds{0};
+};
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_TOURNAMENT_HPP
@@ -4,19 +4,27 @@
 // This file is licensed under the MIT license; see LICENSE file in the root of this
 // project for details.
 
+#include <chrono>
+#include <iostream>
+
 #include <SDL.h>
 #include <SDL_image.h>
 
 #include "engine/Engine.hpp"
+#include "engine/EngineContext.hpp"
 #include "engine/Window.hpp"
 #include "engine/audio/SoundManager.hpp"
 #include "engine/core/GC.hpp"
+#include "engine/core/Game.hpp"
+#include "engine/core/QualityGovernor.hpp"
 #include "engine/gui/Font.hpp"
 #include "engine/input/Input.hpp"
 #include "engine/input/InputManager.hpp"
 #include "engine/menu/Menu.hpp"
 #include "engine/misc/Highscores.hpp"
+#include "engine/util/Clock.hpp"
 #include "engine/util/Exceptions.hpp"
+#include "engine/util/LoadProfile.hpp"
 #include "engine/util/SdlDriver.hpp"
 
 namespace ctb {
@@ -24,24 +32,54 @@ namespace engine {
 
 bool Window::DEBUG = false;
 bool Window::VERBOSE = false;
+bool Window::HEADLESS = false;
 Window* Window::instance = nullptr;
 
 void Window::run(const std::string& title, int width, int height, const WindowArguments& args) {
     Window::DEBUG = args.debug;
     Window::VERBOSE = args.verbose;
-    instance = new Window(title, args.path, width, height);
-    instance->init(args.sound);
-    instance->run();
+    Window::HEADLESS = args.simulate || args.compete || args.serve;
+    // a simulation runs faster than real time and network peers have to simulate the same
+    // steps, so all of them use fixed steps, like a recording with one frame per step
+    Clock::setFixedStep(args.deterministic || args.simulate || args.networked || args.serve ||
+                        !args.recordFile.empty() || !args.inputRecordFile.empty());
+    instance = new Window(title, args, width, height);
+    if (args.simulate) {
+        instance->init(false);
+        instance->simulate(args.simulation);
+    } else if (args.compete) {
+        // the workers load everything they need themselves
+        instance->playTournament(args.path, args.tournament);
+    } else if (args.serve) {
+        instance->init(false);
+        instance->serve(args.server);
+    } else {
+        instance->init(args.sound);
+        if (args.networked) {
+            instance->m_engine->startNetworkGame(args.network);
+        } else if (args.connect) {
+            instance->m_engine->startClientGame(args.client);
+        } else if (!args.replayFile.empty()) {
+            instance->m_engine->startReplay(args.replayFile, args.replayStart);
+        } else {
+            instance->m_engine->restart();
+        }
+        instance->run();
+    }
     delete instance;
 }
 
-Window::Window(const std::string& title, const std::string& gamefile, const int w, const int h)
+Window::Window(const std::string& title, const WindowArguments& args, const int w, const int h)
     : m_width(w), m_height(h) {
     // Initialize SDL
     initSDL(title);
+    EngineContext::main().setRenderer(m_renderer, m_width, m_height);
 
-    m_engine = new Engine(gamefile);
-    m_inputManager = new InputManager(m_engine->getGameConfig());
+    m_engine = new Engine(args);
+    EngineContext::main().setEngine(m_engine);
+    if (!HEADLESS) {
+        m_inputManager = new InputManager(m_engine->getGameConfig());
+    }
 }
 
 Window& Window::getWindow() {
@@ -51,17 +89,13 @@ Window& Window::getWindow() {
     return *instance;
 }
 
-Engine& Window::getEngine() {
-    if (instance == nullptr) {
-        throw std::logic_error("You have to initialize the Window!");
-    }
-    return *(instance->m_engine);
-}
-
 InputManager& Window::getInputManager() {
     if (instance == nullptr) {
         throw std::logic_error("You have to initialize the Window!");
     }
+    if (instance->m_inputManager == nullptr) {
+        throw std::logic_error("There are no input devices in headless mode!");
+    }
     return *(instance->m_inputManager);
 }
 
@@ -69,6 +103,14 @@ bool Window::isDebug() {
     return Window::DEBUG;
 }
 
+bool Window::isVerbose() {
+    return Window::VERBOSE;
+}
+
+bool Window::isHeadless() {
+    return Window::HEADLESS;
+}
+
 void Window::init(const bool sound) {
     auto* config = m_engine->getGameConfig();
 
@@ -80,15 +122,20 @@ void Window::init(const bool sound) {
 
     // load all fonts in the folder
     Font::loadFonts(config->getFontsFolder());
-
-    m_engine->restart();
 }
 
 void Window::run() {
     SDL_Rect background = {0, 0, m_width, m_height};
 
+    // a horde reports the frame times by the number of bots when the window is closed
+    const BotSpawning& spawning = m_engine->getBotSpawning();
+    LoadProfile botLoad(LoadProfile::bucketSizeFor(spawning.budget));
+    QualityGovernor& governor = m_engine->getGovernor();
+
     // Start main loop and event handling
     while (!m_quit && m_renderer) {
+        auto frameStart = std::chrono::steady_clock::now();
+
         // add menus
         while (!m_menusToAdd.empty()) {
             m_menus.push(m_menusToAdd.front());
@@ -112,11 +159,64 @@ void Window::run() {
             m_menus.top()->render();
         }
 
+        // the present waits for the display, so only the time before it shows the headroom
+        std::chrono::duration<float, std::milli> work =
+            std::chrono::steady_clock::now() - frameStart;
+
         // Update screen
         SDL_RenderPresent(m_renderer);
 
         GC::execute();
+
+        Game* game = m_engine->getGame();
+        if (game != nullptr && game->getGameState() == GameState::Running) {
+            if (governor.addFrame(work.count()) && Window::isVerbose()) {
+                std::cout << "Quality level " << governor.getLevel() << " at "
+                          << governor.getDecisions().back().millis << " ms per frame"
+                          << std::endl;
+            }
+            if (spawning.isHorde()) {
+                std::chrono::duration<float, std::milli> frame =
+                    std::chrono::steady_clock::now() - frameStart;
+                botLoad.add(game->getCurrentLevel()->getBots().size(), frame.count());
+            }
+        }
     }
+
+    // the stats of a horde and the decisions of the governor, if there are any
+    bool quality = !governor.getDecisions().empty();
+    if (!botLoad.empty() || quality) {
+        std::cout << "{";
+        if (!botLoad.empty()) {
+            std::cout << "\n  \"bots\": {\"budget\": " << spawning.budget
+                      << ", \"perTick\": " << spawning.perTick << ", \"frameTimes\": ";
+            botLoad.print(std::cout);
+            std::cout << "}" << (quality ? "," : "");
+        }
+        if (quality) {
+            std::cout << "\n  \"quality\": ";
+            governor.print(std::cout);
+        }
+        std::cout << "\n}" << std::endl;
+    }
+}
+
+void Window::simulate(const SimulationArguments& args) {
+    Simulator simulator(*m_engine, args);
+    simulator.run();
+    simulator.printSummary(std::cout);
+}
+
+void Window::playTournament(const std::string& gameFile, const TournamentArguments& args) {
+    Tournament tournament(gameFile, args);
+    tournament.run();
+    tournament.printSummary(std::cout);
+}
+
+void Window::serve(const ServerArguments& args) {
+    ServerPlay server(*m_engine, args);
+    server.run();
+    server.printSummary(std::cout);
 }
 
 void Window::addMenu(Menu* menu) {
@@ -139,31 +239,12 @@ Menu* Window::getCurrentMenu() {
     }
 }
 
-SDL_Texture* Window::loadTexture(const std::string& path,
-                                 const Uint8 colorKeyRed,
-                                 const Uint8 colorKeyGreen,
-                                 const Uint8 colorKeyBlue) {
-    // Load image from disk
-    SDL_Surface* surface = IMG_Load(path.c_str());
-    if (surface == nullptr) {
-        throw SdlException("Error while loading \"" + path + "\".", IMG_GetError());
-    }
-
-    auto defer = gsl::finally([&] { SDL_FreeSurface(surface); });
-
-    // Map transparent color key
-    SDL_SetColorKey(surface, SDL_TRUE,
-                    SDL_MapRGB(surface->format, colorKeyRed, colorKeyGreen, colorKeyBlue));
-
-    // Render SDL2 texture
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(m_renderer, surface);
-    if (texture == nullptr) {
-        throw SdlException("Error while creating texture \"" + path + "\".", SDL_GetError());
+void Window::initSDL(const std::string& title) {
+    if (HEADLESS) {
+        initHeadlessSDL();
+        return;
     }
-    return texture;
-}
 
-void Window::initSDL(const std::string& title) {
     // Initialize SDL
     Uint32 flags = SDL_INIT_VIDEO | SDL_INIT_GAMECONTROLLER;
 #ifdef ENABLE_SOUND
@@ -230,11 +311,38 @@ void Window::initSDL(const std::string& title) {
     SDL_SetRenderDrawBlendMode(m_renderer, SDL_BLENDMODE_BLEND);
 }
 
+void Window::initHeadlessSDL() {
+    if (SDL_Init(SDL_INIT_TIMER) != 0) {
+        throw SdlException("SDL error during initialize.", SDL_GetError());
+    }
+
+    // textures are still created by the game objects, so they get a software renderer
+    m_surface = SDL_CreateRGBSurface(0, m_width, m_height, 32, 0, 0, 0, 0);
+    if (m_surface == nullptr) {
+        throw SdlException("SDL could not create the render surface.", SDL_GetError());
+    }
+    m_renderer = SDL_CreateSoftwareRenderer(m_surface);
+    if (m_renderer == nullptr) {
+        throw SdlException("SDL could not generate renderer.", SDL_GetError());
+    }
+
+    int imgFlags = IMG_INIT_PNG;
+    if ((IMG_Init(imgFlags) & imgFlags) != imgFlags) {
+        throw SdlException("SDL_image could not initialize.", IMG_GetError());
+    }
+}
+
 void Window::quitSDL() {
     // Destroy window and renderer
     if (m_renderer) {
         SDL_DestroyRenderer(m_renderer);
         m_renderer = nullptr;
+        EngineContext::main().setRenderer(nullptr, 0, 0);
+    }
+
+    if (m_surface) {
+        SDL_FreeSurface(m_surface);
+        m_surface = nullptr;
     }
 
     if (m_window) {
@@ -250,6 +358,7 @@ void Window::quitSDL() {
 Window::~Window() {
     // delete engine
     delete m_engine;
+    EngineContext::main().setEngine(nullptr);
 
     // delete menus
     while (!m_menusToAdd.empty()) {
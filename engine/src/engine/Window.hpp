@@ -7,6 +7,7 @@
 #ifndef ENGINE_WINDOW_HPP
 #define ENGINE_WINDOW_HPP
 
+#include <cstdint>
 #include <queue>
 #include <stack>
 #include <string>
@@ -15,6 +16,12 @@
 #include <SDL.h>
 
 #include "engine/Object.hpp"
+#include "engine/Simulator.hpp"
+#include "engine/Tournament.hpp"
+#include "engine/core/BotSpawning.hpp"
+#include "engine/net/ClientPlay.hpp"
+#include "engine/net/NetPlay.hpp"
+#include "engine/net/ServerPlay.hpp"
 
 namespace ctb {
 namespace engine {
@@ -32,6 +39,44 @@ struct WindowArguments {
     bool verbose{false};
     /// Enable sound
     bool sound{true};
+    /// Run with a fixed seed and fixed time steps
+    bool deterministic{false};
+    /// Seed of all games in deterministic mode
+    uint32_t seed{0};
+    /// File the per tick state checksums are written to, disabled if empty
+    std::string checksumFile{};
+    /// Play AI matches without window, sound and human input
+    bool simulate{false};
+    /// What to simulate if simulate is set
+    SimulationArguments simulation{};
+    /// Play AI matches without window, sound and human input on several threads
+    bool compete{false};
+    /// What to play if compete is set
+    TournamentArguments tournament{};
+    /// Play against a remote peer instead of showing the start menu, implies deterministic
+    bool networked{false};
+    /// The connection if networked is set
+    NetworkArguments network{};
+    /// Run games headless for remote clients, implies fixed time steps
+    bool serve{false};
+    /// What to serve if serve is set
+    ServerArguments server{};
+    /// Display the game of a server instead of showing the start menu
+    bool connect{false};
+    /// The server if connect is set
+    ClientArguments client{};
+    /// File the simulated games are recorded to, implies fixed time steps, disabled if empty
+    std::string recordFile{};
+    /// Display the recorded games of this file instead of showing the start menu
+    std::string replayFile{};
+    /// The first recorded game is displayed from this time in seconds
+    double replayStart{0};
+    /// File the inputs of the games are recorded to, implies fixed time steps, disabled if empty
+    std::string inputRecordFile{};
+    /// How many bots the levels spawn, a horde reports its frame times by the number of bots
+    BotSpawning bots{};
+    /// The quality is lowered while frames take longer than this many ms, disabled if 0
+    float frameBudget{1000.0f / 60.0f};
     /// Game file path
     std::string path{};
 };
@@ -46,12 +91,15 @@ class Window : public Object {
 
     static Window& getWindow();
 
-    static Engine& getEngine();
-
     static InputManager& getInputManager();
 
     static bool isDebug();
 
+    static bool isVerbose();
+
+    /// Returns if nothing is displayed and no human input is read
+    static bool isHeadless();
+
     /// Quits the game
     void quit() { m_quit = true; }
 
@@ -64,27 +112,6 @@ class Window : public Object {
     /// Returns the current open menu
     Menu* getCurrentMenu();
 
-    /// Gets the current SDL renderer
-    SDL_Renderer* renderer() const { return m_renderer; }
-
-    /// Returns the current width of the window
-    int w() const { return m_width; }
-
-    /// Returns the current height of the window
-    int h() const { return m_height; }
-
-    /// \brief Returns a SDL_Texture from the given image.
-    ///
-    /// \param path Path to the image
-    /// \param colorKeyRed Color key red
-    /// \param colorKeyGreen Color key green
-    /// \param colorKeyBlue Color key blue
-    /// \return SDL_Texture SDL texture
-    SDL_Texture* loadTexture(const std::string& path,
-                             const Uint8 colorKeyRed = 255,
-                             const Uint8 colorKeyGreen = 0,
-                             const Uint8 colorKeyBlue = 255);
-
     virtual ~Window();
 
    private:
@@ -92,25 +119,37 @@ class Window : public Object {
 
     static bool DEBUG;
     static bool VERBOSE;
+    static bool HEADLESS;
 
     /***
      * Creates the main window with given \ref title, width \ref w and height \ref h
      *
      * @param title		Title of the window
-     * @param gamefile  XML definition of game attributes
+     * @param args      command line arguments, including the game file
      * @param w			Width
      * @param h			Height
-     * @param sound     Sound enabled
      */
-    Window(const std::string& title, const std::string& gamefile, const int w, const int h);
+    Window(const std::string& title, const WindowArguments& args, const int w, const int h);
 
     void init(const bool sound);
 
     void run();
 
+    /// Plays the matches described by args without rendering and prints a summary
+    void simulate(const SimulationArguments& args);
+
+    /// Plays the matches of a tournament on worker threads and prints its report
+    void playTournament(const std::string& gameFile, const TournamentArguments& args);
+
+    /// Runs a headless server and prints its statistics
+    void serve(const ServerArguments& args);
+
     /// Initializes all needed SDL resources
     void initSDL(const std::string& title);
 
+    /// Initializes SDL without window and audio, rendering into a surface
+    void initHeadlessSDL();
+
     /// Quits SDL and frees all resources
     void quitSDL();
 
@@ -125,6 +164,9 @@ class Window : public Object {
     /// SDL renderer struct
     SDL_Renderer* m_renderer{nullptr};
 
+    /// Render target of the software renderer in headless mode
+    SDL_Surface* m_surface{nullptr};
+
     /// Window width
     int m_width;
 
@@ -138,7 +180,8 @@ class Window : public Object {
     /// to prevent the new created menu to listen to the old keys
     std::queue<Menu*> m_menusToAdd;
 
-    InputManager* m_inputManager;
+    /// Human input devices, null in headless mode
+    InputManager* m_inputManager{nullptr};
 };
 
 }  // namespace engine
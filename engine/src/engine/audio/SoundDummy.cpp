@@ -4,6 +4,7 @@
 // This file is licensed under the MIT license; see LICENSE file in the root of this
 // project for details.
 
+#include "engine/EngineContext.hpp"
 #include "engine/audio/SoundManager.hpp"
 
 #ifndef ENABLE_SOUND
@@ -11,13 +12,14 @@
 namespace ctb {
 namespace engine {
 
-SoundManager* instance = nullptr;
-
 void SoundManager::init(parser::GameConfig* /*config*/, bool /*sound*/) {
-    instance = new SoundManager(nullptr, false);
+    EngineContext& context = EngineContext::current();
+    delete context.m_soundManager;
+    context.m_soundManager = new SoundManager(nullptr, false);
 }
 
 SoundManager& SoundManager::getInstance() {
+    SoundManager* instance = EngineContext::current().m_soundManager;
     if (!instance) {
         throw std::runtime_error("SoundManager has not been initialized yet");
     }
@@ -25,10 +27,9 @@ SoundManager& SoundManager::getInstance() {
 }
 
 void SoundManager::deleteSoundManager() {
-    if (instance) {
-        delete instance;
-        instance = nullptr;
-    }
+    EngineContext& context = EngineContext::current();
+    delete context.m_soundManager;
+    context.m_soundManager = nullptr;
 }
 
 SoundManager::SoundManager(parser::GameConfig* /*config*/, bool /*sound*/) {}
@@ -59,6 +60,8 @@ int SoundManager::getNextChannel() {
     return 0;
 }
 
+void SoundManager::play(SoundEffect* /*effect*/) {}
+
 }  // namespace engine
 }  // namespace ctb
 
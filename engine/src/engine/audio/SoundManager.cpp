@@ -4,20 +4,22 @@
 // This file is licensed under the MIT license; see LICENSE file in the root of this
 // project for details.
 
+#include "engine/EngineContext.hpp"
 #include "engine/audio/SoundManager.hpp"
 
 #ifdef ENABLE_SOUND
 namespace ctb {
 namespace engine {
 
-SoundManager* instance = nullptr;
-
 void SoundManager::init(parser::GameConfig* config, bool sound) {
-    // Create one instance
-    instance = new SoundManager(config, sound);
+    // Create one instance per context
+    EngineContext& context = EngineContext::current();
+    delete context.m_soundManager;
+    context.m_soundManager = new SoundManager(config, sound);
 }
 
 SoundManager& SoundManager::getInstance() {
+    SoundManager* instance = EngineContext::current().m_soundManager;
     if (!instance) {
         throw std::runtime_error("SoundManager has not been initialized yet");
     }
@@ -25,10 +27,9 @@ SoundManager& SoundManager::getInstance() {
 }
 
 void SoundManager::deleteSoundManager() {
-    if (instance) {
-        delete instance;
-        instance = nullptr;
-    }
+    EngineContext& context = EngineContext::current();
+    delete context.m_soundManager;
+    context.m_soundManager = nullptr;
 }
 
 SoundManager::SoundManager(parser::GameConfig* config, bool sound) {
@@ -38,17 +39,19 @@ SoundManager::SoundManager(parser::GameConfig* config, bool sound) {
     //    throw std::runtime_error("Mix_Init failed: " + std::string(Mix_GetError()));
     //}
 
-    // Initialize SDL_mixer
-    if (Mix_OpenAudio(22050, MIX_DEFAULT_FORMAT, 2, 4096) == -1) {
-        throw std::runtime_error("Cannot open Audio: " + std::string(Mix_GetError()));
-    }
-
-    Mix_AllocateChannels(m_channelCount);
-
     // Current played music
     m_teamMusic = TeamMusic::NONE;
 
+    // without sound the audio device is not opened, so managers of other contexts can run on
+    // other threads
     if (sound) {
+        // Initialize SDL_mixer
+        if (Mix_OpenAudio(22050, MIX_DEFAULT_FORMAT, 2, 4096) == -1) {
+            throw std::runtime_error("Cannot open Audio: " + std::string(Mix_GetError()));
+        }
+        m_audio = true;
+        Mix_AllocateChannels(m_channelCount);
+
         Music::setVolume(32);
         m_musicRTL = new Music(config->getSoundsFolder() + "musicRTL.wav");
         m_musicLTR = new Music(config->getSoundsFolder() + "musicLTR.wav");
@@ -67,7 +70,9 @@ SoundManager::SoundManager(parser::GameConfig* config, bool sound) {
 
 void SoundManager::stopMusic() {
     m_teamMusic = TeamMusic::NONE;
-    Music::stop();
+    if (m_audio) {
+        Music::stop();
+    }
 }
 
 void SoundManager::playMusicRTL() {
@@ -87,45 +92,31 @@ void SoundManager::playMusicLTR() {
 }
 
 void SoundManager::playJump() {
-    if (m_jumpSound) {
-        m_jumpSound->play(getNextChannel());
-    }
+    play(m_jumpSound);
 }
 
 void SoundManager::playStep() {
-    if (m_stepSound) {
-        m_stepSound->play(getNextChannel());
-    }
+    play(m_stepSound);
 }
 
 void SoundManager::playDoor() {
-    if (m_doorSound) {
-        m_doorSound->play(getNextChannel());
-    }
+    play(m_doorSound);
 }
 
 void SoundManager::playWin() {
-    if (m_winSound) {
-        m_winSound->play(getNextChannel());
-    }
+    play(m_winSound);
 }
 
 void SoundManager::playHit() {
-    if (m_hitSound) {
-        m_hitSound->play(getNextChannel());
-    }
+    play(m_hitSound);
 }
 
 void SoundManager::playDamage() {
-    if (m_damageSound) {
-        m_damageSound->play(getNextChannel());
-    }
+    play(m_damageSound);
 }
 
 void SoundManager::playPew() {
-    if (m_pewSound) {
-        m_pewSound->play(getNextChannel());
-    }
+    play(m_pewSound);
 }
 
 SoundManager::~SoundManager() {
@@ -142,7 +133,15 @@ SoundManager::~SoundManager() {
     delete m_pewSound;
 
     // quit SDL_mixer
-    Mix_CloseAudio();
+    if (m_audio) {
+        Mix_CloseAudio();
+    }
+}
+
+void SoundManager::play(SoundEffect* effect) {
+    if (effect && !m_muted) {
+        effect->play(getNextChannel());
+    }
 }
 
 int SoundManager::getNextChannel() {
@@ -35,7 +35,7 @@ class SoundManager {
     /// \brief sound if sounds are enabled
     static void init(parser::GameConfig* config, bool sound);
 
-    /// \brief delivers instance of SoundManager
+    /// \brief delivers instance of SoundManager of the current EngineContext
     ///
     /// \return Soundmanager& instance
     /// \throws std::runtime_error if soundmanager has not been initialized yet
@@ -74,6 +74,9 @@ class SoundManager {
     /// plays pew sound
     void playPew();
 
+    /// Skips all sound effects while muted, e.g. while ticks are simulated again
+    void setMuted(bool muted) { m_muted = muted; }
+
     /// unregisters SDL Audio and deletes all sounds
     ~SoundManager();
 
@@ -87,6 +90,9 @@ class SoundManager {
     /// delivers the next channel to play audio on
     int getNextChannel();
 
+    /// plays the effect unless it is null or the sound manager is muted
+    void play(SoundEffect* effect);
+
     /// count of channels
     int m_channelCount{16};
 
@@ -119,6 +125,12 @@ class SoundManager {
 
     /// Saves the music played for the current team or none
     TeamMusic m_teamMusic;
+
+    /// If sound effects are skipped
+    bool m_muted{false};
+
+    /// If the audio device was opened, only if sound is enabled
+    bool m_audio{false};
 };
 
 }  // namespace engine
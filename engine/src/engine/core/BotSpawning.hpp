@@ -0,0 +1,30 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_CORE_BOTSPAWNING_HPP
+#define ENGINE_CORE_BOTSPAWNING_HPP
+
+#include <cstdint>
+
+namespace ctb {
+namespace engine {
+
+/// How many bots the current level of a game spawns at its bot spawns
+struct BotSpawning {
+    /// Maximum number of bots in a level at the same time
+    uint32_t budget{5};
+    /// Bots spawned every tick while the level is below its budget. If 0, a bot is spawned now
+    /// and then by chance.
+    uint32_t perTick{0};
+
+    /// Returns if this is a horde, i.e. the bots are spawned every tick
+    bool isHorde() const { return perTick > 0; }
+};
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_CORE_BOTSPAWNING_HPP
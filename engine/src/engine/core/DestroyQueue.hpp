@@ -0,0 +1,66 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT License; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_CORE_DESTROYQUEUE_HPP
+#define ENGINE_CORE_DESTROYQUEUE_HPP
+
+#include <cstddef>
+#include <vector>
+
+namespace ctb {
+namespace engine {
+
+/**
+ * @brief Objects of one type, which are deleted at the next flush.
+ *
+ * Objects can't be deleted while Box2D steps, because their destructors destroy bodies, so
+ * they are queued and deleted in one batch once the world is unlocked again. The queue
+ * doesn't check for duplicates, the owner has to push every object once, e.g. only if
+ * erasing its handle succeeded.
+ */
+template <class T>
+class DestroyQueue {
+   public:
+    DestroyQueue() = default;
+    DestroyQueue(const DestroyQueue&) = delete;
+    DestroyQueue& operator=(const DestroyQueue&) = delete;
+
+    /// Deletes the object with the next flush
+    void push(T* object) {
+        if (object) {
+            m_objects.push_back(object);
+        }
+    }
+
+    /// Deletes all queued objects, objects queued by their destructors are deleted as well
+    void flush() {
+        while (!m_objects.empty()) {
+            m_flushing.swap(m_objects);
+            for (T* object : m_flushing) {
+                delete object;
+            }
+            m_flushing.clear();
+        }
+    }
+
+    /// Returns the number of queued objects
+    size_t size() const { return m_objects.size(); }
+
+    /// Returns if no object is queued
+    bool empty() const { return m_objects.empty(); }
+
+    ~DestroyQueue() { flush(); }
+
+   private:
+    std::vector<T*> m_objects;
+    /// the objects which are deleted right now, kept to reuse the memory
+    std::vector<T*> m_flushing;
+};
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_CORE_DESTROYQUEUE_HPP
@@ -0,0 +1,102 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT License; see LICENSE file in the root of this
+// project for details.
+
+#include <gsl/gsl>
+
+#include "engine/core/EntityStore.hpp"
+#include "engine/graphics/PhysicalRenderable.hpp"
+
+namespace ctb {
+namespace engine {
+
+void EntityStore::add(PhysicalRenderable* object, bool isStatic) {
+    Expects(object != nullptr && object->getBody() != nullptr);
+    auto it = m_indices.find(object);
+    if (it != m_indices.end()) {
+        // objects moving between levels have a body in every level's world
+        m_bodies[it->second] = object->getBody();
+        return;
+    }
+
+    m_objects.push_back(object);
+    m_bodies.push_back(object->getBody());
+    m_positions.push_back(object->worldPosition());
+    size_t index = m_objects.size() - 1;
+    if (!isStatic) {
+        // make room at the end of the dynamic range by moving the first static entity back
+        if (index != m_dynamicCount) {
+            move(m_dynamicCount, index);
+            m_objects[m_dynamicCount] = object;
+            m_bodies[m_dynamicCount] = object->getBody();
+            m_positions[m_dynamicCount] = object->worldPosition();
+            index = m_dynamicCount;
+        }
+        ++m_dynamicCount;
+    }
+    m_indices[object] = index;
+}
+
+void EntityStore::remove(PhysicalRenderable* object) {
+    auto it = m_indices.find(object);
+    if (it == m_indices.end()) {
+        return;
+    }
+    size_t index = it->second;
+    m_indices.erase(it);
+
+    if (index < m_dynamicCount) {
+        // close the gap with the last dynamic entity and that one's gap with the last static one
+        --m_dynamicCount;
+        if (index != m_dynamicCount) {
+            move(m_dynamicCount, index);
+        }
+        index = m_dynamicCount;
+    }
+    size_t last = m_objects.size() - 1;
+    if (index != last) {
+        move(last, index);
+    }
+    popBack();
+}
+
+void EntityStore::clear() {
+    m_objects.clear();
+    m_bodies.clear();
+    m_positions.clear();
+    m_indices.clear();
+    m_dynamicCount = 0;
+}
+
+void EntityStore::updateBodies() {
+    for (size_t i = 0; i < m_objects.size(); ++i) {
+        m_bodies[i] = m_objects[i]->getBody();
+    }
+}
+
+void EntityStore::move(size_t from, size_t to) {
+    m_objects[to] = m_objects[from];
+    m_bodies[to] = m_bodies[from];
+    m_positions[to] = m_positions[from];
+    m_indices[m_objects[to]] = to;
+}
+
+void EntityStore::popBack() {
+    m_objects.pop_back();
+    m_bodies.pop_back();
+    m_positions.pop_back();
+}
+
+void EntityStore::syncTransforms() {
+    for (size_t i = 0; i < m_dynamicCount; ++i) {
+        m_positions[i] = m_bodies[i]->GetPosition();
+    }
+    for (size_t i = 0; i < m_dynamicCount; ++i) {
+        m_objects[i]->syncTransform(m_positions[i]);
+    }
+}
+
+}  // namespace engine
+}  // namespace ctb
@@ -0,0 +1,92 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT License; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_CORE_ENTITYSTORE_HPP
+#define ENGINE_CORE_ENTITYSTORE_HPP
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <Box2D/Box2D.h>
+
+namespace ctb {
+namespace engine {
+
+class PhysicalRenderable;
+
+/**
+ * @brief The physical objects of a level, stored as parallel arrays.
+ *
+ * Dynamic entities are kept at the front of the arrays and static ones (e.g. doors) behind
+ * them, so the per tick sync only loops over the dynamic range and never touches a static
+ * entity. Adding, removing and membership tests are O(1); removing swaps the last entity of
+ * the range into the gap, so the order of the entities is not stable.
+ */
+class EntityStore {
+   public:
+    /**
+     * @brief Adds the object with its current body. If it is already stored, only the body is
+     *        updated.
+     *
+     * @param object    the object, it has to be in the level's world already
+     * @param isStatic  static objects are never synced
+     */
+    void add(PhysicalRenderable* object, bool isStatic = false);
+
+    /// Removes the object if it is stored, this has to happen before its body is destroyed
+    void remove(PhysicalRenderable* object);
+
+    /// Returns if the object is stored
+    bool contains(const PhysicalRenderable* object) const {
+        return m_indices.find(object) != m_indices.end();
+    }
+
+    /// Removes all objects
+    void clear();
+
+    /// Returns the number of stored objects
+    size_t size() const { return m_objects.size(); }
+
+    /// Returns the number of dynamic objects, they have the indices [0, dynamicCount())
+    size_t dynamicCount() const { return m_dynamicCount; }
+
+    /// Returns the object at index
+    PhysicalRenderable* object(size_t index) const { return m_objects[index]; }
+
+    /// Returns the world position of the object at index as of the last sync
+    const b2Vec2& position(size_t index) const { return m_positions[index]; }
+
+    /**
+     * @brief Copies the positions of all dynamic bodies in one pass and moves the objects to
+     *        them. Static objects are skipped.
+     */
+    void syncTransforms();
+
+    /// Takes the current bodies of all objects, e.g. after the world was rebuilt
+    void updateBodies();
+
+   private:
+    /// Moves the entity from index "from" to index "to", overwriting the entity there
+    void move(size_t from, size_t to);
+
+    /// Removes the last entity of the arrays
+    void popBack();
+
+    size_t m_dynamicCount{0};
+
+    std::vector<PhysicalRenderable*> m_objects;
+    std::vector<b2Body*> m_bodies;
+    std::vector<b2Vec2> m_positions;
+
+    /// index of every stored object
+    std::unordered_map<const PhysicalRenderable*, size_t> m_indices;
+};
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_CORE_ENTITYSTORE_HPP
@@ -5,24 +5,18 @@
 // project for details.
 
 #include "engine/core/GC.hpp"
+#include "engine/EngineContext.hpp"
 #include "engine/Object.hpp"
 
 namespace ctb {
 namespace engine {
 
-std::stack<Object*> GC::GC_stack;
-
 void GC::execute() {
-    // Cleanup: delete all objects in the GC:
-    while (!GC_stack.empty()) {
-        Object* item = GC_stack.top();
-        GC_stack.pop();
-        delete item;
-    }
+    EngineContext::current().m_garbage.flush();
 }
 
 void GC::add(Object* item) {
-    GC_stack.push(item);
+    EngineContext::current().m_garbage.push(item);
 }
 
 }  // namespace engine
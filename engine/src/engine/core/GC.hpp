@@ -7,25 +7,21 @@
 #ifndef ENGINE_CORE_GC_HPP
 #define ENGINE_CORE_GC_HPP
 
-#include <stack>
-
 namespace ctb {
 namespace engine {
 
 class Object;
 
+/// Deferred destruction of menus and inputs at the end of a frame. Bots, weapons and
+/// projectiles have typed queues of their own, which are flushed after the physics step.
 class GC {
    public:
     /// "Internal garbage collector"
     /// Add any pointer and the object will be deleted in the next
-    /// run of the main loop
+    /// run of the main loop of the current EngineContext
     static void add(Object* item);
 
     static void execute();
-
-   private:
-    /// The stack for the GC
-    static std::stack<Object*> GC_stack;
 };
 
 }  // namespace engine
@@ -9,25 +9,28 @@
 #include <iterator>
 #include <map>
 #include <numeric>
-#include <random>
 #include <stdexcept>
 #include <vector>
 
 #include <Box2D/Box2D.h>
 #include <SDL.h>
 #include <boost/foreach.hpp>
-#include <boost/range/join.hpp>
 #include <gsl/gsl>
 #include <parser/PlayerConfig.hpp>
 
 #include "engine/Window.hpp"
 #include "engine/audio/SoundManager.hpp"
 #include "engine/core/Game.hpp"
+#include "engine/core/LevelCache.hpp"
+#include "engine/core/Snapshot.hpp"
 #include "engine/input/Input.hpp"
 #include "engine/menu/EndMenu.hpp"
+#include "engine/replay/InputRecorder.hpp"
 #include "engine/scene/Door.hpp"
 #include "engine/scene/Fist.hpp"
 #include "engine/scene/Gun.hpp"
+#include "engine/util/Checksum.hpp"
+#include "engine/util/Clock.hpp"
 #include "engine/util/Random.hpp"
 #include "engine/util/Vector2d.hpp"
 
@@ -37,13 +40,18 @@ using ctb::parser::LevelType;
 namespace ctb {
 namespace engine {
 
-Game::Game(parser::GameConfig* config)
+Game::Game(parser::GameConfig* config, LevelCache* levels, uint32_t seed)
     : m_config(config),
-      m_levelOrder(5),
+      m_levelOrder(LEVELCOUNT, nullptr),
+      m_levelConfigs(LEVELCOUNT),
+      m_levelCache(levels),
       m_state(GameState::Stopped),
       m_currentLevel(2),
-      m_statusbar(nullptr) {
-    m_lastTicks = SDL_GetTicks();
+      m_statusbar(nullptr),
+      m_seed(seed),
+      m_random(seed, Random::GAMEPLAY_STREAM),
+      m_cosmeticRandom(seed, Random::COSMETIC_STREAM) {
+    m_lastTicks = Clock::ticks();
     std::multimap<LevelType, LevelConfig*> lvls = config->getLevels();
     std::multimap<LevelType, LevelConfig*>::iterator st, end;
 
@@ -53,16 +61,10 @@ Game::Game(parser::GameConfig* config)
         throw std::runtime_error("No end Level!");
     }
 
-    // Create b2worlds
-    for (int i = 0; i < LEVELCOUNT; ++i) {
-        m_levelWorlds.push_back(new LevelWorld(b2Vec2(0, /*1000*/ 15)));
-    }
-
     std::tie(st, end) = lvls.equal_range(LevelType::END);
-    std::advance(st, Random::getInt(0, cnt - 1));  // advance to a random end level
-    m_levelOrder[0] = new Level(config, (*st).second, m_levelWorlds.at(0));
-    m_levelOrder[LEVELCOUNT - 1] =
-        new Level(config, new LevelConfig(*(*st).second), m_levelWorlds.at(LEVELCOUNT - 1), true);
+    std::advance(st, m_random.getInt(0, cnt - 1));  // advance to a random end level
+    m_levelConfigs[0] = std::make_pair((*st).second, false);
+    m_levelConfigs[LEVELCOUNT - 1] = std::make_pair((*st).second, true);
 
     // get center level
     cnt = static_cast<int>(lvls.count(LevelType::CENTER));
@@ -70,9 +72,8 @@ Game::Game(parser::GameConfig* config)
         throw std::runtime_error("No center Level!");
     }
     std::tie(st, end) = lvls.equal_range(LevelType::CENTER);
-    std::advance(st, Random::getInt(0, cnt - 1));  // advance to a random center level
-    m_levelOrder[LEVELCOUNT / 2] =
-        new Level(config, (*st).second, m_levelWorlds.at(LEVELCOUNT / 2));
+    std::advance(st, m_random.getInt(0, cnt - 1));  // advance to a random center level
+    m_levelConfigs[LEVELCOUNT / 2] = std::make_pair((*st).second, false);
 
     // get levels inbetween
     cnt = static_cast<int>(lvls.count(LevelType::DEFAULT));
@@ -84,24 +85,47 @@ Game::Game(parser::GameConfig* config)
     // to have unique levels, shuffle a vector with all possible numbers and pick the first x
     std::vector<int> v(static_cast<unsigned>(defCnt));
     std::iota(v.begin(), v.end(), 0);
-    std::shuffle(v.begin(), v.end(), std::mt19937(std::random_device()()));
+    // Fisher-Yates with the seeded generator, std::shuffle differs between standard libraries
+    for (size_t i = v.size(); i > 1; --i) {
+        std::swap(v[i - 1], v[static_cast<size_t>(m_random.getInt(0, static_cast<int>(i) - 1))]);
+    }
     for (size_t i = 0; i < static_cast<size_t>(defCnt); i++) {
         std::tie(st, end) = lvls.equal_range(LevelType::DEFAULT);
         std::advance(st,
                      v.at(i));  // get the level corresponding to the current unique random number
-        m_levelOrder[i + 1] = new Level(config, (*st).second, m_levelWorlds.at(i + 1));
-        m_levelOrder[LEVELCOUNT - i - 2] = new Level(config, new LevelConfig(*(*st).second),
-                                                     m_levelWorlds.at(LEVELCOUNT - i - 2), true);
+        m_levelConfigs[i + 1] = std::make_pair((*st).second, false);
+        m_levelConfigs[LEVELCOUNT - i - 2] = std::make_pair((*st).second, true);
     }
 
+    // only the center level is needed for the start, the others are built when they are entered
+    getLevel(static_cast<int>(m_currentLevel));
+    prefetchNeighbours();
+
     // play Soundtrack
-    if (Random::getBool()) {
+    if (m_cosmeticRandom.getBool()) {
         SoundManager::getInstance().playMusicRTL();
     } else {
         SoundManager::getInstance().playMusicLTR();
     }
 }
 
+Level* Game::getLevel(int index) {
+    size_t i = static_cast<size_t>(index);
+    if (m_levelOrder.at(i) == nullptr) {
+        m_levelOrder[i] = m_levelCache->acquire(m_levelConfigs[i].first, m_levelConfigs[i].second);
+    }
+    return m_levelOrder[i];
+}
+
+void Game::prefetchNeighbours() {
+    // the index below the first level wraps around and is skipped like the one after the last
+    for (uint32_t i : {m_currentLevel - 1, m_currentLevel + 1}) {
+        if (i < m_levelOrder.size() && m_levelOrder[i] == nullptr) {
+            m_levelCache->prefetch(m_levelConfigs[i].first, m_levelConfigs[i].second);
+        }
+    }
+}
+
 void Game::render() {
     m_levelOrder[m_currentLevel]->render();
     if (m_statusbar && m_state == GameState::Running) {
@@ -116,54 +140,206 @@ void Game::update() {
 
     // check for player respawns
     auto& cam = m_levelOrder[m_currentLevel]->getCamera();
-    for (Player* a : boost::join(m_players_L2R, m_players_R2L)) {
+    for (Player* a : m_players) {
         if (a->alive() && cam.checkBounds(a)) {
             a->addDamage(5);  // Nice effect of counting the damage down (it's fast ;))
         }
     }
 
     // iterate through respawnQueue, decrement counters and respawn players if necessary
-    Uint32 ticks = SDL_GetTicks();
+    Uint32 ticks = Clock::ticks();
     std::vector<Player*> del;  // temp vector because iterator gets invalidated on delete ._.
-    for (auto& pair : m_respawnQueue) {
-        Player* a = pair.first;
-        auto& val = pair.second;
+    for (Respawn& entry : m_respawnQueue) {
+        Player* a = entry.player;
         a->setPosition(Vector2dT(-100, 10000));  // just render far, far away
         a->reset();
 
-        if (a->hasFlag() && val.second) {  // if he had flag and died, set flag free
+        if (a->hasFlag() && entry.died) {  // if he had flag and died, set flag free
             a->alterScore(PlayerScoreFrom::SCORE_RESPAWN);
             a->destroyJoint();
             a->setHasFlag(false);
             m_levelOrder[m_currentLevel]->getFlag()->setInUse(false);
         }
 
-        val.first -= static_cast<int32_t>(ticks - m_lastTicks);
-        if (val.first < 0) {
+        entry.timeout -= static_cast<int32_t>(ticks - m_lastTicks);
+        if (entry.timeout < 0) {
             del.push_back(a);
         }
     }
     for (auto& d : del) {
+        m_respawnQueue.erase(
+            std::find_if(m_respawnQueue.begin(), m_respawnQueue.end(),
+                         [d](const Respawn& entry) { return entry.player == d; }));
         respawnPlayer(d);
-        m_respawnQueue.erase(d);
     }
 
-    // increase score of team with flag
-    for (Player* player : m_players_R2L) {
+    // increase score of team with flag, there is only one flag per level
+    for (Player* player : m_players) {
         if (player->hasFlag()) {
-            flagScore(Team::R2L);
+            flagScore(player->getTeam());
             break;
         }
     }
 
-    for (Player* player : m_players_L2R) {
-        if (player->hasFlag()) {
-            flagScore(Team::L2R);
-            break;
+    m_lastTicks = ticks;
+
+    if (m_state == GameState::Running) {
+        ++m_tick;
+        if (m_checksumTrace) {
+            *m_checksumTrace << m_tick << ' ' << std::hex << checksum() << std::dec << '\n';
         }
     }
+}
 
-    m_lastTicks = ticks;
+uint64_t Game::checksum() {
+    Checksum sum;
+    sum.add(static_cast<uint64_t>(m_currentLevel));
+
+    auto addBody = [&sum](PhysicalRenderable* object) {
+        b2Body* body = object->getBody();
+        if (!body) {
+            return;
+        }
+        sum.add(body->GetPosition().x);
+        sum.add(body->GetPosition().y);
+        sum.add(body->GetLinearVelocity().x);
+        sum.add(body->GetLinearVelocity().y);
+    };
+
+    // L2R players first, each team in the order the players were registered in
+    for (Player* player : m_players) {
+        addBody(player);
+        sum.add(static_cast<uint64_t>(player->getHealth()));
+        sum.add(player->getScore());
+    }
+
+    Level* level = m_levelOrder[m_currentLevel];
+    for (Bot* bot : level->getBots()) {
+        addBody(bot);
+    }
+    addBody(level->getFlag());
+    return sum.value();
+}
+
+void Game::saveSnapshot(std::vector<uint8_t>& buffer) {
+    buffer.clear();
+    uint32_t now = Clock::ticks();
+    SnapshotWriter out(buffer, now, m_players);
+
+    out.writeU32(SNAPSHOT_MAGIC);
+    out.writeU16(SNAPSHOT_VERSION);
+    out.writeU32(m_seed);
+    out.writeU32(static_cast<uint32_t>(m_players.size()));
+
+    out.writeU32(now);
+    out.writeU8(static_cast<uint8_t>(m_state));
+    out.writeBool(m_finished);
+    out.writeU8(static_cast<uint8_t>(m_winner));
+    out.writeU32(m_currentLevel);
+    out.writeU64(m_tick);
+    out.writeU64(m_random.getState());
+    out.writeU64(m_random.getIncrement());
+    out.writeU64(m_cosmeticRandom.getState());
+    out.writeU64(m_cosmeticRandom.getIncrement());
+    out.writeTime(m_lastTicks);
+
+    // a level that was never built is in its initial state
+    for (const Level* level : m_levelOrder) {
+        out.writeBool(level != nullptr);
+        if (level != nullptr) {
+            level->saveState(out);
+        }
+    }
+    for (const Player* player : m_players) {
+        player->saveState(out);
+    }
+
+    out.writeU32(static_cast<uint32_t>(m_respawnQueue.size()));
+    for (const Respawn& entry : m_respawnQueue) {
+        out.writePlayer(entry.player);
+        out.writeI32(entry.timeout);
+        out.writeBool(entry.died);
+    }
+
+    // the contacts aren't part of the snapshot, the uninterrupted game continues without them
+    // as well
+    getCurrentLevel()->rebuildWorld(out.getBodies());
+}
+
+void Game::restoreSnapshot(const std::vector<uint8_t>& buffer) {
+    SnapshotReader in(buffer, m_players);
+
+    if (in.readU32() != SNAPSHOT_MAGIC || in.readU16() != SNAPSHOT_VERSION) {
+        throw std::runtime_error("Not a snapshot of this version");
+    }
+    if (in.readU32() != m_seed || in.readU32() != m_players.size()) {
+        throw std::runtime_error("Snapshot of a different game");
+    }
+    Expects(!getCurrentLevel()->getWorld()->getWorld()->IsLocked());
+
+    Clock::restore(in.readU32());
+    in.setNow(Clock::ticks());
+
+    m_state = static_cast<GameState>(in.readU8());
+    m_finished = in.readBool();
+    m_winner = static_cast<Team>(in.readU8());
+
+    // destroy the flag joint before the bodies are moved
+    getCurrentLevel()->getFlag()->destroyJoint();
+    uint32_t currentLevel = in.readU32();
+    if (currentLevel >= m_levelOrder.size()) {
+        throw std::runtime_error("Snapshot refers to an unknown level");
+    }
+    if (currentLevel != m_currentLevel) {
+        m_currentLevel = currentLevel;
+        Level* level = getLevel(static_cast<int>(m_currentLevel));
+        for (Player* player : m_players) {
+            level->addPlayer(player, m_config->getPlayerLayer());
+        }
+    }
+
+    m_tick = in.readU64();
+    uint64_t state = in.readU64();
+    m_random.setState(state, in.readU64());
+    state = in.readU64();
+    m_cosmeticRandom.setState(state, in.readU64());
+    m_lastTicks = in.readTime();
+
+    for (size_t i = 0; i < m_levelOrder.size(); ++i) {
+        if (in.readBool()) {
+            getLevel(static_cast<int>(i))->restoreState(in);
+        } else if (m_levelOrder[i] != nullptr) {
+            // built after the snapshot was taken
+            m_levelOrder[i]->clearState();
+        }
+    }
+    for (Player* player : m_players) {
+        player->restoreState(in);
+    }
+
+    m_respawnQueue.clear();
+    size_t respawns = in.readU32();
+    for (size_t i = 0; i < respawns; ++i) {
+        Respawn entry;
+        entry.player = in.readPlayer();
+        entry.timeout = in.readI32();
+        entry.died = in.readBool();
+        m_respawnQueue.push_back(entry);
+    }
+
+    if (!in.atEnd()) {
+        throw std::runtime_error("Snapshot has trailing data");
+    }
+
+    // the flag joint is not stored, it connects the flag to its carrier in the current level
+    Level* level = getCurrentLevel();
+    for (Player* player : m_players) {
+        if (player->hasFlag() && level->getFlag()->isInUse()) {
+            level->getFlag()->createJoint(player);
+            break;
+        }
+    }
+    level->rebuildWorld(in.getBodies());
 }
 
 void Game::flagScore(Team hasFlag) {
@@ -198,7 +374,8 @@ void Game::nextLevel(Team t) {
 void Game::startLevel(uint32_t level, Team* t) {
     m_levelOrder[m_currentLevel]->getFlag()->setInUse(false);
     m_currentLevel = level;
-    Level* lvl = m_levelOrder[m_currentLevel];
+    // waits for the prefetch of the level if it isn't done yet
+    Level* lvl = getLevel(static_cast<int>(m_currentLevel));
     // make temp map with all players and corresponding teams
     auto all_players = std::map<Team, std::vector<Player*>>{{Team::L2R, m_players_L2R},
                                                             {Team::R2L, m_players_R2L}};
@@ -259,6 +436,7 @@ void Game::startLevel(uint32_t level, Team* t) {
         lvl->getFlag()->createJoint(aWithFlag);
     }
     lvl->getCamera().setFocus(lvl->getFlag());  // reset focus to flag
+    prefetchNeighbours();
 }
 
 void Game::addPlayerToCurrentLevel(Player* player) {
@@ -271,8 +449,10 @@ void Game::setToRespawn(Player* player) {
 }
 
 void Game::setToRespawn(Player* player, const int timeout, const bool died) {
-    if (m_respawnQueue.count(player) == 0) {
-        m_respawnQueue.insert(std::make_pair(player, std::make_pair(timeout, died)));
+    auto it = std::find_if(m_respawnQueue.begin(), m_respawnQueue.end(),
+                           [player](const Respawn& entry) { return entry.player == player; });
+    if (it == m_respawnQueue.end()) {
+        m_respawnQueue.push_back({player, timeout, died});
     }
 }
 
@@ -289,7 +469,7 @@ void Game::respawnPlayer(Player* player) {
         throw std::runtime_error("Unsufficent spawn points!");
     }
 
-    Vector2dT worldPos = lvl->getConfig()->toWorld(Vector2dT(pos[0], pos[1]));
+    Vector2dT worldPos = lvl->getView().toWorld(Vector2dT(pos[0], pos[1]));
     player->resetOnGround();
     player->reset();
     player->setPosition(Vector2dT(worldPos.x, worldPos.y - m_config->getPlayerOffset() - 2));
@@ -311,23 +491,12 @@ std::vector<int> Game::getNextPlayerSpawn(Level* level, Team team) {
     }
 
     int step = (team == Team::L2R) ? 1 : -1;
-    for (; x != cam.x() / config->getTileWidth() && x >= cam.minX() / config->getTileWidth() &&
-           x < cam.maxX() / config->getTileWidth();
-         x += step) {
-        auto& ys = config->getPlayerSpawns().at(static_cast<size_t>(x));
-        if (!ys.empty()) {
-            int y_out = 0;
-            int min = 0;
-            for (size_t i = 0; i < ys.size(); i++) {
-                int newMin = abs(static_cast<int>(
-                    ys.at(i) - static_cast<uint32_t>(cam.y() / config->getTileHeight())));
-                if (i == 0 || newMin < min) {
-                    min = newMin;
-                    y_out = static_cast<int>(ys.at(i));
-                }
-            }
-            return {x, y_out};
-        }
+    int xOut = 0;
+    int yOut = 0;
+    if (level->getSpatialIndex().nextSpawn(
+            x, step, cam.x() / config->getTileWidth(), cam.minX() / config->getTileWidth(),
+            cam.maxX() / config->getTileWidth(), cam.y() / config->getTileHeight(), xOut, yOut)) {
+        return {xOut, yOut};
     }
     return std::vector<int>();
 }
@@ -344,11 +513,18 @@ void Game::startGame(std::vector<Player*> players) {
             }
             player->setGame(this);
         }
+        m_players = m_players_L2R;
+        m_players.insert(m_players.end(), m_players_R2L.begin(), m_players_R2L.end());
 
         // Init statusbar
         m_statusbar = new Statusbar();
         startLevel(m_currentLevel);
         m_state = GameState::Running;
+        // the respawn timers start with the game, the time in the start menu doesn't count
+        m_lastTicks = Clock::ticks();
+        if (m_inputRecorder != nullptr) {
+            m_inputRecorder->begin(*this);
+        }
     }
 }
 
@@ -367,9 +543,13 @@ void Game::endGame(Team teamWon) {
         a->alterScore(PlayerScoreFrom::SCORE_WON);
     }
 
+    m_finished = true;
+    m_winner = teamWon;
     pause();
-    EndMenu* menu = new EndMenu(teamWon);
-    Window::getWindow().addMenu(menu);
+    if (!Window::isHeadless()) {
+        EndMenu* menu = new EndMenu(teamWon);
+        Window::getWindow().addMenu(menu);
+    }
 }
 
 void Game::pause() {
@@ -385,24 +565,24 @@ void Game::resume() {
 }
 
 Game::~Game() {
+    if (m_inputRecorder != nullptr) {
+        m_inputRecorder->end(*this);
+    }
+
+    // hand the levels back first, this removes the player bodies from their worlds
     for (Level* lvl : m_levelOrder) {
-        delete lvl;
-        lvl = nullptr;
+        if (lvl != nullptr) {
+            m_levelCache->release(lvl);
+        }
     }
 
     delete m_statusbar;
     m_statusbar = nullptr;
 
-    for (Player* a : boost::join(m_players_L2R, m_players_R2L)) {
+    for (Player* a : m_players) {
         delete a;
         a = nullptr;
     }
-
-    // Destroy b2worlds
-    for (auto* world : m_levelWorlds) {
-        delete world;
-        world = nullptr;
-    }
 }
 
 }  // namespace engine
@@ -7,13 +7,16 @@
 #ifndef ENGINE_CORE_GAME_HPP
 #define ENGINE_CORE_GAME_HPP
 
+#include <cstdint>
 #include <map>
+#include <ostream>
 #include <utility>
 #include <vector>
 
 #include <parser/GameConfig.hpp>
 #include <parser/LevelConfig.hpp>
 
+#include "engine/core/BotSpawning.hpp"
 #include "engine/core/Level.hpp"
 #include "engine/graphics/SDLRenderable.hpp"
 #include "engine/gui/Statusbar.hpp"
@@ -21,11 +24,14 @@
 #include "engine/physics/LevelWorld.hpp"
 #include "engine/scene/Flag.hpp"
 #include "engine/scene/Player.hpp"
+#include "engine/util/Random.hpp"
 
 namespace ctb {
 namespace engine {
 
+class InputRecorder;
 class Level;
+class LevelCache;
 
 enum class Team { R2L, L2R };
 
@@ -39,12 +45,13 @@ class Game : public SDLRenderable {
     /**
      * @brief constructor
      *
-     * @param mw     a pointer to the window
      * @param config the config this game is based on
+     * @param levels the cache the levels of this game are taken from and handed back to
+     * @param seed   the seed of all random decisions in this game
      *
      * @throws runtime_error if not enough levels are present in the config
      */
-    explicit Game(parser::GameConfig* config);
+    Game(parser::GameConfig* config, LevelCache* levels, uint32_t seed);
 
     /// Renders this game
     void render() override;
@@ -59,12 +66,18 @@ class Game : public SDLRenderable {
     void startGame(std::vector<Player*> players);
 
     /**
-     * @brief ends the game and displays the end menu
+     * @brief ends the game and displays the end menu (unless running headless)
      *
      * @param teamWon the team that won
      */
     void endGame(Team teamWon);
 
+    /// Returns if a team has won this game
+    bool isFinished() const { return m_finished; }
+
+    /// Returns the team that won this game, only valid if isFinished()
+    Team getWinner() const { return m_winner; }
+
     /// Pauses the game
     void pause();
 
@@ -80,6 +93,19 @@ class Game : public SDLRenderable {
     /// return a pointer to the current level
     Level* getCurrentLevel() const { return m_levelOrder[m_currentLevel]; }
 
+    /// returns the level with the given index in the order of this game, building it if needed
+    Level* getLevel(int index);
+
+    /// returns the config of the level with the given index without building the level
+    const parser::LevelConfig* getLevelConfig(int index) const {
+        return m_levelConfigs.at(static_cast<size_t>(index)).first;
+    }
+
+    /// returns if the level with the given index is flipped
+    bool isLevelFlipped(int index) const {
+        return m_levelConfigs.at(static_cast<size_t>(index)).second;
+    }
+
     /**
      * @brief switch to the next or previous level
      *
@@ -124,6 +150,71 @@ class Game : public SDLRenderable {
     /// Returns a pointer to the config of this game.
     parser::GameConfig* getConfig() const { return m_config; }
 
+    /// Returns the seed this game was started with
+    uint32_t getSeed() const { return m_seed; }
+
+    /// Returns the generator of all random decisions that influence the game state
+    Random& getRandom() { return m_random; }
+
+    /// Returns the generator for random decisions that don't influence the game state
+    Random& getCosmeticRandom() { return m_cosmeticRandom; }
+
+    /// Returns the number of simulated ticks
+    uint64_t getTick() const { return m_tick; }
+
+    /**
+     * @brief Hashes the positions and velocities of all players, bots and the flag as well as
+     *        the health and score of all players. Two runs with the same seed and inputs
+     *        produce the same checksums.
+     */
+    uint64_t checksum();
+
+    /**
+     * @brief Writes "tick checksum" of every simulated tick to out
+     *
+     * @param out the stream to write to or nullptr to disable the trace
+     */
+    void setChecksumTrace(std::ostream* out) { m_checksumTrace = out; }
+
+    /**
+     * @brief Records the inputs of the players from the start of the game until it is deleted
+     *
+     * @param recorder the recorder or nullptr to disable the recording
+     */
+    void setInputRecorder(InputRecorder* recorder) { m_inputRecorder = recorder; }
+
+    /// Sets how many bots the current level spawns
+    void setBotSpawning(const BotSpawning& spawning) { m_botSpawning = spawning; }
+
+    /// Returns how many bots the current level spawns
+    const BotSpawning& getBotSpawning() const { return m_botSpawning; }
+
+    /**
+     * @brief Writes the dynamic state of the game into buffer: the clock, the random
+     *        generators, the respawn queue, all players and the bots, weapons, projectiles
+     *        and flags of all levels. The static level geometry is not part of a snapshot.
+     *
+     * Neither are the Box2D contacts, so the world of the current level is rebuilt without them,
+     * see Level::rebuildWorld(). This way the game continues exactly like after restoring the
+     * snapshot.
+     *
+     * @param buffer the buffer to fill, its previous content is discarded
+     */
+    void saveSnapshot(std::vector<uint8_t>& buffer);
+
+    /**
+     * @brief Restores a state written by saveSnapshot of this game. The clock is only restored
+     *        in fixed step mode, otherwise all timers are restored relative to the current time.
+     *
+     * The world of the current level is rebuilt like after saving the snapshot, so the contacts
+     * are detected again from the restored positions.
+     *
+     * @param buffer the snapshot
+     *
+     * @throws runtime_error if the snapshot wasn't written by this game
+     */
+    void restoreSnapshot(const std::vector<uint8_t>& buffer);
+
     /// Destructor
     ~Game() override;
 
@@ -156,14 +247,23 @@ class Game : public SDLRenderable {
      */
     std::vector<int> getNextPlayerSpawn(Level* level, Team team);
 
+    /// Starts building the levels next to the current one in the background
+    void prefetchNeighbours();
+
     /// The underlying config for this game
     parser::GameConfig* m_config;
 
-    /// An ordered vector of all the levels of this game
+    /// An ordered vector of all the levels of this game, null until a level is built
     std::vector<Level*> m_levelOrder;
 
-    /// An ordered vector of all worlds of this game
-    std::vector<LevelWorld*> m_levelWorlds;
+    /// The config of every level in m_levelOrder and if it is flipped
+    std::vector<std::pair<const parser::LevelConfig*, bool>> m_levelConfigs;
+
+    /// The cache owning the levels of this game
+    LevelCache* m_levelCache;
+
+    /// All players in the order of startGame, L2R players first
+    std::vector<Player*> m_players;
 
     /// Players for the R2L team
     std::vector<Player*> m_players_R2L;
@@ -171,9 +271,17 @@ class Game : public SDLRenderable {
     /// Players for the L2R team
     std::vector<Player*> m_players_L2R;
 
-    /// A Queue for the player respawns, mapping an player pointer to the time until respawn and a
-    /// bool indicating if he died or not
-    std::map<Player*, std::pair<int, bool>> m_respawnQueue;
+    /// An entry of the respawn queue
+    struct Respawn {
+        Player* player;
+        /// time until the respawn in ms
+        int timeout;
+        /// if the player died and has to lose the flag
+        bool died;
+    };
+
+    /// A Queue for the player respawns in the order they were added
+    std::vector<Respawn> m_respawnQueue;
 
     /// Save the last update time for the respawn queue
     Uint32 m_lastTicks;
@@ -181,6 +289,12 @@ class Game : public SDLRenderable {
     /// The current game state
     GameState m_state;
 
+    /// If a team has won
+    bool m_finished{false};
+
+    /// The team that won
+    Team m_winner{Team::L2R};
+
     /// Adds the player to the current level and calls setToRespawn
     void addPlayerToCurrentLevel(Player* player);
 
@@ -189,6 +303,27 @@ class Game : public SDLRenderable {
 
     /// A pointer to this game's statusbar
     Statusbar* m_statusbar;
+
+    /// The seed of this game
+    uint32_t m_seed;
+
+    /// Gameplay stream of the seed
+    Random m_random;
+
+    /// Cosmetic stream of the seed
+    Random m_cosmeticRandom;
+
+    /// Number of simulated ticks
+    uint64_t m_tick{0};
+
+    /// Receives the checksum of every tick, may be null
+    std::ostream* m_checksumTrace{nullptr};
+
+    /// Records the inputs of the players, may be null
+    InputRecorder* m_inputRecorder{nullptr};
+
+    /// How many bots the current level spawns
+    BotSpawning m_botSpawning;
 };
 
 }  // namespace engine
@@ -4,26 +4,30 @@
 // This file is licensed under the MIT License; see LICENSE file in the root of this
 // project for details.
 
+#include <algorithm>
 #include <iostream>
+#include <stdexcept>
 
 #include <SDL_image.h>
-#include <parser/BotConfig.hpp>
+#include <parser/DynamicTilestore.hpp>
 #include <parser/GameConfig.hpp>
 #include <parser/GameParser.hpp>
 #include <parser/LevelConfig.hpp>
 #include <parser/LevelParser.hpp>
 
+#include "engine/Engine.hpp"
+#include "engine/EngineContext.hpp"
 #include "engine/Window.hpp"
 #include "engine/core/Game.hpp"
 #include "engine/core/Level.hpp"
+#include "engine/core/SharedTextures.hpp"
+#include "engine/core/Snapshot.hpp"
 #include "engine/graphics/Background.hpp"
 #include "engine/physics/ActingKinematics.hpp"
 #include "engine/scene/Bot.hpp"
 #include "engine/scene/Door.hpp"
 #include "engine/scene/Gun.hpp"
 #include "engine/scene/Player.hpp"
-#include "engine/scene/Ufo.hpp"
-#include "engine/scene/Zombie.hpp"
 #include "engine/util/Random.hpp"
 #include "engine/util/Vector2d.hpp"
 
@@ -33,73 +37,102 @@ namespace engine {
 namespace {
 using parser::GameConfig;
 using parser::LevelConfig;
+
+/// Chances per tick of spawning a bot and a weapon, in 1/10000
+constexpr int kBotSpawnChance = 25;
+constexpr int kWeaponSpawnChance = 4;
 }  // namespace
 
-Level::Level(GameConfig* gconf, LevelConfig* lconf, WorldPtrT world, bool flipped)
-    : m_flipped(flipped),
+Level::Level(GameConfig* gconf,
+             const LevelView& view,
+             const std::vector<const DynamicTilestore*>& tiles,
+             SharedTextures& textures,
+             WorldPtrT world)
+    : m_view(view),
       m_world(world),
       m_camera(0,
                0,
-               Window::getWindow().w(),
-               Window::getWindow().h(),
-               lconf->getPixelWidth(),
-               lconf->getPixelHeight()),
+               EngineContext::current().getWidth(),
+               EngineContext::current().getHeight(),
+               view.getConfig().getPixelWidth(),
+               view.getConfig().getPixelHeight()),
       m_layers(&m_camera),
-      m_lconf(lconf),
-      m_gconf(gconf) {
-    for (auto layer : lconf->getTilesets()) {
-        addLevelTiles(new PhysicalTileSet(layer, lconf, flipped), layer);
-    }
-    for (auto background : lconf->getBackgrounds()) {
-        addRenderable(new Background(background, lconf->getWidth() * lconf->getTileWidth(),
-                                     lconf->getHeight() * lconf->getTileHeight()),
+      m_gconf(gconf),
+      m_spatialIndex(PhysicalObject::convertToWorldCoordinate(view.getConfig().getPixelWidth()),
+                     PhysicalObject::convertToWorldCoordinate(view.getConfig().getPixelHeight())) {
+    const LevelConfig& lconf = view.getConfig();
+    Expects(tiles.size() == lconf.getTilesets().size());
+
+    SDL_Texture* tilesheet = textures.get(lconf.getTilesheetFilename());
+    std::vector<const DynamicTilestore*> botLayers;
+    for (size_t i = 0; i < tiles.size(); ++i) {
+        const parser::TilesetConfig& layer = lconf.getTilesets()[i];
+        addLevelTiles(new PhysicalTileSet(tiles[i], view, tilesheet), layer);
+        if (layer.canCollideBots()) {
+            botLayers.push_back(tiles[i]);
+        }
+    }
+    const auto& backgrounds = lconf.getBackgrounds();
+    for (auto& background : backgrounds) {
+        // the deeper backgrounds are kept longest when the quality is lowered
+        auto depth = static_cast<uint32_t>(std::count_if(
+            backgrounds.begin(), backgrounds.end(), [&](const parser::BackgroundConfig& other) {
+                return other.getLayer() < background.getLayer();
+            }));
+        addRenderable(new Background(background, textures.get(background.getImageFilename()),
+                                     lconf.getPixelWidth(), lconf.getPixelHeight(), depth),
                       background.getLayer());
     }
 
-    m_world->getWorld()->SetGravity(b2Vec2(0, lconf->getGravitation()));
+    m_world->getWorld()->SetGravity(b2Vec2(0, lconf.getGravitation()));
+    buildNavGraph(botLayers);
+    m_spatialIndex.setSpawns(lconf.getPlayerSpawns(), view.isFlipped());
 
-    // maybe flip level
-    if (flipped) {
-        lconf->flipPoints();
+    // spawns of unknown types stay empty
+    const Prefabs& prefabs = this->prefabs();
+    for (size_t i = 0; i < view.getBotSpawnCount(); ++i) {
+        m_botSpawnPrefabs.push_back(prefabs.findBot(view.getBotSpawnType(i)));
     }
+    for (size_t i = 0; i < view.getWeaponSpawnCount(); ++i) {
+        m_weaponSpawnPrefabs.push_back(prefabs.findWeapon(view.getWeaponSpawnType(i)));
+    }
+    m_gunPrefab = prefabs.findWeapon("gun");
 
     // create flag
-    SDL_Texture* tex = Window::getWindow().loadTexture(gconf->getFlagFilename());
+    SDL_Texture* tex = EngineContext::current().loadTexture(gconf->getFlagFilename());
     int w, h;
     SDL_QueryTexture(tex, nullptr, nullptr, &w, &h);
     m_flag = new Flag(tex, w, h, 1);
     m_layers.addRenderable(m_flag, gconf->getPlayerLayer(), true);
     m_camera.setFocus(m_flag);
-    m_objects.push_back(m_flag);
 
     // TODO(felix): Use pointer
     m_flag->addToThisWorld(*m_world->getWorld());
+    m_entities.add(m_flag);
     respawnFlag();
 
     // create doors
-    tex = Window::getWindow().loadTexture(gconf->getDoorFilename());
+    tex = EngineContext::current().loadTexture(gconf->getDoorFilename());
     SDL_QueryTexture(tex, nullptr, nullptr, &w, &h);
 
     Door* door = new Door(Team::R2L, tex, w, h, 1, gconf->getDoorOffset());
-    Vector2dT pos = lconf->getDoorL();
-    pos = lconf->toWorld(pos);
+    Vector2dT pos = view.toWorld(view.getDoorL());
     door->setPosition(pos);
     m_layers.addRenderable(door, gconf->getPlayerLayer() - 1, true);
-    m_objects.push_back(door);
 
     // TODO(felix): Use pointer
     door->addToThisWorld(*m_world->getWorld());
+    m_entities.add(door, true);
     m_doors.push_back(door);
 
     door = new Door(Team::L2R, tex, w, h, 1, gconf->getDoorOffset());
-    pos = lconf->getDoorR();
-    pos = lconf->toWorld(pos);
+    pos = view.toWorld(view.getDoorR());
     door->setPosition(pos);
     m_layers.addRenderable(door, gconf->getPlayerLayer() - 1, true);
-    m_objects.push_back(door);
 
     // TODO(felix): Use pointer
     door->addToThisWorld(*m_world->getWorld());
+    m_entities.add(door, true);
     m_doors.push_back(door);
 }
 
@@ -109,9 +142,9 @@ void Level::addRenderable(TextureBasedRenderable* renderable, int layer) {
 }
 
 void Level::addPlayer(Player* player, int layer) {
-    if (std::find(m_objects.begin(), m_objects.end(), player) == m_objects.end()) {
+    if (!m_entities.contains(player)) {
         m_layers.addRenderable(player, layer, false);
-        m_objects.push_back(player);
+        m_players.push_back(player);
     }
     ActingKinematics k;
     k.setRestitution(0.05f);
@@ -121,31 +154,70 @@ void Level::addPlayer(Player* player, int layer) {
 
     // TODO(felix): Use pointer
     player->addToWorld(*m_world->getWorld(), k);
+    m_entities.add(player);
+}
+
+void Level::buildNavGraph(const std::vector<const DynamicTilestore*>& layers) {
+    // highest jump of a bot, with some margin as the bot has to get over the edge
+    float32 impulse = ActingKinematics().geJumpImpulse();
+    float32 gravitation = std::max(m_view.getConfig().getGravitation(), 1.0f);
+    int height = PhysicalObject::convertToScreenCoordinate(0.8f * impulse * impulse /
+                                                           (2.0f * gravitation));
+    m_navGraph.build(layers, BOT_CLEARANCE,
+                     height / std::max(1, m_view.getConfig().getTileHeight()), BOT_JUMP_DISTANCE,
+                     m_view.isFlipped());
+}
+
+Random& Level::random() {
+    return EngineContext::current().getEngine().getGame()->getRandom();
+}
+
+const Prefabs& Level::prefabs() {
+    return EngineContext::current().getEngine().getPrefabs();
+}
+
+const BotSpawning& Level::botSpawning() {
+    return EngineContext::current().getEngine().getGame()->getBotSpawning();
 }
 
 void Level::addBot() {
-    std::vector<parser::TypeSpawn>& botSpawn = m_lconf->getBotSpawns();
-    if (m_bots.size() < 5 && !botSpawn.empty()) {
-        int pickPos = Random::getInt(0, static_cast<int>(botSpawn.size()) - 1);
-        Vector2dT pos = m_lconf->toWorld(botSpawn.at(static_cast<size_t>(pickPos)).getPosition());
+    size_t spawns = m_view.getBotSpawnCount();
+    if (m_bots.size() < botSpawning().budget && spawns > 0) {
+        auto pickPos = static_cast<size_t>(random().getInt(0, static_cast<int>(spawns) - 1));
+        Vector2dT pos = m_view.toWorld(m_view.getBotSpawn(pickPos));
 
-        // TODO(felix): Use pointer
-        Bot* bot = Bot::createBot(*m_world->getWorld(),
-                                  botSpawn.at(static_cast<size_t>(pickPos)).getType(), pos, this);
-        if (bot != nullptr) {
-            m_bots.push_back(bot);
-        }
+        spawnBot(m_botSpawnPrefabs[pickPos], pos);
+    }
+}
+
+Bot* Level::spawnBot(PrefabId prefab, Vector2dT pos) {
+    const Prefabs& prefabs = this->prefabs();
+    if (prefab >= prefabs.getBotCount()) {
+        return nullptr;
     }
+    // TODO(felix): Use pointer
+    Bot* bot = prefabs.createBot(prefab, *m_world->getWorld(), pos, this);
+    bot->setHandle(m_bots.insert(bot));
+    m_entities.add(bot);
+    return bot;
 }
 
 void Level::deleteBot(Bot* bot) {
-    auto it = std::find(m_bots.begin(), m_bots.end(), bot);
-    if (it != m_bots.end()) {
-        m_bots.erase(it);
+    // the handle is stale if the bot was removed already, e.g. by two contacts in one step
+    if (!m_bots.erase(bot->getHandle())) {
+        return;
     }
+    m_entities.remove(bot);
+    m_deadBots.push(bot);
 }
 
-void Level::addLevelTiles(PhysicalTileSet* tiles, parser::TilesetConfig& config) {
+void Level::flushDestroyed() {
+    Expects(!m_world->getWorld()->IsLocked());
+    m_deadBots.flush();
+    m_deadWeapons.flush();
+}
+
+void Level::addLevelTiles(PhysicalTileSet* tiles, const parser::TilesetConfig& config) {
     if (tiles) {
         m_tiles = tiles;
         m_layers.addRenderable(tiles, config.getLayer(), true);
@@ -177,65 +249,44 @@ void Level::addLevelTiles(PhysicalTileSet* tiles, parser::TilesetConfig& config)
 }
 
 void Level::addWeapon() {
-    if (!m_lconf->getWeaponSpawns().empty()) {
-        parser::TypeSpawn spawn = m_lconf->getWeaponSpawns().at(static_cast<size_t>(
-            Random::getInt(0, static_cast<int>(m_lconf->getWeaponSpawns().size() - 1))));
-
-        if (spawn.getType() == "gun") {
-            // search for weapons and projectiles
-            auto weaponConfig = m_gconf->getWeapons().at(0);
-            for (auto& config : m_gconf->getWeapons()) {
-                if (config->getName() == "gun") {
-                    weaponConfig = config;
-                }
-            }
-            auto projectileConfig = m_gconf->getProjectiles().at(0);
-            for (auto& config : m_gconf->getProjectiles()) {
-                if (config->getName() == "bullet") {
-                    projectileConfig = config;
-                }
-            }
-
-            // get texture information
-            SDL_Texture* gunTexture = Window::getWindow().loadTexture(weaponConfig->getFilename());
-            SDL_Texture* projectileTexture =
-                Window::getWindow().loadTexture(projectileConfig->getFilename());
-
-            int gunWidth, gunHeight;
-            SDL_QueryTexture(gunTexture, nullptr, nullptr, &gunWidth, &gunHeight);
-            int projectileWidth, projectileHeight;
-            SDL_QueryTexture(projectileTexture, nullptr, nullptr, &projectileWidth,
-                             &projectileHeight);
-            SDL_DestroyTexture(projectileTexture);
-            projectileTexture = nullptr;
-
-            /// spawn gun
-            Gun* gun = new Gun(gunTexture, gunWidth, gunHeight, 1, projectileConfig->getFilename(),
-                               projectileHeight, projectileWidth, 1,
-                               static_cast<int>(weaponConfig->getAttackspeed()),
-                               static_cast<float>(weaponConfig->getRange()),
-                               static_cast<uint32_t>(weaponConfig->getDamage()));
-            gun->setPosition({spawn.getPosition().x * m_lconf->getTileWidth(),
-                              spawn.getPosition().y * m_lconf->getTileHeight()});
+    size_t spawns = m_view.getWeaponSpawnCount();
+    if (spawns > 0) {
+        auto spawn = static_cast<size_t>(random().getInt(0, static_cast<int>(spawns - 1)));
+
+        if (m_weaponSpawnPrefabs[spawn] != Prefabs::NONE) {
+            Gun* gun = prefabs().createWeapon(m_weaponSpawnPrefabs[spawn]);
+            Vector2dT pos = m_view.getWeaponSpawn(spawn);
+            gun->setPosition({pos.x * m_view.getConfig().getTileWidth(),
+                              pos.y * m_view.getConfig().getTileHeight()});
             spawnWeapon(gun);
         }
     }
 }
 
+Gun* Level::createGun() {
+    if (m_gunPrefab == Prefabs::NONE) {
+        return nullptr;
+    }
+    return prefabs().createWeapon(m_gunPrefab);
+}
+
 void Level::spawnWeapon(Fist* weapon) {
     if (weapon) {
-        Kinematics k(0.5f, 0.5f, 0.2f);
-        k.setDensity(0.0f);
-        k.setId(Game::WEAPON_ID);
-        k.setCategory(Level::WEAPON_CAT);
-        k.setMask(Level::PLAYER_CAT | Level::GROUND_CAT);
-
-        weapon->addToWorld(*m_world->getWorld(), k);
-
+        addWeaponToWorld(weapon);
         dropWeapon(weapon, false);
     }
 }
 
+void Level::addWeaponToWorld(Fist* weapon) {
+    Kinematics k(0.5f, 0.5f, 0.2f);
+    k.setDensity(0.0f);
+    k.setId(Game::WEAPON_ID);
+    k.setCategory(Level::WEAPON_CAT);
+    k.setMask(Level::PLAYER_CAT | Level::GROUND_CAT);
+
+    weapon->addToWorld(*m_world->getWorld(), k);
+}
+
 void Level::dropWeapon(Fist* weapon, bool xVelocity) {
     if (weapon) {
         m_weapons.push_back(weapon);
@@ -248,7 +299,8 @@ void Level::removeWeapon(Fist* weapon) {
         std::vector<Fist*>::iterator it = std::find(m_weapons.begin(), m_weapons.end(), weapon);
 
         if (it != m_weapons.end()) {
-            m_weapons.erase(it);
+            *it = m_weapons.back();
+            m_weapons.pop_back();
         }
     }
 }
@@ -257,25 +309,214 @@ void Level::respawnFlag() {
     m_flag->setInUse(false);
     m_flag->reset();
     m_flag->destroyJoint();
-    Vector2dT pos = m_lconf->getFlagSpawn();
-    pos = m_lconf->toWorld(pos);
+    Vector2dT pos = m_view.toWorld(m_view.getFlagSpawn());
     m_flag->setPosition(pos);
 }
 
-void Level::update() {
-    // Run physics
-    for (auto obj : m_objects) {
-        obj->update();
+void Level::reset() {
+    // destroys the flag joint before the bodies it is attached to
+    clearState();
+
+    for (Player* player : m_players) {
+        m_layers.removeRenderable(player);
+        m_entities.remove(player);
+        player->removeFromWorld(*m_world->getWorld());
     }
+    m_players.clear();
+}
 
-    if (Random::getInt(0, 10000) < 25) {
-        addBot();
+void Level::clearState() {
+    flushDestroyed();
+    respawnFlag();
+    m_world->getListener()->reset();
+
+    for (Bot* bot : m_bots.objects()) {
+        m_entities.remove(bot);
+        delete bot;
+    }
+    m_bots.clear();
+
+    for (auto& weapon : m_weapons) {
+        delete weapon;
+        weapon = nullptr;
+    }
+    m_weapons.clear();
+
+    m_spatialIndex.clear();
+    m_camera.setFocus(m_flag);
+    m_ticks = 0;
+}
+
+void Level::saveState(SnapshotWriter& out) const {
+    out.writeU32(m_ticks);
+    m_flag->saveState(out);
+
+    const std::vector<Bot*>& bots = m_bots.objects();
+    out.writeU32(static_cast<uint32_t>(bots.size()));
+    // types first, so restoreState knows which bots can be reused before restoring any of them
+    for (const Bot* bot : bots) {
+        out.writeU16(bot->getPrefab());
+    }
+    for (const Bot* bot : bots) {
+        bot->saveState(out);
     }
 
-    // Update bots
-    for (auto obj : m_bots) {
-        obj->update();
+    // all lying weapons are guns, the fist can't be dropped
+    out.writeU32(static_cast<uint32_t>(m_weapons.size()));
+    for (const Fist* weapon : m_weapons) {
+        out.writeU16(static_cast<const Gun*>(weapon)->getPrefab());
+    }
+    for (const Fist* weapon : m_weapons) {
+        weapon->saveState(out);
     }
+}
+
+void Level::restoreState(SnapshotReader& in) {
+    flushDestroyed();
+
+    m_ticks = in.readU32();
+    m_flag->restoreState(in);
+
+    size_t botCount = in.readU32();
+    std::vector<PrefabId> types;
+    types.reserve(botCount);
+    for (size_t i = 0; i < botCount; ++i) {
+        types.push_back(in.readU16());
+    }
+
+    // keep the bots which have the same type as in the snapshot, replace the others
+    size_t reused = 0;
+    while (reused < std::min(botCount, m_bots.size()) &&
+           types[reused] == m_bots.objects()[reused]->getPrefab()) {
+        ++reused;
+    }
+    while (m_bots.size() > reused) {
+        Bot* bot = m_bots.objects().back();
+        m_bots.erase(bot->getHandle());
+        m_entities.remove(bot);
+        delete bot;
+    }
+    for (size_t i = reused; i < botCount; ++i) {
+        if (!spawnBot(types[i], {0, 0})) {
+            throw std::runtime_error("Snapshot contains an unknown bot type: " +
+                                     std::to_string(types[i]));
+        }
+    }
+    for (Bot* bot : m_bots.objects()) {
+        bot->restoreState(in);
+    }
+
+    size_t weaponCount = in.readU32();
+    std::vector<PrefabId> weaponTypes;
+    weaponTypes.reserve(weaponCount);
+    for (size_t i = 0; i < weaponCount; ++i) {
+        weaponTypes.push_back(in.readU16());
+    }
+    reused = 0;
+    while (reused < std::min(weaponCount, m_weapons.size()) &&
+           weaponTypes[reused] == static_cast<Gun*>(m_weapons[reused])->getPrefab()) {
+        ++reused;
+    }
+    while (m_weapons.size() > reused) {
+        delete m_weapons.back();
+        m_weapons.pop_back();
+    }
+    for (size_t i = reused; i < weaponCount; ++i) {
+        if (weaponTypes[i] >= prefabs().getWeaponCount()) {
+            throw std::runtime_error("Snapshot contains an unknown weapon type: " +
+                                     std::to_string(weaponTypes[i]));
+        }
+        Gun* gun = prefabs().createWeapon(weaponTypes[i]);
+        addWeaponToWorld(gun);
+        m_weapons.push_back(gun);
+    }
+    for (Fist* weapon : m_weapons) {
+        weapon->restoreState(in);
+    }
+}
+
+void Level::rebuildWorld(const std::vector<const b2Body*>& bodies) {
+    m_world->rebuild(bodies);
+    m_entities.updateBodies();
+}
+
+void Level::updateSpatialIndex() {
+    m_spatialIndex.clear();
+    for (Player* player : m_players) {
+        m_spatialIndex.insert(player, PLAYER_CAT);
+    }
+    for (Bot* bot : m_bots.objects()) {
+        m_spatialIndex.insert(bot, BOT_CAT);
+    }
+}
+
+int Level::botDistance(Bot* bot) {
+    // distance between the bot's bounding box and the visible area
+    int dx = std::max(std::max(m_camera.minX() - (bot->x() + bot->animationWidth()),
+                               bot->x() - m_camera.maxX()),
+                      0);
+    int dy = std::max(std::max(m_camera.minY() - (bot->y() + bot->animationHeight()),
+                               bot->y() - m_camera.maxY()),
+                      0);
+    return std::max(dx, dy);
+}
+
+SimulationTier Level::botSimulationTier(Bot* bot) {
+    int distance = botDistance(bot);
+    if (distance < BOT_REDUCED_DISTANCE) {
+        return SimulationTier::Full;
+    }
+    if (distance < BOT_DORMANT_DISTANCE) {
+        return SimulationTier::Reduced;
+    }
+    return SimulationTier::Dormant;
+}
+
+void Level::updateBots() {
+    ++m_ticks;
+    // bots may remove themselves from m_bots while updating, which moves the last one to i
+    const std::vector<Bot*>& bots = m_bots.objects();
+    uint32_t full = 0;
+    for (size_t i = 0; i < bots.size();) {
+        Bot* bot = bots[i];
+        SimulationTier tier = botSimulationTier(bot);
+        if (tier == SimulationTier::Full && ++full > BOT_FULL_LIMIT) {
+            tier = SimulationTier::Reduced;
+        }
+        bot->setSimulationTier(tier);
+
+        // stagger the reduced updates over all ticks
+        if (tier == SimulationTier::Full || (m_ticks + i) % BOT_REDUCED_INTERVAL == 0) {
+            bot->update();
+        }
+        if (i < bots.size() && bots[i] == bot) {
+            ++i;
+        }
+    }
+}
+
+void Level::update() {
+    // move all objects to their bodies, the doors are static and skipped
+    m_entities.syncTransforms();
+    for (Player* player : m_players) {
+        player->update();
+    }
+    updateSpatialIndex();
+
+    // a lower quality spawns less
+    const uint32_t spawnDivisor = EngineContext::current().getEngine().getQuality().spawnDivisor;
+    const BotSpawning& spawning = botSpawning();
+    if (spawning.isHorde()) {
+        // a horde fills the level up to its budget, a few bots per tick
+        uint32_t perTick = std::max(spawning.perTick / spawnDivisor, 1u);
+        for (uint32_t i = 0; i < perTick && m_bots.size() < spawning.budget; ++i) {
+            addBot();
+        }
+    } else if (random().getInt(0, 10000) < kBotSpawnChance / static_cast<int>(spawnDivisor)) {
+        addBot();
+    }
+
+    updateBots();
 
     if (m_camera.checkBounds(m_flag)) {
         respawnFlag();
@@ -285,15 +526,20 @@ void Level::update() {
     int32 velocityIterations = 5;
     int32 positionIterations = 6;
 
-    m_world->getWorld()->Step(timeStep, velocityIterations, positionIterations);
+    m_world->step(timeStep, velocityIterations, positionIterations);
     m_world->getListener()->update();
+    // everything removed during the step is deleted in one batch, its bodies with it
+    flushDestroyed();
+
+    if (Window::isVerbose() && m_world->getStats().steps % PHYSICS_STATS_INTERVAL == 0) {
+        m_world->printStats(std::cout);
+    }
 
     for (Fist* fist : m_weapons) {
         fist->update();
     }
 
-    // 0.04% spawnchance for weapons per loop (á 60FPS)
-    if (Random::getInt(0, 10000) < 4) {
+    if (random().getInt(0, 10000) < kWeaponSpawnChance / static_cast<int>(spawnDivisor)) {
         addWeapon();
     }
 }
@@ -306,7 +552,11 @@ void Level::render() {
         fist->render();
     }
 
-    for (auto& item : m_bots) {
+    // most bots of a horde are outside of the visible area
+    for (Bot* item : m_bots.objects()) {
+        if (botDistance(item) > 0) {
+            continue;
+        }
         item->setOffset(m_camera.getPosition());
         item->render();
     }
@@ -315,13 +565,9 @@ void Level::render() {
 Level::~Level() {
     Expects(!m_world->getWorld()->IsLocked());
 
-    if (m_flipped) {
-        delete m_lconf;
-    }
-
-    for (auto& item : m_bots) {
+    flushDestroyed();
+    for (Bot* item : m_bots.objects()) {
         delete item;
-        item = nullptr;
     }
 
     for (auto& m_weapon : m_weapons) {
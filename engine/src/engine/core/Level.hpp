@@ -9,13 +9,20 @@
 
 #include <Box2D/Box2D.h>
 #include <SDL.h>
-#include <stack>
 #include <string>
 #include <vector>
 
 #include <gsl/gsl>
 
+#include "engine/core/BotSpawning.hpp"
 #include "engine/core/Camera.hpp"
+#include "engine/core/DestroyQueue.hpp"
+#include "engine/core/EntityStore.hpp"
+#include "engine/core/LevelView.hpp"
+#include "engine/core/NavGraph.hpp"
+#include "engine/core/Prefabs.hpp"
+#include "engine/core/SlotMap.hpp"
+#include "engine/core/SpatialIndex.hpp"
 #include "engine/graphics/LayerRenderer.hpp"
 #include "engine/graphics/TilesetRenderable.hpp"
 #include "engine/physics/LevelContactListener.hpp"
@@ -28,15 +35,21 @@ namespace ctb {
 namespace parser {
 class GameConfig;
 class LevelConfig;
+class TilesetConfig;
 }  // namespace parser
 
 namespace engine {
 
 class Fist;
+class SharedTextures;
+class Gun;
 class LevelContactListener;
 class Player;
 class Door;
 class Bot;
+class Random;
+class SnapshotReader;
+class SnapshotWriter;
 
 /**
  * @brief Represents a level in the game.
@@ -56,18 +69,41 @@ class Level : public SDLRenderable {
 
     static constexpr float32 PHYSICALTIMESTEPFREQUENCE = 40.0f;
 
+    // distances (in pixels) between a bot and the visible area for the simulation tiers
+    static constexpr int BOT_REDUCED_DISTANCE = 320;
+    static constexpr int BOT_DORMANT_DISTANCE = 1280;
+
+    /// bots outside of the full simulation tier are only updated every n-th tick
+    static constexpr uint32_t BOT_REDUCED_INTERVAL = 4;
+
+    /// at most this many bots are fully simulated per tick, the others near the camera are
+    /// updated like reduced ones, so a horde slows its bots down instead of the game
+    static constexpr uint32_t BOT_FULL_LIMIT = 256;
+
+    /// number of free tiles a walking bot needs above the ground (zombies are 64px high)
+    static constexpr int BOT_CLEARANCE = 2;
+
+    /// number of tiles a walking bot can jump sideways
+    static constexpr int BOT_JUMP_DISTANCE = 4;
+
+    /// physics statistics are printed every n-th step in verbose mode
+    static constexpr uint32_t PHYSICS_STATS_INTERVAL = 200;
+
     /**
      * @brief Construcotr
      *
      * @param gconf		    A pointer to a game config this level should use
-     * @param lconf         A pointer to a level config this level should use. If flipped is true,
-     *                      we take ownership!
-     * @param flipped       wether the level should be flipped or not
+     * @param view          the level config and wether the level should be flipped or not. The
+     *                      config is shared with the other orientation of the level.
+     * @param tiles         the parsed tiles of every tileset of the config, not mirrored
+     * @param textures      the cache the tilesheet and the backgrounds are loaded from
+     * @param world         the physical environment of the level
      */
     Level(parser::GameConfig* gconf,
-          parser::LevelConfig* lconf,
-          WorldPtrT world,
-          bool flipped = false);
+          const LevelView& view,
+          const std::vector<const DynamicTilestore*>& tiles,
+          SharedTextures& textures,
+          WorldPtrT world);
 
     /// Renders the level
     void render() override;
@@ -82,8 +118,11 @@ class Level : public SDLRenderable {
     /// returns a reference to this level's camera
     Camera& getCamera() { return m_camera; }
 
+    /// returns the physical environment of this level
+    WorldPtrT getWorld() const { return m_world; }
+
     /// returns if the level is flipped or not
-    bool isFlipped() const { return m_flipped; }
+    bool isFlipped() const { return m_view.isFlipped(); }
 
     /// Adds a renderable on the given layer to the level
     void addRenderable(TextureBasedRenderable* renderable, int layer = 0);
@@ -91,10 +130,21 @@ class Level : public SDLRenderable {
     /// Adds an player to the level on the given layer
     void addPlayer(Player* player, int layer);
 
-    /// add a bot to the level
+    /// add a bot at a random bot spawn, if the level is below the bot budget of the game
     void addBot();
 
-    /// delete the given bot
+    /**
+     * @brief Creates a bot and adds it to the level
+     *
+     * @param prefab  the type of the bot, see Prefabs
+     * @param pos     the position in pixels
+     *
+     * @return the bot or nullptr if the type is unknown
+     */
+    Bot* spawnBot(PrefabId prefab, Vector2dT pos);
+
+    /// removes the given bot from the level and deletes it after the next physics step, bots
+    /// that were removed already are ignored
     void deleteBot(Bot* bot);
 
     /**
@@ -103,10 +153,13 @@ class Level : public SDLRenderable {
      * @param tiles the tileset to add
      * @param config the config
      */
-    void addLevelTiles(PhysicalTileSet* tiles, parser::TilesetConfig& config);
+    void addLevelTiles(PhysicalTileSet* tiles, const parser::TilesetConfig& config);
+
+    /// get this level's config, its points aren't mirrored if the level is flipped
+    const parser::LevelConfig* getConfig() const { return &m_view.getConfig(); }
 
-    /// get this level's config
-    parser::LevelConfig* getConfig() const { return m_lconf; }
+    /// get this level's config as seen in the level
+    const LevelView& getView() const { return m_view; }
 
     /// get this level's doors
     std::vector<Door*>& getDoors() { return m_doors; }
@@ -114,9 +167,18 @@ class Level : public SDLRenderable {
     /// get this level's flag
     Flag* getFlag() { return m_flag; }
 
+    /// returns all bots of this level
+    const std::vector<Bot*>& getBots() const { return m_bots.objects(); }
+
+    /// returns all weapons lying in this level
+    const std::vector<Fist*>& getWeapons() const { return m_weapons; }
+
     /// adds a dropped weapon to the level
     void addWeapon();
 
+    /// creates the gun the levels spawn, it isn't added to a world yet
+    Gun* createGun();
+
     /// drops weapon and adds it to world
     void spawnWeapon(Fist* weapon);
 
@@ -126,12 +188,61 @@ class Level : public SDLRenderable {
     /// removes weapon from level (e.g if player collects it)
     void removeWeapon(Fist* weapon);
 
+    /// deletes a weapon, which isn't lying in the level, after the next physics step
+    void destroyWeapon(Fist* weapon) { m_deadWeapons.push(weapon); }
+
     /// respawns this levels flag and destroys its joint if needed
     void respawnFlag();
 
+    /**
+     * @brief Removes all dynamic state (players, bots, weapons) from this level so it can be
+     *        reused by the next game. Tiles, backgrounds, doors and the flag are kept.
+     */
+    void reset();
+
+    /**
+     * @brief Removes the bots and weapons and respawns the flag, like in a level that was never
+     *        played. Unlike reset, the players stay in the level.
+     */
+    void clearState();
+
+    /**
+     * @brief Writes the flag, the bots and the lying weapons to a snapshot. The players are
+     *        written by the game.
+     *
+     * @param out the snapshot to write to
+     */
+    void saveState(SnapshotWriter& out) const;
+
+    /**
+     * @brief Restores the state written by saveState. Bots and weapons are reused where
+     *        possible and created or deleted otherwise. The world must not be locked.
+     *
+     * @param in the snapshot to read from
+     */
+    void restoreState(SnapshotReader& in);
+
+    /// Deletes the removed bots and weapons, the world must not be locked. Happens in every
+    /// update, only needed if bots are removed without updating the level.
+    void flushDestroyed();
+
+    /**
+     * @brief Rebuilds the world without its contacts after a snapshot was written or restored,
+     *        so both continue the same way, see LevelWorld::rebuild()
+     *
+     * @param bodies the bodies of the snapshot in their order
+     */
+    void rebuildWorld(const std::vector<const b2Body*>& bodies);
+
+    /// returns the spatial index of this level's players, bots and spawns
+    const SpatialIndex& getSpatialIndex() const { return m_spatialIndex; }
+
+    /// returns the navigation graph of the tiles bots collide with
+    NavGraph& getNavGraph() { return m_navGraph; }
+
    private:
-    /// Is this level flipped?
-    bool m_flipped{false};
+    /// The config of this level and if it is flipped
+    LevelView m_view;
 
     /// Physical Environment
     WorldPtrT m_world;
@@ -142,21 +253,22 @@ class Level : public SDLRenderable {
     /// A layer renderer for correct rendering of the renderables
     LayerRenderer m_layers;
 
+    /// all players that were added to this level
+    std::vector<Player*> m_players;
+
     /// all bots in this level
-    std::vector<Bot*> m_bots;
+    SlotMap<Bot> m_bots;
 
-    /// garbage collector for the bots
-    std::stack<Bot*> m_GCBots;
+    /// removed bots and weapons, deleted after the physics step
+    DestroyQueue<Bot> m_deadBots;
+    DestroyQueue<Fist> m_deadWeapons;
 
-    /// all physical objects in this level
-    std::vector<PhysicalRenderable*> m_objects;
+    /// all physical objects in this level except the weapons
+    EntityStore m_entities;
 
     /// all doors in this level
     std::vector<Door*> m_doors;
 
-    /// this level's config
-    parser::LevelConfig* m_lconf;
-
     /// the gameconfig of the game this level is in
     parser::GameConfig* m_gconf;
 
@@ -168,6 +280,49 @@ class Level : public SDLRenderable {
 
     /// this weapons of this level
     std::vector<Fist*> m_weapons;
+
+    /// proximity lookups for players, bots and player spawns
+    SpatialIndex m_spatialIndex;
+
+    /// paths for walking bots
+    NavGraph m_navGraph;
+
+    /// Number of update calls, used to stagger reduced bot updates
+    uint32_t m_ticks{0};
+
+    /// the prefab of every bot and weapon spawn of the config, NONE for an unknown type
+    std::vector<PrefabId> m_botSpawnPrefabs;
+    std::vector<PrefabId> m_weaponSpawnPrefabs;
+
+    /// the prefab of createGun
+    PrefabId m_gunPrefab{Prefabs::NONE};
+
+    /// Returns the gameplay random generator of the running game
+    Random& random();
+
+    /// Returns the bot and weapon types of the engine
+    const Prefabs& prefabs();
+
+    /// Returns the bot spawning of the running game
+    const BotSpawning& botSpawning();
+
+    /// Builds the navigation graph from the given tile layers
+    void buildNavGraph(const std::vector<const DynamicTilestore*>& layers);
+
+    /// Re-inserts all players and bots into the spatial index
+    void updateSpatialIndex();
+
+    /// Updates all bots according to their simulation tier
+    void updateBots();
+
+    /// Adds the weapon to the world of this level
+    void addWeaponToWorld(Fist* weapon);
+
+    /// Returns the distance in pixels between a bot and the visible area, 0 if it is visible
+    int botDistance(Bot* bot);
+
+    /// Computes the simulation tier of a bot from its distance to the visible area
+    SimulationTier botSimulationTier(Bot* bot);
 };
 
 }  // namespace engine
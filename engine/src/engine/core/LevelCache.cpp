@@ -0,0 +1,140 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT License; see LICENSE file in the root of this
+// project for details.
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include <Box2D/Box2D.h>
+#include <gsl/gsl>
+#include <parser/DynamicTilestore.hpp>
+#include <parser/GameConfig.hpp>
+#include <parser/LevelConfig.hpp>
+
+#include "engine/EngineContext.hpp"
+#include "engine/core/Level.hpp"
+#include "engine/core/LevelCache.hpp"
+#include "engine/physics/LevelWorld.hpp"
+
+namespace ctb {
+namespace engine {
+
+LevelCache::LevelCache(parser::GameConfig* config) : m_config(config) {}
+
+Level* LevelCache::acquire(const parser::LevelConfig* config, bool flipped) {
+    Expects(config != nullptr);
+
+    auto key = std::make_pair(config, flipped);
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) {
+        auto prefetch = m_prefetches.find(key);
+        if (prefetch != m_prefetches.end()) {
+            std::future<DecodedImages> images = std::move(prefetch->second);
+            m_prefetches.erase(prefetch);
+            // waits if the worker isn't done yet
+            for (auto& image : images.get()) {
+                EngineContext::current().addDecodedImage(image.first, image.second);
+            }
+        }
+
+        LevelWorld* world = new LevelWorld(b2Vec2(0, /*1000*/ 15));
+        Level* level = new Level(m_config, LevelView(config, flipped), getTiles(config),
+                                 m_textures, world);
+        it = m_entries.emplace(key, Entry{world, level, false}).first;
+    }
+
+    if (it->second.inUse) {
+        throw std::logic_error("Level is already in use!");
+    }
+    it->second.inUse = true;
+    return it->second.level;
+}
+
+void LevelCache::prefetch(const parser::LevelConfig* config, bool flipped) {
+    Expects(config != nullptr);
+
+    auto key = std::make_pair(config, flipped);
+    if (m_entries.count(key) != 0 || m_prefetches.count(key) != 0) {
+        return;
+    }
+
+    // every image the level constructor loads that isn't loaded yet, the other orientation of
+    // the level loads the same ones
+    std::vector<std::string> paths;
+    if (m_prefetches.count(std::make_pair(config, !flipped)) == 0) {
+        paths.push_back(config->getTilesheetFilename());
+        for (auto& background : config->getBackgrounds()) {
+            paths.push_back(background.getImageFilename());
+        }
+        paths.erase(std::remove_if(paths.begin(), paths.end(),
+                                   [this](const std::string& path) {
+                                       return m_textures.contains(path);
+                                   }),
+                    paths.end());
+    }
+    paths.push_back(m_config->getFlagFilename());
+    paths.push_back(m_config->getDoorFilename());
+
+    m_prefetches.emplace(key, std::async(std::launch::async, &LevelCache::decode, paths));
+}
+
+const std::vector<const DynamicTilestore*>& LevelCache::getTiles(
+    const parser::LevelConfig* config) {
+    auto it = m_tiles.find(config);
+    if (it == m_tiles.end()) {
+        std::vector<const DynamicTilestore*> tiles;
+        for (auto& tileset : config->getTilesets()) {
+            tiles.push_back(new DynamicTilestore(tileset.getTileArrangement(), config->getWidth(),
+                                                 config->getHeight(), config->getTileWidth(),
+                                                 config->getTileHeight()));
+        }
+        it = m_tiles.emplace(config, std::move(tiles)).first;
+    }
+    return it->second;
+}
+
+LevelCache::DecodedImages LevelCache::decode(const std::vector<std::string>& paths) {
+    DecodedImages images;
+    for (const std::string& path : paths) {
+        // a missing image is reported by the loadTexture of acquire
+        SDL_Surface* surface = EngineContext::decodeImage(path);
+        if (surface != nullptr) {
+            images.emplace_back(path, surface);
+        }
+    }
+    return images;
+}
+
+void LevelCache::release(Level* level) {
+    for (auto& pair : m_entries) {
+        Entry& entry = pair.second;
+        if (entry.level == level) {
+            entry.level->reset();
+            entry.inUse = false;
+            return;
+        }
+    }
+}
+
+LevelCache::~LevelCache() {
+    for (auto& pair : m_prefetches) {
+        for (auto& image : pair.second.get()) {
+            SDL_FreeSurface(image.second);
+        }
+    }
+    for (auto& pair : m_entries) {
+        delete pair.second.level;
+        delete pair.second.world;
+    }
+    for (auto& pair : m_tiles) {
+        for (const DynamicTilestore* tiles : pair.second) {
+            delete tiles;
+        }
+    }
+}
+
+}  // namespace engine
+}  // namespace ctb
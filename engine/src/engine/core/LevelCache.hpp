@@ -0,0 +1,122 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT License; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_CORE_LEVELCACHE_HPP
+#define ENGINE_CORE_LEVELCACHE_HPP
+
+#include <future>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <SDL.h>
+
+#include "engine/core/SharedTextures.hpp"
+
+namespace ctb {
+class DynamicTilestore;
+
+namespace parser {
+class GameConfig;
+class LevelConfig;
+}  // namespace parser
+
+namespace engine {
+
+class Level;
+class LevelWorld;
+
+/**
+ * @brief Keeps built levels (tile bodies, textures, backgrounds) alive between games.
+ *
+ * A level is identified by its LevelConfig and whether it is flipped. Levels are built on first
+ * use and reset when they are handed back, so a rematch only has to reset dynamic state.
+ * The flipped and the unflipped level of a config share the config, its parsed tiles and all
+ * images, a flipped level only mirrors them.
+ * A level can be prefetched before it is needed: its images are decoded on a worker thread and
+ * acquire only creates the textures and bodies, which have to be created on the main thread.
+ */
+class LevelCache {
+   public:
+    /**
+     * @brief Constructor
+     *
+     * @param config the game config all levels are built with
+     */
+    explicit LevelCache(parser::GameConfig* config);
+
+    /// Deletes all cached levels and their worlds
+    ~LevelCache();
+
+    LevelCache(const LevelCache&) = delete;
+    LevelCache& operator=(const LevelCache&) = delete;
+
+    /**
+     * @brief Returns the level for the given config, building it if it was never used before
+     *
+     * @param config the config of the level, it must outlive the cache
+     * @param flipped whether the level should be flipped or not
+     *
+     * @return the level
+     * @throws logic_error if the level is already in use
+     */
+    Level* acquire(const parser::LevelConfig* config, bool flipped);
+
+    /**
+     * @brief Starts decoding the images of a level on a worker thread, acquire waits for it.
+     *        Does nothing if the level is already built or prefetched.
+     *
+     * @param config the config of the level
+     * @param flipped whether the level should be flipped or not
+     */
+    void prefetch(const parser::LevelConfig* config, bool flipped);
+
+    /**
+     * @brief Hands a level back and removes all dynamic state from it
+     *
+     * @param level a level returned by acquire
+     */
+    void release(Level* level);
+
+   private:
+    struct Entry {
+        LevelWorld* world;
+        Level* level;
+        bool inUse;
+    };
+
+    using Key = std::pair<const parser::LevelConfig*, bool>;
+
+    /// Images by their path, decoded by a prefetch
+    using DecodedImages = std::vector<std::pair<std::string, SDL_Surface*>>;
+
+    /// Decodes the images, runs on the worker thread of a prefetch
+    static DecodedImages decode(const std::vector<std::string>& paths);
+
+    /// Returns the tiles of every tileset of a config, parsed on first use
+    const std::vector<const DynamicTilestore*>& getTiles(const parser::LevelConfig* config);
+
+    /// The game config all levels are built with
+    parser::GameConfig* m_config;
+
+    /// All built levels by their config and if they are flipped
+    std::map<Key, Entry> m_entries;
+
+    /// The running and finished prefetches of levels that are not built yet
+    std::map<Key, std::future<DecodedImages>> m_prefetches;
+
+    /// The parsed tiles of every tileset by config, shared by both orientations of a level
+    std::map<const parser::LevelConfig*, std::vector<const DynamicTilestore*>> m_tiles;
+
+    /// The tilesheets and backgrounds of all levels
+    SharedTextures m_textures;
+};
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_CORE_LEVELCACHE_HPP
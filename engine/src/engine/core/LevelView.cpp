@@ -0,0 +1,70 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT License; see LICENSE file in the root of this
+// project for details.
+
+#include <gsl/gsl>
+#include <parser/LevelConfig.hpp>
+
+#include "engine/core/LevelView.hpp"
+
+namespace ctb {
+namespace engine {
+
+LevelView::LevelView(const parser::LevelConfig* config, bool flipped)
+    : m_config(config), m_flipped(flipped) {
+    Expects(config != nullptr);
+}
+
+int LevelView::mirrorX(int x) const {
+    return m_flipped ? m_config->getWidth() - x - 1 : x;
+}
+
+Vector2dT LevelView::mirror(Vector2dT pos) const {
+    pos.x = mirrorX(pos.x);
+    return pos;
+}
+
+Vector2dT LevelView::getDoorL() const {
+    return m_flipped ? mirror(m_config->getDoorR()) : m_config->getDoorL();
+}
+
+Vector2dT LevelView::getDoorR() const {
+    return m_flipped ? mirror(m_config->getDoorL()) : m_config->getDoorR();
+}
+
+Vector2dT LevelView::getFlagSpawn() const {
+    return mirror(m_config->getFlagSpawn());
+}
+
+size_t LevelView::getBotSpawnCount() const {
+    return m_config->getBotSpawns().size();
+}
+
+Vector2dT LevelView::getBotSpawn(size_t index) const {
+    return mirror(m_config->getBotSpawns().at(index).getPosition());
+}
+
+const std::string& LevelView::getBotSpawnType(size_t index) const {
+    return m_config->getBotSpawns().at(index).getType();
+}
+
+size_t LevelView::getWeaponSpawnCount() const {
+    return m_config->getWeaponSpawns().size();
+}
+
+Vector2dT LevelView::getWeaponSpawn(size_t index) const {
+    return mirror(m_config->getWeaponSpawns().at(index).getPosition());
+}
+
+const std::string& LevelView::getWeaponSpawnType(size_t index) const {
+    return m_config->getWeaponSpawns().at(index).getType();
+}
+
+Vector2dT LevelView::toWorld(Vector2dT pos) const {
+    return m_config->toWorld(pos);
+}
+
+}  // namespace engine
+}  // namespace ctb
@@ -0,0 +1,91 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT License; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_CORE_LEVELVIEW_HPP
+#define ENGINE_CORE_LEVELVIEW_HPP
+
+#include <cstddef>
+#include <string>
+
+#include "engine/util/Vector2d.hpp"
+
+namespace ctb {
+namespace parser {
+class LevelConfig;
+}  // namespace parser
+
+namespace engine {
+
+/**
+ * @brief A read-only view of a parsed level that can mirror it horizontally.
+ *
+ * The flipped and the unflipped level of a config share the config, the view mirrors the x
+ * tile coordinates of its points on access. Mirroring swaps the doors, so the left door of a
+ * flipped level is the mirrored right door of its config. The view is as cheap to copy as a
+ * pointer, the config has to outlive it.
+ */
+class LevelView {
+   public:
+    /**
+     * @brief Constructor
+     *
+     * @param config    the parsed level, it isn't changed
+     * @param flipped   whether the level is mirrored
+     */
+    LevelView(const parser::LevelConfig* config, bool flipped);
+
+    /// Returns the parsed level, its points aren't mirrored
+    const parser::LevelConfig& getConfig() const { return *m_config; }
+
+    /// Returns whether the level is mirrored
+    bool isFlipped() const { return m_flipped; }
+
+    /// Returns the x tile coordinate of the config as seen through the view, or the other way
+    /// round, as mirroring twice changes nothing
+    int mirrorX(int x) const;
+
+    /// Returns the tile position of the config as seen through the view
+    Vector2dT mirror(Vector2dT pos) const;
+
+    /// Returns the tile position of the left door
+    Vector2dT getDoorL() const;
+
+    /// Returns the tile position of the right door
+    Vector2dT getDoorR() const;
+
+    /// Returns the tile position of the flag spawn
+    Vector2dT getFlagSpawn() const;
+
+    /// Returns the number of bot spawns
+    size_t getBotSpawnCount() const;
+
+    /// Returns the tile position of the bot spawn with the given index
+    Vector2dT getBotSpawn(size_t index) const;
+
+    /// Returns the bot type of the bot spawn with the given index
+    const std::string& getBotSpawnType(size_t index) const;
+
+    /// Returns the number of weapon spawns
+    size_t getWeaponSpawnCount() const;
+
+    /// Returns the tile position of the weapon spawn with the given index
+    Vector2dT getWeaponSpawn(size_t index) const;
+
+    /// Returns the weapon type of the weapon spawn with the given index
+    const std::string& getWeaponSpawnType(size_t index) const;
+
+    /// Converts a tile position to pixels
+    Vector2dT toWorld(Vector2dT pos) const;
+
+   private:
+    const parser::LevelConfig* m_config;
+    bool m_flipped;
+};
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_CORE_LEVELVIEW_HPP
@@ -0,0 +1,312 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT License; see LICENSE file in the root of this
+// project for details.
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <utility>
+
+#include <gsl/gsl>
+#include <parser/DynamicTilestore.hpp>
+
+#include "engine/core/NavGraph.hpp"
+
+namespace ctb {
+namespace engine {
+
+namespace {
+/// Number of tiles searched below an object for a node
+constexpr int kNodeSearchDepth = 4;
+}  // namespace
+
+constexpr int NavGraph::NO_NODE;
+constexpr size_t NavGraph::MAX_CACHED_GOALS;
+constexpr size_t NavGraph::MAX_EXPANSIONS;
+constexpr int32_t NavGraph::UNKNOWN;
+constexpr int32_t NavGraph::UNREACHABLE;
+
+void NavGraph::build(const std::vector<const DynamicTilestore*>& layers,
+                     int clearance,
+                     int maxJumpHeight,
+                     int maxJumpDistance,
+                     bool mirrored) {
+    Expects(clearance > 0 && maxJumpHeight >= 0 && maxJumpDistance >= 0);
+
+    m_nodes.clear();
+    m_links.clear();
+    m_goalCaches.clear();
+    m_width = m_height = 0;
+    if (layers.empty()) {
+        m_solid.clear();
+        m_nodeIds.clear();
+        return;
+    }
+
+    m_width = layers.front()->getWidth();
+    m_height = layers.front()->getHeight();
+    m_tileWidth = std::max(1, layers.front()->getTileWidth());
+    m_tileHeight = std::max(1, layers.front()->getTileHeight());
+
+    const size_t size = static_cast<size_t>(m_width * m_height);
+    m_solid.assign(size, false);
+    for (const DynamicTilestore* layer : layers) {
+        Expects(layer->getWidth() == m_width && layer->getHeight() == m_height);
+        for (int y = 0; y < m_height; ++y) {
+            for (int x = 0; x < m_width; ++x) {
+                if (layer->get(mirrored ? m_width - x - 1 : x, y) != 0) {
+                    m_solid[static_cast<size_t>(y * m_width + x)] = true;
+                }
+            }
+        }
+    }
+
+    // every empty tile with ground below and enough headroom is a node
+    m_nodeIds.assign(size, NO_NODE);
+    for (int y = 0; y < m_height; ++y) {
+        for (int x = 0; x < m_width; ++x) {
+            if (solid(x, y + 1) && clear(x, y, clearance)) {
+                m_nodeIds[static_cast<size_t>(y * m_width + x)] = static_cast<int>(m_nodes.size());
+                m_nodes.push_back({x, y, 0, 0});
+            }
+        }
+    }
+
+    for (Node& node : m_nodes) {
+        node.firstLink = static_cast<uint32_t>(m_links.size());
+        addLinks(node.x, node.y, clearance, maxJumpHeight, maxJumpDistance);
+        node.linkCount = static_cast<uint32_t>(m_links.size()) - node.firstLink;
+    }
+
+    m_cost.assign(m_nodes.size(), 0.0f);
+    m_cameFrom.assign(m_nodes.size(), UNKNOWN);
+    m_cameFromNode.assign(m_nodes.size(), NO_NODE);
+    m_visited.assign(m_nodes.size(), 0);
+    m_searchId = 0;
+}
+
+bool NavGraph::solid(int x, int y) const {
+    if (x < 0 || y < 0 || x >= m_width || y >= m_height) {
+        return false;
+    }
+    return m_solid[static_cast<size_t>(y * m_width + x)];
+}
+
+bool NavGraph::clear(int x, int y, int height) const {
+    for (int i = 0; i < height; ++i) {
+        if (solid(x, y - i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int NavGraph::nodeAt(int x, int y) const {
+    if (x < 0 || y < 0 || x >= m_width || y >= m_height) {
+        return NO_NODE;
+    }
+    return m_nodeIds[static_cast<size_t>(y * m_width + x)];
+}
+
+int NavGraph::nodeAtPixel(int px, int py) const {
+    if (px < 0 || py < 0) {
+        return NO_NODE;
+    }
+    int x = px / m_tileWidth;
+    int y = py / m_tileHeight;
+    // start one tile above in case the object sank into the ground a bit
+    for (int ty = y - 1; ty <= y + kNodeSearchDepth; ++ty) {
+        int node = nodeAt(x, ty);
+        if (node != NO_NODE) {
+            return node;
+        }
+    }
+    return NO_NODE;
+}
+
+void NavGraph::addLinks(int x, int y, int clearance, int maxJumpHeight, int maxJumpDistance) {
+    for (int dir = -1; dir <= 1; dir += 2) {
+        int nx = x + dir;
+        int neighbour = nodeAt(nx, y);
+        if (neighbour != NO_NODE) {
+            m_links.push_back({neighbour, LinkType::Walk, 1.0f});
+        } else if (clear(nx, y, clearance)) {
+            // walk over the edge and fall down to the next floor
+            for (int ny = y + 1; ny < m_height && !solid(nx, ny); ++ny) {
+                int target = nodeAt(nx, ny);
+                if (target != NO_NODE) {
+                    m_links.push_back(
+                        {target, LinkType::Fall, 1.0f + 0.5f * static_cast<float>(ny - y)});
+                    break;
+                }
+            }
+        }
+    }
+
+    for (int dy = 0; dy <= maxJumpHeight; ++dy) {
+        int ty = y - dy;
+        // room to rise in the start column, including one tile for the apex
+        if (!clear(x, y, dy + clearance + 1)) {
+            break;
+        }
+        for (int dx = -maxJumpDistance; dx <= maxJumpDistance; ++dx) {
+            if (dx == 0 || (dy == 0 && std::abs(dx) == 1)) {
+                continue;
+            }
+            int target = nodeAt(x + dx, ty);
+            if (target == NO_NODE) {
+                continue;
+            }
+
+            int step = dx > 0 ? 1 : -1;
+            bool reachable = true;
+            bool walkable = dy == 0;
+            for (int c = x + step; c != x + dx; c += step) {
+                if (!clear(c, ty - 1, clearance)) {
+                    reachable = false;
+                    break;
+                }
+                walkable = walkable && nodeAt(c, ty) != NO_NODE;
+            }
+            // flat ground is covered by walk links
+            if (reachable && !walkable) {
+                m_links.push_back({target, LinkType::Jump,
+                                   static_cast<float>(std::abs(dx) + 2 * dy + 1)});
+            }
+        }
+    }
+}
+
+NavGraph::SearchResult NavGraph::search(int start, int goal) {
+    m_pathLinks.clear();
+    if (start == NO_NODE || goal == NO_NODE || start == goal) {
+        return SearchResult::Unreachable;
+    }
+
+    if (++m_searchId == 0) {
+        std::fill(m_visited.begin(), m_visited.end(), 0);
+        m_searchId = 1;
+    }
+
+    const Node& goalNode = getNode(goal);
+    auto heuristic = [&goalNode](const Node& node) {
+        return static_cast<float>(std::abs(node.x - goalNode.x)) +
+               0.5f * static_cast<float>(std::abs(node.y - goalNode.y));
+    };
+
+    using Entry = std::pair<float, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+
+    auto s = static_cast<size_t>(start);
+    m_visited[s] = m_searchId;
+    m_cost[s] = 0.0f;
+    m_cameFrom[s] = UNKNOWN;
+    m_cameFromNode[s] = NO_NODE;
+    open.emplace(heuristic(getNode(start)), start);
+
+    size_t expansions = 0;
+    while (!open.empty() && expansions < MAX_EXPANSIONS) {
+        Entry current = open.top();
+        open.pop();
+        auto c = static_cast<size_t>(current.second);
+        const Node& node = m_nodes[c];
+        // skip outdated queue entries
+        if (current.first > m_cost[c] + heuristic(node) + 1e-4f) {
+            continue;
+        }
+        if (current.second == goal) {
+            for (int n = goal; n != start; n = m_cameFromNode[static_cast<size_t>(n)]) {
+                m_pathLinks.push_back(m_cameFrom[static_cast<size_t>(n)]);
+            }
+            std::reverse(m_pathLinks.begin(), m_pathLinks.end());
+            return SearchResult::Found;
+        }
+        ++expansions;
+
+        for (uint32_t i = 0; i < node.linkCount; ++i) {
+            auto linkIndex = static_cast<int32_t>(node.firstLink + i);
+            const Link& link = m_links[static_cast<size_t>(linkIndex)];
+            auto t = static_cast<size_t>(link.to);
+            float cost = m_cost[c] + link.cost;
+            if (m_visited[t] != m_searchId || cost < m_cost[t]) {
+                m_visited[t] = m_searchId;
+                m_cost[t] = cost;
+                m_cameFrom[t] = linkIndex;
+                m_cameFromNode[t] = current.second;
+                open.emplace(cost + heuristic(m_nodes[t]), link.to);
+            }
+        }
+    }
+    return open.empty() ? SearchResult::Unreachable : SearchResult::Aborted;
+}
+
+NavGraph::GoalCache& NavGraph::goalCache(int goal) {
+    ++m_useCounter;
+    for (GoalCache& cache : m_goalCaches) {
+        if (cache.goal == goal) {
+            cache.lastUse = m_useCounter;
+            return cache;
+        }
+    }
+
+    if (m_goalCaches.size() < MAX_CACHED_GOALS) {
+        m_goalCaches.push_back({goal, m_useCounter, {}});
+        m_goalCaches.back().next.assign(m_nodes.size(), UNKNOWN);
+        return m_goalCaches.back();
+    }
+
+    // reuse the least recently used cache
+    auto lru = std::min_element(
+        m_goalCaches.begin(), m_goalCaches.end(),
+        [](const GoalCache& a, const GoalCache& b) { return a.lastUse < b.lastUse; });
+    lru->goal = goal;
+    lru->lastUse = m_useCounter;
+    std::fill(lru->next.begin(), lru->next.end(), UNKNOWN);
+    return *lru;
+}
+
+const NavGraph::Link* NavGraph::nextLink(int start, int goal) {
+    if (start == NO_NODE || goal == NO_NODE || start == goal) {
+        return nullptr;
+    }
+
+    GoalCache& cache = goalCache(goal);
+    int32_t& next = cache.next[static_cast<size_t>(start)];
+    if (next == UNKNOWN) {
+        SearchResult result = search(start, goal);
+        if (result == SearchResult::Found) {
+            // every suffix of a shortest path is a shortest path as well
+            int node = start;
+            for (int32_t link : m_pathLinks) {
+                cache.next[static_cast<size_t>(node)] = link;
+                node = m_links[static_cast<size_t>(link)].to;
+            }
+        } else if (result == SearchResult::Unreachable) {
+            next = UNREACHABLE;
+        } else {
+            // an aborted search says nothing about the goal, try again next time
+            return nullptr;
+        }
+    }
+    if (next == UNREACHABLE) {
+        return nullptr;
+    }
+    return &m_links[static_cast<size_t>(next)];
+}
+
+bool NavGraph::findPath(int start, int goal, std::vector<const Link*>& path) {
+    path.clear();
+    if (search(start, goal) != SearchResult::Found) {
+        return false;
+    }
+    for (int32_t link : m_pathLinks) {
+        path.push_back(&m_links[static_cast<size_t>(link)]);
+    }
+    return true;
+}
+
+}  // namespace engine
+}  // namespace ctb
@@ -0,0 +1,179 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT License; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_CORE_NAVGRAPH_HPP
+#define ENGINE_CORE_NAVGRAPH_HPP
+
+#include <cstdint>
+#include <vector>
+
+namespace ctb {
+class DynamicTilestore;
+
+namespace engine {
+
+/**
+ * @brief Navigation graph for walking bots, built from the solid tiles of a level.
+ *
+ * Every empty tile with a solid tile below it and enough headroom is a node. Nodes are
+ * connected by walk links (neighbour on the same height), fall links (walking over an edge) and
+ * jump links (reachable with a single jump). Paths are searched with A* and cached per goal, so
+ * bots chasing the same target reuse each other's results.
+ */
+class NavGraph {
+   public:
+    /// How a link has to be traversed
+    enum class LinkType { Walk, Fall, Jump };
+
+    /// A directed connection between two nodes
+    struct Link {
+        int to;
+        LinkType type;
+        float cost;
+    };
+
+    /// A standable tile
+    struct Node {
+        int x;
+        int y;
+        uint32_t firstLink;
+        uint32_t linkCount;
+    };
+
+    /// Returned if there is no node
+    static constexpr int NO_NODE = -1;
+
+    /// Number of goals the next hops are cached for
+    static constexpr size_t MAX_CACHED_GOALS = 16;
+
+    /// Maximal number of nodes expanded by one A* search
+    static constexpr size_t MAX_EXPANSIONS = 4096;
+
+    NavGraph() = default;
+
+    /**
+     * @brief Builds the graph, replacing any previous one
+     *
+     * @param layers            all tile layers bots collide with. They must have the same size.
+     * @param clearance         number of empty tiles needed above a node
+     * @param maxJumpHeight     number of tiles a bot can jump up
+     * @param maxJumpDistance   number of tiles a bot can jump sideways
+     * @param mirrored          whether the layers are read mirrored, for a flipped level
+     */
+    void build(const std::vector<const DynamicTilestore*>& layers,
+               int clearance,
+               int maxJumpHeight,
+               int maxJumpDistance,
+               bool mirrored = false);
+
+    /// Returns if the graph contains no nodes
+    bool empty() const { return m_nodes.empty(); }
+
+    /// Returns the number of nodes
+    size_t nodeCount() const { return m_nodes.size(); }
+
+    /// Returns the width of a tile in pixels
+    int getTileWidth() const { return m_tileWidth; }
+
+    /// Returns the node with the given id
+    const Node& getNode(int id) const { return m_nodes[static_cast<size_t>(id)]; }
+
+    /// Returns the node at the given tile or NO_NODE
+    int nodeAt(int x, int y) const;
+
+    /**
+     * @brief Returns the node an object stands on or is falling towards
+     *
+     * @param px x pixel coordinate of the object's center
+     * @param py y pixel coordinate of the object's feet
+     *
+     * @return the node or NO_NODE if there is none within a few tiles below
+     */
+    int nodeAtPixel(int px, int py) const;
+
+    /**
+     * @brief Returns the first link of the shortest path from start to goal
+     *
+     * @param start the start node
+     * @param goal the goal node
+     *
+     * @return the link or nullptr if start is the goal, the goal is unreachable or the search
+     *         took more than MAX_EXPANSIONS expansions
+     */
+    const Link* nextLink(int start, int goal);
+
+    /**
+     * @brief Searches the shortest path from start to goal
+     *
+     * @param start the start node
+     * @param goal the goal node
+     * @param path receives the links of the path
+     *
+     * @return if a path was found
+     */
+    bool findPath(int start, int goal, std::vector<const Link*>& path);
+
+   private:
+    /// Next hops towards one goal, shared by all bots chasing it
+    struct GoalCache {
+        int goal;
+        uint32_t lastUse;
+        /// link index per node, UNKNOWN or UNREACHABLE
+        std::vector<int32_t> next;
+    };
+
+    static constexpr int32_t UNKNOWN = -1;
+    static constexpr int32_t UNREACHABLE = -2;
+
+    /// Outcome of an A* search
+    enum class SearchResult { Found, Unreachable, Aborted };
+
+    /// Returns if the tile is solid, tiles outside of the level are empty
+    bool solid(int x, int y) const;
+
+    /// Returns if the tile and the given number of tiles above it are empty
+    bool clear(int x, int y, int height) const;
+
+    /// Adds all links of the node at x, y
+    void addLinks(int x, int y, int clearance, int maxJumpHeight, int maxJumpDistance);
+
+    /// Runs A* and stores the links of the found path in m_pathLinks. The search is aborted
+    /// after MAX_EXPANSIONS expanded nodes.
+    SearchResult search(int start, int goal);
+
+    /// Returns the cache for the goal, evicting the least recently used one if needed
+    GoalCache& goalCache(int goal);
+
+    int m_width{0};
+    int m_height{0};
+    int m_tileWidth{1};
+    int m_tileHeight{1};
+
+    /// solid tiles, row major
+    std::vector<bool> m_solid;
+
+    /// node id per tile, row major
+    std::vector<int> m_nodeIds;
+
+    std::vector<Node> m_nodes;
+    std::vector<Link> m_links;
+
+    std::vector<GoalCache> m_goalCaches;
+    uint32_t m_useCounter{0};
+
+    // scratch memory for the A* search, reused between searches
+    std::vector<float> m_cost;
+    std::vector<int32_t> m_cameFrom;
+    std::vector<int> m_cameFromNode;
+    std::vector<uint32_t> m_visited;
+    uint32_t m_searchId{0};
+    std::vector<int32_t> m_pathLinks;
+};
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_CORE_NAVGRAPH_HPP
@@ -0,0 +1,118 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT License; see LICENSE file in the root of this
+// project for details.
+
+#include <cmath>
+
+#include <SDL_image.h>
+#include <gsl/gsl>
+#include <parser/GameConfig.hpp>
+#include <parser/PlayerConfig.hpp>
+
+#include "engine/EngineContext.hpp"
+#include "engine/core/PlayerSprites.hpp"
+#include "engine/scene/Player.hpp"
+#include "engine/util/Color.hpp"
+#include "engine/util/Exceptions.hpp"
+
+namespace ctb {
+namespace engine {
+
+namespace {
+/// The transparent color of the sheets, the same as for EngineContext::loadTexture
+const Color kColorKey(255, 0, 255);
+
+/// Returns whether a color is the transparent one
+bool isColorKey(const Color& color) {
+    return color.r == kColorKey.r && color.g == kColorKey.g && color.b == kColorKey.b;
+}
+
+/// Rotates the hues of all pixels of a 32 bit sheet except the transparent ones
+void swapPalette(SDL_Surface* sheet, uint32_t palette) {
+    HueRotation rotation(
+        std::fmod(static_cast<float>(palette) * PlayerSprites::PALETTE_HUE_STEP, 360.0f));
+    SDL_LockSurface(sheet);
+    for (int y = 0; y < sheet->h; ++y) {
+        auto* row =
+            reinterpret_cast<Uint32*>(static_cast<Uint8*>(sheet->pixels) + y * sheet->pitch);
+        for (int x = 0; x < sheet->w; ++x) {
+            Color color;
+            Uint8 alpha;
+            SDL_GetRGBA(row[x], sheet->format, &color.r, &color.g, &color.b, &alpha);
+            if (isColorKey(color)) {
+                continue;
+            }
+            Color rotated = rotation.apply(color);
+            // a visible pixel must not become transparent
+            if (isColorKey(rotated)) {
+                rotated.g = 1;
+            }
+            row[x] = SDL_MapRGBA(sheet->format, rotated.r, rotated.g, rotated.b, alpha);
+        }
+    }
+    SDL_UnlockSurface(sheet);
+}
+}  // namespace
+
+constexpr float PlayerSprites::PALETTE_HUE_STEP;
+
+PlayerSprites::PlayerSprites(parser::GameConfig* config) : m_config(config) {
+    Expects(config != nullptr && !config->getPlayers().empty());
+}
+
+uint32_t PlayerSprites::getSheetCount() const {
+    return static_cast<uint32_t>(m_config->getPlayers().size());
+}
+
+Player* PlayerSprites::createPlayer(Team team, uint32_t look) {
+    parser::PlayerConfig* config = m_config->getPlayers()[look % getSheetCount()];
+    // the player destroys its texture, so every player gets its own
+    auto* player = new Player(team, EngineContext::current().createTexture(getSheet(look)),
+                              config->getFrameWidth(), config->getFrameHeight(),
+                              config->getNumFrames());
+    player->setFPS(14);
+    player->setConfigIndex(look);
+    return player;
+}
+
+SDL_Surface* PlayerSprites::getSheet(uint32_t look) {
+    if (look >= m_sheets.size()) {
+        m_sheets.resize(look + 1, nullptr);
+    }
+    if (m_sheets[look] != nullptr) {
+        return m_sheets[look];
+    }
+
+    const std::string& path = m_config->getPlayers()[look % getSheetCount()]->getName();
+    SDL_Surface* decoded = EngineContext::decodeImage(path);
+    if (decoded == nullptr) {
+        throw SdlException("Error while loading \"" + path + "\".", IMG_GetError());
+    }
+    SDL_Surface* sheet = SDL_ConvertSurfaceFormat(decoded, SDL_PIXELFORMAT_ARGB8888, 0);
+    SDL_FreeSurface(decoded);
+    if (sheet == nullptr) {
+        throw SdlException("Error while converting \"" + path + "\".", SDL_GetError());
+    }
+
+    uint32_t palette = look / getSheetCount();
+    if (palette > 0) {
+        swapPalette(sheet, palette);
+    }
+    SDL_SetColorKey(sheet, SDL_TRUE,
+                    SDL_MapRGB(sheet->format, kColorKey.r, kColorKey.g, kColorKey.b));
+    m_sheets[look] = sheet;
+    return sheet;
+}
+
+PlayerSprites::~PlayerSprites() {
+    for (SDL_Surface* sheet : m_sheets) {
+        if (sheet != nullptr) {
+            SDL_FreeSurface(sheet);
+        }
+    }
+}
+
+}  // namespace engine
+}  // namespace ctb
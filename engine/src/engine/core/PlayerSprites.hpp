@@ -0,0 +1,78 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT License; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_CORE_PLAYERSPRITES_HPP
+#define ENGINE_CORE_PLAYERSPRITES_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include <SDL.h>
+
+namespace ctb {
+namespace parser {
+class GameConfig;
+}  // namespace parser
+
+namespace engine {
+
+class Player;
+enum class Team;
+
+/**
+ * @brief Creates any number of players that all look different.
+ *
+ * The looks of the players use the animation sheets of the player configs in turn. Every
+ * further round through them swaps the palette of the sheets, i.e. rotates their hues, so a
+ * look is the index of its player config plus the number of player configs per palette swap.
+ * The decoded and recolored sheets are kept, every player gets its own texture of them.
+ */
+class PlayerSprites {
+   public:
+    /**
+     * @brief Constructor, the sheets are decoded on first use
+     *
+     * @param config    the game config with the player configs
+     */
+    explicit PlayerSprites(parser::GameConfig* config);
+    PlayerSprites(const PlayerSprites&) = delete;
+    PlayerSprites& operator=(const PlayerSprites&) = delete;
+
+    /// Frees the sheets, the textures belong to the players
+    ~PlayerSprites();
+
+    /// Hue difference of two consecutive palettes in degrees, the golden angle keeps any number
+    /// of palettes apart
+    static constexpr float PALETTE_HUE_STEP = 137.508f;
+
+    /// Returns the number of looks before the palettes are swapped, i.e. of player configs
+    uint32_t getSheetCount() const;
+
+    /**
+     * @brief Creates a player with the given look, which is also its config index
+     *
+     * @param team  the team of the player
+     * @param look  any number, the player config look % getSheetCount() is used
+     * @return the player
+     *
+     * @throws SdlException if the sheet can't be loaded
+     */
+    Player* createPlayer(Team team, uint32_t look);
+
+   private:
+    /// Returns the sheet of a look, decoded and recolored on first use
+    SDL_Surface* getSheet(uint32_t look);
+
+    parser::GameConfig* m_config;
+
+    /// the 32 bit sheets by look, nullptr if not used yet
+    std::vector<SDL_Surface*> m_sheets;
+};
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_CORE_PLAYERSPRITES_HPP
@@ -0,0 +1,154 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT License; see LICENSE file in the root of this
+// project for details.
+
+#include <gsl/gsl>
+#include <parser/BotConfig.hpp>
+#include <parser/GameConfig.hpp>
+#include <parser/ProjectileConfig.hpp>
+#include <parser/WeaponConfig.hpp>
+
+#include "engine/core/Game.hpp"
+#include "engine/core/Level.hpp"
+#include "engine/core/Prefabs.hpp"
+#include "engine/core/SharedTextures.hpp"
+#include "engine/scene/Bot.hpp"
+#include "engine/scene/Gun.hpp"
+#include "engine/scene/Ufo.hpp"
+#include "engine/scene/Zombie.hpp"
+
+namespace ctb {
+namespace engine {
+
+namespace {
+/// Creates a bot of the given class
+template <typename T>
+Bot* createBehaviour(SDL_Texture* texture, int width, int height, int count, Level* level) {
+    return new T(texture, width, height, count, level);
+}
+
+/// A class of bots, its frames are used if the bot config has none
+struct Behaviour {
+    const char* name;
+    Bot* (*create)(SDL_Texture*, int, int, int, Level*);
+    int frameWidth;
+    int frameHeight;
+    int frameCount;
+};
+
+const Behaviour kBehaviours[] = {
+    {"zombie", &createBehaviour<Zombie>, 32, 64, 1},
+    {"ufo", &createBehaviour<Ufo>, 56, 48, 5},
+};
+
+/// Returns the behaviour with the given name or nullptr
+const Behaviour* findBehaviour(const std::string& name) {
+    for (const Behaviour& behaviour : kBehaviours) {
+        if (name == behaviour.name) {
+            return &behaviour;
+        }
+    }
+    return nullptr;
+}
+
+/// Returns the projectile a weapon shoots: the one it names, else "bullet", else the first one
+parser::ProjectileConfig* findProjectile(parser::GameConfig* config,
+                                         parser::WeaponConfig* weapon) {
+    parser::ProjectileConfig* bullet = config->getProjectiles().front();
+    for (parser::ProjectileConfig* projectile : config->getProjectiles()) {
+        if (projectile->getName() == weapon->getProjectile()) {
+            return projectile;
+        }
+        if (projectile->getName() == "bullet") {
+            bullet = projectile;
+        }
+    }
+    return bullet;
+}
+}  // namespace
+
+constexpr PrefabId Prefabs::NONE;
+
+Prefabs::Prefabs(parser::GameConfig* config, SharedTextures& textures) {
+    Expects(config != nullptr);
+
+    ActingKinematics kinematics;
+    kinematics.setId(Game::BOT_ID);
+    kinematics.setCategory(Level::BOT_CAT);
+    kinematics.setMask(Level::GROUND_CAT | Level::PLAYER_CAT | Level::PROJECTILE_CAT);
+    for (parser::BotConfig* bot : config->getBots()) {
+        const Behaviour* behaviour = findBehaviour(bot->getBehaviour());
+        if (behaviour == nullptr || m_botIds.count(bot->getName()) != 0) {
+            continue;
+        }
+        bool framed = bot->getNumFrames() > 0 && bot->getFrameWidth() > 0 &&
+                      bot->getFrameHeight() > 0;
+        m_botIds.emplace(bot->getName(), static_cast<PrefabId>(m_bots.size()));
+        m_bots.push_back({bot->getName(), behaviour->create, textures.get(bot->getFilename()),
+                          framed ? bot->getFrameWidth() : behaviour->frameWidth,
+                          framed ? bot->getFrameHeight() : behaviour->frameHeight,
+                          framed ? bot->getNumFrames() : behaviour->frameCount, kinematics});
+    }
+
+    // a gun can't be built without projectile
+    if (config->getProjectiles().empty()) {
+        return;
+    }
+    for (parser::WeaponConfig* weapon : config->getWeapons()) {
+        if (m_weaponIds.count(weapon->getName()) != 0) {
+            continue;
+        }
+        WeaponPrefab prefab;
+        prefab.name = weapon->getName();
+        prefab.texture = textures.get(weapon->getFilename());
+        SDL_QueryTexture(prefab.texture, nullptr, nullptr, &prefab.width, &prefab.height);
+        prefab.projectileTexture = textures.get(findProjectile(config, weapon)->getFilename());
+        SDL_QueryTexture(prefab.projectileTexture, nullptr, nullptr, &prefab.projectileWidth,
+                         &prefab.projectileHeight);
+        prefab.cooldown = static_cast<int>(weapon->getAttackspeed());
+        prefab.projectileSpeed = static_cast<float>(weapon->getRange());
+        prefab.damage = static_cast<uint32_t>(weapon->getDamage());
+        prefab.hitscan = weapon->isHitscan();
+        m_weaponIds.emplace(prefab.name, static_cast<PrefabId>(m_weapons.size()));
+        m_weapons.push_back(prefab);
+    }
+    if (!m_weapons.empty()) {
+        // levels spawn guns, which were the first weapon before weapons had prefabs
+        m_weaponIds.emplace("gun", 0);
+    }
+}
+
+PrefabId Prefabs::findBot(const std::string& name) const {
+    auto it = m_botIds.find(name);
+    return it != m_botIds.end() ? it->second : NONE;
+}
+
+PrefabId Prefabs::findWeapon(const std::string& name) const {
+    auto it = m_weaponIds.find(name);
+    return it != m_weaponIds.end() ? it->second : NONE;
+}
+
+Bot* Prefabs::createBot(PrefabId id, b2World& world, Vector2dT pos, Level* level) const {
+    const BotPrefab& prefab = getBot(id);
+    Bot* bot = prefab.create(prefab.texture, prefab.frameWidth, prefab.frameHeight,
+                             prefab.frameCount, level);
+    bot->setPrefab(id);
+    ActingKinematics kinematics = prefab.kinematics;
+    bot->setPosition(pos);
+    bot->addToWorld(world, kinematics);
+    return bot;
+}
+
+Gun* Prefabs::createWeapon(PrefabId id) const {
+    const WeaponPrefab& prefab = getWeapon(id);
+    Gun* gun = new Gun(prefab.texture, prefab.width, prefab.height, 1, prefab.projectileTexture,
+                       prefab.projectileHeight, prefab.projectileWidth, 1, prefab.cooldown,
+                       prefab.projectileSpeed, prefab.damage, prefab.hitscan);
+    gun->setPrefab(id);
+    return gun;
+}
+
+}  // namespace engine
+}  // namespace ctb
@@ -0,0 +1,140 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT License; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_CORE_PREFABS_HPP
+#define ENGINE_CORE_PREFABS_HPP
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <Box2D/Box2D.h>
+#include <SDL.h>
+
+#include "engine/physics/ActingKinematics.hpp"
+#include "engine/util/Vector2d.hpp"
+
+namespace ctb {
+namespace parser {
+class GameConfig;
+}  // namespace parser
+
+namespace engine {
+
+class Bot;
+class Gun;
+class Level;
+class SharedTextures;
+
+/// Index of a bot or weapon prefab, bots and weapons are numbered separately
+using PrefabId = uint16_t;
+
+/// Everything needed to create a bot of a type
+struct BotPrefab {
+    /// the name of the bot config, used by the bot spawns of the levels
+    std::string name;
+    /// creates the bot of the behaviour of the type
+    Bot* (*create)(SDL_Texture* texture, int width, int height, int count, Level* level);
+    /// the texture all bots of the type share
+    SDL_Texture* texture;
+    int frameWidth;
+    int frameHeight;
+    int frameCount;
+    /// the kinematics of the body of a bot
+    ActingKinematics kinematics;
+};
+
+/// Everything needed to create a weapon of a type, all weapons that can lie in a level are guns
+struct WeaponPrefab {
+    /// the name of the weapon config, used by the weapon spawns of the levels
+    std::string name;
+    /// the texture all weapons of the type share
+    SDL_Texture* texture;
+    int width;
+    int height;
+    /// the texture all projectiles of the weapons share
+    SDL_Texture* projectileTexture;
+    int projectileWidth;
+    int projectileHeight;
+    int cooldown;
+    float projectileSpeed;
+    uint32_t damage;
+    bool hitscan;
+};
+
+/**
+ * @brief The bot and weapon types of a game, resolved once when the game config is loaded.
+ *
+ * Every bot config becomes a bot prefab with the behaviour it names, and every weapon config
+ * a weapon prefab with its projectile. The textures are loaded when the prefabs are built and
+ * shared by all bots, weapons and projectiles of a type, so creating one neither searches the
+ * config nor loads an image. Levels resolve the names of their spawns to prefab ids once.
+ */
+class Prefabs {
+   public:
+    /// Returned by find if there is no prefab of the name
+    static constexpr PrefabId NONE = 0xFFFF;
+
+    /**
+     * @brief Builds the prefabs of all bot and weapon configs
+     *
+     * @param config    the game config
+     * @param textures  the cache the textures are loaded from, it has to outlive the prefabs
+     *
+     * @throws SdlException if an image can't be loaded
+     */
+    Prefabs(parser::GameConfig* config, SharedTextures& textures);
+    Prefabs(const Prefabs&) = delete;
+    Prefabs& operator=(const Prefabs&) = delete;
+
+    /// Returns the id of the bot prefab with the given name or NONE. Bot configs with an
+    /// unknown behaviour have no prefab.
+    PrefabId findBot(const std::string& name) const;
+
+    /// Returns the id of the weapon prefab with the given name or NONE. "gun" is the first
+    /// weapon if no weapon has that name.
+    PrefabId findWeapon(const std::string& name) const;
+
+    /// Returns the number of bot prefabs, the ids are below it
+    size_t getBotCount() const { return m_bots.size(); }
+
+    /// Returns the bot prefab with the given id
+    const BotPrefab& getBot(PrefabId id) const { return m_bots.at(id); }
+
+    /// Returns the number of weapon prefabs, the ids are below it
+    size_t getWeaponCount() const { return m_weapons.size(); }
+
+    /// Returns the weapon prefab with the given id
+    const WeaponPrefab& getWeapon(PrefabId id) const { return m_weapons.at(id); }
+
+    /**
+     * @brief Creates a bot and adds it to a world
+     *
+     * @param id    the id of the bot prefab
+     * @param world the world of the level
+     * @param pos   the position in pixels
+     * @param level the level the bot belongs to
+     * @return the bot
+     */
+    Bot* createBot(PrefabId id, b2World& world, Vector2dT pos, Level* level) const;
+
+    /// Creates a weapon of the weapon prefab with the given id, it isn't added to a world
+    Gun* createWeapon(PrefabId id) const;
+
+   private:
+    std::vector<BotPrefab> m_bots;
+    std::vector<WeaponPrefab> m_weapons;
+
+    /// the prefab ids by their name
+    std::unordered_map<std::string, PrefabId> m_botIds;
+    std::unordered_map<std::string, PrefabId> m_weaponIds;
+};
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_CORE_PREFABS_HPP
@@ -0,0 +1,121 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#include <algorithm>
+#include <limits>
+
+#include "engine/core/QualityGovernor.hpp"
+
+namespace ctb {
+namespace engine {
+
+namespace {
+/// The quality levels, from the full quality to the lowest one
+const Quality kLevels[] = {
+    {std::numeric_limits<uint32_t>::max(), 1, 1, 0},
+    // the nearest background layers scroll the most and cover the least
+    {3, 1, 1, 0},
+    {1, 2, 1, 0},
+    {1, 2, 2, 32},
+    {1, 4, 4, 8},
+};
+
+/// Number of levels that only change how the game looks
+constexpr uint32_t kRenderLevels = 3;
+
+constexpr auto kLevelCount = static_cast<uint32_t>(sizeof(kLevels) / sizeof(kLevels[0]));
+}  // namespace
+
+constexpr uint32_t QualityGovernor::FRAME_WINDOW;
+constexpr float QualityGovernor::RESTORE_SHARE;
+constexpr uint32_t QualityGovernor::RESTORE_FRAMES;
+constexpr uint32_t QualityGovernor::MAX_RESTORE_BACKOFF;
+
+QualityGovernor::QualityGovernor(float budget, bool gameplay)
+    : m_budget(budget), m_gameplay(gameplay) {
+    m_window.reserve(FRAME_WINDOW);
+}
+
+uint32_t QualityGovernor::getMaxLevel() const {
+    return (m_gameplay ? kLevelCount : kRenderLevels) - 1;
+}
+
+const Quality& QualityGovernor::getQuality() const {
+    return kLevels[m_level];
+}
+
+bool QualityGovernor::addFrame(float millis) {
+    if (!isEnabled()) {
+        return false;
+    }
+    ++m_frames;
+    if (m_window.size() < FRAME_WINDOW) {
+        m_window.push_back(millis);
+    } else {
+        m_window[m_next] = millis;
+    }
+    m_next = (m_next + 1) % FRAME_WINDOW;
+
+    // a restored level that held for a while resets the restore delay
+    if (m_restored && m_frames - m_restoredAt > 2 * FRAME_WINDOW) {
+        m_restored = false;
+        m_backoff = 0;
+    }
+    if (m_window.size() < FRAME_WINDOW) {
+        return false;
+    }
+
+    std::vector<float> sorted = m_window;
+    std::nth_element(sorted.begin(), sorted.begin() + FRAME_WINDOW / 2, sorted.end());
+    float median = sorted[FRAME_WINDOW / 2];
+
+    if (median > m_budget) {
+        m_headroom = 0;
+        if (m_level < getMaxLevel()) {
+            if (m_restored) {
+                m_backoff = std::min(m_backoff + 1, MAX_RESTORE_BACKOFF);
+                m_restored = false;
+            }
+            changeLevel(m_level + 1, median);
+            return true;
+        }
+    } else if (median < m_budget * RESTORE_SHARE) {
+        if (++m_headroom >= RESTORE_FRAMES << m_backoff && m_level > 0) {
+            m_restored = true;
+            m_restoredAt = m_frames;
+            changeLevel(m_level - 1, median);
+            return true;
+        }
+    } else {
+        m_headroom = 0;
+    }
+    return false;
+}
+
+void QualityGovernor::changeLevel(uint32_t level, float millis) {
+    m_decisions.push_back({m_frames, m_level, level, millis});
+    m_level = level;
+    // the frames of the old level say nothing about the new one
+    m_window.clear();
+    m_next = 0;
+    m_headroom = 0;
+}
+
+void QualityGovernor::print(std::ostream& out) const {
+    out << "{\"budget\": " << m_budget << ", \"frames\": " << m_frames
+        << ", \"level\": " << m_level << ", \"maxLevel\": " << getMaxLevel()
+        << ", \"decisions\": [";
+    for (size_t i = 0; i < m_decisions.size(); ++i) {
+        const Decision& decision = m_decisions[i];
+        out << (i > 0 ? ",\n    " : "\n    ") << "{\"frame\": " << decision.frame
+            << ", \"from\": " << decision.from << ", \"to\": " << decision.to
+            << ", \"median\": " << decision.millis << "}";
+    }
+    out << (m_decisions.empty() ? "]}" : "\n  ]}");
+}
+
+}  // namespace engine
+}  // namespace ctb
@@ -0,0 +1,134 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_CORE_QUALITYGOVERNOR_HPP
+#define ENGINE_CORE_QUALITYGOVERNOR_HPP
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace ctb {
+namespace engine {
+
+/// What the game renders and spawns at a quality level
+struct Quality {
+    /// Number of background layers of a level that are rendered, the deepest ones first
+    uint32_t backgroundLayers;
+    /// Every animation step is shown this many times longer
+    uint32_t animationSlowdown;
+    /// The spawn chances of bots and weapons and the bots a horde spawns per tick are divided
+    /// by this
+    uint32_t spawnDivisor;
+    /// Live projectiles per gun, further shots are hitscan; 0 if unlimited
+    uint32_t projectileLimit;
+};
+
+/**
+ * @brief Lowers the quality while the frames take longer than a budget and restores it when
+ *        there is headroom again.
+ *
+ * The governor compares the median of the last FRAME_WINDOW frame times with the budget, so
+ * single hitches like loading the next level are ignored. Every quality level gives up more
+ * than the previous one: first the background layers, then the animation rate, then the
+ * spawn rates and the live projectiles. A level is only restored after RESTORE_FRAMES frames
+ * far below the budget, and a level that has to be lowered again right after its restore waits
+ * twice as long for the next one, so the quality doesn't flap at the edge of the budget.
+ *
+ * The last levels change how the game plays, they are only used if gameplay is allowed.
+ */
+class QualityGovernor {
+   public:
+    /// A change of the quality level
+    struct Decision {
+        /// the number of frames added before the change
+        uint64_t frame;
+        uint32_t from;
+        uint32_t to;
+        /// the median frame time in ms that caused it
+        float millis;
+    };
+
+    /// Number of frames the median frame time is taken of
+    static constexpr uint32_t FRAME_WINDOW = 60;
+
+    /// A level is restored if the median frame time is below this share of the budget...
+    static constexpr float RESTORE_SHARE = 0.7f;
+
+    /// ...for this many frames in a row
+    static constexpr uint32_t RESTORE_FRAMES = 180;
+
+    /// The restore delay doubles at most this many times
+    static constexpr uint32_t MAX_RESTORE_BACKOFF = 4;
+
+    /**
+     * @brief Constructor
+     *
+     * @param budget    the frame time in ms, the governor is disabled if it isn't positive
+     * @param gameplay  whether the levels that change spawns and projectiles may be used
+     */
+    QualityGovernor(float budget, bool gameplay);
+
+    /// Returns if the governor changes the quality at all
+    bool isEnabled() const { return m_budget > 0; }
+
+    /// Returns the frame time budget in ms
+    float getBudget() const { return m_budget; }
+
+    /**
+     * @brief Adds the duration of a frame and changes the quality level if needed
+     *
+     * @param millis    the time the frame took in ms, without waiting for the display
+     * @return if the quality level changed
+     */
+    bool addFrame(float millis);
+
+    /// Returns the current quality level, 0 is the full quality
+    uint32_t getLevel() const { return m_level; }
+
+    /// Returns the lowest quality level the governor may use
+    uint32_t getMaxLevel() const;
+
+    /// Returns the settings of the current quality level
+    const Quality& getQuality() const;
+
+    /// Returns all changes of the quality level, oldest first
+    const std::vector<Decision>& getDecisions() const { return m_decisions; }
+
+    /// Writes the budget, the current level and all decisions as JSON object to out
+    void print(std::ostream& out) const;
+
+   private:
+    /// Changes the level and starts a new window of frames
+    void changeLevel(uint32_t level, float millis);
+
+    float m_budget;
+    bool m_gameplay;
+    uint32_t m_level{0};
+
+    /// the last frame times, a ring of FRAME_WINDOW ones once it is full
+    std::vector<float> m_window;
+    size_t m_next{0};
+
+    uint64_t m_frames{0};
+
+    /// frames in a row with enough headroom to restore a level
+    uint32_t m_headroom{0};
+
+    /// how often the restore delay was doubled
+    uint32_t m_backoff{0};
+
+    /// the frame of the last restore, if it was the last decision
+    uint64_t m_restoredAt{0};
+    bool m_restored{false};
+
+    std::vector<Decision> m_decisions;
+};
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_CORE_QUALITYGOVERNOR_HPP
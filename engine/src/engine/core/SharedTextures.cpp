@@ -0,0 +1,30 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#include "engine/EngineContext.hpp"
+#include "engine/core/SharedTextures.hpp"
+
+namespace ctb {
+namespace engine {
+
+SDL_Texture* SharedTextures::get(const std::string& path) {
+    auto it = m_textures.find(path);
+    if (it != m_textures.end()) {
+        return it->second;
+    }
+    SDL_Texture* texture = EngineContext::current().loadTexture(path);
+    m_textures.emplace(path, texture);
+    return texture;
+}
+
+SharedTextures::~SharedTextures() {
+    for (auto& texture : m_textures) {
+        SDL_DestroyTexture(texture.second);
+    }
+}
+
+}  // namespace engine
+}  // namespace ctb
@@ -0,0 +1,55 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_CORE_SHAREDTEXTURES_HPP
+#define ENGINE_CORE_SHAREDTEXTURES_HPP
+
+#include <map>
+#include <string>
+
+#include <SDL.h>
+
+namespace ctb {
+namespace engine {
+
+/**
+ * @brief The textures of renderables that exist many times with the same image, e.g. the bots
+ *        of a type or the tilesheet of a level and its flipped twin. Every image is loaded once,
+ *        and its texture belongs to this cache, so the renderables using it must not destroy it.
+ */
+class SharedTextures {
+   public:
+    SharedTextures() = default;
+    SharedTextures(const SharedTextures&) = delete;
+    SharedTextures& operator=(const SharedTextures&) = delete;
+
+    /// Destroys all textures, their renderables have to be deleted already
+    ~SharedTextures();
+
+    /**
+     * @brief Returns the texture of an image, loaded with the current context on first use
+     *
+     * @param path  path of the image
+     * @return the texture, owned by this cache
+     *
+     * @throws SdlException if the image can't be loaded
+     */
+    SDL_Texture* get(const std::string& path);
+
+    /// Returns whether the image of the given path is loaded already
+    bool contains(const std::string& path) const { return m_textures.count(path) != 0; }
+
+    /// Returns the number of loaded textures
+    size_t size() const { return m_textures.size(); }
+
+   private:
+    std::map<std::string, SDL_Texture*> m_textures;
+};
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_CORE_SHAREDTEXTURES_HPP
@@ -0,0 +1,157 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT License; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_CORE_SLOTMAP_HPP
+#define ENGINE_CORE_SLOTMAP_HPP
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace ctb {
+namespace engine {
+
+/**
+ * @brief A weak reference to an object stored in a SlotMap<T>.
+ *
+ * The generation of a slot is increased whenever its object is removed, so a handle to a
+ * removed object never resolves to the object that reuses the slot later.
+ */
+template <class T>
+struct Handle {
+    /// Index of the invalid handle
+    static constexpr uint32_t INVALID = std::numeric_limits<uint32_t>::max();
+
+    uint32_t index{INVALID};
+    uint32_t generation{0};
+
+    /// Returns if the handle was ever assigned, it may be stale nevertheless
+    explicit operator bool() const { return index != INVALID; }
+
+    bool operator==(const Handle& other) const {
+        return index == other.index && generation == other.generation;
+    }
+
+    bool operator!=(const Handle& other) const { return !(*this == other); }
+};
+
+template <class T>
+constexpr uint32_t Handle<T>::INVALID;
+
+/**
+ * @brief Stores pointers to objects and hands out generational handles to them.
+ *
+ * The objects are kept in a dense array for iteration, the handles point into a slot array
+ * which maps them to the dense index. Insertion, removal and lookup are O(1); removing moves
+ * the last object into the gap, so the order of the objects is not stable. Freed slots are
+ * reused by later insertions. The map doesn't own the objects.
+ */
+template <class T>
+class SlotMap {
+   public:
+    /// Stores the object and returns its handle
+    Handle<T> insert(T* object) {
+        uint32_t index;
+        if (m_free.empty()) {
+            index = static_cast<uint32_t>(m_slots.size());
+            m_slots.push_back({0, 0});
+        } else {
+            index = m_free.back();
+            m_free.pop_back();
+        }
+        Slot& slot = m_slots[index];
+        slot.dense = static_cast<uint32_t>(m_objects.size());
+        m_objects.push_back(object);
+        m_denseSlots.push_back(index);
+        return {index, slot.generation};
+    }
+
+    /// Returns if the handle refers to a stored object
+    bool contains(Handle<T> handle) const {
+        // freeing a slot increases its generation, so a matching generation means it is in use
+        return handle.index < m_slots.size() &&
+               m_slots[handle.index].generation == handle.generation;
+    }
+
+    /// Returns the object of the handle or nullptr if it was removed
+    T* get(Handle<T> handle) const {
+        return contains(handle) ? m_objects[m_slots[handle.index].dense] : nullptr;
+    }
+
+    /**
+     * @brief Removes the object of the handle, its slot is reused by a later insertion.
+     *
+     * @return false if the handle is stale, e.g. because the object was removed before
+     */
+    bool erase(Handle<T> handle) {
+        if (!contains(handle)) {
+            return false;
+        }
+        Slot& slot = m_slots[handle.index];
+        uint32_t last = static_cast<uint32_t>(m_objects.size()) - 1;
+        if (slot.dense != last) {
+            m_objects[slot.dense] = m_objects[last];
+            m_denseSlots[slot.dense] = m_denseSlots[last];
+            m_slots[m_denseSlots[slot.dense]].dense = slot.dense;
+        }
+        m_objects.pop_back();
+        m_denseSlots.pop_back();
+        release(handle.index);
+        return true;
+    }
+
+    /// Removes all objects, all handles become stale
+    void clear() {
+        for (uint32_t index : m_denseSlots) {
+            release(index);
+        }
+        m_objects.clear();
+        m_denseSlots.clear();
+    }
+
+    /// Returns the stored objects in no particular order
+    const std::vector<T*>& objects() const { return m_objects; }
+
+    /// Returns the number of stored objects
+    size_t size() const { return m_objects.size(); }
+
+    /// Returns if no object is stored
+    bool empty() const { return m_objects.empty(); }
+
+    /// Returns the number of slots, i.e. the highest number of objects stored at once
+    size_t capacity() const { return m_slots.size(); }
+
+   private:
+    /// Dense index of an unused slot
+    static constexpr uint32_t FREE = std::numeric_limits<uint32_t>::max();
+
+    struct Slot {
+        uint32_t dense;
+        uint32_t generation;
+    };
+
+    /// Invalidates the handles of the slot and makes it available again
+    void release(uint32_t index) {
+        m_slots[index].dense = FREE;
+        ++m_slots[index].generation;
+        m_free.push_back(index);
+    }
+
+    std::vector<Slot> m_slots;
+    /// unused slots
+    std::vector<uint32_t> m_free;
+    std::vector<T*> m_objects;
+    /// slot of every object in m_objects
+    std::vector<uint32_t> m_denseSlots;
+};
+
+template <class T>
+constexpr uint32_t SlotMap<T>::FREE;
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_CORE_SLOTMAP_HPP
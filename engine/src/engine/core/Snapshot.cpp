@@ -0,0 +1,72 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT License; see LICENSE file in the root of this
+// project for details.
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "engine/core/Snapshot.hpp"
+
+namespace ctb {
+namespace engine {
+
+void SnapshotWriter::writePlayer(const Player* player) {
+    auto it = std::find(m_players.begin(), m_players.end(), player);
+    writeI32(it == m_players.end() ? -1 : static_cast<int32_t>(it - m_players.begin()));
+}
+
+void SnapshotWriter::writeBody(const b2Body* body) {
+    writeBool(body != nullptr);
+    if (!body) {
+        return;
+    }
+    const b2Transform& transform = body->GetTransform();
+    writeFloat(transform.p.x);
+    writeFloat(transform.p.y);
+    writeFloat(body->GetAngle());
+    writeFloat(body->GetLinearVelocity().x);
+    writeFloat(body->GetLinearVelocity().y);
+    writeFloat(body->GetAngularVelocity());
+    writeBool(body->IsAwake());
+    m_bodies.push_back(body);
+}
+
+Player* SnapshotReader::readPlayer() {
+    int32_t index = readI32();
+    if (index < 0) {
+        return nullptr;
+    }
+    if (static_cast<size_t>(index) >= m_players.size()) {
+        throw std::runtime_error("Snapshot refers to an unknown player");
+    }
+    return m_players[static_cast<size_t>(index)];
+}
+
+bool SnapshotReader::readBody(b2Body* body) {
+    if (!readBool()) {
+        return false;
+    }
+    b2Vec2 position;
+    position.x = readFloat();
+    position.y = readFloat();
+    float32 angle = readFloat();
+    b2Vec2 velocity;
+    velocity.x = readFloat();
+    velocity.y = readFloat();
+    float32 angularVelocity = readFloat();
+    bool awake = readBool();
+
+    if (body) {
+        body->SetTransform(position, angle);
+        body->SetLinearVelocity(velocity);
+        body->SetAngularVelocity(angularVelocity);
+        body->SetAwake(awake);
+        m_bodies.push_back(body);
+    }
+    return true;
+}
+
+}  // namespace engine
+}  // namespace ctb
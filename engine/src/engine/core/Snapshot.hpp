@@ -0,0 +1,107 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT License; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_CORE_SNAPSHOT_HPP
+#define ENGINE_CORE_SNAPSHOT_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include <Box2D/Box2D.h>
+
+#include "engine/util/ByteStream.hpp"
+
+namespace ctb {
+namespace engine {
+
+class Player;
+
+/// First bytes of every snapshot ("CTBS")
+constexpr uint32_t SNAPSHOT_MAGIC = 0x53425443;
+
+/// Format version of the snapshots, increased on every change of the layout
+constexpr uint16_t SNAPSHOT_VERSION = 4;
+
+/**
+ * @brief Writes the dynamic state of a game into a byte buffer, see Game::saveSnapshot().
+ *
+ * Times are stored relative to the game time of the snapshot, so the timers keep running
+ * correctly if the snapshot is restored at a different time. Players are stored by their
+ * index in the game.
+ */
+class SnapshotWriter : public ByteWriter {
+   public:
+    /**
+     * @brief Constructor
+     *
+     * @param buffer    the buffer to append to
+     * @param now       the game time of the snapshot
+     * @param players   all players of the game
+     */
+    SnapshotWriter(std::vector<uint8_t>& buffer, uint32_t now, const std::vector<Player*>& players)
+        : ByteWriter(buffer), m_now(now), m_players(players) {}
+
+    /// Writes a point in game time
+    void writeTime(uint32_t time) { writeI32(static_cast<int32_t>(time - m_now)); }
+
+    /// Writes a player of the game or nullptr
+    void writePlayer(const Player* player);
+
+    /// Writes the transform, the velocities and the awake flag of the body, it may be null
+    void writeBody(const b2Body* body);
+
+    /// Returns the written bodies in their order, see LevelWorld::rebuild()
+    const std::vector<const b2Body*>& getBodies() const { return m_bodies; }
+
+   private:
+    uint32_t m_now;
+    const std::vector<Player*>& m_players;
+    std::vector<const b2Body*> m_bodies;
+};
+
+/// Reads the state written by a SnapshotWriter, see Game::restoreSnapshot()
+class SnapshotReader : public ByteReader {
+   public:
+    /**
+     * @brief Constructor
+     *
+     * @param buffer    the snapshot, it has to outlive the reader
+     * @param players   all players of the game, in the same order as at the snapshot
+     */
+    SnapshotReader(const std::vector<uint8_t>& buffer, const std::vector<Player*>& players)
+        : ByteReader(buffer), m_players(players) {}
+
+    /// Sets the game time the times are restored relative to
+    void setNow(uint32_t now) { m_now = now; }
+
+    /// Reads a point in game time
+    uint32_t readTime() { return m_now + static_cast<uint32_t>(readI32()); }
+
+    /// Reads a player of the game or nullptr
+    Player* readPlayer();
+
+    /**
+     * @brief Reads the state written by writeBody() into the body
+     *
+     * @param body  the body to restore, if it is null the state is skipped
+     *
+     * @return if the snapshot contained a body
+     */
+    bool readBody(b2Body* body);
+
+    /// Returns the restored bodies in the order they were written, see LevelWorld::rebuild()
+    const std::vector<const b2Body*>& getBodies() const { return m_bodies; }
+
+   private:
+    uint32_t m_now{0};
+    const std::vector<Player*>& m_players;
+    std::vector<const b2Body*> m_bodies;
+};
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_CORE_SNAPSHOT_HPP
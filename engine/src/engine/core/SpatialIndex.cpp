@@ -0,0 +1,193 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT License; see LICENSE file in the root of this
+// project for details.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+#include <gsl/gsl>
+
+#include "engine/core/Level.hpp"
+#include "engine/core/SpatialIndex.hpp"
+#include "engine/graphics/PhysicalRenderable.hpp"
+#include "engine/scene/Player.hpp"
+
+namespace ctb {
+namespace engine {
+
+SpatialIndex::SpatialIndex(float32 width, float32 height, float32 cellSize)
+    : m_cellSize(cellSize),
+      m_columns(std::max(1, static_cast<int>(std::ceil(width / cellSize)))),
+      m_rows(std::max(1, static_cast<int>(std::ceil(height / cellSize)))),
+      m_cells(static_cast<size_t>(m_columns * m_rows)) {
+    Expects(cellSize > 0.0f);
+}
+
+void SpatialIndex::clear() {
+    for (size_t index : m_usedCells) {
+        m_cells[index].clear();
+    }
+    m_usedCells.clear();
+}
+
+int SpatialIndex::cellX(float32 x) const {
+    return std::min(std::max(static_cast<int>(std::floor(x / m_cellSize)), 0), m_columns - 1);
+}
+
+int SpatialIndex::cellY(float32 y) const {
+    return std::min(std::max(static_cast<int>(std::floor(y / m_cellSize)), 0), m_rows - 1);
+}
+
+void SpatialIndex::insert(PhysicalRenderable* object, uint16 category) {
+    Expects(object != nullptr);
+    b2Vec2 pos = object->worldPosition();
+    size_t index = static_cast<size_t>(cellY(pos.y) * m_columns + cellX(pos.x));
+    if (m_cells[index].empty()) {
+        m_usedCells.push_back(index);
+    }
+    m_cells[index].push_back({object, category, pos});
+}
+
+PhysicalRenderable* SpatialIndex::nearest(const b2Vec2& pos,
+                                          uint16 mask,
+                                          float32* distanceSquared) const {
+    const int cx = cellX(pos.x);
+    const int cy = cellY(pos.y);
+    const int maxRing = std::max(m_columns, m_rows);
+
+    PhysicalRenderable* result = nullptr;
+    float32 best = std::numeric_limits<float32>::infinity();
+
+    auto visit = [&](int x, int y) {
+        if (x < 0 || y < 0 || x >= m_columns || y >= m_rows) {
+            return;
+        }
+        for (const Entry& entry : cell(x, y)) {
+            if ((entry.category & mask) == 0) {
+                continue;
+            }
+            float32 current = (entry.position - pos).LengthSquared();
+            if (current < best) {
+                best = current;
+                result = entry.object;
+            }
+        }
+    };
+
+    for (int ring = 0; ring <= maxRing; ++ring) {
+        // everything in this ring is at least (ring - 1) cells away
+        if (result) {
+            float32 bound = static_cast<float32>(ring - 1) * m_cellSize;
+            if (bound > 0.0f && bound * bound > best) {
+                break;
+            }
+        }
+        for (int y = cy - ring; y <= cy + ring; ++y) {
+            if (y == cy - ring || y == cy + ring) {
+                for (int x = cx - ring; x <= cx + ring; ++x) {
+                    visit(x, y);
+                }
+            } else {
+                visit(cx - ring, y);
+                visit(cx + ring, y);
+            }
+        }
+    }
+
+    if (distanceSquared) {
+        *distanceSquared = best;
+    }
+    return result;
+}
+
+Player* SpatialIndex::nearestPlayer(const b2Vec2& pos) const {
+    return static_cast<Player*>(nearest(pos, Level::PLAYER_CAT));
+}
+
+void SpatialIndex::queryRadius(const b2Vec2& pos,
+                               float32 radius,
+                               uint16 mask,
+                               std::vector<PhysicalRenderable*>& out) const {
+    const float32 radiusSquared = radius * radius;
+    const int minX = cellX(pos.x - radius);
+    const int maxX = cellX(pos.x + radius);
+    const int minY = cellY(pos.y - radius);
+    const int maxY = cellY(pos.y + radius);
+
+    for (int y = minY; y <= maxY; ++y) {
+        for (int x = minX; x <= maxX; ++x) {
+            for (const Entry& entry : cell(x, y)) {
+                if ((entry.category & mask) != 0 &&
+                    (entry.position - pos).LengthSquared() <= radiusSquared) {
+                    out.push_back(entry.object);
+                }
+            }
+        }
+    }
+}
+
+void SpatialIndex::setSpawns(const std::vector<std::vector<uint32_t>>& spawns, bool mirrored) {
+    m_spawns.clear();
+    for (size_t x = 0; x < spawns.size(); ++x) {
+        const std::vector<uint32_t>& ys = spawns[mirrored ? spawns.size() - x - 1 : x];
+        if (ys.empty()) {
+            continue;
+        }
+        SpawnColumn column{static_cast<int>(x), {}};
+        for (uint32_t y : ys) {
+            column.ys.push_back(static_cast<int>(y));
+        }
+        m_spawns.push_back(std::move(column));
+    }
+}
+
+bool SpatialIndex::nextSpawn(int fromX,
+                             int step,
+                             int stopX,
+                             int minX,
+                             int maxX,
+                             int y,
+                             int& outX,
+                             int& outY) const {
+    Expects(step == 1 || step == -1);
+    if (fromX == stopX || fromX < minX || fromX >= maxX) {
+        return false;
+    }
+
+    auto byX = [](const SpawnColumn& column, int x) { return column.x < x; };
+    const SpawnColumn* found = nullptr;
+    if (step > 0) {
+        int limit = (stopX > fromX) ? std::min(stopX, maxX) : maxX;
+        auto it = std::lower_bound(m_spawns.begin(), m_spawns.end(), fromX, byX);
+        if (it != m_spawns.end() && it->x < limit) {
+            found = &*it;
+        }
+    } else {
+        int limit = (stopX < fromX) ? std::max(stopX, minX - 1) : minX - 1;
+        auto it = std::lower_bound(m_spawns.begin(), m_spawns.end(), fromX + 1, byX);
+        if (it != m_spawns.begin() && (it - 1)->x > limit) {
+            found = &*(it - 1);
+        }
+    }
+    if (!found) {
+        return false;
+    }
+
+    int min = 0;
+    for (size_t i = 0; i < found->ys.size(); ++i) {
+        int current = std::abs(found->ys[i] - y);
+        if (i == 0 || current < min) {
+            min = current;
+            outY = found->ys[i];
+        }
+    }
+    outX = found->x;
+    return true;
+}
+
+}  // namespace engine
+}  // namespace ctb
@@ -0,0 +1,154 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT License; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_CORE_SPATIALINDEX_HPP
+#define ENGINE_CORE_SPATIALINDEX_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include <Box2D/Box2D.h>
+
+namespace ctb {
+namespace engine {
+
+class PhysicalRenderable;
+class Player;
+
+/**
+ * @brief A uniform grid over a level's b2World used for proximity queries.
+ *
+ * Dynamic entities (players, bots) are re-inserted every frame by the owning level, spawn
+ * points are static and registered once. All distance comparisons are done on squared
+ * distances.
+ */
+class SpatialIndex {
+   public:
+    /// Edge length of a grid cell in world coordinates (8m = 160px)
+    static constexpr float32 DEFAULT_CELL_SIZE = 8.0f;
+
+    /**
+     * @brief Constructor
+     *
+     * @param width     width of the indexed area in world coordinates
+     * @param height    height of the indexed area in world coordinates
+     * @param cellSize  edge length of one grid cell in world coordinates
+     */
+    SpatialIndex(float32 width, float32 height, float32 cellSize = DEFAULT_CELL_SIZE);
+
+    /// Removes all dynamic entities, spawns are kept
+    void clear();
+
+    /**
+     * @brief Inserts an object at its current world position
+     *
+     * @param object    the object to insert
+     * @param category  the collision category of the object (e.g. Level::PLAYER_CAT)
+     */
+    void insert(PhysicalRenderable* object, uint16 category);
+
+    /**
+     * @brief Returns the object closest to pos matching the category mask
+     *
+     * @param pos               the position to search from
+     * @param mask              bitmask of the categories to consider
+     * @param distanceSquared   if not null, receives the squared distance to the result
+     * @return the closest object or nullptr if there is none
+     */
+    PhysicalRenderable* nearest(const b2Vec2& pos,
+                                uint16 mask,
+                                float32* distanceSquared = nullptr) const;
+
+    /// Returns the player closest to pos or nullptr if there is none
+    Player* nearestPlayer(const b2Vec2& pos) const;
+
+    /**
+     * @brief Collects all objects within radius around pos matching the category mask
+     *
+     * @param pos       the center of the search
+     * @param radius    the search radius in world coordinates
+     * @param mask      bitmask of the categories to consider
+     * @param out       receives the found objects (it is not cleared beforehand)
+     */
+    void queryRadius(const b2Vec2& pos,
+                     float32 radius,
+                     uint16 mask,
+                     std::vector<PhysicalRenderable*>& out) const;
+
+    /**
+     * @brief Registers the player spawn points of a level
+     *
+     * @param spawns     the y tile coordinates of all spawns, indexed by their x tile coordinate
+     * @param mirrored  whether the level is flipped, i.e. the spawns are indexed from the right
+     */
+    void setSpawns(const std::vector<std::vector<uint32_t>>& spawns, bool mirrored = false);
+
+    /**
+     * @brief Finds the first spawn column when walking from fromX in direction step.
+     *
+     * The walk stops before stopX and never leaves [minX, maxX). Within the found column the
+     * spawn with the smallest vertical distance to y is chosen.
+     *
+     * @param fromX     the tile column to start at
+     * @param step      1 to walk right, -1 to walk left
+     * @param stopX     the (exclusive) tile column to stop at
+     * @param minX      the smallest allowed tile column
+     * @param maxX      the (exclusive) largest allowed tile column
+     * @param y         the tile row to compare the spawns to
+     * @param outX      receives the x tile coordinate of the spawn
+     * @param outY      receives the y tile coordinate of the spawn
+     * @return true if a spawn was found
+     */
+    bool nextSpawn(int fromX,
+                   int step,
+                   int stopX,
+                   int minX,
+                   int maxX,
+                   int y,
+                   int& outX,
+                   int& outY) const;
+
+   private:
+    /// An entry of the grid
+    struct Entry {
+        PhysicalRenderable* object;
+        uint16 category;
+        b2Vec2 position;
+    };
+
+    /// A column containing at least one spawn
+    struct SpawnColumn {
+        int x;
+        std::vector<int> ys;
+    };
+
+    /// Returns the (clamped) cell coordinate of the given world coordinate
+    int cellX(float32 x) const;
+    int cellY(float32 y) const;
+
+    /// Returns the cell at the given cell coordinates
+    const std::vector<Entry>& cell(int x, int y) const {
+        return m_cells[static_cast<size_t>(y * m_columns + x)];
+    }
+
+    float32 m_cellSize;
+    int m_columns;
+    int m_rows;
+
+    /// The grid cells, row major
+    std::vector<std::vector<Entry>> m_cells;
+
+    /// The cells that are not empty, used for a cheap clear()
+    std::vector<size_t> m_usedCells;
+
+    /// All columns containing spawns, sorted by x
+    std::vector<SpawnColumn> m_spawns;
+};
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_CORE_SPATIALINDEX_HPP
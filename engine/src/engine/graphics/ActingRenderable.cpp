@@ -6,6 +6,7 @@
 
 #include "engine/graphics/ActingRenderable.hpp"
 #include "engine/core/Level.hpp"
+#include "engine/core/Snapshot.hpp"
 #include "engine/physics/ActingKinematics.hpp"
 
 namespace ctb {
@@ -47,6 +48,18 @@ void ActingRenderable::resetOnGround() {
     m_ground_counter = 0;
 }
 
+void ActingRenderable::saveState(SnapshotWriter& out) const {
+    PhysicalRenderable::saveState(out);
+    out.writeBool(m_moveright);
+    out.writeI32(m_ground_counter);
+}
+
+void ActingRenderable::restoreState(SnapshotReader& in) {
+    PhysicalRenderable::restoreState(in);
+    m_moveright = in.readBool();
+    m_ground_counter = in.readI32();
+}
+
 void ActingRenderable::jump() {
     if (m_ground_counter) {
         m_body->ApplyLinearImpulse(b2Vec2(0, -1 * m_impulse * m_body->GetMass()),
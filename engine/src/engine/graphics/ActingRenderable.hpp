@@ -72,6 +72,18 @@ class ActingRenderable : public PhysicalRenderable {
      */
     virtual void jump();
 
+    /// Returns if the object looks to the right
+    bool facesRight() const { return m_moveright; }
+
+    /// Turns the object without moving it
+    void setFacesRight(bool right) { m_moveright = right; }
+
+    /// Writes the body, the direction and the ground contacts to the snapshot
+    void saveState(SnapshotWriter& out) const override;
+
+    /// Restores the state written by saveState
+    void restoreState(SnapshotReader& in) override;
+
     /**
      * @brief let this object move to the right
      */
@@ -8,16 +8,25 @@
 #include <SDL_image.h>
 #include <iostream>
 
-#include "engine/Window.hpp"
+#include "engine/Engine.hpp"
+#include "engine/EngineContext.hpp"
 #include "engine/graphics/Background.hpp"
 
 namespace ctb {
 namespace engine {
 
-Background::Background(parser::BackgroundConfig& backgroundConf, int levelWidth, int levelHeight)
-    : TextureBasedRenderable(Window::getWindow().loadTexture(backgroundConf.getImageFilename())),
+Background::Background(const parser::BackgroundConfig& backgroundConf,
+                       SDL_Texture* texture,
+                       int levelWidth,
+                       int levelHeight,
+                       uint32_t depth)
+    : TextureBasedRenderable(texture),
       m_levelWidth(levelWidth),
-      m_levelHeight(levelHeight) {
+      m_levelHeight(levelHeight),
+      m_depth(depth) {
+    // the image is shared by all levels that use it
+    m_ownsTexture = false;
+
     // calculate scroll speed
     m_scrollSpeed = static_cast<float>(backgroundConf.getScrollSpeed()) / 100.0F;
 
@@ -31,18 +40,24 @@ Background::Background(parser::BackgroundConfig& backgroundConf, int levelWidth,
 }
 
 void Background::render() {
+    if (m_depth >= EngineContext::current().getEngine().getQuality().backgroundLayers) {
+        return;
+    }
+
     // repeat image to the end of the level
     for (int startX = 0; startX < m_levelWidth; startX += m_targetRect.w) {
         // calculate x and y
         m_targetRect.x =
             startX -
-            static_cast<int>(static_cast<float>(m_offset.x - (Window::getWindow().w() / 2)) *
-                             m_scrollSpeed);
+            static_cast<int>(
+                static_cast<float>(m_offset.x - (EngineContext::current().getWidth() / 2)) *
+                m_scrollSpeed);
         m_targetRect.y =
-            0 - static_cast<int>(static_cast<float>(m_offset.y - (Window::getWindow().h() / 2)) *
-                                 m_scrollSpeed);
+            0 - static_cast<int>(
+                    static_cast<float>(m_offset.y - (EngineContext::current().getHeight() / 2)) *
+                    m_scrollSpeed);
 
-        SDL_RenderCopy(Window::getWindow().renderer(), m_texture, nullptr, &m_targetRect);
+        SDL_RenderCopy(EngineContext::current().getRenderer(), m_texture, nullptr, &m_targetRect);
     }
 }
 
@@ -7,6 +7,8 @@
 #ifndef ENGINE_GRAPHIC_BACKGROUND_HPP
 #define ENGINE_GRAPHIC_BACKGROUND_HPP
 
+#include <cstdint>
+
 #include <parser/BackgroundConfig.hpp>
 
 #include "engine/graphics/TextureBasedRenderable.hpp"
@@ -20,12 +22,17 @@ class Background : public TextureBasedRenderable {
     /// \brief creates new background layer
     ///
     /// \param backgroundConf config of background
+    /// \param texture texture of the image of backgroundConf, it isn't destroyed with the layer
     /// \param levelWidth width of level in pixels
     /// \param levelHeight height of level in pixels
-    /// \throws std::invalid_argument if image of backgroundConf is invalid
-    Background(parser::BackgroundConfig& backgroundConf, int levelWidth, int levelHeight);
-
-    /// \brief Renders the background
+    /// \param depth index of the layer among the backgrounds of the level, the deepest is 0
+    Background(const parser::BackgroundConfig& backgroundConf,
+               SDL_Texture* texture,
+               int levelWidth,
+               int levelHeight,
+               uint32_t depth);
+
+    /// \brief Renders the background, unless the quality has fewer background layers
     void render() override;
 
     /// \brief Destructor
@@ -40,6 +47,9 @@ class Background : public TextureBasedRenderable {
 
     /// height of level in pixels
     int m_levelHeight;
+
+    /// index of the layer among the backgrounds of the level
+    uint32_t m_depth;
 };
 
 }  // namespace engine
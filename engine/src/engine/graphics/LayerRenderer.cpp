@@ -30,6 +30,19 @@ void LayerRenderer::addRenderable(TextureBasedRenderable* renderable,
     m_renderables.insert(std::make_tuple(renderable, layerId, freeRenderable));
 }
 
+void LayerRenderer::removeRenderable(TextureBasedRenderable* renderable) {
+    for (auto it = m_renderables.begin(); it != m_renderables.end();) {
+        if (std::get<TextureBasedRenderable*>(*it) == renderable) {
+            if (std::get<bool>(*it)) {
+                delete renderable;
+            }
+            it = m_renderables.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
 void LayerRenderer::render() {
     if (!m_camera) {
         throw std::runtime_error("No camera defined in LayerManager!");
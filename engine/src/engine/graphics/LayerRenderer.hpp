@@ -52,6 +52,11 @@ class LayerRenderer {
     /// \param freeTexture If true, we take ownership of renderable
     void addRenderable(TextureBasedRenderable* renderable, int layerId, bool freeRenderable);
 
+    /// \brief Removes a renderable from all layers. Owned renderables are freed.
+    ///
+    /// \param renderable Layer/Texture to remove
+    void removeRenderable(TextureBasedRenderable* renderable);
+
     /// Renders each layer starting with layer id 0.
     void render();
 
@@ -4,9 +4,13 @@
 // This file is licensed under the MIT license; see LICENSE file in the root of this
 // project for details.
 
+#include <algorithm>
+
+#include "engine/Engine.hpp"
+#include "engine/EngineContext.hpp"
 #include "engine/graphics/PhysicalRenderable.hpp"
-#include "engine/Window.hpp"
 #include "engine/core/Game.hpp"
+#include "engine/core/Snapshot.hpp"
 #include "engine/util/Vector2d.hpp"
 
 namespace ctb {
@@ -54,7 +58,7 @@ PhysicalRenderable::~PhysicalRenderable() {
 
 void PhysicalRenderable::nextAnimation() {
     Uint32 ticks = SDL_GetTicks();
-    if (m_animationDuration < (ticks - m_lastTick)) {
+    if (animationDuration() < (ticks - m_lastTick)) {
         // Set next animation step
         m_currentAnimationStep++;
         if (m_currentAnimationStep >= m_animationCount) {
@@ -70,10 +74,21 @@ void PhysicalRenderable::reset() {
     m_body->SetLinearVelocity(b2Vec2(0, 0));
 }
 
+void PhysicalRenderable::showAnimationStep(int step) {
+    m_currentAnimationStep = step;
+    m_sourceRect.x = m_currentAnimationStep * m_animationWidth;
+    m_lastTick = SDL_GetTicks();
+}
+
 void PhysicalRenderable::setFPS(int frames) {
     m_animationDuration = static_cast<Uint32>(1000.0 / static_cast<double>(frames));
 }
 
+Uint32 PhysicalRenderable::animationDuration() const {
+    const Quality& quality = EngineContext::current().getEngine().getQuality();
+    return m_animationDuration * quality.animationSlowdown;
+}
+
 void PhysicalRenderable::setWorldPosition(const b2Vec2& position) {
     m_worldPosition = position;
     m_body->SetTransform(position, 0);
@@ -84,6 +99,54 @@ b2Vec2 PhysicalRenderable::worldPosition() const {
     return m_worldPosition;
 }
 
+void PhysicalRenderable::saveState(SnapshotWriter& out) const {
+    out.writeBody(m_body);
+}
+
+void PhysicalRenderable::restoreState(SnapshotReader& in) {
+    if (in.readBody(m_body) && m_body) {
+        syncTransform(m_body->GetPosition());
+    }
+}
+
+void PhysicalRenderable::replaceBody(b2Body* body, b2Body* copy) {
+    for (auto& pair : m_representations) {
+        if (pair.second == body) {
+            pair.first = copy ? copy->GetWorld() : nullptr;
+            pair.second = copy;
+        }
+    }
+    m_representations.erase(std::remove_if(m_representations.begin(), m_representations.end(),
+                                           [](const std::pair<b2World*, b2Body*>& pair) {
+                                               return pair.second == nullptr;
+                                           }),
+                            m_representations.end());
+    if (m_body != body) {
+        return;
+    }
+    m_body = copy;
+
+    // the fixture and the joint are found by their position in the body's lists
+    b2Fixture* fixture = copy ? copy->GetFixtureList() : nullptr;
+    for (b2Fixture* old = body->GetFixtureList(); fixture && old != m_fixture;
+         old = old->GetNext()) {
+        fixture = fixture->GetNext();
+    }
+    m_fixture = m_fixture ? fixture : nullptr;
+
+    if (m_joint) {
+        // the joints are rebuilt in a different order, they are found by the connected object
+        b2Body* other = m_joint->GetBodyA() == body ? m_joint->GetBodyB() : m_joint->GetBodyA();
+        m_joint = nullptr;
+        for (b2JointEdge* edge = copy ? copy->GetJointList() : nullptr; edge;
+             edge = edge->next) {
+            if (edge->other->GetUserData() == other->GetUserData()) {
+                m_joint = edge->joint;
+            }
+        }
+    }
+}
+
 void PhysicalRenderable::setPosition(const Vector2dT& vector) {
     TextureBasedRenderable::setPosition(vector);
     computeWorldCoordinates();
@@ -127,8 +190,8 @@ void PhysicalRenderable::render() {
         animationRect.w = m_targetRect.w;
         animationRect.h = m_targetRect.h;
 
-        SDL_RenderCopyEx(Window::getWindow().renderer(), m_texture, &m_sourceRect, &animationRect,
-                         m_flip_angle, nullptr, m_flip);
+        SDL_RenderCopyEx(EngineContext::current().getRenderer(), m_texture, &m_sourceRect,
+                         &animationRect, m_flip_angle, nullptr, m_flip);
     }
 }
 
@@ -190,6 +253,21 @@ void PhysicalRenderable::addToWorld(b2World& world, Kinematics& kinematics) {
     m_representations.emplace_back(&world, m_body);
 }
 
+void PhysicalRenderable::removeFromWorld(b2World& world) {
+    auto it = std::find_if(m_representations.begin(), m_representations.end(),
+                           [&world](const std::pair<b2World*, b2Body*>& pair) {
+                               return pair.first == &world;
+                           });
+    if (it == m_representations.end()) {
+        return;
+    }
+    if (m_body == it->second) {
+        m_body = nullptr;
+    }
+    world.DestroyBody(it->second);
+    m_representations.erase(it);
+}
+
 void PhysicalRenderable::computeScreenCoordinates() {
     // Round world coordinates to nearest int
     m_targetRect.x = convertToScreenCoordinate(m_worldPosition.x) - m_animationWidth / 2;
@@ -19,6 +19,8 @@ namespace ctb {
 namespace engine {
 
 class IWindowWithEngine;
+class SnapshotReader;
+class SnapshotWriter;
 
 /**
  * @brief Class that handles rendering of animations with a physical base.
@@ -60,6 +62,15 @@ class PhysicalRenderable : public PhysicalObject, public TextureBasedRenderable
      */
     void setFPS(int frames);
 
+    /// Returns the current animation step
+    int animationStep() const { return m_currentAnimationStep; }
+
+    /**
+     * @brief Shows the given animation step until the animation advances by itself, e.g. to
+     *        display a state received over the network
+     */
+    void showAnimationStep(int step);
+
     /**
      * @brief Sets the current position in world coordinates.
      *        The world position is synchronous to the screen position
@@ -80,6 +91,33 @@ class PhysicalRenderable : public PhysicalObject, public TextureBasedRenderable
      */
     virtual void update();
 
+    /**
+     * @brief Moves this object to the given position of its body without touching the body
+     *
+     * @param position the current position of the body in the b2World
+     */
+    void syncTransform(const b2Vec2& position) {
+        m_worldPosition = position;
+        computeScreenCoordinates();
+    }
+
+    /**
+     * @brief Writes the state of this object, which changes during a game, to a snapshot.
+     *        By default this is the body.
+     *
+     * @param out the snapshot to write to
+     */
+    virtual void saveState(SnapshotWriter& out) const;
+
+    /**
+     * @brief Restores the state written by saveState. The world must not be locked.
+     *
+     * @param in the snapshot to read from
+     */
+    virtual void restoreState(SnapshotReader& in);
+
+    void replaceBody(b2Body* body, b2Body* copy) override;
+
     /**
      * @brief Sets the screen position of this object.
      *        The screen position is synchronous to the world position
@@ -134,7 +172,17 @@ class PhysicalRenderable : public PhysicalObject, public TextureBasedRenderable
      */
     virtual void reset();
 
+    /**
+     * @brief Destroys the physical representation of this object in the given world
+     *
+     * @param world from which this object should be removed
+     */
+    void removeFromWorld(b2World& world);
+
    protected:
+    /// Returns the duration between two animations at the current quality
+    Uint32 animationDuration() const;
+
     /// Number of animations
     int m_animationCount;
 
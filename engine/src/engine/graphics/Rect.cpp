@@ -4,16 +4,16 @@
 // This file is licensed under the MIT license; see LICENSE file in the root of this
 // project for details.
 
+#include "engine/EngineContext.hpp"
 #include "engine/graphics/Rect.hpp"
-#include "engine/Window.hpp"
 
 namespace ctb {
 namespace engine {
 
 void Rect::render() {
-    SDL_SetRenderDrawColor(Window::getWindow().renderer(), m_color.r, m_color.g, m_color.b,
+    SDL_SetRenderDrawColor(EngineContext::current().getRenderer(), m_color.r, m_color.g, m_color.b,
                            m_color.a);
-    SDL_RenderFillRect(Window::getWindow().renderer(), &m_rect);
+    SDL_RenderFillRect(EngineContext::current().getRenderer(), &m_rect);
 }
 
 }  // namespace engine
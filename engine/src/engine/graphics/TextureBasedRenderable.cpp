@@ -4,8 +4,8 @@
 // This file is licensed under the MIT license; see LICENSE file in the root of this
 // project for details.
 
+#include "engine/EngineContext.hpp"
 #include "engine/graphics/TextureBasedRenderable.hpp"
-#include "engine/Window.hpp"
 
 namespace ctb {
 namespace engine {
@@ -14,7 +14,8 @@ TextureBasedRenderable::TextureBasedRenderable(SDL_Texture* texture)
     : m_position(0, 0),
       m_texture(texture),
       m_offset(0, 0),
-      m_windowOffset(Window::getWindow().w() / 2, Window::getWindow().h() / 2),
+      m_windowOffset(EngineContext::current().getWidth() / 2,
+                     EngineContext::current().getHeight() / 2),
       m_flip(SDL_FLIP_NONE),
       m_flip_angle(0.0) {
     m_sourceRect = {0, 0, 0, 0};
@@ -33,8 +34,8 @@ TextureBasedRenderable::TextureBasedRenderable(SDL_Texture* texture)
 
 void TextureBasedRenderable::render() {
     if (m_texture != nullptr) {
-        SDL_RenderCopyEx(Window::getWindow().renderer(), m_texture, &m_sourceRect, &m_targetRect,
-                         m_flip_angle, nullptr, m_flip);
+        SDL_RenderCopyEx(EngineContext::current().getRenderer(), m_texture, &m_sourceRect,
+                         &m_targetRect, m_flip_angle, nullptr, m_flip);
     }
 }
 
@@ -49,7 +50,7 @@ Vector2dT TextureBasedRenderable::computeTargetPosition() const {
 }
 
 TextureBasedRenderable::~TextureBasedRenderable() {
-    if (m_texture != nullptr) {
+    if (m_texture != nullptr && m_ownsTexture) {
         SDL_DestroyTexture(m_texture);
         m_texture = nullptr;
     }
@@ -66,6 +66,9 @@ class TextureBasedRenderable : public SDLRenderable {
     /// A texture object
     SDL_Texture* m_texture;
 
+    /// Whether the destructor destroys the texture, false for a texture of SharedTextures
+    bool m_ownsTexture{true};
+
     /// Source rect in the texture
     SDL_Rect m_sourceRect;
 
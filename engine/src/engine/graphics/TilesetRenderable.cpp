@@ -5,37 +5,32 @@
 // project for details.
 
 #include <SDL.h>
-#include <SDL_image.h>
 #include <parser/LevelConfig.hpp>
 
-#include "engine/Window.hpp"
+#include "engine/EngineContext.hpp"
 #include "engine/graphics/TilesetRenderable.hpp"
 
 namespace ctb {
 namespace engine {
 
-namespace {
-using ctb::parser::LevelConfig;
-using ctb::parser::TilesetConfig;
-}  // namespace
-
-TilesetRenderable::TilesetRenderable(parser::TilesetConfig& config,
-                                     parser::LevelConfig* levelConfig,
-                                     bool flip)
-    : TextureBasedRenderable(Window::getWindow().loadTexture(levelConfig->getTilesheetFilename())) {
-    m_tileWidth = levelConfig->getTileWidth();
-    m_tileHeight = levelConfig->getTileHeight();
-    m_tileOffset = levelConfig->getTileOffset();
-    m_tilesPerRow = levelConfig->getTilesPerRow();
-    m_levelWidth = levelConfig->getWidth();
-    m_levelHeight = levelConfig->getHeight();
-    m_tiles = std::make_unique<DynamicTilestore>(config.getTileArrangement(), m_levelWidth,
-                                                 m_levelHeight, m_tileWidth, m_tileHeight);
+TilesetRenderable::TilesetRenderable(const DynamicTilestore* tiles,
+                                     const LevelView& view,
+                                     SDL_Texture* tilesheet)
+    : TextureBasedRenderable(tilesheet), m_tiles(tiles), m_view(view) {
+    const parser::LevelConfig& levelConfig = view.getConfig();
+    m_tileWidth = levelConfig.getTileWidth();
+    m_tileHeight = levelConfig.getTileHeight();
+    m_tileOffset = levelConfig.getTileOffset();
+    m_tilesPerRow = levelConfig.getTilesPerRow();
+    m_levelWidth = levelConfig.getWidth();
+    m_levelHeight = levelConfig.getHeight();
+    // the tilesheet is shared by all levels that use it
+    m_ownsTexture = false;
+    m_flip = view.isFlipped() ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
+}
 
-    if (flip) {
-        m_tiles->flip();
-    }
-    m_flip = flip ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
+int TilesetRenderable::tile(int x, int y) const {
+    return m_tiles->get(m_view.mirrorX(x), y);
 }
 
 int TilesetRenderable::width() const {
@@ -51,22 +46,22 @@ void TilesetRenderable::render() {
 
     SDL_Rect srcRect = {0, 0, m_tileWidth, m_tileHeight};
     SDL_Rect dstRect = {0, 0, m_tileWidth, m_tileHeight};
+    SDL_Renderer* renderer = EngineContext::current().getRenderer();
     for (int y = 0; y < m_levelHeight; ++y) {
         for (int x = 0; x < m_levelWidth; ++x) {
-            int tile = m_tiles->get(x, y) - 1;
-            if (tile <= -1) {
+            int id = tile(x, y) - 1;
+            if (id <= -1) {
                 continue;
             }
 
-            int tile_x = tile % m_tilesPerRow;
-            int tile_y = tile / m_tilesPerRow;
+            int tile_x = id % m_tilesPerRow;
+            int tile_y = id / m_tilesPerRow;
 
             srcRect.x = (tile_x * m_tileWidth) + (tile_x * m_tileOffset);
             srcRect.y = (tile_y * m_tileHeight) + (tile_y * m_tileOffset);
             dstRect.x = x * m_tileWidth - m_offset.x + m_windowOffset.x;
             dstRect.y = y * m_tileHeight - m_offset.y + m_windowOffset.y;
-            SDL_RenderCopyEx(Window::getWindow().renderer(), m_texture, &srcRect, &dstRect, 0,
-                             nullptr, m_flip);
+            SDL_RenderCopyEx(renderer, m_texture, &srcRect, &dstRect, 0, nullptr, m_flip);
         }
     }
 }
@@ -7,17 +7,13 @@
 #ifndef ENGINE_GRAPHIC_TILESET_HPP
 #define ENGINE_GRAPHIC_TILESET_HPP
 
-#include <memory>
-
+#include <SDL.h>
 #include <parser/DynamicTilestore.hpp>
-#include <parser/TilesetConfig.hpp>
 
+#include "engine/core/LevelView.hpp"
 #include "engine/graphics/TextureBasedRenderable.hpp"
 
 namespace ctb {
-namespace parser {
-class LevelConfig;
-}
 class DynamicTilestore;
 
 namespace engine {
@@ -27,12 +23,10 @@ class TilesetRenderable : public TextureBasedRenderable {
    public:
     /// \brief Constructor
     ///
-    /// \param config Tileset configuration
-    /// \param levelConfig Level configuration
-    /// \param flip Flip level?
-    TilesetRenderable(parser::TilesetConfig& config,
-                      parser::LevelConfig* levelConfig,
-                      bool flip = false);
+    /// \param tiles Tiles of the layer as parsed, shared with the other orientation of the level
+    /// \param view Level, mirrors the tiles if it is flipped
+    /// \param tilesheet Texture of the tilesheet, it isn't destroyed with the tileset
+    TilesetRenderable(const DynamicTilestore* tiles, const LevelView& view, SDL_Texture* tilesheet);
 
     /// Renders the tileset
     void render() override;
@@ -43,8 +37,8 @@ class TilesetRenderable : public TextureBasedRenderable {
     /// Retruns the height of the tileset
     int height() const override;
 
-    /// Return the tilestore
-    DynamicTilestore* tiles() { return m_tiles.get(); }
+    /// Returns the tile id at the given tile position, 0 means no tile
+    int tile(int x, int y) const;
 
     /// Destructor
     ~TilesetRenderable() override = default;
@@ -68,8 +62,11 @@ class TilesetRenderable : public TextureBasedRenderable {
     /// Height of level in tiles
     int m_levelHeight;
 
-    /// Tilestore
-    std::unique_ptr<DynamicTilestore> m_tiles;
+    /// Tiles as parsed, not mirrored
+    const DynamicTilestore* m_tiles;
+
+    /// Level the tiles belong to
+    LevelView m_view;
 };
 
 }  // namespace engine
@@ -10,13 +10,12 @@
 #include <common/Exceptions.hpp>
 #include <common/Utils.hpp>
 
+#include "engine/EngineContext.hpp"
 #include "engine/gui/Font.hpp"
 
 namespace ctb {
 namespace engine {
 
-std::map<std::string, Font> Font::fontMap;
-
 // Load all fonts in the given path. Fonts have to have the extension .fnt
 void Font::loadFonts(const std::string& folderPath) {
     for (auto& file : boost::filesystem::directory_iterator(folderPath)) {
@@ -30,11 +29,12 @@ void Font::loadFonts(const std::string& folderPath) {
 // Add a fontFile to the static Font map
 void Font::addFont(const boost::filesystem::path& path, const std::string& name) {
     Font f(path.string());
-    fontMap.insert(std::pair<std::string, Font>(name, f));
+    EngineContext::current().m_fonts->insert(std::pair<std::string, Font>(name, f));
 }
 
 // Query a Font and returns a pointer to it
 Font* Font::getFont(const std::string& name) {
+    std::map<std::string, Font>& fontMap = *EngineContext::current().m_fonts;
     auto it = fontMap.find(name);
     if (it == fontMap.end()) {
         return nullptr;
@@ -65,7 +65,7 @@ Font::Font(const std::string& filename) {
     uint8_t keyB = static_cast<uint8_t>(b);
 
     // Load textures
-    m_texture = Window::getWindow().loadTexture(path + tilesheetFilename, keyR, keyG, keyB);
+    m_texture = EngineContext::current().loadTexture(path + tilesheetFilename, keyR, keyG, keyB);
 }
 
 }  // namespace engine
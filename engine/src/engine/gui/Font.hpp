@@ -29,7 +29,8 @@ class Font {
     /// \param std::string folderPath The folder to search for fonts
     static void loadFonts(const std::string& folderPath);
 
-    /// \brief Add a font to the fontMap and make it available to render
+    /// \brief Add a font to the font map of the current EngineContext and make it available to
+    /// render
     /// boost::filesystem::path path The path to the .fnt file
     /// std::string name The name of the font. Needed to insert into the font map. The
     /// font is available with this name.
@@ -53,9 +54,6 @@ class Font {
     int get_h() const { return m_h; }
 
    private:
-    /// Maps all font names to loaded fonts.
-    static std::map<std::string, Font> fontMap;
-
     /// \brief private contructor, so only the static functions can add fonts
     /// \param std::string filename The name of the font
     /// \throws std::runtime_error if the found could not be loaded
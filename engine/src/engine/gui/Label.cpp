@@ -7,7 +7,7 @@
 #include <iostream>
 #include <utility>
 
-#include "engine/Window.hpp"
+#include "engine/EngineContext.hpp"
 #include "engine/gui/Label.hpp"
 
 namespace ctb {
@@ -96,7 +96,7 @@ void Label::renderChar(SDL_Texture* texture, SDL_Rect& target, SDL_Rect& source)
     source.y = col * source.h;
 
     // Render the character
-    SDL_RenderCopy(Window::getWindow().renderer(), texture, &source, &target);
+    SDL_RenderCopy(EngineContext::current().getRenderer(), texture, &source, &target);
 }
 
 void Label::renderText(SDL_Texture* texture, SDL_Rect& target, SDL_Rect& source) {
@@ -112,7 +112,7 @@ void Label::renderText(SDL_Texture* texture, SDL_Rect& target, SDL_Rect& source)
         source.y = col * source.h;
 
         // Render it!
-        SDL_RenderCopy(Window::getWindow().renderer(), texture, &source, &target);
+        SDL_RenderCopy(EngineContext::current().getRenderer(), texture, &source, &target);
 
         target.x += source.w * m_scale;  // Move one char foreward
     }
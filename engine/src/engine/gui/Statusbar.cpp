@@ -4,10 +4,13 @@
 // This file is licensed under the MIT license; see LICENSE file in the root of this
 // project for details.
 
+#include <algorithm>
+#include <string>
+
 #include <SDL.h>
 
 #include "engine/Engine.hpp"
-#include "engine/Window.hpp"
+#include "engine/EngineContext.hpp"
 #include "engine/core/Game.hpp"
 #include "engine/gui/Label.hpp"
 #include "engine/gui/Statusbar.hpp"
@@ -19,9 +22,20 @@
 namespace ctb {
 namespace engine {
 
-int Statusbar::entryWidth = 170;
+namespace {
+/// Height of the bar with the level indicator
+constexpr int kBarHeight = 64;
+
+/// Horizontal distance of the level indicator from the entries
+constexpr int kIndicatorMargin = 30;
+}  // namespace
+
+const Statusbar::EntryStyle Statusbar::FULL_ENTRY = {"std_18px", 170, 64, 1.0f, 4, 4,
+                                                     60,         10,  35, 108};
+const Statusbar::EntryStyle Statusbar::COMPACT_ENTRY = {"std_12px", 110, 32, 0.5f, 2, 0,
+                                                        30,         3,   17, 72};
 
-Statusbar::Statusbar() : m_currentLevelRectShow(true), m_lastRenderTicks(0) {
+Statusbar::Statusbar() : m_height(kBarHeight), m_currentLevelRectShow(true), m_lastRenderTicks(0) {
     setFPS(2);  // Slow blink
     setupUI();
 }
@@ -43,73 +57,88 @@ void Statusbar::updateCurrentLevelRect() {
     }
 
     // Update position deteminated from the current level
-    int x = Window::getWindow().w() / 2 -
-            ((Window::getEngine().getGame()->getLevelCount() / 2) * 50 + 15) +
-            (Window::getEngine().getGame()->getCurrentLevelIndex()) * 50;
+    int x = EngineContext::current().getWidth() / 2 -
+            ((EngineContext::current().getEngine().getGame()->getLevelCount() / 2) * 50 + 15) +
+            (EngineContext::current().getEngine().getGame()->getCurrentLevelIndex()) * 50;
     m_currentLevelRect->setX(x);
 }
 
-void Statusbar::setupUI() {
-    int w = Window::getWindow().w();
-    int h = Window::getWindow().h();
-    Game* game = Window::getEngine().getGame();
+const Statusbar::EntryStyle& Statusbar::entryStyle(size_t players, int available) {
+    if (static_cast<int>(players) * FULL_ENTRY.width <= available) {
+        return FULL_ENTRY;
+    }
+    return COMPACT_ENTRY;
+}
 
-    int y_score = h - 54;
-    int y_health = h - 29;
+int Statusbar::entryColumns(const EntryStyle& style, int available) {
+    return std::max(available / style.width, 1);
+}
 
-    int x = 60;
+void Statusbar::addEntries(const std::vector<Player*>& players, Team team, int available) {
+    int w = EngineContext::current().getWidth();
+    int h = EngineContext::current().getHeight();
+    const EntryStyle& style = entryStyle(players.size(), available);
+    int columns = entryColumns(style, available);
     Color red(255, 0, 0);
 
-    // L2R players
-    for (auto& player : game->getL2RPlayers()) {
-        // Score label
-        Label* l = new Label("std_18px", Highscores::formatScore(player->getScore()),
-                             Vector2dT(x, y_score));
-        m_scoreLabels.insert(std::make_pair(player, l));
-        m_labels.push_back(l);
-
-        // Health label
-        l = new Label("std_18px", "100%", Vector2dT(x + 108, y_health));
-        l->setAlignment(LabelAlignment::Right);
-        m_healthLabels.insert(std::make_pair(player, l));
-        m_labels.push_back(l);
+    for (size_t i = 0; i < players.size(); ++i) {
+        int column = static_cast<int>(i) % columns;
+        int top = h - m_height + (static_cast<int>(i) / columns) * style.height;
+        Entry entry{players[i], Vector2dT(0, top + style.spriteY), style.spriteScale,
+                    nullptr, nullptr, nullptr, players[i]->getScore(), players[i]->getHealth()};
+
+        // the L2R team starts at the left border, the R2L team mirrored at the right one
+        int heartX;
+        if (team == Team::L2R) {
+            int left = column * style.width;
+            entry.spritePosition.x = left + style.spriteX;
+            entry.score = new Label(style.font, Highscores::formatScore(entry.shownScore),
+                                    Vector2dT(left + style.labelX, top + style.scoreY));
+            entry.health = new Label(style.font, std::to_string(entry.shownHealth) + "%",
+                                     Vector2dT(left + style.labelX + style.healthWidth,
+                                               top + style.healthY));
+            heartX = left + style.labelX;
+        } else {
+            int right = w - column * style.width;
+            entry.spritePosition.x = right - style.labelX;
+            entry.score = new Label(style.font, Highscores::formatScore(entry.shownScore),
+                                    Vector2dT(right - style.labelX, top + style.scoreY));
+            entry.score->setAlignment(LabelAlignment::Right);
+            entry.health = new Label(style.font, std::to_string(entry.shownHealth) + "%",
+                                     Vector2dT(right - style.labelX, top + style.healthY));
+            heartX = right - style.labelX - style.healthWidth;
+        }
+        entry.health->setAlignment(LabelAlignment::Right);
 
         // red heart
-        l = new Label("std_18px", static_cast<char>(3), Vector2dT(x, y_health));
-        l->setColor(red);
-        m_heartLabels.insert(std::make_pair(player, l));
-        m_labels.push_back(l);
-
-        x += entryWidth;
+        entry.heart =
+            new Label(style.font, static_cast<char>(3), Vector2dT(heartX, top + style.healthY));
+        entry.heart->setColor(red);
+        m_entries.push_back(entry);
     }
+}
 
-    // r2l players
-    x = w - 60;
-    for (auto& player : game->getR2LPlayers()) {
-        // Score label
-        Label* l = new Label("std_18px", Highscores::formatScore(player->getScore()),
-                             Vector2dT(x, y_score));
-        l->setAlignment(LabelAlignment::Right);
-        m_scoreLabels.insert(std::make_pair(player, l));
-        m_labels.push_back(l);
-
-        // Health label
-        l = new Label("std_18px", "100%", Vector2dT(x, y_health));
-        l->setAlignment(LabelAlignment::Right);
-        m_healthLabels.insert(std::make_pair(player, l));
-        m_labels.push_back(l);
-
-        // red heart
-        l = new Label("std_18px", static_cast<char>(3), Vector2dT(x - 108, y_health));
-        l->setColor(red);
-        m_heartLabels.insert(std::make_pair(player, l));
-        m_labels.push_back(l);
+void Statusbar::setupUI() {
+    int w = EngineContext::current().getWidth();
+    int h = EngineContext::current().getHeight();
+    Game* game = EngineContext::current().getEngine().getGame();
 
-        x -= entryWidth;
+    // the teams share the width beside the level indicator, a team with more rows than the
+    // bar has grows it upwards
+    int levelCount = game->getLevelCount();
+    int available = w / 2 - (levelCount / 2) * 50 - kIndicatorMargin;
+    for (const std::vector<Player*>* team : {&game->getL2RPlayers(), &game->getR2LPlayers()}) {
+        const EntryStyle& style = entryStyle(team->size(), available);
+        int columns = entryColumns(style, available);
+        int rows = (static_cast<int>(team->size()) + columns - 1) / columns;
+        m_height = std::max(m_height, rows * style.height);
     }
+    m_entries.reserve(game->getL2RPlayers().size() + game->getR2LPlayers().size());
+    addEntries(game->getL2RPlayers(), Team::L2R, available);
+    addEntries(game->getR2LPlayers(), Team::R2L, available);
 
+    int x;
     // the level indicator
-    int levelCount = game->getLevelCount();
     SDL_Color color = {200, 200, 200, 255};
     int y = h - 52;  // (64-40) / 2 + 40
     x = w / 2 - (levelCount / 2) * 50 - 20;
@@ -141,46 +170,34 @@ void Statusbar::setupUI() {
 }
 
 void Statusbar::render() {
-    int w = Window::getWindow().w();
-    int h = Window::getWindow().h();
-    Game* game = Window::getEngine().getGame();
-    auto* renderer = Window::getWindow().renderer();
+    int w = EngineContext::current().getWidth();
+    int h = EngineContext::current().getHeight();
+    auto* renderer = EngineContext::current().getRenderer();
 
     updateCurrentLevelRect();
 
     // Renders a transparent black rect over the bottom of the window
-    SDL_Rect a = {0, h - 64, w, 64};
+    SDL_Rect a = {0, h - m_height, w, m_height};
     SDL_SetRenderDrawColor(renderer, 0, 0, 0, 128);
     SDL_RenderFillRect(renderer, &a);
 
-    int y = h - 60;
-    int x = 4;
     // Render the players and update their score and health labels
-    for (auto& player : game->getL2RPlayers()) {
-        Vector2dT p(x, y);
-        player->renderStatic(p);
-        m_scoreLabels[player]->setText(Highscores::formatScore(player->getScore()));
-        m_healthLabels[player]->setText(std::to_string(player->getHealth()) + "%");
-        x += entryWidth;
-
-        // Update heart
-        m_heartLabels[player]->setShow(!player->isHealing());
-    }
-    x = w - 60;
-    for (auto& player : game->getR2LPlayers()) {
-        Vector2dT p(x, y);
-        player->renderStatic(p);
-        m_scoreLabels[player]->setText(Highscores::formatScore(player->getScore()));
-        m_healthLabels[player]->setText(std::to_string(player->getHealth()) + "%");
-        x -= entryWidth;
-
-        // Update heart
-        m_heartLabels[player]->setShow(!player->isHealing());
-    }
-
-    // Render all labels
-    for (auto& lbl : m_labels) {
-        lbl->render();
+    for (Entry& entry : m_entries) {
+        Player* player = entry.player;
+        player->renderStatic(entry.spritePosition, entry.spriteScale);
+        if (player->getScore() != entry.shownScore) {
+            entry.shownScore = player->getScore();
+            entry.score->setText(Highscores::formatScore(entry.shownScore));
+        }
+        if (player->getHealth() != entry.shownHealth) {
+            entry.shownHealth = player->getHealth();
+            entry.health->setText(std::to_string(entry.shownHealth) + "%");
+        }
+        entry.heart->setShow(!player->isHealing());
+
+        entry.score->render();
+        entry.health->render();
+        entry.heart->render();
     }
 
     // level indicator
@@ -195,8 +212,10 @@ void Statusbar::render() {
 }
 
 Statusbar::~Statusbar() {
-    for (auto& lbl : m_labels) {
-        delete lbl;
+    for (Entry& entry : m_entries) {
+        delete entry.score;
+        delete entry.health;
+        delete entry.heart;
     }
     for (auto& rect : m_rects) {
         delete rect;
@@ -7,11 +7,12 @@
 #ifndef ENGINE_GUI_STATUSBAR_HPP
 #define ENGINE_GUI_STATUSBAR_HPP
 
-#include <map>
+#include <cstdint>
 #include <vector>
 
 #include "engine/graphics/Rect.hpp"
 #include "engine/graphics/SDLRenderable.hpp"
+#include "engine/util/Vector2d.hpp"
 
 namespace ctb {
 namespace engine {
@@ -20,7 +21,10 @@ class Label;
 
 class Player;
 
-/// The in-game GUI for scores, health and more information
+enum class Team;
+
+/// The in-game GUI for scores, health and more information. It fits any number of players: a
+/// team that doesn't fit into one row of full size entries gets rows of half size ones.
 class Statusbar : public SDLRenderable {
    public:
     Statusbar();
@@ -33,8 +37,50 @@ class Statusbar : public SDLRenderable {
     ~Statusbar() override;
 
    private:
-    /// The width of the combo of one player and the score and health label
-    static int entryWidth;
+    /// The size and font of the entry of a player, the offsets of its parts are measured from
+    /// the edge of the entry at the window border
+    struct EntryStyle {
+        const char* font;
+        int width;
+        int height;
+        float spriteScale;
+        int spriteX;
+        int spriteY;
+        int labelX;
+        int scoreY;
+        int healthY;
+        /// distance between the heart and the end of the health label
+        int healthWidth;
+    };
+
+    /// The full size entries of teams that fit into one row
+    static const EntryStyle FULL_ENTRY;
+
+    /// The half size entries of larger teams
+    static const EntryStyle COMPACT_ENTRY;
+
+    /// The entry of a player
+    struct Entry {
+        Player* player;
+        /// upper left corner of the sprite
+        Vector2dT spritePosition;
+        float spriteScale;
+        Label* score;
+        Label* health;
+        Label* heart;
+        /// the displayed values, the labels are only updated when they change
+        uint64_t shownScore;
+        uint32_t shownHealth;
+    };
+
+    /// Returns the entries of a team of the given size fit into the given width
+    static const EntryStyle& entryStyle(size_t players, int available);
+
+    /// Returns the number of entries per row
+    static int entryColumns(const EntryStyle& style, int available);
+
+    /// Adds the entries of the players of a team, beginning at its window border
+    void addEntries(const std::vector<Player*>& players, Team team, int available);
 
     /// Set the frame rate for the blinking
     void setFPS(int fps);
@@ -42,17 +88,11 @@ class Statusbar : public SDLRenderable {
     /// Sets the black rectangle over the current level and make it blink
     void updateCurrentLevelRect();
 
-    /// All labels
-    std::vector<Label*> m_labels;
-
-    /// Maps the player to his/her score label for easy access
-    std::map<Player*, Label*> m_scoreLabels;
-
-    /// Maps the player to his/her health label for easy access
-    std::map<Player*, Label*> m_healthLabels;
+    /// The entries of all players
+    std::vector<Entry> m_entries;
 
-    /// Maps the heart label to the player
-    std::map<Player*, Label*> m_heartLabels;
+    /// Height of the bar, it grows with the rows of entries
+    int m_height;
 
     /// All rects used for the level indicator
     std::vector<Rect*> m_rects;
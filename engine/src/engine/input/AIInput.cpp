@@ -0,0 +1,319 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#include "engine/Engine.hpp"
+#include "engine/EngineContext.hpp"
+#include "engine/core/Game.hpp"
+#include "engine/core/Level.hpp"
+#include "engine/core/NavGraph.hpp"
+#include "engine/input/AIInput.hpp"
+#include "engine/scene/Door.hpp"
+#include "engine/scene/Fist.hpp"
+#include "engine/scene/Flag.hpp"
+#include "engine/scene/Player.hpp"
+
+namespace ctb {
+namespace engine {
+
+namespace {
+/// Horizontal distance in pixels at which a waypoint counts as reached
+constexpr int kArriveDistance = 8;
+
+/// Number of ticks without horizontal movement until the AI jumps
+constexpr uint32_t kStuckTicks = 10;
+
+/// Distance in pixels at which the AI starts shooting at enemies
+constexpr int kShootDistance = 400;
+
+/// Distance in pixels at which the AI starts punching enemies
+constexpr int kMeleeDistance = 48;
+
+/// The aim is only corrected if it is off by more degrees
+constexpr float kAimTolerance = 3.0f;
+
+/// Ticks of shooting without damaging the enemy until the gun is dropped
+constexpr uint32_t kMissedTicks = 200;
+
+/// Below this health the AI heals if no enemy is in reach
+constexpr uint32_t kHealHealth = 50;
+
+/// Distance in pixels of the guard position in front of the defended door
+constexpr int kGuardDistance = 160;
+
+/// A defender leaves its position for the flag if it is closer than this many pixels
+constexpr int kGuardRadius = 480;
+
+/// Returns the horizontal center of the object
+int centerX(const PhysicalRenderable* object) {
+    return object->x() + object->animationWidth() / 2;
+}
+
+/// Returns the vertical center of the object
+int centerY(const PhysicalRenderable* object) {
+    return object->y() + object->animationHeight() / 2;
+}
+
+/// Returns the lowest pixel row of the object
+int feetY(const PhysicalRenderable* object) {
+    return object->y() + object->animationHeight() - 1;
+}
+}  // namespace
+
+constexpr uint32_t AIInput::THINK_INTERVAL;
+
+AIInput::AIInput(AIPolicy policy, uint32_t offset)
+    : m_policy(policy), m_thinkCountdown(offset % THINK_INTERVAL) {}
+
+void AIInput::pollInput(const Uint8* /*keyStates*/) {
+    Game* game = EngineContext::current().getEngine().getGame();
+    if (!m_player || !game || game->getGameState() != GameState::Running || !m_player->alive()) {
+        releaseAll();
+        return;
+    }
+    Level* level = game->getCurrentLevel();
+
+    // release the buttons pressed in the last tick, events are only emitted on changes
+    if (m_jumping) {
+        call_handlers(InputType::INPUT_JUMP, false);
+        m_jumping = false;
+    }
+    if (m_healing) {
+        call_handlers(InputType::INPUT_HEAL, false);
+        m_healing = false;
+    }
+    if (m_dropping) {
+        call_handlers(InputType::INPUT_DROP_WEAPON, false);
+        m_dropping = false;
+    }
+
+    if (m_thinkCountdown == 0) {
+        think(game, level);
+        m_thinkCountdown = THINK_INTERVAL;
+    }
+    --m_thinkCountdown;
+
+    plan(level);
+    move();
+    fight();
+    heal();
+}
+
+void AIInput::think(Game* game, Level* level) {
+    const Team team = m_player->getTeam();
+    auto& enemies = team == Team::L2R ? game->getR2LPlayers() : game->getL2RPlayers();
+    auto& friends = team == Team::L2R ? game->getL2RPlayers() : game->getR2LPlayers();
+
+    Player* enemyCarrier = nullptr;
+    Player* friendCarrier = nullptr;
+    Player* closestEnemy = nullptr;
+    int closestDistance = 0;
+    for (Player* enemy : enemies) {
+        if (!enemy->alive()) {
+            continue;
+        }
+        if (enemy->hasFlag()) {
+            enemyCarrier = enemy;
+        }
+        int dx = centerX(enemy) - centerX(m_player);
+        int dy = centerY(enemy) - centerY(m_player);
+        int distance = dx * dx + dy * dy;
+        if (!closestEnemy || distance < closestDistance) {
+            closestEnemy = enemy;
+            closestDistance = distance;
+        }
+    }
+    for (Player* player : friends) {
+        if (player != m_player && player->alive() && player->hasFlag()) {
+            friendCarrier = player;
+        }
+    }
+
+    if (closestEnemy != m_enemy) {
+        m_missedTicks = 0;
+        m_enemyHealth = closestEnemy ? closestEnemy->getHealth() : 0;
+    }
+    m_enemy = closestEnemy;
+    m_enemyDistanceSquared = closestDistance;
+
+    // carriers reach the next level through the door of their own team
+    Door* ownDoor = nullptr;
+    Door* enemyDoor = nullptr;
+    for (Door* door : level->getDoors()) {
+        (door->getTeam() == team ? ownDoor : enemyDoor) = door;
+    }
+    Flag* flag = level->getFlag();
+
+    if (m_player->hasFlag()) {
+        setTarget(ownDoor ? static_cast<PhysicalRenderable*>(ownDoor) : flag);
+        return;
+    }
+
+    switch (m_policy) {
+        case AIPolicy::SeekFlag:
+            if (enemyCarrier) {
+                setTarget(enemyCarrier);
+            } else if (friendCarrier && ownDoor) {
+                setTarget(ownDoor);
+            } else {
+                setTarget(flag);
+            }
+            break;
+        case AIPolicy::ChaseCarrier:
+            if (enemyCarrier) {
+                setTarget(enemyCarrier);
+            } else if (friendCarrier) {
+                setTarget(friendCarrier);
+            } else if (closestEnemy) {
+                setTarget(closestEnemy);
+            } else {
+                setTarget(flag);
+            }
+            break;
+        case AIPolicy::DefendDoor:
+            if (enemyCarrier) {
+                setTarget(enemyCarrier);
+            } else if (!enemyDoor) {
+                setTarget(flag);
+            } else {
+                // stand a bit in front of the door, on the side the flag comes from
+                int doorX = centerX(enemyDoor);
+                int guardX = doorX + (centerX(flag) < doorX ? -kGuardDistance : kGuardDistance);
+                if (!friendCarrier && std::abs(centerX(flag) - guardX) < kGuardRadius) {
+                    setTarget(flag);
+                } else {
+                    m_targetX = guardX;
+                    m_targetY = feetY(enemyDoor);
+                }
+            }
+            break;
+    }
+}
+
+void AIInput::setTarget(const PhysicalRenderable* object) {
+    m_targetX = centerX(object);
+    m_targetY = feetY(object);
+}
+
+void AIInput::plan(Level* level) {
+    m_waypointX = m_targetX;
+    m_jumpNext = false;
+
+    NavGraph& nav = level->getNavGraph();
+    if (nav.empty()) {
+        return;
+    }
+    // the next hops are cached per goal, so this is a lookup for most ticks
+    int start = nav.nodeAtPixel(centerX(m_player), feetY(m_player));
+    int goal = nav.nodeAtPixel(m_targetX, m_targetY);
+    if (const NavGraph::Link* link = nav.nextLink(start, goal)) {
+        const NavGraph::Node& node = nav.getNode(link->to);
+        m_waypointX = node.x * nav.getTileWidth() + nav.getTileWidth() / 2;
+        m_jumpNext = link->type == NavGraph::LinkType::Jump;
+    }
+}
+
+void AIInput::move() {
+    int dx = m_waypointX - centerX(m_player);
+    bool left = dx < -kArriveDistance;
+    bool right = dx > kArriveDistance;
+
+    // releasing any direction stops the player, so release before pressing the other one
+    if (!left) {
+        call_handlers(InputType::INPUT_LEFT, false);
+    }
+    if (!right) {
+        call_handlers(InputType::INPUT_RIGHT, false);
+    }
+    if (left) {
+        call_handlers(InputType::INPUT_LEFT, true);
+        m_facingLeft = true;
+    }
+    if (right) {
+        call_handlers(InputType::INPUT_RIGHT, true);
+        m_facingLeft = false;
+    }
+
+    // jump if the path says so or if an obstacle blocks the way
+    b2Body* body = m_player->getBody();
+    if ((left || right) && body && std::abs(body->GetLinearVelocity().x) < 0.5f) {
+        ++m_stuckTicks;
+    } else {
+        m_stuckTicks = 0;
+    }
+    if (m_jumpNext || m_stuckTicks >= kStuckTicks) {
+        press(InputType::INPUT_JUMP, m_jumping);
+        m_stuckTicks = 0;
+    }
+}
+
+void AIInput::fight() {
+    Fist* weapon = m_player->getWeapon();
+    bool shoot = false;
+    if (m_enemy && m_enemy->alive() && weapon) {
+        int dx = centerX(m_enemy) - centerX(m_player);
+        // screen coordinates grow downwards, angles upwards
+        int dy = centerY(m_player) - centerY(m_enemy);
+        int reach = weapon->isMelee() ? kMeleeDistance : kShootDistance;
+        bool facing = dx == 0 || (dx < 0) == m_facingLeft;
+        shoot = facing && dx * dx + dy * dy < reach * reach;
+
+        if (!weapon->isMelee()) {
+            auto angle = static_cast<float>(std::atan2(dy, std::abs(dx)) * 180.0 / M_PI);
+            angle = std::max(-90.0f, std::min(90.0f, angle));
+            if (std::abs(angle - m_angle) > kAimTolerance) {
+                call_handlers(InputType::INPUT_AIM_VERT, true, angle);
+                m_angle = angle;
+            }
+
+            // switch to the fists if the gun doesn't hit, e.g. because of a wall in between
+            if (shoot && m_enemy->getHealth() >= m_enemyHealth) {
+                ++m_missedTicks;
+            } else {
+                m_missedTicks = 0;
+            }
+            m_enemyHealth = m_enemy->getHealth();
+            if (m_missedTicks >= kMissedTicks && weapon->isDropable()) {
+                press(InputType::INPUT_DROP_WEAPON, m_dropping);
+                m_missedTicks = 0;
+                shoot = false;
+            }
+        }
+    }
+    call_handlers(InputType::INPUT_SHOOT, shoot);
+}
+
+void AIInput::heal() {
+    bool inDanger = m_enemy && m_enemy->alive() &&
+                    m_enemyDistanceSquared < kShootDistance * kShootDistance;
+    if (m_player->getHealth() < kHealHealth && !inDanger && !m_player->isHealing()) {
+        press(InputType::INPUT_HEAL, m_healing);
+    }
+}
+
+void AIInput::press(InputType type, bool& pressed) {
+    call_handlers(type, true);
+    pressed = true;
+}
+
+void AIInput::releaseAll() {
+    call_handlers(InputType::INPUT_LEFT, false);
+    call_handlers(InputType::INPUT_RIGHT, false);
+    call_handlers(InputType::INPUT_SHOOT, false);
+    call_handlers(InputType::INPUT_JUMP, false);
+    call_handlers(InputType::INPUT_HEAL, false);
+    call_handlers(InputType::INPUT_DROP_WEAPON, false);
+    m_jumping = m_healing = m_dropping = false;
+    m_stuckTicks = 0;
+    m_missedTicks = 0;
+    m_enemy = nullptr;
+}
+
+}  // namespace engine
+}  // namespace ctb
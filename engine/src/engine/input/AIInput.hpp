@@ -0,0 +1,153 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_INPUT_AIINPUT_HPP
+#define ENGINE_INPUT_AIINPUT_HPP
+
+#include <cstdint>
+
+#include <SDL.h>
+
+#include "engine/input/Input.hpp"
+
+namespace ctb {
+namespace engine {
+
+class Game;
+class Level;
+class PhysicalRenderable;
+class Player;
+
+/// What an AIInput tries to achieve. Every policy carries a picked up flag to the own door.
+enum class AIPolicy {
+    SeekFlag,      // pick up the flag, chase an enemy carrier
+    ChaseCarrier,  // hunt the enemy carrier or the closest enemy, escort an own carrier
+    DefendDoor     // guard the door the enemies have to reach, intercept carriers
+};
+
+/***
+ * An input device controlled by the computer. It emits the same events as a keyboard or a
+ * controller, so the controlled player goes through the regular input handling.
+ *
+ * The policy is evaluated every THINK_INTERVAL ticks only, in between the last decision is
+ * followed. A decision scans the players once and asks the level's navigation graph for the
+ * next hop, whose search is bounded and cached, so the cost per tick is bounded as well.
+ */
+class AIInput : public Input {
+   public:
+    /// Number of ticks between two decisions
+    static constexpr uint32_t THINK_INTERVAL = 5;
+
+    /***
+     * Constructor
+     *
+     * @param policy	what the controlled player tries to do
+     * @param offset	delays the first decision to spread the decisions of many inputs
+     */
+    explicit AIInput(AIPolicy policy = AIPolicy::SeekFlag, uint32_t offset = 0);
+
+    /// Does nothing, the AI doesn't react to SDL events
+    void handleSdlEvent(const SDL_Event&) override {}
+
+    /***
+     * Decides what to do in this tick and emits the corresponding events
+     *
+     * @param Uint8*	Keyboard representation, ignored in this class, inherited from Input
+     */
+    void pollInput(const Uint8*) override;
+
+    /***
+     *  Name for rendering in the start menu
+     *
+     *  @return	An InputDeviceType to cast safely from Input (to AIInput)
+     */
+    InputDeviceType getType() override { return InputDeviceType::AI; }
+
+    /// Sets the player controlled by this input, it must be registered to this input
+    void setPlayer(Player* player) { m_player = player; }
+
+    /// Returns the policy of this input
+    AIPolicy getPolicy() const { return m_policy; }
+
+    /// Changes the policy, it is applied with the next decision
+    void setPolicy(AIPolicy policy) { m_policy = policy; }
+
+    ~AIInput() override = default;
+
+   private:
+    /// Evaluates the policy and updates the target and the enemy to fight
+    void think(Game* game, Level* level);
+
+    /// Sets the next waypoint towards the target, using the navigation graph if possible
+    void plan(Level* level);
+
+    /// Presses or releases the move and jump buttons to get to the waypoint
+    void move();
+
+    /// Aims at the enemy and presses shoot if it is in reach
+    void fight();
+
+    /// Presses heal if the player is hurt and out of danger
+    void heal();
+
+    /// Presses the button for one tick
+    void press(InputType type, bool& pressed);
+
+    /// Releases all buttons
+    void releaseAll();
+
+    /// Sets the target to the center of the object
+    void setTarget(const PhysicalRenderable* object);
+
+    AIPolicy m_policy;
+
+    /// The controlled player
+    Player* m_player{nullptr};
+
+    /// Ticks until the next decision
+    uint32_t m_thinkCountdown;
+
+    /// Where the player wants to go, in pixels
+    int m_targetX{0};
+    int m_targetY{0};
+
+    /// The next x coordinate on the way to the target, in pixels
+    int m_waypointX{0};
+
+    /// Jump at the next tick, because the path requires it
+    bool m_jumpNext{false};
+
+    /// The enemy to fight or nullptr
+    Player* m_enemy{nullptr};
+
+    /// Squared distance to m_enemy at the last decision
+    int m_enemyDistanceSquared{0};
+
+    /// Health of m_enemy in the last tick
+    uint32_t m_enemyHealth{0};
+
+    /// Number of ticks shot at m_enemy without damaging it
+    uint32_t m_missedTicks{0};
+
+    /// Number of ticks the player wanted to move but didn't
+    uint32_t m_stuckTicks{0};
+
+    /// Last emitted aiming angle
+    float m_angle{0.0f};
+
+    /// Is the player facing left?
+    bool m_facingLeft{false};
+
+    /// Buttons pressed for one tick only
+    bool m_jumping{false};
+    bool m_healing{false};
+    bool m_dropping{false};
+};
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_INPUT_AIINPUT_HPP
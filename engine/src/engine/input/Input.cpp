@@ -33,11 +33,12 @@ Input::Input() {
     m_lastStates.insert(std::make_pair(InputType::INPUT_DROP_WEAPON, false));
 }
 
-uint64_t Input::idCounter = 1;
+std::atomic<uint64_t> Input::idCounter{1};
 
 uint64_t Input::register_handler(InputHandler& handler) {
-    m_handlers[idCounter] = handler;
-    return idCounter++;
+    uint64_t id = idCounter++;
+    m_handlers[id] = handler;
+    return id;
 }
 
 void Input::deregister_handler(uint64_t id) {
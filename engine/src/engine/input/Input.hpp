@@ -6,6 +6,7 @@
 
 #ifndef ENGINE_INPUT_INPUT_HPP
 #define ENGINE_INPUT_INPUT_HPP
+#include <atomic>
 #include <forward_list>
 #include <functional>
 #include <map>
@@ -38,7 +39,7 @@ enum class InputType {
 };
 
 /// enum used in getType() to downcast savely from Input
-enum class InputDeviceType { Keyboard, Controller };
+enum class InputDeviceType { Keyboard, Controller, AI, Network, Replay };
 
 /// forward declaration for following typedef
 class Input;
@@ -102,9 +103,13 @@ class Input : public Object {
     ///              is invalid.
     void call_handlers(InputType type, bool state, float angle = 0.0);
 
+    /// Sets the last state of type without calling the handlers, e.g. because the state of
+    /// the handlers was restored
+    void setLastState(InputType type, bool state) { m_lastStates[type] = state; }
+
    private:
-    /// Static counter for input handler ids.
-    static uint64_t idCounter;
+    /// Static counter for input handler ids, shared by the inputs of all threads
+    static std::atomic<uint64_t> idCounter;
 
     /// Saves the handlers associated with the handler ids
     std::map<uint64_t, InputHandler> m_handlers;
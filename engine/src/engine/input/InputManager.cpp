@@ -8,6 +8,7 @@
 #include <parser/GameConfig.hpp>
 
 #include "engine/Engine.hpp"
+#include "engine/EngineContext.hpp"
 #include "engine/Window.hpp"
 #include "engine/core/GC.hpp"
 #include "engine/core/Game.hpp"
@@ -45,9 +46,9 @@ bool InputManager::update() {
                 // TODO(felix): Move this block into 'Engine'
                 if (Window::isDebug()) {
                     if (e.key.keysym.sym == SDLK_F12) {
-                        Window::getWindow().getEngine().getGame()->endGame(Team::R2L);
+                        EngineContext::current().getEngine().getGame()->endGame(Team::R2L);
                     } else if (e.key.keysym.sym == SDLK_F11) {
-                        Window::getWindow().getEngine().getGame()->endGame(Team::L2R);
+                        EngineContext::current().getEngine().getGame()->endGame(Team::L2R);
                     }
                 }
                 break;
@@ -7,7 +7,7 @@
 #include <iostream>
 #include <utility>
 
-#include "engine/Window.hpp"
+#include "engine/EngineContext.hpp"
 #include "engine/input/Keyboard.hpp"
 
 namespace ctb {
@@ -47,7 +47,7 @@ void Keyboard::handleSdlEvent(const SDL_Event& event) {
     // Get the mouse's vertical offset
     if (event.type == SDL_MOUSEMOTION) {
         int dy = event.motion.y;
-        int h = Window::getWindow().h();
+        int h = EngineContext::current().getHeight();
         int y = h - dy;
 
         // compute the aiming angle
@@ -0,0 +1,31 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#include "engine/input/ReplayInput.hpp"
+
+namespace ctb {
+namespace engine {
+
+ReplayInput::ReplayInput(const InputMatch& match, uint8_t player) {
+    for (const InputEvent& event : match.events) {
+        if (event.player == player) {
+            m_events.push_back(event);
+        }
+    }
+}
+
+void ReplayInput::pollInput(const Uint8* /*keyStates*/) {
+    // the events of a tick were recorded before it was simulated
+    while (m_next < m_events.size() && m_events[m_next].tick <= m_tick) {
+        const InputEvent& event = m_events[m_next];
+        call_handlers(event.type, event.state, event.angle);
+        ++m_next;
+    }
+    ++m_tick;
+}
+
+}  // namespace engine
+}  // namespace ctb
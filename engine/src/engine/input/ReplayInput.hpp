@@ -0,0 +1,61 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_INPUT_REPLAYINPUT_HPP
+#define ENGINE_INPUT_REPLAYINPUT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <SDL.h>
+
+#include "engine/input/Input.hpp"
+#include "engine/replay/InputRecording.hpp"
+
+namespace ctb {
+namespace engine {
+
+/***
+ * An input device that emits the recorded events of one player of an InputMatch. Every
+ * pollInput emits the events of the next tick, so it has to be polled exactly once before
+ * every simulated tick, starting with the first one of the game.
+ */
+class ReplayInput : public Input {
+   public:
+    /***
+     * Constructor
+     *
+     * @param match	    the recorded match, only its events are copied
+     * @param player	the index of the player in the match whose events are emitted
+     */
+    ReplayInput(const InputMatch& match, uint8_t player);
+
+    /// Does nothing, the events are recorded
+    void handleSdlEvent(const SDL_Event&) override {}
+
+    /// Emits the events of the next tick
+    void pollInput(const Uint8*) override;
+
+    InputDeviceType getType() override { return InputDeviceType::Replay; }
+
+    /// Returns if all events were emitted
+    bool isFinished() const { return m_next == m_events.size(); }
+
+    ~ReplayInput() override = default;
+
+   private:
+    std::vector<InputEvent> m_events;
+    /// index of the next event to emit
+    size_t m_next{0};
+    /// the tick whose events are emitted by the next poll
+    uint32_t m_tick{0};
+};
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_INPUT_REPLAYINPUT_HPP
@@ -4,6 +4,7 @@
 // This file is licensed under the MIT license; see LICENSE file in the root of this
 // project for details.
 
+#include "engine/EngineContext.hpp"
 #include "engine/menu/CreditsMenu.hpp"
 #include "engine/Engine.hpp"
 #include "engine/gui/Label.hpp"
@@ -28,8 +29,8 @@ void CreditsMenu::render() {
 
 void CreditsMenu::setupUI() {
     // Create header label
-    int x = Window::getWindow().w() / 2;
-    int y = Window::getWindow().h() / 10;
+    int x = EngineContext::current().getWidth() / 2;
+    int y = EngineContext::current().getHeight() / 10;
     m_labels.push_back(new Label("std_12px", "Credits", Vector2dT(x, y), 3));
 
     // Create labels for each contributor
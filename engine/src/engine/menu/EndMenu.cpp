@@ -8,6 +8,7 @@
 #include <string>
 
 #include "engine/Engine.hpp"
+#include "engine/EngineContext.hpp"
 #include "engine/Window.hpp"
 #include "engine/input/InputManager.hpp"
 #include "engine/menu/EndMenu.hpp"
@@ -33,20 +34,20 @@ void EndMenu::setupUI() {
     } else {
         s = "Team L2R has won!";
     }
-    int w = Window::getWindow().w();
-    int h = Window::getWindow().h();
+    int w = EngineContext::current().getWidth();
+    int h = EngineContext::current().getHeight();
     Label* header = new Label("std_12px", s, Vector2dT(w / 2, h / 10), 3);
     header->setAlignment(LabelAlignment::Center);
     m_labels.push_back(header);
 
     int y = h / 10 + 100;
     // R2L vector and label
-    m_r2l = Window::getEngine().getGame()->getR2LPlayers();
+    m_r2l = EngineContext::current().getEngine().getGame()->getR2LPlayers();
     std::sort(m_r2l.begin(), m_r2l.end(), PlayerScoreSorter());
     m_labels.push_back(new Label("std_12px", "Team R2L", Vector2dT(w / 2 - 250, y), 2));
 
     // L2R
-    m_l2r = Window::getEngine().getGame()->getL2RPlayers();
+    m_l2r = EngineContext::current().getEngine().getGame()->getL2RPlayers();
     std::sort(m_l2r.begin(), m_l2r.end(), PlayerScoreSorter());
     m_labels.push_back(new Label("std_12px", "Team L2R", Vector2dT(w / 2 + 50, y), 2));
 
@@ -97,9 +98,9 @@ void EndMenu::render() {
     }
 
     // Render players
-    int y = Window::getWindow().h() / 10 + 90;
+    int y = EngineContext::current().getHeight() / 10 + 90;
     int count = 1;
-    int w = Window::getWindow().w();
+    int w = EngineContext::current().getWidth();
     for (auto& player : m_r2l) {
         Vector2dT pos = {w / 2 - 210, y + count * 60};
         player->renderStatic(pos);
@@ -150,7 +151,7 @@ void EndMenu::checkForHighscores() {
 void EndMenu::handleInput(InputType type, const Input* /*input*/, bool state, float /*angle*/) {
     if (type == InputType::INPUT_SELECT && state) {
         Window::getWindow().closeCurrentMenu();
-        Window::getEngine().restart();
+        EngineContext::current().getEngine().restart();
     }
 }
 
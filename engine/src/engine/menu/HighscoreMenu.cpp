@@ -7,6 +7,7 @@
 #include <string>
 
 #include "engine/Engine.hpp"
+#include "engine/EngineContext.hpp"
 #include "engine/Window.hpp"
 #include "engine/gui/Label.hpp"
 #include "engine/input/InputManager.hpp"
@@ -23,9 +24,9 @@ HighscoreMenu::HighscoreMenu() {
 }
 
 void HighscoreMenu::setupUI() {
-    int w = Window::getWindow().w();
+    int w = EngineContext::current().getWidth();
     int x = w / 2;
-    int y = Window::getWindow().h() / 10;
+    int y = EngineContext::current().getHeight() / 10;
 
     // header label in the center.
     Label* header = new Label("std_12px", "Highscores", Vector2dT(x, y), 3);
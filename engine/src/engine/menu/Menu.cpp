@@ -10,6 +10,7 @@
 #include <SDL.h>
 
 #include "engine/Engine.hpp"
+#include "engine/EngineContext.hpp"
 #include "engine/Window.hpp"
 #include "engine/menu/Menu.hpp"
 
@@ -18,8 +19,8 @@ namespace engine {
 
 void Menu::renderBackground() {
     // Renders a full black rect over the complete window.
-    SDL_Rect a = {0, 0, Window::getWindow().w(), Window::getWindow().h()};
-    auto* renderer = Window::getWindow().renderer();
+    SDL_Rect a = {0, 0, EngineContext::current().getWidth(), EngineContext::current().getHeight()};
+    auto* renderer = EngineContext::current().getRenderer();
     SDL_SetRenderDrawColor(renderer, 0, 0, 0, 210);
     SDL_RenderFillRect(renderer, &a);
 }
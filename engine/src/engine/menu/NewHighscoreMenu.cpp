@@ -4,6 +4,7 @@
 // This file is licensed under the MIT license; see LICENSE file in the root of this
 // project for details.
 
+#include "engine/EngineContext.hpp"
 #include "engine/menu/NewHighscoreMenu.hpp"
 #include "engine/Engine.hpp"
 #include "engine/Window.hpp"
@@ -42,8 +43,8 @@ void NewHighscoreMenu::setupUI() {
         headerText = std::to_string(place) + ". Place in Highscores!";
     }
 
-    int x = Window::getWindow().w() / 2;
-    int y = Window::getWindow().h() / 10;
+    int x = EngineContext::current().getWidth() / 2;
+    int y = EngineContext::current().getHeight() / 10;
 
     Label* header = new Label("std_12px", headerText, Vector2dT(x, y), 3);
     header->setAlignment(LabelAlignment::Center);
@@ -58,7 +59,7 @@ void NewHighscoreMenu::setupUI() {
 
     // The prompt
     x = 100;
-    y = Window::getWindow().h() / 2;
+    y = EngineContext::current().getHeight() / 2;
     m_labels.push_back(new Label("std_12px", "Enter name:", Vector2dT(x, y), 2));
 
     // The name label and cursor
@@ -76,13 +77,14 @@ void NewHighscoreMenu::render() {
         lbl->render();
     }
     // Render the player who reached the score
-    Vector2dT p(Window::getWindow().w() / 2 - 27, Window::getWindow().h() / 10 + 150);
+    Vector2dT p(EngineContext::current().getWidth() / 2 - 27,
+                EngineContext::current().getHeight() / 10 + 150);
     m_player->renderStatic(p);
 }
 
 void NewHighscoreMenu::setCursorPosition() {
     int x = 400 + static_cast<int>(m_name.length()) * 24;
-    int y = Window::getWindow().h() / 2;
+    int y = EngineContext::current().getHeight() / 2;
     m_lblCursor->setPosition(Vector2dT(x, y));
 }
 
@@ -4,6 +4,7 @@
 // This file is licensed under the MIT license; see LICENSE file in the root of this
 // project for details.
 
+#include "engine/EngineContext.hpp"
 #include "engine/menu/PauseMenu.hpp"
 #include "engine/Engine.hpp"
 #include "engine/Window.hpp"
@@ -16,14 +17,14 @@ namespace ctb {
 namespace engine {
 
 PauseMenu::PauseMenu(Player* player) : m_player(player) {
-    Window::getEngine().getGame()->pause();
+    EngineContext::current().getEngine().getGame()->pause();
     setupUI();
     registerInput(player->getInput());
 }
 
 void PauseMenu::setupUI() {
-    int w = Window::getWindow().w();
-    int h = Window::getWindow().h();
+    int w = EngineContext::current().getWidth();
+    int h = EngineContext::current().getHeight();
     // header label
     m_labels.push_back(new Label("std_12px", "Game paused by", Vector2dT(w / 2, h / 7), 3));
 
@@ -48,14 +49,15 @@ void PauseMenu::render() {
     for (auto& lbl : m_labels) {
         lbl->render();
     }
-    Vector2dT p(Window::getWindow().w() / 2 - 24, Window::getWindow().h() / 7 + 100);
+    Vector2dT p(EngineContext::current().getWidth() / 2 - 24,
+                EngineContext::current().getHeight() / 7 + 100);
     m_player->renderStatic(p);
 }
 
 void PauseMenu::handleInput(InputType type, const Input* input, bool state, float /*angle*/) {
     // Check, if the return button was pressed from the input that opened this menu.
     if (type == InputType::INPUT_RETURN && state && input == m_player->getInput()) {
-        Window::getEngine().getGame()->resume();
+        EngineContext::current().getEngine().getGame()->resume();
         Window::getWindow().closeCurrentMenu();
     }
 }
@@ -4,12 +4,15 @@
 // This file is licensed under the MIT license; see LICENSE file in the root of this
 // project for details.
 
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
 
 #include <boost/filesystem.hpp>
 
 #include "engine/Engine.hpp"
+#include "engine/EngineContext.hpp"
+#include "engine/core/PlayerSprites.hpp"
 #include "engine/gui/Label.hpp"
 #include "engine/input/InputManager.hpp"
 #include "engine/input/Keyboard.hpp"
@@ -24,51 +27,39 @@ namespace engine {
 
 StartMenu::StartMenu(parser::GameConfig* config)
     : m_gameconfig(config),
+      m_looks(0),
       m_lastRenderTicks(0),
       m_selected(0),
       m_startEnabled(true),
+      m_fillAI(false),
       m_freePlayersUsed(true) {
     setFPS(4);  // blick with 4 fps
-    setupPlayers();
     setupUI();
 }
 
-void StartMenu::setupPlayers() {
-    uint32_t max_players = static_cast<uint32_t>(m_gameconfig->getPlayers().size());
-    Player* player = nullptr;
-    parser::PlayerConfig* config;
-
-    // Create all players.
-    for (uint32_t i = 0; i < max_players; i++) {
-        // get the config
-        config = m_gameconfig->getPlayers()[i];
-
-        player =
-            new Player(Team::R2L, Window::getWindow().loadTexture(config->getName()),
-                       config->getFrameWidth(), config->getFrameHeight(), config->getNumFrames());
-        player->setFPS(14);
-
-        m_playersUnused.push_back(player);
+Player* StartMenu::takePlayer() {
+    Player* player;
+    if (m_playersUnused.empty()) {
+        // every input gets a look of its own, palette swaps after the player configs
+        player = EngineContext::current().getEngine().getPlayerSprites().createPlayer(Team::R2L,
+                                                                                      m_looks++);
+    } else {
+        player = m_playersUnused.back();
+        m_playersUnused.pop_back();
     }
+    m_playersUsed.push_back(player);
+    return player;
 }
 
 void StartMenu::registerInputs(const std::vector<Input*> inputs) {
     // call base function
     Menu::registerInputs(inputs);
 
-    // Check, if not too much inputs are there.
-    uint64_t maxPlayers = m_gameconfig->getPlayers().size();
-    if (inputs.size() > maxPlayers) {
-        throw std::runtime_error("Too Many Inputs!");
-    }
-
     // Map all teams to the given inputs
     Team team = Team::R2L;
     for (Input* i : inputs) {
         // get player and save it to m_playersUsed
-        Player* player = m_playersUnused.back();
-        m_playersUnused.pop_back();
-        m_playersUsed.push_back(player);
+        Player* player = takePlayer();
 
         // register input
         player->registerInput(i);
@@ -82,19 +73,31 @@ void StartMenu::registerInputs(const std::vector<Input*> inputs) {
         }
     }
 
-    // Update divider height
-    updateDividerHeight();
     updateStartEntry();
 }
 
+size_t StartMenu::countL2RPlayers() const {
+    return static_cast<size_t>(
+        std::count_if(m_playersUsed.begin(), m_playersUsed.end(),
+                      [](Player* player) { return player->getTeam() == Team::L2R; }));
+}
+
+int StartMenu::getPlayerSpacing(size_t teamSize) {
+    // the rows of a large team shrink to fit between the team labels and the window bottom
+    int available = EngineContext::current().getHeight() * 8 / 10 - 50;
+    return std::min(60, available / std::max(static_cast<int>(teamSize), 1));
+}
+
 void StartMenu::updateDividerHeight() {
-    int height = static_cast<int>(m_playersUsed.size()) * 60 + 100;
+    size_t teamL2R = countL2RPlayers();
+    size_t teamSize = std::max(teamL2R, m_playersUsed.size() - teamL2R);
+    int height = static_cast<int>(teamSize) * getPlayerSpacing(teamSize) + 100;
     m_divider->setH(height);
 }
 
 void StartMenu::setupUI() {
-    int w = Window::getWindow().w();
-    int h = Window::getWindow().h();
+    int w = EngineContext::current().getWidth();
+    int h = EngineContext::current().getHeight();
 
     // one tenths of padding here.
     int menuX = w / 10;
@@ -109,10 +112,9 @@ void StartMenu::setupUI() {
 
     m_menuLabels.emplace_back(new Label("std_12px", "Highscores", Vector2dT(menuX, menuY += 30), 2),
                               StartMenuAction::Highscores);
-    // Just add the enable/disable keyboard only, if there are other controls and not too much.
-    uint64_t maxPlayers = m_gameconfig->getPlayers().size();
+    // Just add the enable/disable keyboard only, if there are other controls.
     uint64_t inputs = Window::getInputManager().getInputs().size();
-    if (inputs > 1 && inputs < maxPlayers) {
+    if (inputs > 1) {
         std::string kb;
         if (Window::getInputManager().hasKeyboard()) {
             kb = "Disable keyboard";
@@ -124,6 +126,8 @@ void StartMenu::setupUI() {
     } else {
         m_lblKeyboard = nullptr;
     }
+    m_lblFillAI = new Label("std_12px", "AI fill-in: off", Vector2dT(menuX, menuY += 30), 2);
+    m_menuLabels.emplace_back(m_lblFillAI, StartMenuAction::FillAI);
     m_menuLabels.emplace_back(new Label("std_12px", "Edit game", Vector2dT(menuX, menuY += 30), 2),
                               StartMenuAction::EditGame);
     m_menuLabels.emplace_back(new Label("std_12px", "Credits", Vector2dT(menuX, menuY += 30), 2),
@@ -181,21 +185,28 @@ void StartMenu::render() {
 }
 
 void StartMenu::renderPlayers() {
-    int w = Window::getWindow().w();
-    int h = Window::getWindow().h();
+    int w = EngineContext::current().getWidth();
+    int h = EngineContext::current().getHeight();
 
     int xBase = (w * 9) / 10 - 405;
     int y = h / 10 + 50;
-    // iterate over all players
+    size_t teamL2R = countL2RPlayers();
+    size_t teamR2L = m_playersUsed.size() - teamL2R;
+
+    // every team has its own column, the sprites shrink with the rows
+    int spacing = getPlayerSpacing(std::max(teamL2R, teamR2L));
+    float scale = static_cast<float>(spacing) / 60.0f;
+    int offset = 24 * spacing / 60;
+    int rowL2R = 0;
+    int rowR2L = 0;
     for (auto& player : m_playersUsed) {
         if (player->getTeam() == Team::R2L) {
-            Vector2dT p(xBase + 305 - 24, y);
-            player->renderStatic(p);
+            Vector2dT p(xBase + 305 - offset, y + rowR2L++ * spacing);
+            player->renderStatic(p, scale);
         } else {
-            Vector2dT p(xBase + 100 - 24, y);
-            player->renderStatic(p);
+            Vector2dT p(xBase + 100 - offset, y + rowL2R++ * spacing);
+            player->renderStatic(p, scale);
         }
-        y += 60;
     }
 }
 
@@ -257,7 +268,10 @@ void StartMenu::select() {
     switch (m_menuLabels[m_selected].second) {
         case StartMenuAction::Start:
             m_freePlayersUsed = false;
-            Window::getEngine().getGame()->startGame(m_playersUsed);
+            if (m_fillAI) {
+                EngineContext::current().getEngine().fillWithAI(m_playersUsed);
+            }
+            EngineContext::current().getEngine().getGame()->startGame(m_playersUsed);
             Window::getWindow().closeCurrentMenu();
             break;
 
@@ -272,6 +286,12 @@ void StartMenu::select() {
             }
             break;
 
+        case StartMenuAction::FillAI:
+            m_fillAI = !m_fillAI;
+            m_lblFillAI->setText(m_fillAI ? "AI fill-in: on" : "AI fill-in: off");
+            updateStartEntry();
+            break;
+
         case StartMenuAction::EditGame: {
             Window::getWindow().quit();
 
@@ -290,8 +310,8 @@ void StartMenu::select() {
             }
 
             if (found) {
-                boost::filesystem::path absoluteGameXml =
-                    boost::filesystem::canonical(Window::getEngine().getGameFile());
+                boost::filesystem::path absoluteGameXml = boost::filesystem::canonical(
+                    EngineContext::current().getEngine().getGameFile());
 
                 // execute it!
                 execl(editorPath.c_str(), "ctb-editor", absoluteGameXml.string().c_str(), nullptr);
@@ -325,8 +345,9 @@ void StartMenu::updateStartEntry() {
     }
 
     // One team is empty, so disable start.
-    // But only, if the -d argument was not given...
-    if ((r2l_empty || l2r_empty) && !Window::isDebug()) {
+    // But only, if the -d argument was not given or AI players fill the empty team...
+    bool filled = m_fillAI && !m_playersUsed.empty();
+    if ((r2l_empty || l2r_empty) && !Window::isDebug() && !filled) {
         Color c(128, 128, 128);
         m_lblStart->setColor(c);
         m_lblStart->setShow(true);
@@ -340,6 +361,7 @@ void StartMenu::updateStartEntry() {
         m_lblStart->setShow(true);
         m_startEnabled = true;
     }
+    updateDividerHeight();
 }
 
 void StartMenu::toggleKeyboard() {
@@ -372,15 +394,12 @@ void StartMenu::toggleKeyboard() {
         registerInput(k);
 
         // use player
-        Player* player = m_playersUnused.back();
-        m_playersUnused.pop_back();
+        Player* player = takePlayer();
         player->setTeam(Team::L2R);
         player->registerInput(k);
-        m_playersUsed.push_back(player);
 
         m_lblKeyboard->setText("Disable keyboard");
     }
-    updateDividerHeight();
     updateStartEntry();
 }
 
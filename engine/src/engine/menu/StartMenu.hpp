@@ -21,7 +21,7 @@ namespace engine {
 class Label;
 
 /// Enumerates all actions possible in this menu.
-enum class StartMenuAction { Start, Highscores, Keyboard, EditGame, Credits, Quit };
+enum class StartMenuAction { Start, Highscores, Keyboard, FillAI, EditGame, Credits, Quit };
 
 /// \brief The Start menu to launch the game, see credits and highscores, team assignments
 ///        and launch of the game editor
@@ -44,8 +44,15 @@ class StartMenu : public Menu {
     ~StartMenu() override;
 
    private:
-    /// Sets up all possible players. Put them into the m_playersUnused.
-    void setupPlayers();
+    /// Moves an unused player to m_playersUsed, a new one with the next look if there is none
+    Player* takePlayer();
+
+    /// Returns the number of used players in the L2R team
+    size_t countL2RPlayers() const;
+
+    /// Returns the vertical distance of the players in the team table, it shrinks for large
+    /// teams
+    static int getPlayerSpacing(size_t teamSize);
 
     /// Setup all needed ui elements.
     void setupUI();
@@ -71,6 +78,9 @@ class StartMenu : public Menu {
     /// The gameconfig is needed to create all players from the level config.
     parser::GameConfig* m_gameconfig;
 
+    /// The look of the next new player
+    uint32_t m_looks;
+
     /// List of all players, that are not mapped to inputs, so not used
     std::vector<Player*> m_playersUnused;
 
@@ -92,6 +102,9 @@ class StartMenu : public Menu {
     /// The toggle keyboard label
     Label* m_lblKeyboard;
 
+    /// The toggle AI fill-in label
+    Label* m_lblFillAI;
+
     /// All labels that have an select action mapped to them
     std::vector<std::pair<Label*, StartMenuAction>> m_menuLabels;
 
@@ -110,6 +123,9 @@ class StartMenu : public Menu {
     /// Save, if the start label is enabled
     bool m_startEnabled;
 
+    /// Add AI players to even the teams when the game starts
+    bool m_fillAI;
+
     /// Save if this menu should free all used players or give the
     /// ownership to the game
     bool m_freePlayersUsed;
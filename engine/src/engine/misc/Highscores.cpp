@@ -11,6 +11,7 @@
 
 #include <boost/filesystem.hpp>
 
+#include "engine/EngineContext.hpp"
 #include "engine/misc/Highscores.hpp"
 
 using namespace boost::filesystem;
@@ -18,8 +19,6 @@ using namespace boost::filesystem;
 namespace ctb {
 namespace engine {
 
-std::vector<std::pair<std::string, uint64_t>> Highscores::highscores;
-
 // 10 Scores should be enough
 uint32_t Highscores::MAX_HIGHSCORES = 10;
 
@@ -28,10 +27,10 @@ uint32_t Highscores::MAX_HIGHSCORES = 10;
 // The second line is tha actual score. We have to do this with seperate lines, because
 // the name is a sting and may contains numbers. During parsing the file, the name length
 // is cut to 16 characters.
-std::string Highscores::m_highscorePath;
-
 void Highscores::init(const std::string& highscorePath) {
-    m_highscorePath = highscorePath;
+    EngineContext& context = EngineContext::current();
+    context.m_highscorePath = highscorePath;
+    auto& highscores = context.m_highscores;
     path p(highscorePath);
     // Load the file, if it ok
     if (exists(p) && is_regular_file(p)) {
@@ -65,15 +64,17 @@ void Highscores::init(const std::string& highscorePath) {
 }
 
 void Highscores::sortScores() {
+    auto& highscores = EngineContext::current().m_highscores;
     std::sort(highscores.begin(), highscores.end(),
               [](auto& left, auto& right) { return left.second > right.second; });
 }
 
 std::vector<std::pair<std::string, uint64_t>>& Highscores::getScores() {
-    return highscores;
+    return EngineContext::current().m_highscores;
 }
 
 uint32_t Highscores::isHighscore(uint64_t score) {
+    auto& highscores = EngineContext::current().m_highscores;
     if (score == 0) {
         return 0;
     }
@@ -94,6 +95,7 @@ uint32_t Highscores::isHighscore(uint64_t score) {
 }
 
 void Highscores::insert(const std::string& name, const uint64_t score) {
+    auto& highscores = EngineContext::current().m_highscores;
     // check, if the score is valied
     if (isHighscore(score)) {
         // Add the score
@@ -121,7 +123,9 @@ std::string Highscores::formatScore(const uint64_t score, const uint32_t padding
 }
 
 void Highscores::save() {
-    std::ofstream file(m_highscorePath, std::ios_base::trunc);
+    const EngineContext& context = EngineContext::current();
+    const auto& highscores = context.m_highscores;
+    std::ofstream file(context.m_highscorePath, std::ios_base::trunc);
 
     if (file.is_open()) {
         for (auto& entry : highscores) {
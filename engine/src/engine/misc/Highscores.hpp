@@ -13,7 +13,7 @@
 namespace ctb {
 namespace engine {
 
-/// Manage save and load of highscores
+/// Manage save and load of the highscores of the current EngineContext
 class Highscores {
    public:
     /// Static-only class:
@@ -58,12 +58,6 @@ class Highscores {
     /// The number of max highsores saved.
     static uint32_t MAX_HIGHSCORES;
 
-    /// The Path of the highscore file.
-    static std::string m_highscorePath;
-
-    /// The actual highscores. This vector has always to be sorted!
-    static std::vector<std::pair<std::string, uint64_t>> highscores;
-
     /// Helper function to sort the highscore vector. Should be called after all
     /// modifications of this vector.
     static void sortScores();
@@ -0,0 +1,94 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+
+#include "engine/Window.hpp"
+#include "engine/input/InputManager.hpp"
+#include "engine/net/ClientPlay.hpp"
+#include "engine/net/NetworkInput.hpp"
+#include "engine/net/StateClient.hpp"
+#include "engine/net/UdpTransport.hpp"
+#include "engine/util/Clock.hpp"
+
+namespace ctb {
+namespace engine {
+
+namespace {
+/// Maximum number of inputs sent in one update, the rest of a long frame is skipped
+constexpr uint32_t kMaxTicksPerUpdate = 4;
+}  // namespace
+
+constexpr double ClientPlay::RENDER_DELAY;
+constexpr double ClientPlay::MAX_DRIFT;
+constexpr uint32_t ClientPlay::STATS_INTERVAL;
+
+ClientPlay::ClientPlay(Engine& engine, const ClientArguments& args)
+    : m_mirror(engine), m_lastTime(SDL_GetTicks()) {
+    std::vector<Input*>& devices = Window::getInputManager().getInputs();
+    if (devices.empty()) {
+        throw std::runtime_error("A network game needs an input device");
+    }
+    m_udp = new UdpTransport(args.localPort, args.host, args.port);
+    m_client = new StateClient(*m_udp);
+    m_sampler = new InputSampler(devices.front());
+}
+
+void ClientPlay::update() {
+    uint32_t now = SDL_GetTicks();
+    uint32_t elapsed = now - m_lastTime;
+    m_lastTime = now;
+    m_pending = std::min(m_pending + elapsed, kMaxTicksPerUpdate * Clock::FIXED_STEP);
+    while (m_pending >= Clock::FIXED_STEP) {
+        m_pending -= Clock::FIXED_STEP;
+        m_client->sendInput(m_sampler->sample());
+        if (Window::isVerbose() && ++m_inputs % STATS_INTERVAL == 0) {
+            printStats(std::cout);
+        }
+    }
+
+    m_client->receive();
+    const WorldState* latest = m_client->getLatest();
+    if (latest == nullptr) {
+        return;
+    }
+    if (m_mirror.getGame() == nullptr || m_client->getSeed() != m_mirror.getSeed()) {
+        m_mirror.start(m_client->getSeed(), *latest);
+        m_renderTick = latest->tick - RENDER_DELAY;
+    }
+
+    // the displayed tick runs with the wall clock and only jumps if it drifts too far
+    m_renderTick += static_cast<double>(elapsed) / Clock::FIXED_STEP;
+    double target = latest->tick - RENDER_DELAY;
+    if (std::abs(m_renderTick - target) > MAX_DRIFT) {
+        m_renderTick = target;
+    }
+    m_client->sample(m_renderTick, m_sampled);
+    m_mirror.apply(m_sampled);
+}
+
+void ClientPlay::printStats(std::ostream& out) const {
+    const StateClientStats& stats = m_client->getStats();
+    const WorldState* latest = m_client->getLatest();
+    out << "client: latest tick " << (latest ? static_cast<int64_t>(latest->tick) : -1)
+        << " displayed " << m_renderTick << " snapshots " << stats.snapshots << " ("
+        << stats.outdatedSnapshots << " outdated, " << stats.missingBaselines
+        << " without baseline, " << stats.invalidPackets << " invalid) bytes "
+        << stats.bytesReceived << " inputs " << stats.packetsSent << " errors "
+        << m_udp->getErrors() << std::endl;
+}
+
+ClientPlay::~ClientPlay() {
+    delete m_sampler;
+    delete m_client;
+    delete m_udp;
+}
+
+}  // namespace engine
+}  // namespace ctb
@@ -0,0 +1,96 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_NET_CLIENTPLAY_HPP
+#define ENGINE_NET_CLIENTPLAY_HPP
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+#include "engine/net/MirrorGame.hpp"
+#include "engine/net/WorldState.hpp"
+
+namespace ctb {
+namespace engine {
+
+class Engine;
+class InputSampler;
+class StateClient;
+class UdpTransport;
+
+/// Arguments of a client of a server
+struct ClientArguments {
+    /// host name or address of the server
+    std::string host{};
+    /// UDP port of the server
+    uint16_t port{0};
+    /// the local UDP port, 0 for any free port
+    uint16_t localPort{0};
+};
+
+/**
+ * @brief Plays on a ServerPlay: sends the input of the first input device and displays the
+ *        states streamed by the server in a MirrorGame, interpolated RENDER_DELAY ticks in
+ *        the past.
+ */
+class ClientPlay {
+   public:
+    /**
+     * @brief Opens the connection, the game starts with the first received state
+     *
+     * @param engine    the engine to create the mirror game with
+     * @param args      the server
+     *
+     * @throws runtime_error if the socket can't be opened or there is no input device
+     */
+    ClientPlay(Engine& engine, const ClientArguments& args);
+    ClientPlay(const ClientPlay&) = delete;
+    ClientPlay& operator=(const ClientPlay&) = delete;
+
+    /// Sends the input if a tick is due and displays the latest states
+    void update();
+
+    /// Writes the statistics of the connection
+    void printStats(std::ostream& out) const;
+
+    /// Destructor, stops the game
+    ~ClientPlay();
+
+    /// Number of ticks the displayed state is behind the latest received one
+    static constexpr double RENDER_DELAY = 6.0;
+
+    /// The displayed tick jumps to the target if it drifts further away than this
+    static constexpr double MAX_DRIFT = 8.0;
+
+   private:
+    /// Number of sent inputs after which the statistics are printed in verbose mode
+    static constexpr uint32_t STATS_INTERVAL = 400;
+
+    /// displays the received states
+    MirrorGame m_mirror;
+
+    UdpTransport* m_udp{nullptr};
+    StateClient* m_client{nullptr};
+    /// records the local device
+    InputSampler* m_sampler{nullptr};
+
+    /// the displayed tick
+    double m_renderTick{0};
+    /// the displayed state, its memory is reused
+    WorldState m_sampled;
+
+    /// wall clock time of the last update in ms
+    uint32_t m_lastTime;
+    /// wall clock time since the last sent input in ms
+    uint32_t m_pending{0};
+    uint32_t m_inputs{0};
+};
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_NET_CLIENTPLAY_HPP
@@ -0,0 +1,43 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#include "engine/net/ConditionedTransport.hpp"
+
+namespace ctb {
+namespace engine {
+
+ConditionedTransport::ConditionedTransport(Transport& inner,
+                                           const LinkConditions& conditions,
+                                           uint32_t seed)
+    : m_inner(inner), m_conditions(conditions), m_random(seed) {}
+
+void ConditionedTransport::send(const uint8_t* data, size_t size) {
+    if (m_conditions.loss > 0.0f && m_random.getFloat() < m_conditions.loss) {
+        ++m_dropped;
+        return;
+    }
+    uint32_t delay = m_conditions.latency;
+    if (m_conditions.jitter > 0) {
+        delay += static_cast<uint32_t>(m_random.getInt(0, static_cast<int>(m_conditions.jitter)));
+    }
+    if (delay == 0) {
+        m_inner.send(data, size);
+    } else if (!m_delayed.push(data, size, m_time + delay)) {
+        ++m_dropped;
+    }
+}
+
+void ConditionedTransport::update() {
+    ++m_time;
+    size_t size;
+    while ((size = m_delayed.pop(m_packet, m_time)) > 0) {
+        m_inner.send(m_packet, size);
+    }
+    m_inner.update();
+}
+
+}  // namespace engine
+}  // namespace ctb
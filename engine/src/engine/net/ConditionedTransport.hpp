@@ -0,0 +1,69 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_NET_CONDITIONEDTRANSPORT_HPP
+#define ENGINE_NET_CONDITIONEDTRANSPORT_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "engine/net/Transport.hpp"
+#include "engine/util/Random.hpp"
+
+namespace ctb {
+namespace engine {
+
+/// The simulated quality of a connection
+struct LinkConditions {
+    /// delay of every packet in ticks
+    uint32_t latency{0};
+    /// additional random delay of every packet in ticks, reorders packets
+    uint32_t jitter{0};
+    /// probability that a packet is lost, in [0, 1]
+    float loss{0.0f};
+};
+
+/**
+ * @brief Wraps a transport and delays or drops the sent packets according to LinkConditions,
+ *        to test network games on a single machine. The time advances by one tick with every
+ *        update(). The decisions are seeded, so a test with a LoopbackLink is reproducible.
+ */
+class ConditionedTransport : public Transport {
+   public:
+    /**
+     * @brief Constructor
+     *
+     * @param inner         the transport to send the delayed packets with
+     * @param conditions    the simulated connection
+     * @param seed          the seed of the loss and jitter decisions
+     */
+    ConditionedTransport(Transport& inner, const LinkConditions& conditions, uint32_t seed);
+
+    void send(const uint8_t* data, size_t size) override;
+
+    size_t receive(uint8_t* buffer) override { return m_inner.receive(buffer); }
+
+    /// Advances the time by one tick and sends the packets that are due
+    void update() override;
+
+    /// Returns the number of packets dropped on purpose or because too many were delayed
+    uint32_t getDropped() const { return m_dropped; }
+
+   private:
+    Transport& m_inner;
+    LinkConditions m_conditions;
+    Random m_random;
+    PacketQueue m_delayed;
+    uint32_t m_time{0};
+    uint32_t m_dropped{0};
+    /// buffer for the packet sent next
+    uint8_t m_packet[MAX_PACKET_SIZE];
+};
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_NET_CONDITIONEDTRANSPORT_HPP
@@ -0,0 +1,41 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_NET_INPUTFRAME_HPP
+#define ENGINE_NET_INPUTFRAME_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ctb {
+namespace engine {
+
+/**
+ * @brief The state of the gameplay inputs of one player in one tick, the unit that is exchanged
+ *        between the peers of a network game.
+ *
+ * Every bit of buttons is the pressed state of one InputType, see NETWORK_BUTTONS in
+ * NetworkInput.hpp. Menu inputs and pause are never exchanged.
+ */
+struct InputFrame {
+    uint16_t buttons{0};
+    /// the aiming angle in degrees, between -90 and 90
+    int8_t aim{0};
+
+    bool operator==(const InputFrame& other) const {
+        return buttons == other.buttons && aim == other.aim;
+    }
+
+    bool operator!=(const InputFrame& other) const { return !(*this == other); }
+};
+
+/// Number of bytes of a serialized InputFrame
+constexpr size_t INPUT_FRAME_SIZE = 3;
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_NET_INPUTFRAME_HPP
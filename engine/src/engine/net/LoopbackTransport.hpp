@@ -0,0 +1,58 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_NET_LOOPBACKTRANSPORT_HPP
+#define ENGINE_NET_LOOPBACKTRANSPORT_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "engine/net/Transport.hpp"
+
+namespace ctb {
+namespace engine {
+
+/**
+ * @brief Two transports connected in memory, for tests and local sessions. Packets are
+ *        delivered in order with the next receive of the other end, unless the queue of the
+ *        other end is full. Combine with ConditionedTransport to add latency and loss.
+ */
+class LoopbackLink {
+   public:
+    LoopbackLink() : m_first(m_toSecond, m_toFirst), m_second(m_toFirst, m_toSecond) {}
+    LoopbackLink(const LoopbackLink&) = delete;
+    LoopbackLink& operator=(const LoopbackLink&) = delete;
+
+    /// Returns one end of the link
+    Transport& first() { return m_first; }
+
+    /// Returns the other end of the link
+    Transport& second() { return m_second; }
+
+   private:
+    class End : public Transport {
+       public:
+        End(PacketQueue& out, PacketQueue& in) : m_out(out), m_in(in) {}
+
+        void send(const uint8_t* data, size_t size) override { m_out.push(data, size, 0); }
+
+        size_t receive(uint8_t* buffer) override { return m_in.pop(buffer, 0); }
+
+       private:
+        PacketQueue& m_out;
+        PacketQueue& m_in;
+    };
+
+    PacketQueue m_toFirst;
+    PacketQueue m_toSecond;
+    End m_first;
+    End m_second;
+};
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_NET_LOOPBACKTRANSPORT_HPP
@@ -0,0 +1,140 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#include <cmath>
+
+#include "engine/Engine.hpp"
+#include "engine/core/Game.hpp"
+#include "engine/core/Level.hpp"
+#include "engine/core/PlayerSprites.hpp"
+#include "engine/net/MirrorGame.hpp"
+#include "engine/net/StateProtocol.hpp"
+#include "engine/scene/Bot.hpp"
+#include "engine/scene/Flag.hpp"
+#include "engine/scene/Player.hpp"
+
+namespace ctb {
+namespace engine {
+
+namespace {
+/// Returns the position in pixels of an entity
+Vector2dT pixelPosition(const EntityState& entity) {
+    return {static_cast<int>(std::lround(EntityState::dequantize(entity.x))),
+            static_cast<int>(std::lround(EntityState::dequantize(entity.y)))};
+}
+}  // namespace
+
+void MirrorGame::start(uint32_t seed, const WorldState& state) {
+    // the players of the previous game are deleted together with it
+    m_game = m_engine.newGame(seed);
+    m_seed = seed;
+    m_players.clear();
+    m_bots.clear();
+    m_flagHolder = WorldState::NO_ENTITY;
+
+    for (const EntityState& entity : state.entities) {
+        if (entity.kind != EntityKind::Player || entity.id != m_players.size()) {
+            continue;
+        }
+        // the variant of a player is its look
+        Team team = (entity.flags & EntityState::TEAM_R2L) != 0 ? Team::R2L : Team::L2R;
+        Player* player = m_engine.getPlayerSprites().createPlayer(team, entity.variant);
+        m_players.push_back(player);
+    }
+    m_game->startGame(m_players);
+    clearBots();
+}
+
+void MirrorGame::clearBots() {
+    Level* level = m_game->getCurrentLevel();
+    // deleting changes the bots of the level
+    std::vector<Bot*> bots = level->getBots();
+    for (Bot* bot : bots) {
+        level->deleteBot(bot);
+    }
+    level->flushDestroyed();
+    m_bots.clear();
+}
+
+void MirrorGame::apply(const WorldState& state) {
+    if (state.level != m_game->getCurrentLevelIndex() && state.level < m_game->getLevelCount()) {
+        // starting a level binds the flag to its holder, so the holder is set again afterwards
+        for (Player* player : m_players) {
+            player->setHasFlag(false);
+        }
+        m_flagHolder = WorldState::NO_ENTITY;
+        m_game->startLevel(state.level);
+        // the bots of an earlier visit of the level are outdated
+        clearBots();
+    }
+    Level* level = m_game->getCurrentLevel();
+    ++m_applied;
+
+    for (const EntityState& entity : state.entities) {
+        if (entity.kind == EntityKind::Player) {
+            if (entity.id >= m_players.size()) {
+                continue;
+            }
+            Player* player = m_players[entity.id];
+            player->setPosition(pixelPosition(entity));
+            player->showAnimationStep(entity.frame);
+            player->setFacesRight((entity.flags & EntityState::FACING_LEFT) == 0);
+            player->setHealth(entity.health);
+        } else if (entity.kind == EntityKind::Flag) {
+            level->getFlag()->setPosition(pixelPosition(entity));
+            level->getFlag()->showAnimationStep(entity.frame);
+        } else {
+            auto it = m_bots.find(entity.id);
+            if (it == m_bots.end()) {
+                // nullptr for a prefab the game config doesn't have
+                Bot* bot = level->spawnBot(entity.variant, pixelPosition(entity));
+                if (bot == nullptr) {
+                    continue;
+                }
+                it = m_bots.insert({entity.id, {bot, m_applied}}).first;
+            }
+            Bot* bot = it->second.bot;
+            it->second.applied = m_applied;
+            bot->setPosition(pixelPosition(entity));
+            bot->showAnimationStep(entity.frame);
+            bot->setFacesRight((entity.flags & EntityState::FACING_LEFT) == 0);
+        }
+    }
+
+    // the bots that died or left the captured area
+    for (auto it = m_bots.begin(); it != m_bots.end();) {
+        if (it->second.applied != m_applied) {
+            level->deleteBot(it->second.bot);
+            it = m_bots.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    level->flushDestroyed();
+
+    if (state.flagHolder != m_flagHolder) {
+        m_flagHolder = state.flagHolder;
+        Player* holder = getPlayer(m_flagHolder);
+        for (Player* player : m_players) {
+            player->setHasFlag(player == holder);
+        }
+        // the camera follows the flag, like in the captured game
+        if (holder != nullptr) {
+            level->getCamera().setFocus(holder);
+        } else {
+            level->getCamera().setFocus(level->getFlag());
+        }
+    }
+}
+
+MirrorGame::~MirrorGame() {
+    if (m_game != nullptr) {
+        m_engine.stopGame();
+    }
+}
+
+}  // namespace engine
+}  // namespace ctb
@@ -0,0 +1,92 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_NET_MIRRORGAME_HPP
+#define ENGINE_NET_MIRRORGAME_HPP
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include <SDL.h>
+
+#include "engine/net/WorldState.hpp"
+
+namespace ctb {
+namespace engine {
+
+class Bot;
+class Engine;
+class Game;
+class Player;
+
+/**
+ * @brief A game that displays world states captured elsewhere, e.g. streamed by a server or
+ *        recorded in a replay.
+ *
+ * The game is created with the seed of the captured game, so it has the same levels. It is
+ * never simulated: its players, bots and flag are only moved to the positions of the states.
+ */
+class MirrorGame {
+   public:
+    /// Constructor, the game is started by start()
+    explicit MirrorGame(Engine& engine) : m_engine(engine) {}
+    MirrorGame(const MirrorGame&) = delete;
+    MirrorGame& operator=(const MirrorGame&) = delete;
+
+    /**
+     * @brief Replaces the game of the engine by a new one with the players of state
+     *
+     * @param seed  the seed of the captured game
+     * @param state a state of the captured game, players have the ids 0 to n - 1
+     */
+    void start(uint32_t seed, const WorldState& state);
+
+    /// Moves the players, bots and the flag to state
+    void apply(const WorldState& state);
+
+    /// Returns the game or nullptr if it wasn't started
+    Game* getGame() const { return m_game; }
+
+    /// Returns the seed of the game
+    uint32_t getSeed() const { return m_seed; }
+
+    /// Returns the player with id or nullptr
+    Player* getPlayer(uint16_t id) const {
+        return id < m_players.size() ? m_players[id] : nullptr;
+    }
+
+    /// Destructor, stops the game
+    ~MirrorGame();
+
+   private:
+    /// Deletes all bots of the current level
+    void clearBots();
+
+    Engine& m_engine;
+    Game* m_game{nullptr};
+    uint32_t m_seed{0};
+
+    /// the players by id
+    std::vector<Player*> m_players;
+    /// id of the player displayed with the flag
+    uint16_t m_flagHolder{WorldState::NO_ENTITY};
+
+    /// A bot of the game and the last applied state it was part of
+    struct MirrorBot {
+        Bot* bot;
+        uint32_t applied;
+    };
+    /// the bots of the current level by id
+    std::map<uint16_t, MirrorBot> m_bots;
+    /// number of applied states
+    uint32_t m_applied{0};
+};
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_NET_MIRRORGAME_HPP
@@ -0,0 +1,91 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+#include <SDL.h>
+
+#include "engine/Engine.hpp"
+#include "engine/Window.hpp"
+#include "engine/core/Game.hpp"
+#include "engine/input/InputManager.hpp"
+#include "engine/net/NetPlay.hpp"
+#include "engine/net/NetworkGame.hpp"
+#include "engine/net/NetworkInput.hpp"
+#include "engine/net/UdpTransport.hpp"
+#include "engine/util/Clock.hpp"
+
+namespace ctb {
+namespace engine {
+
+namespace {
+/// Maximum number of ticks simulated in one update, the rest of a long frame is skipped
+constexpr uint32_t kMaxTicksPerUpdate = 4;
+}  // namespace
+
+constexpr uint32_t NetPlay::STATS_INTERVAL;
+
+NetPlay::NetPlay(Engine& engine, const NetworkArguments& args) : m_lastTime(SDL_GetTicks()) {
+    std::vector<Input*>& devices = Window::getInputManager().getInputs();
+    if (devices.empty()) {
+        throw std::runtime_error("A network game needs an input device");
+    }
+    if (!Clock::isFixedStep()) {
+        throw std::logic_error("A network game has to run in fixed steps");
+    }
+
+    m_udp = new UdpTransport(args.port, args.peerHost, args.peerPort);
+    // the conditions are applied to the sent packets, to the received ones by the remote peer
+    m_conditioned = new ConditionedTransport(*m_udp, args.conditions, args.port);
+
+    m_game = new NetworkGame(engine, engine.newGame());
+    m_sampler = new InputSampler(devices.front());
+    // player 0 (L2R) is controlled by the host, player 1 (R2L) by the other peer
+    m_session = new RollbackSession(*m_game, *m_conditioned, NetworkGame::PLAYER_COUNT,
+                                    args.host ? 1u : 2u, m_game->getGame()->getSeed(),
+                                    args.inputDelay);
+}
+
+void NetPlay::update() {
+    uint32_t now = SDL_GetTicks();
+    m_pending = std::min(m_pending + (now - m_lastTime), kMaxTicksPerUpdate * Clock::FIXED_STEP);
+    m_lastTime = now;
+
+    while (m_pending >= Clock::FIXED_STEP) {
+        m_pending -= Clock::FIXED_STEP;
+        InputFrame local = m_sampler->sample();
+        m_session->advanceFrame(&local);
+
+        const RollbackStats& stats = m_session->getStats();
+        if (Window::isVerbose() && (stats.ticks + stats.stalls) % STATS_INTERVAL == 0) {
+            printStats(std::cout);
+        }
+    }
+}
+
+void NetPlay::printStats(std::ostream& out) const {
+    const RollbackStats& stats = m_session->getStats();
+    out << "network: tick " << m_session->getTick() << " confirmed "
+        << m_session->getConfirmedTick() << " rollbacks " << stats.rollbacks << " (resimulated "
+        << stats.resimulatedTicks << " ticks, max " << stats.maxRollback << ") stalls "
+        << stats.stalls << " packets " << stats.packetsSent << "/" << stats.packetsReceived
+        << " sent/received, " << stats.invalidPackets << " invalid, "
+        << m_conditioned->getDropped() << " dropped, " << m_udp->getErrors()
+        << " errors, desyncs " << stats.desyncs << std::endl;
+}
+
+NetPlay::~NetPlay() {
+    delete m_session;
+    delete m_sampler;
+    delete m_game;
+    delete m_conditioned;
+    delete m_udp;
+}
+
+}  // namespace engine
+}  // namespace ctb
@@ -0,0 +1,92 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_NET_NETPLAY_HPP
+#define ENGINE_NET_NETPLAY_HPP
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "engine/net/ConditionedTransport.hpp"
+#include "engine/net/RollbackSession.hpp"
+
+namespace ctb {
+namespace engine {
+
+class Engine;
+class InputSampler;
+class NetworkGame;
+class UdpTransport;
+
+/// Arguments of a network game
+struct NetworkArguments {
+    /// the local UDP port
+    uint16_t port{0};
+    /// host name or address of the remote peer
+    std::string peerHost{};
+    /// UDP port of the remote peer
+    uint16_t peerPort{0};
+    /// this peer controls the L2R player, the remote peer the R2L player
+    bool host{false};
+    /// ticks between sampling and applying a local input
+    uint32_t inputDelay{2};
+    /// simulated connection quality on top of the real one, for tests
+    LinkConditions conditions{};
+};
+
+/**
+ * @brief A game between two peers connected over UDP, each with one local player controlled
+ *        by the first input device. Both peers run the complete simulation in fixed steps from
+ *        the same seed and exchange their inputs via a RollbackSession.
+ */
+class NetPlay {
+   public:
+    /**
+     * @brief Opens the connection and starts a new game of engine
+     *
+     * @param engine    the engine to create the game with, it has to be in deterministic mode
+     * @param args      the connection
+     *
+     * @throws runtime_error if the socket can't be opened or there is no input device
+     */
+    NetPlay(Engine& engine, const NetworkArguments& args);
+    NetPlay(const NetPlay&) = delete;
+    NetPlay& operator=(const NetPlay&) = delete;
+
+    /// Simulates the ticks that are due since the last call
+    void update();
+
+    /// Writes the statistics of the session
+    void printStats(std::ostream& out) const;
+
+    /// Destructor, stops the game
+    ~NetPlay();
+
+   private:
+    /// Number of wall clock ticks after which the statistics are printed in verbose mode
+    static constexpr uint32_t STATS_INTERVAL = 400;
+
+    NetworkGame* m_game{nullptr};
+
+    UdpTransport* m_udp{nullptr};
+    ConditionedTransport* m_conditioned{nullptr};
+    RollbackSession* m_session{nullptr};
+
+    /// records the local device
+    InputSampler* m_sampler{nullptr};
+
+    /// wall clock time of the last update in ms
+    uint32_t m_lastTime;
+    /// wall clock time not simulated yet in ms
+    uint32_t m_pending{0};
+};
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_NET_NETPLAY_HPP
@@ -0,0 +1,72 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#include <stdexcept>
+
+#include "engine/Engine.hpp"
+#include "engine/audio/SoundManager.hpp"
+#include "engine/core/Game.hpp"
+#include "engine/core/PlayerSprites.hpp"
+#include "engine/net/NetworkGame.hpp"
+#include "engine/net/NetworkInput.hpp"
+#include "engine/scene/Player.hpp"
+#include "engine/util/Clock.hpp"
+
+namespace ctb {
+namespace engine {
+
+constexpr uint32_t NetworkGame::PLAYER_COUNT;
+
+NetworkGame::NetworkGame(Engine& engine, Game* game) : m_engine(engine), m_game(game) {
+    if (!Clock::isFixedStep()) {
+        throw std::logic_error("A network game has to run in fixed steps");
+    }
+
+    std::vector<Player*> players;
+    for (Team team : {Team::L2R, Team::R2L}) {
+        Player* player = m_engine.getPlayerSprites().createPlayer(
+            team, static_cast<uint32_t>(players.size()));
+
+        auto* input = new NetworkInput();
+        player->registerInput(input);
+        m_inputs.push_back(input);
+        players.push_back(player);
+    }
+    m_game->startGame(players);
+}
+
+void NetworkGame::saveState(std::vector<uint8_t>& state) {
+    m_game->saveSnapshot(state);
+}
+
+void NetworkGame::loadState(const std::vector<uint8_t>& state, const InputFrame* previous) {
+    m_game->restoreSnapshot(state);
+    for (size_t i = 0; i < m_inputs.size(); ++i) {
+        m_inputs[i]->reset(previous[i]);
+    }
+}
+
+void NetworkGame::advance(const InputFrame* inputs, bool resimulating) {
+    SoundManager::getInstance().setMuted(resimulating);
+    // same order as a local game: input events, then the tick
+    for (size_t i = 0; i < m_inputs.size(); ++i) {
+        m_inputs[i]->apply(inputs[i]);
+    }
+    Clock::step();
+    m_game->update();
+    SoundManager::getInstance().setMuted(false);
+}
+
+NetworkGame::~NetworkGame() {
+    // the players deregister from their inputs when they are deleted with the game
+    m_engine.stopGame();
+    for (NetworkInput* input : m_inputs) {
+        delete input;
+    }
+}
+
+}  // namespace engine
+}  // namespace ctb
@@ -0,0 +1,65 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_NET_NETWORKGAME_HPP
+#define ENGINE_NET_NETWORKGAME_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "engine/net/RollbackSession.hpp"
+
+namespace ctb {
+namespace engine {
+
+class Engine;
+class Game;
+class NetworkInput;
+
+/**
+ * @brief A game of one L2R and one R2L player, both controlled by NetworkInputs, which a
+ *        RollbackSession simulates. It is independent of the connection, so both peers of a
+ *        session can also run in one process.
+ */
+class NetworkGame : public RollbackGame {
+   public:
+    /// Number of players of a network game
+    static constexpr uint32_t PLAYER_COUNT = 2;
+
+    /**
+     * @brief Creates the players and starts the game
+     *
+     * @param engine    the engine the game belongs to, it has to run in fixed steps
+     * @param game      a new game of engine, both peers create it with the same seed
+     */
+    NetworkGame(Engine& engine, Game* game);
+    NetworkGame(const NetworkGame&) = delete;
+    NetworkGame& operator=(const NetworkGame&) = delete;
+
+    /// Returns the simulated game
+    Game* getGame() const { return m_game; }
+
+    void saveState(std::vector<uint8_t>& state) override;
+
+    void loadState(const std::vector<uint8_t>& state, const InputFrame* previous) override;
+
+    void advance(const InputFrame* inputs, bool resimulating) override;
+
+    /// Destructor, stops the game
+    ~NetworkGame() override;
+
+   private:
+    Engine& m_engine;
+    Game* m_game;
+
+    /// the inputs of all players, in the order of the session
+    std::vector<NetworkInput*> m_inputs;
+};
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_NET_NETWORKGAME_HPP
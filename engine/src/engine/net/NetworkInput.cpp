@@ -0,0 +1,80 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+#include "engine/net/NetworkInput.hpp"
+
+namespace ctb {
+namespace engine {
+
+namespace {
+/// Returns the bit of the button in InputFrame::buttons or 0 if it isn't exchanged
+uint16_t buttonBit(InputType type) {
+    for (size_t i = 0; i < NETWORK_BUTTON_COUNT; ++i) {
+        if (NETWORK_BUTTONS[i] == type) {
+            return static_cast<uint16_t>(1u << i);
+        }
+    }
+    return 0;
+}
+}  // namespace
+
+InputSampler::InputSampler(Input* device) : m_device(device) {
+    InputHandler handler =
+        std::bind(&InputSampler::handleInput, this, std::placeholders::_1, std::placeholders::_2,
+                  std::placeholders::_3, std::placeholders::_4);
+    m_handlerId = m_device->register_handler(handler);
+}
+
+InputFrame InputSampler::sample() {
+    InputFrame frame;
+    frame.buttons = static_cast<uint16_t>(m_held | m_pressed);
+    frame.aim = m_aim;
+    m_pressed = 0;
+    return frame;
+}
+
+void InputSampler::handleInput(InputType type, Input* /*input*/, bool state, float angle) {
+    if (type == InputType::INPUT_AIM_VERT) {
+        m_aim = static_cast<int8_t>(std::lround(std::max(-90.0f, std::min(90.0f, angle))));
+        return;
+    }
+    uint16_t bit = buttonBit(type);
+    if (state) {
+        m_held = static_cast<uint16_t>(m_held | bit);
+        m_pressed = static_cast<uint16_t>(m_pressed | bit);
+    } else {
+        m_held = static_cast<uint16_t>(m_held & ~bit);
+    }
+}
+
+InputSampler::~InputSampler() {
+    m_device->deregister_handler(m_handlerId);
+}
+
+void NetworkInput::apply(const InputFrame& frame) {
+    for (size_t i = 0; i < NETWORK_BUTTON_COUNT; ++i) {
+        // call_handlers skips the buttons whose state didn't change
+        call_handlers(NETWORK_BUTTONS[i], (frame.buttons >> i & 1u) != 0);
+    }
+    if (frame.aim != m_last.aim) {
+        call_handlers(InputType::INPUT_AIM_VERT, true, static_cast<float>(frame.aim));
+    }
+    m_last = frame;
+}
+
+void NetworkInput::reset(const InputFrame& frame) {
+    for (size_t i = 0; i < NETWORK_BUTTON_COUNT; ++i) {
+        setLastState(NETWORK_BUTTONS[i], (frame.buttons >> i & 1u) != 0);
+    }
+    m_last = frame;
+}
+
+}  // namespace engine
+}  // namespace ctb
@@ -0,0 +1,87 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_NET_NETWORKINPUT_HPP
+#define ENGINE_NET_NETWORKINPUT_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <SDL.h>
+
+#include "engine/input/Input.hpp"
+#include "engine/net/InputFrame.hpp"
+
+namespace ctb {
+namespace engine {
+
+/// The buttons exchanged in network games, bit i of InputFrame::buttons is the i-th button
+constexpr InputType NETWORK_BUTTONS[] = {InputType::INPUT_LEFT,  InputType::INPUT_RIGHT,
+                                         InputType::INPUT_SHOOT, InputType::INPUT_JUMP,
+                                         InputType::INPUT_HEAL,  InputType::INPUT_TAUNT,
+                                         InputType::INPUT_DROP_WEAPON};
+
+constexpr size_t NETWORK_BUTTON_COUNT = sizeof(NETWORK_BUTTONS) / sizeof(NETWORK_BUTTONS[0]);
+
+/**
+ * @brief Records the gameplay inputs of a local device as InputFrames. A button pressed and
+ *        released between two samples is reported as pressed once, so short taps aren't lost.
+ */
+class InputSampler {
+   public:
+    /// Constructor, registers a handler at device, which has to outlive the sampler
+    explicit InputSampler(Input* device);
+    InputSampler(const InputSampler&) = delete;
+    InputSampler& operator=(const InputSampler&) = delete;
+
+    /// Returns the inputs since the last sample
+    InputFrame sample();
+
+    /// Destructor, deregisters the handler
+    ~InputSampler();
+
+   private:
+    void handleInput(InputType type, Input* input, bool state, float angle);
+
+    Input* m_device;
+    uint64_t m_handlerId;
+    /// buttons currently held
+    uint16_t m_held{0};
+    /// buttons pressed since the last sample
+    uint16_t m_pressed{0};
+    int8_t m_aim{0};
+};
+
+/**
+ * @brief An input device that replays InputFrames, which controls a player in a network
+ *        game. Events are only emitted for the inputs that changed since the previous frame.
+ */
+class NetworkInput : public Input {
+   public:
+    /// Emits the events to get from the previous frame to frame
+    void apply(const InputFrame& frame);
+
+    /// Continues with frame as previous frame without emitting events, e.g. after a rollback
+    void reset(const InputFrame& frame);
+
+    /// Does nothing, the frames are applied by the network session
+    void pollInput(const Uint8*) override {}
+
+    /// Does nothing, the frames are applied by the network session
+    void handleSdlEvent(const SDL_Event&) override {}
+
+    InputDeviceType getType() override { return InputDeviceType::Network; }
+
+    ~NetworkInput() override = default;
+
+   private:
+    InputFrame m_last;
+};
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_NET_NETWORKINPUT_HPP
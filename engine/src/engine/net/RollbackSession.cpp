@@ -0,0 +1,270 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <gsl/gsl>
+
+#include "engine/net/RollbackSession.hpp"
+#include "engine/util/ByteStream.hpp"
+#include "engine/util/Checksum.hpp"
+
+namespace ctb {
+namespace engine {
+
+namespace {
+/// First bytes of every packet ("CTBN")
+constexpr uint32_t PACKET_MAGIC = 0x4E425443;
+
+/// Format version of the packets
+constexpr uint8_t PACKET_VERSION = 1;
+
+/// Size of a packet without inputs
+constexpr size_t PACKET_HEADER_SIZE = 4 + 1 + 4 + 4 + 4 + 8 + 4 + 1 + 1;
+
+/// Number of stored local checksums
+constexpr uint32_t CHECK_COUNT = 8;
+}  // namespace
+
+constexpr uint32_t RollbackSession::MAX_PLAYERS;
+constexpr uint32_t RollbackSession::MAX_ROLLBACK;
+constexpr uint32_t RollbackSession::MAX_INPUT_DELAY;
+constexpr uint32_t RollbackSession::INPUT_WINDOW;
+constexpr uint32_t RollbackSession::CHECKSUM_INTERVAL;
+constexpr uint32_t RollbackSession::NO_TICK;
+
+RollbackSession::RollbackSession(RollbackGame& game,
+                                 Transport& transport,
+                                 uint32_t playerCount,
+                                 uint32_t localPlayers,
+                                 uint32_t sessionId,
+                                 uint32_t inputDelay)
+    : m_game(game),
+      m_transport(transport),
+      m_playerCount(playerCount),
+      m_localPlayers(localPlayers),
+      m_sessionId(sessionId),
+      m_localEnd(inputDelay),
+      m_remoteEnd(inputDelay),
+      m_peerAck(inputDelay) {
+    Expects(playerCount > 0 && playerCount <= MAX_PLAYERS);
+    Expects(inputDelay <= MAX_INPUT_DELAY);
+    // the unacknowledged local inputs and the ticks to roll back have to fit into the window
+    static_assert(INPUT_WINDOW >= 4 * (MAX_ROLLBACK + MAX_INPUT_DELAY),
+                  "INPUT_WINDOW too small");
+
+    for (uint32_t player = 0; player < playerCount; ++player) {
+        if (isLocal(player)) {
+            ++m_localCount;
+        }
+    }
+    Expects(m_localCount > 0 && m_localCount < playerCount);
+    // the inputs before the input delay are neutral for all players
+    for (auto& frames : m_frames) {
+        std::fill(std::begin(frames), std::end(frames), InputFrame());
+    }
+    m_sendBuffer.reserve(MAX_PACKET_SIZE);
+}
+
+bool RollbackSession::advanceFrame(const InputFrame* localInputs) {
+    m_transport.update();
+    receive();
+    if (m_rollbackTick != NO_TICK) {
+        rollback();
+    }
+    // the state before the latest checkpoint may have become final by the received inputs
+    uint32_t confirmed = std::min(m_remoteEnd, m_currentTick);
+    checkpoint(confirmed - confirmed % CHECKSUM_INTERVAL);
+
+    if (m_currentTick >= m_remoteEnd + MAX_ROLLBACK) {
+        ++m_stats.stalls;
+        send();
+        return false;
+    }
+
+    for (uint32_t player = 0, i = 0; player < m_playerCount; ++player) {
+        if (isLocal(player)) {
+            frame(m_localEnd, player) = localInputs[i++];
+        }
+    }
+    ++m_localEnd;
+
+    simulate(m_currentTick, false);
+    ++m_currentTick;
+    ++m_stats.ticks;
+    send();
+    return true;
+}
+
+void RollbackSession::simulate(uint32_t tick, bool resimulating) {
+    State& state = m_states[tick % (MAX_ROLLBACK + 1)];
+    m_game.saveState(state.data);
+    state.tick = tick;
+
+    for (uint32_t player = 0; player < m_playerCount; ++player) {
+        if (!isLocal(player) && tick >= m_remoteEnd) {
+            // predict that the remote player keeps the last known input
+            frame(tick, player) =
+                m_remoteEnd > 0 ? frame(m_remoteEnd - 1, player) : InputFrame();
+        }
+        m_tickInputs[player] = frame(tick, player);
+    }
+    if (tick % CHECKSUM_INTERVAL == 0) {
+        checkpoint(tick);
+    }
+    m_game.advance(m_tickInputs, resimulating);
+}
+
+void RollbackSession::checkpoint(uint32_t tick) {
+    // the state before a tick is final on both peers if the inputs of all earlier ticks are known
+    const State& state = m_states[tick % (MAX_ROLLBACK + 1)];
+    Check& check = m_localChecks[tick / CHECKSUM_INTERVAL % CHECK_COUNT];
+    if (tick > m_remoteEnd || state.tick != tick || check.tick == tick) {
+        return;
+    }
+    Checksum sum;
+    sum.add(state.data.data(), state.data.size());
+    check.tick = tick;
+    check.sum = sum.value();
+    m_lastCheck = check;
+    compare(check, m_remoteCheck);
+}
+
+void RollbackSession::rollback() {
+    uint32_t from = m_rollbackTick;
+    m_rollbackTick = NO_TICK;
+    if (from >= m_currentTick) {
+        return;
+    }
+    uint32_t depth = m_currentTick - from;
+    const State& state = m_states[from % (MAX_ROLLBACK + 1)];
+    Expects(depth <= MAX_ROLLBACK && state.tick == from);
+
+    for (uint32_t player = 0; player < m_playerCount; ++player) {
+        m_tickInputs[player] = from > 0 ? frame(from - 1, player) : InputFrame();
+    }
+    m_game.loadState(state.data, m_tickInputs);
+
+    for (uint32_t tick = from; tick < m_currentTick; ++tick) {
+        simulate(tick, true);
+    }
+    ++m_stats.rollbacks;
+    m_stats.resimulatedTicks += depth;
+    m_stats.maxRollback = std::max(m_stats.maxRollback, depth);
+}
+
+void RollbackSession::receive() {
+    size_t size;
+    while ((size = m_transport.receive(m_receiveBuffer)) > 0) {
+        bool valid;
+        try {
+            valid = readPacket(size);
+        } catch (const std::runtime_error&) {
+            // truncated
+            valid = false;
+        }
+        if (valid) {
+            ++m_stats.packetsReceived;
+        } else {
+            ++m_stats.invalidPackets;
+        }
+    }
+}
+
+bool RollbackSession::readPacket(size_t size) {
+    ByteReader in(m_receiveBuffer, size);
+    if (in.readU32() != PACKET_MAGIC || in.readU8() != PACKET_VERSION ||
+        in.readU32() != m_sessionId) {
+        return false;
+    }
+    uint32_t ack = in.readU32();
+    Check check;
+    check.tick = in.readU32();
+    check.sum = in.readU64();
+    uint32_t firstTick = in.readU32();
+    uint32_t count = in.readU8();
+    uint32_t players = in.readU8();
+    if (players != m_playerCount - m_localCount) {
+        return false;
+    }
+
+    m_peerAck = std::max(m_peerAck, std::min(ack, m_localEnd));
+    if (check.tick != NO_TICK &&
+        (m_remoteCheck.tick == NO_TICK || check.tick > m_remoteCheck.tick)) {
+        m_remoteCheck = check;
+        compare(m_localChecks[check.tick / CHECKSUM_INTERVAL % CHECK_COUNT], m_remoteCheck);
+    }
+
+    for (uint32_t tick = firstTick; tick < firstTick + count; ++tick) {
+        // only the next missing tick extends the known inputs, inputs beyond the window would
+        // overwrite inputs that may still be needed
+        bool next = tick == m_remoteEnd && tick < m_currentTick + INPUT_WINDOW / 2;
+        for (uint32_t player = 0; player < m_playerCount; ++player) {
+            if (isLocal(player)) {
+                continue;
+            }
+            InputFrame input;
+            input.buttons = in.readU16();
+            input.aim = static_cast<int8_t>(in.readU8());
+            if (!next) {
+                continue;
+            }
+            InputFrame& known = frame(tick, player);
+            if (tick < m_currentTick && known != input) {
+                m_rollbackTick = std::min(m_rollbackTick, tick);
+            }
+            known = input;
+        }
+        if (next) {
+            ++m_remoteEnd;
+        }
+    }
+    return true;
+}
+
+void RollbackSession::send() {
+    uint32_t first = std::max(m_peerAck, m_localEnd - std::min(m_localEnd, INPUT_WINDOW / 2));
+    size_t capacity = (MAX_PACKET_SIZE - PACKET_HEADER_SIZE) / (INPUT_FRAME_SIZE * m_localCount);
+    auto count = static_cast<uint32_t>(std::min<size_t>({m_localEnd - first, capacity, 255}));
+
+    m_sendBuffer.clear();
+    ByteWriter out(m_sendBuffer);
+    out.writeU32(PACKET_MAGIC);
+    out.writeU8(PACKET_VERSION);
+    out.writeU32(m_sessionId);
+    out.writeU32(m_remoteEnd);
+    out.writeU32(m_lastCheck.tick);
+    out.writeU64(m_lastCheck.sum);
+    out.writeU32(first);
+    out.writeU8(static_cast<uint8_t>(count));
+    out.writeU8(static_cast<uint8_t>(m_localCount));
+    for (uint32_t tick = first; tick < first + count; ++tick) {
+        for (uint32_t player = 0; player < m_playerCount; ++player) {
+            if (isLocal(player)) {
+                const InputFrame& input = frame(tick, player);
+                out.writeU16(input.buttons);
+                out.writeU8(static_cast<uint8_t>(input.aim));
+            }
+        }
+    }
+    m_transport.send(m_sendBuffer.data(), m_sendBuffer.size());
+    ++m_stats.packetsSent;
+}
+
+void RollbackSession::compare(const Check& local, const Check& remote) {
+    if (local.tick == NO_TICK || local.tick != remote.tick ||
+        (m_comparedTick != NO_TICK && local.tick <= m_comparedTick)) {
+        return;
+    }
+    m_comparedTick = local.tick;
+    if (local.sum != remote.sum) {
+        ++m_stats.desyncs;
+    }
+}
+
+}  // namespace engine
+}  // namespace ctb
@@ -0,0 +1,228 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_NET_ROLLBACKSESSION_HPP
+#define ENGINE_NET_ROLLBACKSESSION_HPP
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "engine/net/InputFrame.hpp"
+#include "engine/net/Transport.hpp"
+
+namespace ctb {
+namespace engine {
+
+/// The deterministic simulation a RollbackSession runs
+class RollbackGame {
+   public:
+    virtual ~RollbackGame() = default;
+
+    /// Writes the complete state before the next tick into state, reusing its memory
+    virtual void saveState(std::vector<uint8_t>& state) = 0;
+
+    /**
+     * @brief Restores a state written by saveState
+     *
+     * @param state     the state
+     * @param previous  the inputs of all players in the tick before the state
+     */
+    virtual void loadState(const std::vector<uint8_t>& state, const InputFrame* previous) = 0;
+
+    /**
+     * @brief Simulates one tick
+     *
+     * @param inputs        the inputs of all players in this tick
+     * @param resimulating  if the tick is simulated again after a rollback, e.g. to mute sounds
+     */
+    virtual void advance(const InputFrame* inputs, bool resimulating) = 0;
+};
+
+/// Counters of a RollbackSession
+struct RollbackStats {
+    /// simulated ticks, without resimulations
+    uint64_t ticks{0};
+    /// number of mispredicted remote inputs that caused a rollback
+    uint64_t rollbacks{0};
+    uint64_t resimulatedTicks{0};
+    /// the most ticks simulated again in a single rollback
+    uint32_t maxRollback{0};
+    /// frames without a tick, because the remote peer was too far behind
+    uint64_t stalls{0};
+    uint64_t packetsSent{0};
+    uint64_t packetsReceived{0};
+    /// packets of a different session or version, or truncated ones
+    uint64_t invalidPackets{0};
+    /// compared state checksums that differed
+    uint32_t desyncs{0};
+};
+
+/**
+ * @brief Synchronizes a deterministic game between two peers, which both run the complete
+ *        simulation. Only the inputs of the players are exchanged.
+ *
+ * The inputs of the local players are applied after the input delay and sent to the remote
+ * peer with every frame, repeating all inputs it hasn't acknowledged yet, so lost packets
+ * need no retransmission. Missing remote inputs are predicted by repeating the last known
+ * ones. When a remote input arrives that differs from the prediction, the state before its
+ * tick is restored and the ticks up to the present are simulated again.
+ *
+ * Every CHECKSUM_INTERVAL ticks, the saved state before a tick whose previous inputs are all
+ * confirmed is hashed and compared with the hash of the remote peer to detect desyncs.
+ *
+ * The memory is fixed after the first frames: inputs are kept in a ring of INPUT_WINDOW
+ * ticks and states in a ring of MAX_ROLLBACK + 1 buffers. A session never runs more than
+ * MAX_ROLLBACK ticks ahead of the last confirmed remote input, so a rollback simulates at
+ * most MAX_ROLLBACK ticks again. If the remote peer falls further behind, the session stalls.
+ */
+class RollbackSession {
+   public:
+    /// Maximum number of players of a session
+    static constexpr uint32_t MAX_PLAYERS = 32;
+
+    /// Maximum number of ticks the simulation can run ahead of the confirmed remote inputs
+    static constexpr uint32_t MAX_ROLLBACK = 8;
+
+    /// Maximum input delay in ticks
+    static constexpr uint32_t MAX_INPUT_DELAY = 8;
+
+    /// Number of ticks the inputs are kept for
+    static constexpr uint32_t INPUT_WINDOW = 64;
+
+    /// Number of ticks between two state checksums compared with the remote peer
+    static constexpr uint32_t CHECKSUM_INTERVAL = 16;
+
+    /**
+     * @brief Constructor
+     *
+     * @param game          the game to run, both peers start it in the same state
+     * @param transport     the connection to the remote peer
+     * @param playerCount   the number of players of both peers
+     * @param localPlayers  bit i is set if player i is controlled by this peer, the remote peer
+     *                      controls the others
+     * @param sessionId     packets with a different id are ignored, e.g. the seed of the game
+     * @param inputDelay    ticks between sampling and applying a local input, reduces rollbacks
+     *                      at the cost of responsiveness
+     */
+    RollbackSession(RollbackGame& game,
+                    Transport& transport,
+                    uint32_t playerCount,
+                    uint32_t localPlayers,
+                    uint32_t sessionId,
+                    uint32_t inputDelay = 2);
+
+    /**
+     * @brief Receives the remote inputs, rolls back if necessary, simulates the next tick and
+     *        sends the local inputs
+     *
+     * @param localInputs   the inputs of the local players, in the order of their indices
+     *
+     * @return false if the session stalled and no tick was simulated
+     */
+    bool advanceFrame(const InputFrame* localInputs);
+
+    /// Returns the next tick to simulate
+    uint32_t getTick() const { return m_currentTick; }
+
+    /// Returns the number of ticks whose remote inputs are known
+    uint32_t getConfirmedTick() const { return m_remoteEnd; }
+
+    /// Returns the number of local and remote players
+    uint32_t getPlayerCount() const { return m_playerCount; }
+
+    /// Returns if player is controlled by this peer
+    bool isLocal(uint32_t player) const { return (m_localPlayers >> player & 1u) != 0; }
+
+    const RollbackStats& getStats() const { return m_stats; }
+
+   private:
+    /// A saved state before a tick
+    struct State {
+        uint32_t tick{NO_TICK};
+        std::vector<uint8_t> data;
+    };
+
+    /// A checksum of the saved state before a tick
+    struct Check {
+        uint32_t tick{NO_TICK};
+        uint64_t sum{0};
+    };
+
+    static constexpr uint32_t NO_TICK = std::numeric_limits<uint32_t>::max();
+
+    /// Returns the input of player in tick
+    InputFrame& frame(uint32_t tick, uint32_t player) {
+        return m_frames[tick % INPUT_WINDOW][player];
+    }
+
+    /// Saves the state and simulates tick with the known or predicted inputs
+    void simulate(uint32_t tick, bool resimulating);
+
+    /// Hashes the saved state before tick, if it is still saved and wasn't hashed yet
+    void checkpoint(uint32_t tick);
+
+    /// Restores the state before m_rollbackTick and simulates the following ticks again
+    void rollback();
+
+    /// Handles all waiting packets
+    void receive();
+
+    /// Reads a packet, returns false if it is invalid
+    bool readPacket(size_t size);
+
+    /// Sends the unacknowledged local inputs, the acknowledgement and the latest checksum
+    void send();
+
+    /// Compares the checksums, if both are for the same tick and it wasn't compared yet
+    void compare(const Check& local, const Check& remote);
+
+    RollbackGame& m_game;
+    Transport& m_transport;
+    uint32_t m_playerCount;
+    uint32_t m_localPlayers;
+    uint32_t m_localCount{0};
+    uint32_t m_sessionId;
+
+    /// the inputs of all players, indexed by tick % INPUT_WINDOW
+    InputFrame m_frames[INPUT_WINDOW][MAX_PLAYERS];
+    /// the inputs of one tick, passed to the game
+    InputFrame m_tickInputs[MAX_PLAYERS];
+
+    /// the states before the last ticks, indexed by tick % (MAX_ROLLBACK + 1)
+    State m_states[MAX_ROLLBACK + 1];
+
+    /// the next tick to simulate
+    uint32_t m_currentTick{0};
+    /// the local inputs of all ticks before this are known
+    uint32_t m_localEnd;
+    /// the remote inputs of all ticks before this are known
+    uint32_t m_remoteEnd;
+    /// the remote peer knows the local inputs of all ticks before this
+    uint32_t m_peerAck;
+    /// the earliest tick with a mispredicted input or NO_TICK
+    uint32_t m_rollbackTick{NO_TICK};
+
+    /// the checksums of the last states, indexed by tick / CHECKSUM_INTERVAL % 8
+    Check m_localChecks[8];
+    /// the latest checksum of the remote peer
+    Check m_remoteCheck;
+    /// the latest local checksum, sent with every packet
+    Check m_lastCheck;
+    /// the latest tick whose checksums were compared
+    uint32_t m_comparedTick{NO_TICK};
+
+    /// buffers of the next sent and the last received packet
+    std::vector<uint8_t> m_sendBuffer;
+    uint8_t m_receiveBuffer[MAX_PACKET_SIZE];
+
+    RollbackStats m_stats;
+};
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_NET_ROLLBACKSESSION_HPP
@@ -0,0 +1,267 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+
+#include <gsl/gsl>
+
+#include "engine/Engine.hpp"
+#include "engine/Window.hpp"
+#include "engine/core/GC.hpp"
+#include "engine/core/Game.hpp"
+#include "engine/core/PlayerSprites.hpp"
+#include "engine/input/AIInput.hpp"
+#include "engine/net/LoopbackTransport.hpp"
+#include "engine/net/NetworkInput.hpp"
+#include "engine/net/ServerPlay.hpp"
+#include "engine/net/StateClient.hpp"
+#include "engine/net/StateServer.hpp"
+#include "engine/net/UdpHost.hpp"
+#include "engine/net/WorldCapture.hpp"
+#include "engine/scene/Player.hpp"
+#include "engine/util/Clock.hpp"
+
+namespace ctb {
+namespace engine {
+
+namespace {
+using SteadyClock = std::chrono::steady_clock;
+
+/// Number of values of AIPolicy
+constexpr uint32_t kPolicyCount = 3;
+
+/// Maximum number of ticks the server catches up after a long tick, the rest is skipped
+constexpr uint32_t kMaxLateTicks = 4;
+}  // namespace
+
+constexpr uint32_t ServerPlay::MAX_CLIENTS;
+constexpr uint64_t ServerPlay::STATS_INTERVAL;
+
+static_assert(ServerPlay::MAX_CLIENTS <= FLAG_ENTITY_ID, "Every player needs an entity id");
+
+ServerPlay::ServerPlay(Engine& engine, const ServerArguments& args)
+    : m_engine(engine),
+      m_args(args),
+      m_clientCount(args.benchClients > 0 ? args.benchClients : args.clients),
+      m_bench(args.benchClients > 0) {
+    Expects(m_clientCount > 0 && m_clientCount <= MAX_CLIENTS && args.snapshotInterval > 0);
+    if (!Clock::isFixedStep()) {
+        throw std::logic_error("A server has to run in fixed steps");
+    }
+
+    if (!m_bench) {
+        m_host = new UdpHost(args.port, m_clientCount);
+    }
+    startGame();
+    m_server = new StateServer(m_game->getSeed());
+    for (uint32_t i = 0; i < m_clientCount; ++i) {
+        if (m_bench) {
+            m_links.push_back(new LoopbackLink());
+            m_server->addClient(m_links.back()->first());
+            m_benchClients.push_back(new StateClient(m_links.back()->second()));
+        } else {
+            m_server->addClient(m_host->getSlot(i));
+        }
+    }
+    m_reported.resize(m_clientCount, false);
+}
+
+void ServerPlay::startGame() {
+    // the players of the previous game are deleted together with it
+    m_game = m_engine.newGame();
+    deleteInputs();
+    if (m_server != nullptr) {
+        m_server->restart(m_game->getSeed());
+    }
+
+    // client i controls player i with look i, the teams alternate so any number of clients
+    // is fair
+    m_players.clear();
+    for (uint32_t i = 0; i < m_clientCount; ++i) {
+        Player* player =
+            m_engine.getPlayerSprites().createPlayer(i % 2 == 0 ? Team::L2R : Team::R2L, i);
+
+        if (m_bench) {
+            auto* input = new AIInput(static_cast<AIPolicy>(i % kPolicyCount), i);
+            player->registerInput(input);
+            input->setPlayer(player);
+            m_aiInputs.push_back(input);
+        } else {
+            auto* input = new NetworkInput();
+            player->registerInput(input);
+            m_networkInputs.push_back(input);
+        }
+        m_players.push_back(player);
+    }
+    m_game->startGame(m_players);
+    ++m_games;
+}
+
+void ServerPlay::deleteInputs() {
+    for (NetworkInput* input : m_networkInputs) {
+        delete input;
+    }
+    m_networkInputs.clear();
+    for (AIInput* input : m_aiInputs) {
+        delete input;
+    }
+    m_aiInputs.clear();
+}
+
+void ServerPlay::run() {
+    const auto start = SteadyClock::now();
+    uint32_t next = SDL_GetTicks();
+    while (m_ticks < m_args.maxTicks) {
+        if (!m_bench) {
+            // the tick times may wrap around, so they are compared by their difference
+            auto wait = static_cast<int32_t>(next - SDL_GetTicks());
+            if (wait > 0) {
+                SDL_Delay(static_cast<uint32_t>(wait));
+            } else if (-wait > static_cast<int32_t>(kMaxLateTicks * Clock::FIXED_STEP)) {
+                next = SDL_GetTicks();
+            }
+            next += Clock::FIXED_STEP;
+        }
+
+        auto tickStart = SteadyClock::now();
+        tick();
+        m_simulationSeconds +=
+            std::chrono::duration<double>(SteadyClock::now() - tickStart).count();
+
+        if (m_bench) {
+            updateBenchClients();
+        }
+        for (uint32_t i = 0; i < m_clientCount; ++i) {
+            if (!m_reported[i] && m_server->isConnected(i)) {
+                m_reported[i] = true;
+                if (!m_bench) {
+                    std::cout << "client " << i << " connected" << std::endl;
+                }
+            }
+        }
+        if (Window::isVerbose() && m_ticks % STATS_INTERVAL == 0) {
+            printStats(std::cout);
+        }
+    }
+    m_seconds = std::chrono::duration<double>(SteadyClock::now() - start).count();
+}
+
+void ServerPlay::tick() {
+    if (m_game->isFinished()) {
+        startGame();
+    }
+
+    m_server->receive();
+    if (m_bench) {
+        for (AIInput* input : m_aiInputs) {
+            input->pollInput(nullptr);
+        }
+    } else {
+        for (uint32_t i = 0; i < m_clientCount; ++i) {
+            m_networkInputs[i]->apply(m_server->getInput(i));
+        }
+    }
+    Clock::step();
+    m_game->update();
+    GC::execute();
+    m_engine.recordTick();
+
+    if (m_ticks % m_args.snapshotInterval == 0) {
+        captureWorldState(*m_game, m_players, static_cast<uint32_t>(m_ticks), m_state);
+        m_server->broadcast(m_state);
+    }
+    ++m_ticks;
+}
+
+void ServerPlay::updateBenchClients() {
+    for (StateClient* client : m_benchClients) {
+        client->receive();
+        // the input is only sent for the acknowledgement, the AI plays
+        client->sendInput(InputFrame());
+        if (client->isConnected()) {
+            // like a rendering client, three snapshots behind the latest one
+            double tick = client->getLatest()->tick - 3.0 * m_args.snapshotInterval;
+            client->sample(tick, m_sampled);
+        }
+    }
+}
+
+void ServerPlay::printStats(std::ostream& out) const {
+    const StateServerStats& stats = m_server->getStats();
+    out << "server: tick " << m_ticks << " game " << m_games << " snapshots " << stats.snapshots
+        << " (" << stats.fullSnapshots << " full, " << stats.truncatedSnapshots
+        << " truncated) bytes " << stats.bytesSent << " packets " << stats.packetsReceived
+        << " received, " << stats.invalidPackets << " invalid";
+    if (m_host != nullptr) {
+        out << ", clients " << m_host->getPeerCount() << "/" << m_clientCount << ", "
+            << m_host->getRejected() << " rejected, " << m_host->getErrors() << " errors";
+    }
+    out << std::endl;
+}
+
+void ServerPlay::printSummary(std::ostream& out) const {
+    const StateServerStats& stats = m_server->getStats();
+    double seconds = std::max(m_seconds, 1e-9);
+    double gameSeconds = static_cast<double>(m_ticks * Clock::FIXED_STEP) / 1000.0;
+    double snapshots = std::max(static_cast<double>(stats.snapshots), 1.0);
+
+    out << "{\n";
+    out << "  \"clients\": " << m_clientCount << ",\n";
+    out << "  \"benchmark\": " << (m_bench ? "true" : "false") << ",\n";
+    out << "  \"snapshotInterval\": " << m_args.snapshotInterval << ",\n";
+    out << "  \"games\": " << m_games << ",\n";
+    out << "  \"ticks\": " << m_ticks << ",\n";
+    out << "  \"seconds\": " << m_seconds << ",\n";
+    out << "  \"ticksPerSecond\": " << static_cast<double>(m_ticks) / seconds << ",\n";
+    out << "  \"simulatedTicksPerSecond\": "
+        << static_cast<double>(m_ticks) / std::max(m_simulationSeconds, 1e-9) << ",\n";
+    // per second of game time, so a benchmark reports what a real time server would send
+    out << "  \"bytesPerClientPerSecond\": [";
+    for (uint32_t i = 0; i < m_clientCount; ++i) {
+        out << (i > 0 ? ", " : "")
+            << static_cast<double>(m_server->getBytesSent(i)) / std::max(gameSeconds, 1e-9);
+    }
+    out << "],\n";
+    out << "  \"snapshots\": {\"sent\": " << stats.snapshots
+        << ", \"full\": " << stats.fullSnapshots << ", \"truncated\": " << stats.truncatedSnapshots
+        << ", \"bytes\": " << stats.bytesSent
+        << ", \"encodeMicros\": " << stats.encodeSeconds * 1e6 / snapshots << "},\n";
+    out << "  \"inputs\": {\"received\": " << stats.packetsReceived
+        << ", \"invalid\": " << stats.invalidPackets << "}";
+
+    if (m_bench) {
+        uint64_t received = 0;
+        uint64_t missingBaselines = 0;
+        double decodeSeconds = 0;
+        for (StateClient* client : m_benchClients) {
+            received += client->getStats().snapshots;
+            missingBaselines += client->getStats().missingBaselines;
+            decodeSeconds += client->getStats().decodeSeconds;
+        }
+        out << ",\n  \"received\": {\"snapshots\": " << received
+            << ", \"missingBaselines\": " << missingBaselines << ", \"decodeMicros\": "
+            << decodeSeconds * 1e6 / std::max(static_cast<double>(received), 1.0) << "}";
+    }
+    out << "\n}" << std::endl;
+}
+
+ServerPlay::~ServerPlay() {
+    // the players deregister from their inputs when they are deleted with the game
+    m_engine.stopGame();
+    deleteInputs();
+    delete m_server;
+    for (size_t i = 0; i < m_benchClients.size(); ++i) {
+        delete m_benchClients[i];
+        delete m_links[i];
+    }
+    delete m_host;
+}
+
+}  // namespace engine
+}  // namespace ctb
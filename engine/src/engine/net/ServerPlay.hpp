@@ -0,0 +1,134 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_NET_SERVERPLAY_HPP
+#define ENGINE_NET_SERVERPLAY_HPP
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include <SDL.h>
+
+#include "engine/net/WorldState.hpp"
+
+namespace ctb {
+namespace engine {
+
+class AIInput;
+class Engine;
+class Game;
+class LoopbackLink;
+class NetworkInput;
+class Player;
+class StateClient;
+class StateServer;
+class UdpHost;
+
+/// Arguments of a headless server
+struct ServerArguments {
+    /// the UDP port clients connect to
+    uint16_t port{0};
+    /// number of players, each controlled by one client
+    uint32_t clients{2};
+    /// ticks between two snapshots
+    uint32_t snapshotInterval{2};
+    /// the server stops after this many ticks
+    uint64_t maxTicks{60 * 60 * 40};
+    /// instead of waiting for remote clients, let this many AI players play as fast as possible
+    /// and stream to the same number of clients in this process
+    uint32_t benchClients{0};
+};
+
+/**
+ * @brief Runs games headless and authoritative: every client controls one player by sending
+ *        its input, the server simulates in fixed steps and streams delta compressed world
+ *        states to all clients via a StateServer. A finished game is followed by a new one.
+ *
+ * Only what clients render is streamed, see captureWorldState.
+ */
+class ServerPlay {
+   public:
+    /**
+     * @brief Opens the socket, unless benchmarking, and starts a game of engine
+     *
+     * @param engine    the engine to create the games with
+     * @param args      what to serve
+     *
+     * @throws runtime_error if the socket can't be opened
+     */
+    ServerPlay(Engine& engine, const ServerArguments& args);
+    ServerPlay(const ServerPlay&) = delete;
+    ServerPlay& operator=(const ServerPlay&) = delete;
+
+    /// Simulates maxTicks ticks, in real time unless benchmarking
+    void run();
+
+    /// Writes the throughput and bandwidth statistics as JSON to out
+    void printSummary(std::ostream& out) const;
+
+    /// Destructor, stops the game
+    ~ServerPlay();
+
+    /// Maximum number of clients, every player needs an entity id below the flag's
+    static constexpr uint32_t MAX_CLIENTS = 256;
+
+   private:
+    /// Number of ticks after which the statistics are printed in verbose mode
+    static constexpr uint64_t STATS_INTERVAL = 400;
+
+    /// Starts a new game with the players of all clients
+    void startGame();
+
+    /// Deletes the inputs of the last game, its players must be deleted already
+    void deleteInputs();
+
+    /// Simulates one tick and broadcasts the state if a snapshot is due
+    void tick();
+
+    /// Lets the benchmark clients receive and answer
+    void updateBenchClients();
+
+    /// Writes a status line of all clients
+    void printStats(std::ostream& out) const;
+
+    Engine& m_engine;
+    ServerArguments m_args;
+    uint32_t m_clientCount;
+    bool m_bench;
+    Game* m_game{nullptr};
+
+    UdpHost* m_host{nullptr};
+    StateServer* m_server{nullptr};
+
+    /// the players of the current game in the order of the clients
+    std::vector<Player*> m_players;
+    /// the inputs of the players, applied from the received frames
+    std::vector<NetworkInput*> m_networkInputs;
+    /// the inputs of the players when benchmarking
+    std::vector<AIInput*> m_aiInputs;
+    /// if the connection of a client was reported
+    std::vector<bool> m_reported;
+
+    /// the in-process clients when benchmarking
+    std::vector<LoopbackLink*> m_links;
+    std::vector<StateClient*> m_benchClients;
+    WorldState m_sampled;
+
+    /// the state of the tick being broadcast, its memory is reused
+    WorldState m_state;
+
+    uint64_t m_ticks{0};
+    uint32_t m_games{0};
+    double m_seconds{0};
+    /// time spent simulating, without waiting for the next tick
+    double m_simulationSeconds{0};
+};
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_NET_SERVERPLAY_HPP
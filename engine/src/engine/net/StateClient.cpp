@@ -0,0 +1,141 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <utility>
+
+#include "engine/net/StateClient.hpp"
+#include "engine/net/StateProtocol.hpp"
+#include "engine/util/ByteStream.hpp"
+
+namespace ctb {
+namespace engine {
+
+constexpr uint32_t StateClient::HISTORY;
+
+StateClient::StateClient(Transport& transport) : m_transport(transport) {
+    m_sendBuffer.reserve(MAX_PACKET_SIZE);
+}
+
+void StateClient::sendInput(const InputFrame& input) {
+    m_sendBuffer.clear();
+    ByteWriter out(m_sendBuffer);
+    out.writeU32(STATE_MAGIC);
+    out.writeU8(STATE_VERSION);
+    out.writeU8(STATE_INPUT);
+    out.writeU32(m_latest ? m_latest->tick : STATE_NO_TICK);
+    out.writeU32(++m_sequence);
+    out.writeU16(input.buttons);
+    out.writeU8(static_cast<uint8_t>(input.aim));
+    m_transport.send(m_sendBuffer.data(), m_sendBuffer.size());
+    ++m_stats.packetsSent;
+}
+
+bool StateClient::receive() {
+    m_transport.update();
+    bool newer = false;
+    size_t size;
+    while ((size = m_transport.receive(m_receiveBuffer)) > 0) {
+        auto start = std::chrono::steady_clock::now();
+        bool valid;
+        try {
+            valid = readPacket(size, newer);
+        } catch (const std::runtime_error&) {
+            // truncated or inconsistent with the baseline
+            valid = false;
+        }
+        m_stats.decodeSeconds +=
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        m_stats.bytesReceived += size;
+        if (!valid) {
+            ++m_stats.invalidPackets;
+        }
+    }
+    return newer;
+}
+
+bool StateClient::readPacket(size_t size, bool& newer) {
+    ByteReader in(m_receiveBuffer, size);
+    if (in.readU32() != STATE_MAGIC || in.readU8() != STATE_VERSION ||
+        in.readU8() != STATE_SNAPSHOT) {
+        return false;
+    }
+    uint32_t seed = in.readU32();
+    uint32_t player = in.readU8();
+    uint32_t baselineTick = in.readU32();
+    if (m_latest != nullptr && seed != m_seed) {
+        // a new game started, the kept states belong to the old one
+        m_latest = nullptr;
+        m_received = 0;
+    }
+
+    const WorldState* baseline = nullptr;
+    if (baselineTick != STATE_NO_TICK) {
+        baseline = find(baselineTick);
+        if (baseline == nullptr) {
+            ++m_stats.missingBaselines;
+            return true;
+        }
+    }
+    readWorldState(baseline, in, m_incoming);
+    if (m_latest != nullptr && m_incoming.tick <= m_latest->tick) {
+        ++m_stats.outdatedSnapshots;
+        return true;
+    }
+
+    // swapping keeps the memory of the replaced state for the next snapshot
+    WorldState& slot = m_states[m_received % HISTORY];
+    std::swap(slot, m_incoming);
+    ++m_received;
+    m_latest = &slot;
+    m_seed = seed;
+    m_player = player;
+    ++m_stats.snapshots;
+    newer = true;
+    return true;
+}
+
+const WorldState* StateClient::find(uint32_t tick) const {
+    uint32_t count = std::min(m_received, HISTORY);
+    for (uint32_t i = 0; i < count; ++i) {
+        if (m_states[i].tick == tick) {
+            return &m_states[i];
+        }
+    }
+    return nullptr;
+}
+
+bool StateClient::sample(double tick, WorldState& out) const {
+    if (m_latest == nullptr) {
+        return false;
+    }
+    // the kept states bracketing tick, they are in the ring in the order they were received
+    const WorldState* before = nullptr;
+    const WorldState* after = nullptr;
+    uint32_t count = std::min(m_received, HISTORY);
+    for (uint32_t i = 0; i < count; ++i) {
+        const WorldState& state = m_states[i];
+        double stateTick = state.tick;
+        if (stateTick <= tick && (before == nullptr || state.tick > before->tick)) {
+            before = &state;
+        }
+        if (stateTick >= tick && (after == nullptr || state.tick < after->tick)) {
+            after = &state;
+        }
+    }
+    if (before == nullptr || after == nullptr || before == after) {
+        out = before ? *before : *after;
+        return true;
+    }
+    auto t = static_cast<float>((tick - before->tick) / (after->tick - before->tick));
+    interpolate(*before, *after, t, out);
+    return true;
+}
+
+}  // namespace engine
+}  // namespace ctb
@@ -0,0 +1,109 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_NET_STATECLIENT_HPP
+#define ENGINE_NET_STATECLIENT_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "engine/net/InputFrame.hpp"
+#include "engine/net/Transport.hpp"
+#include "engine/net/WorldState.hpp"
+
+namespace ctb {
+namespace engine {
+
+/// Counters of a StateClient
+struct StateClientStats {
+    uint64_t snapshots{0};
+    uint64_t bytesReceived{0};
+    uint64_t packetsSent{0};
+    /// snapshots older than the latest one
+    uint64_t outdatedSnapshots{0};
+    /// snapshots relative to a state that is no longer kept
+    uint64_t missingBaselines{0};
+    /// packets of a different version or type, or truncated ones
+    uint64_t invalidPackets{0};
+    /// time spent reading snapshots
+    double decodeSeconds{0};
+};
+
+/**
+ * @brief The thin side of a game streamed by a StateServer: sends the local input and keeps the
+ *        last received world states to interpolate between them.
+ *
+ * The client doesn't simulate anything. It renders the past: sample() is called with a tick
+ * some snapshot intervals behind the latest one, so there are usually two states around it.
+ */
+class StateClient {
+   public:
+    /// Number of received states kept as baselines and for interpolation
+    static constexpr uint32_t HISTORY = 32;
+
+    /// Constructor, transport has to outlive the client
+    explicit StateClient(Transport& transport);
+
+    /// Sends input with the acknowledgement of the latest state
+    void sendInput(const InputFrame& input);
+
+    /// Handles all waiting snapshots, returns if a newer state arrived
+    bool receive();
+
+    /// Returns if a state was received
+    bool isConnected() const { return m_latest != nullptr; }
+
+    /// Returns the seed of the streamed game, only valid if isConnected()
+    uint32_t getSeed() const { return m_seed; }
+
+    /// Returns the index of the player controlled by this client, only valid if isConnected()
+    uint32_t getPlayer() const { return m_player; }
+
+    /// Returns the latest state or nullptr
+    const WorldState* getLatest() const { return m_latest; }
+
+    /**
+     * @brief Interpolates the kept states at tick. Before the oldest or after the latest state
+     *        the nearest one is used, states are never extrapolated.
+     *
+     * @param tick  the tick, may be between two ticks
+     * @param out   receives the state, its memory is reused
+     *
+     * @return false if no state was received yet
+     */
+    bool sample(double tick, WorldState& out) const;
+
+    const StateClientStats& getStats() const { return m_stats; }
+
+   private:
+    /// Reads a packet, returns false if it is invalid
+    bool readPacket(size_t size, bool& newer);
+
+    /// Returns the kept state of tick or nullptr
+    const WorldState* find(uint32_t tick) const;
+
+    Transport& m_transport;
+    uint32_t m_seed{0};
+    uint32_t m_player{0};
+    uint32_t m_sequence{0};
+
+    /// the received states, indexed by received count % HISTORY
+    WorldState m_states[HISTORY];
+    uint32_t m_received{0};
+    const WorldState* m_latest{nullptr};
+    /// the state being read, swapped into m_states if it is valid
+    WorldState m_incoming;
+
+    std::vector<uint8_t> m_sendBuffer;
+    uint8_t m_receiveBuffer[MAX_PACKET_SIZE];
+
+    StateClientStats m_stats;
+};
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_NET_STATECLIENT_HPP
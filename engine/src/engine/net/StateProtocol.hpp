@@ -0,0 +1,48 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_NET_STATEPROTOCOL_HPP
+#define ENGINE_NET_STATEPROTOCOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ctb {
+namespace engine {
+
+/**
+ * The packets between a StateServer and its StateClients. Every packet starts with
+ * STATE_MAGIC (u32), STATE_VERSION (u8) and its type (u8).
+ *
+ * STATE_INPUT, client to server:
+ *   ack u32        the tick of the latest received snapshot or STATE_NO_TICK
+ *   sequence u32   increases with every packet, older inputs are ignored
+ *   buttons u16, aim u8
+ *
+ * STATE_SNAPSHOT, server to client:
+ *   seed u32       the seed of the game
+ *   player u8      the index of the player controlled by the client
+ *   baseline u32   the tick of the state the snapshot is relative to or STATE_NO_TICK
+ *   the state as written by writeWorldState
+ */
+
+/// First bytes of every packet ("CTBS")
+constexpr uint32_t STATE_MAGIC = 0x53425443;
+
+/// Format version of the packets
+constexpr uint8_t STATE_VERSION = 2;
+
+/// Packet types
+constexpr uint8_t STATE_INPUT = 1;
+constexpr uint8_t STATE_SNAPSHOT = 2;
+
+/// A tick that was never simulated
+constexpr uint32_t STATE_NO_TICK = 0xFFFFFFFF;
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_NET_STATEPROTOCOL_HPP
@@ -0,0 +1,138 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+#include <gsl/gsl>
+
+#include "engine/net/StateProtocol.hpp"
+#include "engine/net/StateServer.hpp"
+#include "engine/util/ByteStream.hpp"
+
+namespace ctb {
+namespace engine {
+
+constexpr uint32_t StateServer::HISTORY;
+
+StateServer::StateServer(uint32_t seed) : m_seed(seed) {
+    m_sendBuffer.reserve(MAX_PACKET_SIZE);
+}
+
+uint32_t StateServer::addClient(Transport& transport) {
+    // the player index is sent as one byte
+    Expects(m_clients.size() < 256);
+    m_clients.push_back({&transport, STATE_NO_TICK, 0, InputFrame(), 0, false});
+    return static_cast<uint32_t>(m_clients.size() - 1);
+}
+
+void StateServer::receive() {
+    for (Client& client : m_clients) {
+        client.transport->update();
+        size_t size;
+        while ((size = client.transport->receive(m_receiveBuffer)) > 0) {
+            bool valid;
+            try {
+                valid = readPacket(client, size);
+            } catch (const std::runtime_error&) {
+                // truncated
+                valid = false;
+            }
+            if (valid) {
+                ++m_stats.packetsReceived;
+            } else {
+                ++m_stats.invalidPackets;
+            }
+        }
+    }
+}
+
+bool StateServer::readPacket(Client& client, size_t size) {
+    ByteReader in(m_receiveBuffer, size);
+    if (in.readU32() != STATE_MAGIC || in.readU8() != STATE_VERSION ||
+        in.readU8() != STATE_INPUT) {
+        return false;
+    }
+    uint32_t ack = in.readU32();
+    uint32_t sequence = in.readU32();
+    InputFrame input;
+    input.buttons = in.readU16();
+    input.aim = static_cast<int8_t>(in.readU8());
+
+    // packets may arrive out of order, only newer ones count
+    if (client.connected && sequence <= client.sequence) {
+        return true;
+    }
+    client.connected = true;
+    client.sequence = sequence;
+    client.input = input;
+    // the client may have dropped its states, e.g. after a restart, so the ack can decrease
+    client.ack = ack;
+    return true;
+}
+
+const WorldState* StateServer::findBaseline(uint32_t tick) const {
+    if (tick == STATE_NO_TICK) {
+        return nullptr;
+    }
+    auto count = static_cast<size_t>(std::min<uint64_t>(m_broadcasts, HISTORY));
+    for (size_t i = 0; i < count; ++i) {
+        if (m_history[i].tick == tick) {
+            return &m_history[i];
+        }
+    }
+    return nullptr;
+}
+
+void StateServer::restart(uint32_t seed) {
+    m_seed = seed;
+    m_broadcasts = 0;
+    for (Client& client : m_clients) {
+        client.ack = STATE_NO_TICK;
+    }
+}
+
+void StateServer::broadcast(const WorldState& state) {
+    // assigning reuses the memory of the oldest state
+    m_history[m_broadcasts % HISTORY] = state;
+    ++m_broadcasts;
+
+    for (Client& client : m_clients) {
+        auto start = std::chrono::steady_clock::now();
+        const WorldState* baseline = findBaseline(client.ack);
+        if (baseline != nullptr && baseline->tick >= state.tick) {
+            // the same tick was broadcast again
+            baseline = nullptr;
+        }
+
+        m_sendBuffer.clear();
+        ByteWriter out(m_sendBuffer);
+        out.writeU32(STATE_MAGIC);
+        out.writeU8(STATE_VERSION);
+        out.writeU8(STATE_SNAPSHOT);
+        out.writeU32(m_seed);
+        out.writeU8(static_cast<uint8_t>(&client - m_clients.data()));
+        out.writeU32(baseline ? baseline->tick : STATE_NO_TICK);
+        size_t written = writeWorldState(baseline, state, out, MAX_PACKET_SIZE);
+        m_stats.encodeSeconds +=
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        client.transport->send(m_sendBuffer.data(), m_sendBuffer.size());
+        client.bytesSent += m_sendBuffer.size();
+        m_stats.bytesSent += m_sendBuffer.size();
+        ++m_stats.snapshots;
+        if (baseline == nullptr) {
+            ++m_stats.fullSnapshots;
+        }
+        if (written < state.entities.size()) {
+            ++m_stats.truncatedSnapshots;
+        }
+    }
+}
+
+}  // namespace engine
+}  // namespace ctb
@@ -0,0 +1,118 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_NET_STATESERVER_HPP
+#define ENGINE_NET_STATESERVER_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "engine/net/InputFrame.hpp"
+#include "engine/net/Transport.hpp"
+#include "engine/net/WorldState.hpp"
+
+namespace ctb {
+namespace engine {
+
+/// Counters of a StateServer
+struct StateServerStats {
+    /// sent snapshots, one per client and broadcast
+    uint64_t snapshots{0};
+    /// snapshots sent without baseline, because the client didn't acknowledge a recent one
+    uint64_t fullSnapshots{0};
+    /// snapshots that didn't fit into a packet and left entities out
+    uint64_t truncatedSnapshots{0};
+    uint64_t bytesSent{0};
+    uint64_t packetsReceived{0};
+    /// packets of a different version or type, or truncated ones
+    uint64_t invalidPackets{0};
+    /// time spent writing snapshots
+    double encodeSeconds{0};
+};
+
+/**
+ * @brief The authoritative side of a game streamed to clients: receives the inputs of the
+ *        clients and sends each one the world state as difference to the latest state it
+ *        acknowledged. A client that hasn't acknowledged any of the last HISTORY states
+ *        gets the complete state. Lost snapshots are never resent, the next one replaces them.
+ */
+class StateServer {
+   public:
+    /// Number of broadcast states kept as baselines
+    static constexpr uint32_t HISTORY = 32;
+
+    /**
+     * @brief Constructor
+     *
+     * @param seed the seed of the game, clients need it to load the same levels
+     */
+    explicit StateServer(uint32_t seed);
+
+    /**
+     * @brief Adds a client, it controls the player with the returned index
+     *
+     * @param transport the connection to the client, it has to outlive the server
+     */
+    uint32_t addClient(Transport& transport);
+
+    /// Handles the waiting packets of all clients
+    void receive();
+
+    /// Returns the latest input of client
+    const InputFrame& getInput(uint32_t client) const { return m_clients[client].input; }
+
+    /// Returns if a packet of client was received
+    bool isConnected(uint32_t client) const { return m_clients[client].connected; }
+
+    /// Returns the number of bytes sent to client
+    uint64_t getBytesSent(uint32_t client) const { return m_clients[client].bytesSent; }
+
+    /// Returns the number of clients
+    uint32_t getClientCount() const { return static_cast<uint32_t>(m_clients.size()); }
+
+    /// Forgets all baselines, e.g. because a new game with seed started
+    void restart(uint32_t seed);
+
+    /// Keeps state as baseline and sends it to all clients
+    void broadcast(const WorldState& state);
+
+    const StateServerStats& getStats() const { return m_stats; }
+
+   private:
+    struct Client {
+        Transport* transport;
+        /// the latest acknowledged tick
+        uint32_t ack;
+        /// the sequence of the latest input
+        uint32_t sequence;
+        InputFrame input;
+        uint64_t bytesSent;
+        bool connected;
+    };
+
+    /// Reads a packet of client, returns false if it is invalid
+    bool readPacket(Client& client, size_t size);
+
+    /// Returns the kept state of tick or nullptr
+    const WorldState* findBaseline(uint32_t tick) const;
+
+    uint32_t m_seed;
+    std::vector<Client> m_clients;
+
+    /// the last broadcast states, indexed by broadcast count % HISTORY
+    WorldState m_history[HISTORY];
+    uint64_t m_broadcasts{0};
+
+    std::vector<uint8_t> m_sendBuffer;
+    uint8_t m_receiveBuffer[MAX_PACKET_SIZE];
+
+    StateServerStats m_stats;
+};
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_NET_STATESERVER_HPP
@@ -0,0 +1,58 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#include <cstring>
+
+#include <gsl/gsl>
+
+#include "engine/net/Transport.hpp"
+
+namespace ctb {
+namespace engine {
+
+constexpr size_t PacketQueue::CAPACITY;
+
+bool PacketQueue::push(const uint8_t* data, size_t size, uint32_t due) {
+    Expects(size > 0 && size <= MAX_PACKET_SIZE);
+    for (Slot& slot : m_slots) {
+        if (slot.size == 0) {
+            slot.due = due;
+            slot.sequence = m_sequence++;
+            slot.size = size;
+            std::memcpy(slot.data, data, size);
+            ++m_size;
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t PacketQueue::pop(uint8_t* buffer, uint32_t now) {
+    if (m_size == 0) {
+        return 0;
+    }
+    Slot* next = nullptr;
+    for (Slot& slot : m_slots) {
+        // the sequence difference handles the wrap around of the counter
+        if (slot.size > 0 && slot.due <= now &&
+            (!next || slot.due < next->due ||
+             (slot.due == next->due &&
+              static_cast<int32_t>(slot.sequence - next->sequence) < 0))) {
+            next = &slot;
+        }
+    }
+    if (!next) {
+        return 0;
+    }
+    size_t size = next->size;
+    std::memcpy(buffer, next->data, size);
+    next->size = 0;
+    --m_size;
+    return size;
+}
+
+}  // namespace engine
+}  // namespace ctb
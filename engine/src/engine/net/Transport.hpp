@@ -0,0 +1,94 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_NET_TRANSPORT_HPP
+#define ENGINE_NET_TRANSPORT_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ctb {
+namespace engine {
+
+/// Maximum size of a packet in bytes, small enough to never be fragmented
+constexpr size_t MAX_PACKET_SIZE = 1024;
+
+/**
+ * @brief A connection to one remote peer, which sends and receives unreliable datagrams.
+ *        Packets may be lost or reordered, but are never corrupted or split.
+ */
+class Transport {
+   public:
+    virtual ~Transport() = default;
+
+    /// Sends the packet, size has to be at most MAX_PACKET_SIZE
+    virtual void send(const uint8_t* data, size_t size) = 0;
+
+    /**
+     * @brief Receives the next waiting packet, never blocks
+     *
+     * @param buffer    receives the packet, has to hold MAX_PACKET_SIZE bytes
+     *
+     * @return the size of the packet or 0 if no packet is waiting
+     */
+    virtual size_t receive(uint8_t* buffer) = 0;
+
+    /// Called once per tick before receiving, advances the time of simulated connections
+    virtual void update() {}
+};
+
+/**
+ * @brief A fixed number of packets, each with the time it is due. Used to buffer packets in
+ *        memory without allocating.
+ */
+class PacketQueue {
+   public:
+    /// Maximum number of queued packets
+    static constexpr size_t CAPACITY = 64;
+
+    /**
+     * @brief Queues a copy of the packet
+     *
+     * @param data  the packet
+     * @param size  its size, at most MAX_PACKET_SIZE
+     * @param due   the time the packet can be popped
+     *
+     * @return false if the queue is full and the packet was dropped
+     */
+    bool push(const uint8_t* data, size_t size, uint32_t due);
+
+    /**
+     * @brief Removes the packet with the earliest due time, if it is due. Packets with the same
+     *        due time are popped in the order they were pushed.
+     *
+     * @param buffer    receives the packet, has to hold MAX_PACKET_SIZE bytes
+     * @param now       the current time
+     *
+     * @return the size of the packet or 0 if no packet is due
+     */
+    size_t pop(uint8_t* buffer, uint32_t now);
+
+    /// Returns the number of queued packets
+    size_t size() const { return m_size; }
+
+   private:
+    struct Slot {
+        uint32_t due;
+        /// order of the push, to keep packets with the same due time in order
+        uint32_t sequence;
+        size_t size{0};
+        uint8_t data[MAX_PACKET_SIZE];
+    };
+
+    Slot m_slots[CAPACITY];
+    size_t m_size{0};
+    uint32_t m_sequence{0};
+};
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_NET_TRANSPORT_HPP
@@ -0,0 +1,107 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#include <stdexcept>
+#include <string>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/udp.hpp>
+#include <boost/system/error_code.hpp>
+#include <gsl/gsl>
+
+#include "engine/net/UdpHost.hpp"
+
+using boost::asio::ip::udp;
+
+namespace ctb {
+namespace engine {
+
+struct UdpHost::Socket {
+    explicit Socket(uint16_t port) : socket(context, udp::endpoint(udp::v4(), port)) {}
+
+    boost::asio::io_context context;
+    udp::socket socket;
+    /// the address of every claimed slot, in the order of the slots
+    std::vector<udp::endpoint> peers;
+    /// sender of the last received packet
+    udp::endpoint sender;
+};
+
+UdpHost::UdpHost(uint16_t port, uint32_t slots) : m_socket(nullptr) {
+    Expects(slots > 0);
+    try {
+        m_socket = new Socket(port);
+        m_socket->socket.non_blocking(true);
+    } catch (const boost::system::system_error& e) {
+        delete m_socket;
+        throw std::runtime_error("Cannot open UDP socket: " + std::string(e.what()));
+    }
+    for (uint32_t i = 0; i < slots; ++i) {
+        m_slots.push_back(new Slot(*this, i));
+    }
+}
+
+void UdpHost::poll() {
+    for (;;) {
+        boost::system::error_code error;
+        size_t size = m_socket->socket.receive_from(boost::asio::buffer(m_buffer),
+                                                    m_socket->sender, 0, error);
+        if (error == boost::asio::error::would_block) {
+            return;
+        }
+        if (error) {
+            // e.g. an ICMP port unreachable of an earlier packet, try again with the next tick
+            ++m_errors;
+            return;
+        }
+        if (size == 0) {
+            continue;
+        }
+
+        auto& peers = m_socket->peers;
+        uint32_t slot = 0;
+        while (slot < m_peers && peers[slot] != m_socket->sender) {
+            ++slot;
+        }
+        if (slot == m_peers) {
+            if (m_peers == m_slots.size()) {
+                ++m_rejected;
+                continue;
+            }
+            peers.push_back(m_socket->sender);
+            ++m_peers;
+        }
+        // a full queue drops the packet, which is treated as loss
+        m_slots[slot]->queue().push(m_buffer, size, 0);
+    }
+}
+
+void UdpHost::Slot::send(const uint8_t* data, size_t size) {
+    Expects(size <= MAX_PACKET_SIZE);
+    if (m_index >= m_host.m_peers) {
+        return;
+    }
+    boost::system::error_code error;
+    m_host.m_socket->socket.send_to(boost::asio::buffer(data, size),
+                                    m_host.m_socket->peers[m_index], 0, error);
+    if (error) {
+        ++m_host.m_errors;
+    }
+}
+
+size_t UdpHost::Slot::receive(uint8_t* buffer) {
+    return m_queue.pop(buffer, 0);
+}
+
+UdpHost::~UdpHost() {
+    for (Slot* slot : m_slots) {
+        delete slot;
+    }
+    delete m_socket;
+}
+
+}  // namespace engine
+}  // namespace ctb
@@ -0,0 +1,89 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_NET_UDPHOST_HPP
+#define ENGINE_NET_UDPHOST_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "engine/net/Transport.hpp"
+
+namespace ctb {
+namespace engine {
+
+/**
+ * @brief A non-blocking UDP socket shared by a fixed number of remote peers. Every peer gets
+ *        its own Transport: the first packet of an unknown address claims the next free slot,
+ *        packets of further addresses are rejected once all slots are taken.
+ */
+class UdpHost {
+   public:
+    /**
+     * @brief Opens the socket
+     *
+     * @param port  the port to receive on
+     * @param slots the maximum number of peers
+     *
+     * @throws runtime_error if the socket can't be opened
+     */
+    UdpHost(uint16_t port, uint32_t slots);
+    UdpHost(const UdpHost&) = delete;
+    UdpHost& operator=(const UdpHost&) = delete;
+
+    /// Returns the connection to the peer of slot. Packets sent before a peer claimed the slot
+    /// are dropped.
+    Transport& getSlot(uint32_t slot) { return *m_slots[slot]; }
+
+    /// Returns the number of slots claimed by a peer
+    uint32_t getPeerCount() const { return m_peers; }
+
+    /// Returns the number of packets that couldn't be sent or received
+    uint32_t getErrors() const { return m_errors; }
+
+    /// Returns the number of packets of unknown addresses while all slots were taken
+    uint32_t getRejected() const { return m_rejected; }
+
+    ~UdpHost();
+
+   private:
+    /// The connection to one peer, its packets are queued by poll()
+    class Slot : public Transport {
+       public:
+        Slot(UdpHost& host, uint32_t index) : m_host(host), m_index(index) {}
+
+        void send(const uint8_t* data, size_t size) override;
+
+        size_t receive(uint8_t* buffer) override;
+
+        void update() override { m_host.poll(); }
+
+        PacketQueue& queue() { return m_queue; }
+
+       private:
+        UdpHost& m_host;
+        uint32_t m_index;
+        PacketQueue m_queue;
+    };
+
+    /// Moves all waiting packets into the queues of their slots
+    void poll();
+
+    /// the Boost.Asio socket and the addresses of the peers, kept out of this header
+    struct Socket;
+    Socket* m_socket;
+    std::vector<Slot*> m_slots;
+    uint32_t m_peers{0};
+    uint32_t m_errors{0};
+    uint32_t m_rejected{0};
+    uint8_t m_buffer[MAX_PACKET_SIZE];
+};
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_NET_UDPHOST_HPP
@@ -0,0 +1,77 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#include <stdexcept>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/udp.hpp>
+#include <boost/system/error_code.hpp>
+#include <gsl/gsl>
+
+#include "engine/net/UdpTransport.hpp"
+
+using boost::asio::ip::udp;
+
+namespace ctb {
+namespace engine {
+
+struct UdpTransport::Socket {
+    explicit Socket(uint16_t localPort) : socket(context, udp::endpoint(udp::v4(), localPort)) {}
+
+    boost::asio::io_context context;
+    udp::socket socket;
+    udp::endpoint peer;
+    /// sender of the last received packet
+    udp::endpoint sender;
+};
+
+UdpTransport::UdpTransport(uint16_t localPort, const std::string& peerHost, uint16_t peerPort)
+    : m_socket(nullptr) {
+    try {
+        m_socket = new Socket(localPort);
+        m_socket->socket.non_blocking(true);
+        udp::resolver resolver(m_socket->context);
+        m_socket->peer = *resolver.resolve(udp::v4(), peerHost, std::to_string(peerPort)).begin();
+    } catch (const boost::system::system_error& e) {
+        delete m_socket;
+        throw std::runtime_error("Cannot open UDP socket: " + std::string(e.what()));
+    }
+}
+
+void UdpTransport::send(const uint8_t* data, size_t size) {
+    Expects(size <= MAX_PACKET_SIZE);
+    boost::system::error_code error;
+    m_socket->socket.send_to(boost::asio::buffer(data, size), m_socket->peer, 0, error);
+    if (error) {
+        ++m_errors;
+    }
+}
+
+size_t UdpTransport::receive(uint8_t* buffer) {
+    for (;;) {
+        boost::system::error_code error;
+        size_t size = m_socket->socket.receive_from(boost::asio::buffer(buffer, MAX_PACKET_SIZE),
+                                                    m_socket->sender, 0, error);
+        if (error == boost::asio::error::would_block) {
+            return 0;
+        }
+        if (error) {
+            // e.g. an ICMP port unreachable of an earlier packet, try again with the next tick
+            ++m_errors;
+            return 0;
+        }
+        if (m_socket->sender == m_socket->peer && size > 0) {
+            return size;
+        }
+    }
+}
+
+UdpTransport::~UdpTransport() {
+    delete m_socket;
+}
+
+}  // namespace engine
+}  // namespace ctb
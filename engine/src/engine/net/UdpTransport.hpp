@@ -0,0 +1,58 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_NET_UDPTRANSPORT_HPP
+#define ENGINE_NET_UDPTRANSPORT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "engine/net/Transport.hpp"
+
+namespace ctb {
+namespace engine {
+
+/**
+ * @brief A non-blocking UDP socket, which exchanges packets with one remote peer. Packets from
+ *        other addresses are ignored, errors of single packets are counted and otherwise
+ *        treated as loss.
+ */
+class UdpTransport : public Transport {
+   public:
+    /**
+     * @brief Opens the socket
+     *
+     * @param localPort the port to receive on
+     * @param peerHost  the address or host name of the remote peer
+     * @param peerPort  the port the remote peer receives on
+     *
+     * @throws runtime_error if the socket can't be opened or the peer can't be resolved
+     */
+    UdpTransport(uint16_t localPort, const std::string& peerHost, uint16_t peerPort);
+    UdpTransport(const UdpTransport&) = delete;
+    UdpTransport& operator=(const UdpTransport&) = delete;
+
+    void send(const uint8_t* data, size_t size) override;
+
+    size_t receive(uint8_t* buffer) override;
+
+    /// Returns the number of packets that couldn't be sent or received
+    uint32_t getErrors() const { return m_errors; }
+
+    ~UdpTransport() override;
+
+   private:
+    /// the Boost.Asio socket, kept out of this header
+    struct Socket;
+    Socket* m_socket;
+    uint32_t m_errors{0};
+};
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_NET_UDPTRANSPORT_HPP
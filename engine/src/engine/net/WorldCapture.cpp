@@ -0,0 +1,90 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#include <algorithm>
+
+#include <gsl/gsl>
+
+#include "engine/core/Game.hpp"
+#include "engine/core/Level.hpp"
+#include "engine/net/StateProtocol.hpp"
+#include "engine/net/WorldCapture.hpp"
+#include "engine/scene/Bot.hpp"
+#include "engine/scene/Flag.hpp"
+#include "engine/scene/Player.hpp"
+
+namespace ctb {
+namespace engine {
+
+void captureWorldState(Game& game,
+                       const std::vector<Player*>& players,
+                       uint32_t tick,
+                       WorldState& state) {
+    Expects(players.size() <= FLAG_ENTITY_ID);
+    Level* level = game.getCurrentLevel();
+    state.tick = tick;
+    state.level = static_cast<uint8_t>(game.getCurrentLevelIndex());
+    state.flagHolder = WorldState::NO_ENTITY;
+    state.entities.clear();
+
+    EntityState entity;
+    for (size_t i = 0; i < players.size(); ++i) {
+        Player* player = players[i];
+        entity.id = static_cast<uint16_t>(i);
+        entity.kind = EntityKind::Player;
+        entity.variant = static_cast<uint8_t>(player->getConfigIndex());
+        entity.x = EntityState::quantize(static_cast<float>(player->x()));
+        entity.y = EntityState::quantize(static_cast<float>(player->y()));
+        entity.frame = static_cast<uint8_t>(player->animationStep());
+        entity.health = static_cast<uint8_t>(std::min(player->getHealth(), 255u));
+        entity.flags = static_cast<uint8_t>(
+            (player->facesRight() ? 0 : EntityState::FACING_LEFT) |
+            (player->getTeam() == Team::R2L ? EntityState::TEAM_R2L : 0));
+        if (player->hasFlag()) {
+            state.flagHolder = entity.id;
+        }
+        state.entities.push_back(entity);
+    }
+
+    Flag* flag = level->getFlag();
+    entity = EntityState();
+    entity.id = FLAG_ENTITY_ID;
+    entity.kind = EntityKind::Flag;
+    entity.x = EntityState::quantize(static_cast<float>(flag->x()));
+    entity.y = EntityState::quantize(static_cast<float>(flag->y()));
+    entity.frame = static_cast<uint8_t>(flag->animationStep());
+    state.entities.push_back(entity);
+
+    size_t firstBot = state.entities.size();
+    Camera& camera = level->getCamera();
+    for (Bot* bot : level->getBots()) {
+        uint32_t slot = bot->getHandle().index;
+        // the variant of a bot is its prefab, both sides load the same game config
+        PrefabId variant = bot->getPrefab();
+        if (bot->x() + bot->animationWidth() < camera.minX() - CAPTURE_MARGIN ||
+            bot->x() > camera.maxX() + CAPTURE_MARGIN ||
+            bot->y() + bot->animationHeight() < camera.minY() - CAPTURE_MARGIN ||
+            bot->y() > camera.maxY() + CAPTURE_MARGIN || variant > UINT8_MAX ||
+            slot > WorldState::NO_ENTITY - 1u - FIRST_BOT_ENTITY_ID) {
+            continue;
+        }
+        entity.id = static_cast<uint16_t>(FIRST_BOT_ENTITY_ID + slot);
+        entity.kind = EntityKind::Bot;
+        entity.variant = static_cast<uint8_t>(variant);
+        entity.x = EntityState::quantize(static_cast<float>(bot->x()));
+        entity.y = EntityState::quantize(static_cast<float>(bot->y()));
+        entity.frame = static_cast<uint8_t>(bot->animationStep());
+        entity.flags = bot->facesRight() ? 0 : EntityState::FACING_LEFT;
+        state.entities.push_back(entity);
+    }
+    // the order of the bots in the level changes when bots are removed
+    std::sort(state.entities.begin() + static_cast<std::ptrdiff_t>(firstBot),
+              state.entities.end(),
+              [](const EntityState& a, const EntityState& b) { return a.id < b.id; });
+}
+
+}  // namespace engine
+}  // namespace ctb
@@ -0,0 +1,47 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_NET_WORLDCAPTURE_HPP
+#define ENGINE_NET_WORLDCAPTURE_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "engine/net/WorldState.hpp"
+
+namespace ctb {
+namespace engine {
+
+class Game;
+class Player;
+
+/// Bots further away from the camera than this many pixels are not captured
+constexpr int CAPTURE_MARGIN = 320;
+
+/// Id of the flag, players have the ids below
+constexpr uint16_t FLAG_ENTITY_ID = 256;
+
+/// Id of the bot in the first slot of a level, the other bots follow by slot
+constexpr uint16_t FIRST_BOT_ENTITY_ID = 1024;
+
+/**
+ * @brief Captures the visible state of game: the players, the flag and the bots near the
+ *        camera, the only area anybody watching the game sees.
+ *
+ * @param game      the game
+ * @param players   the players of game, a player's id is its index, at most FLAG_ENTITY_ID
+ * @param tick      the tick of the state
+ * @param state     receives the state, its memory is reused
+ */
+void captureWorldState(Game& game,
+                       const std::vector<Player*>& players,
+                       uint32_t tick,
+                       WorldState& state);
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_NET_WORLDCAPTURE_HPP
@@ -0,0 +1,220 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <gsl/gsl>
+
+#include "engine/net/WorldState.hpp"
+#include "engine/util/ByteStream.hpp"
+
+namespace ctb {
+namespace engine {
+
+namespace {
+/// Bits of the change mask of an entity
+constexpr uint8_t CHANGED_KIND = 1;
+constexpr uint8_t CHANGED_VARIANT = 2;
+constexpr uint8_t CHANGED_X = 4;
+constexpr uint8_t CHANGED_Y = 8;
+constexpr uint8_t CHANGED_FRAME = 16;
+constexpr uint8_t CHANGED_HEALTH = 32;
+constexpr uint8_t CHANGED_FLAGS = 64;
+
+/// The most bytes an entity can take: id gap, mask, kind, variant, x, y, frame, health, flags
+constexpr size_t MAX_ENTITY_BYTES = 3 + 1 + 1 + 1 + 5 + 5 + 1 + 1 + 1;
+
+/// Walks the sorted entities of a baseline along the sorted ids of a state
+class BaselineCursor {
+   public:
+    explicit BaselineCursor(const WorldState* baseline) : m_baseline(baseline) {}
+
+    /// Returns the entity with id or nullptr, the ids have to be ascending
+    const EntityState* find(uint16_t id) {
+        if (m_baseline == nullptr) {
+            return nullptr;
+        }
+        const std::vector<EntityState>& entities = m_baseline->entities;
+        while (m_index < entities.size() && entities[m_index].id < id) {
+            ++m_index;
+        }
+        return m_index < entities.size() && entities[m_index].id == id ? &entities[m_index]
+                                                                       : nullptr;
+    }
+
+    /// Returns the entity with id or a default one, the ids have to be ascending
+    const EntityState& findOrDefault(uint16_t id) {
+        const EntityState* entity = find(id);
+        if (entity != nullptr) {
+            return *entity;
+        }
+        m_default.id = id;
+        return m_default;
+    }
+
+   private:
+    const WorldState* m_baseline;
+    size_t m_index{0};
+    EntityState m_default;
+};
+
+/// Returns a + (b - a) * t rounded to the next integer
+int32_t lerp(int32_t a, int32_t b, float t) {
+    return a + static_cast<int32_t>(std::lround(static_cast<float>(b - a) * t));
+}
+}  // namespace
+
+constexpr int32_t EntityState::POSITION_SCALE;
+constexpr uint8_t EntityState::FACING_LEFT;
+constexpr uint8_t EntityState::TEAM_R2L;
+constexpr uint16_t WorldState::NO_ENTITY;
+
+const EntityState* WorldState::find(uint16_t id) const {
+    auto it = std::lower_bound(
+        entities.begin(), entities.end(), id,
+        [](const EntityState& entity, uint16_t value) { return entity.id < value; });
+    return it != entities.end() && it->id == id ? &*it : nullptr;
+}
+
+size_t writeWorldState(const WorldState* baseline,
+                       const WorldState& state,
+                       ByteWriter& out,
+                       size_t maxBytes) {
+    Expects(baseline == nullptr || baseline->tick <= state.tick);
+    out.writeVarU32(baseline ? state.tick - baseline->tick : state.tick);
+    out.writeU8(state.level);
+    // NO_ENTITY wraps to 0, the most common value
+    out.writeVarU32(static_cast<uint16_t>(state.flagHolder + 1));
+
+    BaselineCursor cursor(baseline);
+    size_t written = 0;
+    int32_t previous = -1;
+    for (const EntityState& entity : state.entities) {
+        // one byte for the end marker has to fit after the entity
+        if (out.size() + MAX_ENTITY_BYTES + 1 > maxBytes) {
+            break;
+        }
+        Expects(entity.id > previous);
+        const EntityState& ref = cursor.findOrDefault(entity.id);
+        uint8_t mask = 0;
+        mask |= entity.kind != ref.kind ? CHANGED_KIND : 0;
+        mask |= entity.variant != ref.variant ? CHANGED_VARIANT : 0;
+        mask |= entity.x != ref.x ? CHANGED_X : 0;
+        mask |= entity.y != ref.y ? CHANGED_Y : 0;
+        mask |= entity.frame != ref.frame ? CHANGED_FRAME : 0;
+        mask |= entity.health != ref.health ? CHANGED_HEALTH : 0;
+        mask |= entity.flags != ref.flags ? CHANGED_FLAGS : 0;
+
+        out.writeVarU32(static_cast<uint32_t>(entity.id - previous));
+        out.writeU8(mask);
+        if (mask & CHANGED_KIND) {
+            out.writeU8(static_cast<uint8_t>(entity.kind));
+        }
+        if (mask & CHANGED_VARIANT) {
+            out.writeU8(entity.variant);
+        }
+        if (mask & CHANGED_X) {
+            out.writeVarI32(entity.x - ref.x);
+        }
+        if (mask & CHANGED_Y) {
+            out.writeVarI32(entity.y - ref.y);
+        }
+        if (mask & CHANGED_FRAME) {
+            out.writeU8(entity.frame);
+        }
+        if (mask & CHANGED_HEALTH) {
+            out.writeU8(entity.health);
+        }
+        if (mask & CHANGED_FLAGS) {
+            out.writeU8(entity.flags);
+        }
+        previous = entity.id;
+        ++written;
+    }
+    // ids are ascending, so a gap of 0 ends the list
+    out.writeVarU32(0);
+    return written;
+}
+
+void readWorldState(const WorldState* baseline, ByteReader& in, WorldState& state) {
+    uint32_t tick = in.readVarU32();
+    state.tick = baseline ? baseline->tick + tick : tick;
+    state.level = in.readU8();
+    state.flagHolder = static_cast<uint16_t>(in.readVarU32() - 1);
+    state.entities.clear();
+
+    BaselineCursor cursor(baseline);
+    int32_t previous = -1;
+    for (;;) {
+        uint32_t gap = in.readVarU32();
+        if (gap == 0) {
+            break;
+        }
+        if (gap > static_cast<uint32_t>(WorldState::NO_ENTITY - previous)) {
+            throw std::runtime_error("Invalid entity id in world state");
+        }
+        auto id = static_cast<uint16_t>(previous + static_cast<int32_t>(gap));
+        EntityState entity = cursor.findOrDefault(id);
+        uint8_t mask = in.readU8();
+        if (mask & CHANGED_KIND) {
+            uint8_t kind = in.readU8();
+            if (kind > static_cast<uint8_t>(EntityKind::Flag)) {
+                throw std::runtime_error("Invalid entity kind in world state");
+            }
+            entity.kind = static_cast<EntityKind>(kind);
+        }
+        if (mask & CHANGED_VARIANT) {
+            entity.variant = in.readU8();
+        }
+        if (mask & CHANGED_X) {
+            entity.x += in.readVarI32();
+        }
+        if (mask & CHANGED_Y) {
+            entity.y += in.readVarI32();
+        }
+        if (mask & CHANGED_FRAME) {
+            entity.frame = in.readU8();
+        }
+        if (mask & CHANGED_HEALTH) {
+            entity.health = in.readU8();
+        }
+        if (mask & CHANGED_FLAGS) {
+            entity.flags = in.readU8();
+        }
+        state.entities.push_back(entity);
+        previous = id;
+    }
+}
+
+void interpolate(const WorldState& from, const WorldState& to, float t, WorldState& out) {
+    const WorldState& nearer = t < 0.5f ? from : to;
+    out.tick = nearer.tick;
+    out.level = nearer.level;
+    out.flagHolder = nearer.flagHolder;
+    if (from.level != to.level) {
+        out.entities = nearer.entities;
+        return;
+    }
+
+    out.entities.clear();
+    BaselineCursor fromCursor(&from);
+    BaselineCursor toCursor(&to);
+    for (const EntityState& entity : nearer.entities) {
+        const EntityState* a = fromCursor.find(entity.id);
+        const EntityState* b = toCursor.find(entity.id);
+        EntityState result = entity;
+        // an entity that is not in both states appeared or vanished and isn't moved
+        if (a != nullptr && b != nullptr) {
+            result.x = lerp(a->x, b->x, t);
+            result.y = lerp(a->y, b->y, t);
+        }
+        out.entities.push_back(result);
+    }
+}
+
+}  // namespace engine
+}  // namespace ctb
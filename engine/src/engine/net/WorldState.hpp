@@ -0,0 +1,137 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_NET_WORLDSTATE_HPP
+#define ENGINE_NET_WORLDSTATE_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ctb {
+namespace engine {
+
+class ByteReader;
+class ByteWriter;
+
+/// What an EntityState describes
+enum class EntityKind : uint8_t { Player, Bot, Flag };
+
+/**
+ * @brief The visible state of one entity as streamed to clients. Positions are quantized to
+ *        1 / POSITION_SCALE pixels.
+ */
+struct EntityState {
+    /// Quantization steps per pixel
+    static constexpr int32_t POSITION_SCALE = 4;
+
+    /// Bit of flags: the entity looks to the left
+    static constexpr uint8_t FACING_LEFT = 1;
+
+    /// Bit of flags: the player belongs to the R2L team
+    static constexpr uint8_t TEAM_R2L = 2;
+
+    /// Unique while the entity exists, the states of a WorldState are sorted by it
+    uint16_t id{0};
+    EntityKind kind{EntityKind::Player};
+    /// e.g. the player config or bot prefab
+    uint8_t variant{0};
+    /// quantized position of the upper left corner in pixels
+    int32_t x{0};
+    int32_t y{0};
+    /// the animation frame
+    uint8_t frame{0};
+    uint8_t health{0};
+    uint8_t flags{0};
+
+    /// Returns the quantized value of a position in pixels
+    static int32_t quantize(float pixels) {
+        return static_cast<int32_t>(std::lround(pixels * static_cast<float>(POSITION_SCALE)));
+    }
+
+    /// Returns the position in pixels of a quantized value
+    static float dequantize(int32_t value) {
+        return static_cast<float>(value) / static_cast<float>(POSITION_SCALE);
+    }
+
+    bool operator==(const EntityState& other) const {
+        return id == other.id && kind == other.kind && variant == other.variant &&
+               x == other.x && y == other.y && frame == other.frame && health == other.health &&
+               flags == other.flags;
+    }
+
+    bool operator!=(const EntityState& other) const { return !(*this == other); }
+};
+
+/// The visible state of a game in one tick
+struct WorldState {
+    /// Value of flagHolder if nobody holds the flag
+    static constexpr uint16_t NO_ENTITY = 0xFFFF;
+
+    uint32_t tick{0};
+    /// index of the current level
+    uint8_t level{0};
+    /// id of the player holding the flag or NO_ENTITY
+    uint16_t flagHolder{NO_ENTITY};
+    /// the entities, sorted by id
+    std::vector<EntityState> entities;
+
+    /// Returns the entity with id or nullptr, uses binary search
+    const EntityState* find(uint16_t id) const;
+
+    bool operator==(const WorldState& other) const {
+        return tick == other.tick && level == other.level && flagHolder == other.flagHolder &&
+               entities == other.entities;
+    }
+};
+
+/**
+ * @brief Writes state as difference to baseline: entities are identified by the gap to the
+ *        previous id, a bit mask tells which fields changed and only those are written as
+ *        variable length differences. An unchanged entity needs 2 bytes.
+ *
+ * Entities are only written while the output stays below maxBytes, the rest is left out.
+ *
+ * @param baseline  a state the receiver has or nullptr to write all fields
+ * @param state     the state to write
+ * @param out       the output
+ * @param maxBytes  the size out must not exceed
+ *
+ * @return the number of written entities
+ */
+size_t writeWorldState(const WorldState* baseline,
+                       const WorldState& state,
+                       ByteWriter& out,
+                       size_t maxBytes);
+
+/**
+ * @brief Reads a state written by writeWorldState
+ *
+ * @param baseline  the baseline passed to writeWorldState
+ * @param in        the input
+ * @param state     receives the state, its memory is reused
+ *
+ * @throws runtime_error if the data is truncated or doesn't match the baseline
+ */
+void readWorldState(const WorldState* baseline, ByteReader& in, WorldState& state);
+
+/**
+ * @brief Interpolates between two states. The positions of entities in both states are
+ *        interpolated linearly, all other fields and the entities in only one state are taken
+ *        from the nearer state. States of different levels are not interpolated.
+ *
+ * @param from  the earlier state
+ * @param to    the later state
+ * @param t     0 for from, 1 for to
+ * @param out   receives the result, its memory is reused
+ */
+void interpolate(const WorldState& from, const WorldState& to, float t, WorldState& out);
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_NET_WORLDSTATE_HPP
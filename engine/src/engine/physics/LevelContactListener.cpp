@@ -4,8 +4,12 @@
 // This file is licensed under the MIT license; see LICENSE file in the root of this
 // project for details.
 
+#include <utility>
+
 #include <gsl/gsl>
 
+#include "engine/Engine.hpp"
+#include "engine/EngineContext.hpp"
 #include "engine/audio/SoundManager.hpp"
 #include "engine/core/Game.hpp"
 #include "engine/graphics/PhysicalRenderable.hpp"
@@ -18,6 +22,7 @@
 #include "engine/scene/Gun.hpp"
 #include "engine/scene/Player.hpp"
 #include "engine/scene/Projectile.hpp"
+#include "engine/util/Clock.hpp"
 #include "engine/util/Random.hpp"
 
 namespace ctb {
@@ -36,7 +41,54 @@ void LevelContactListener::update() {
     }
 }
 
+size_t LevelContactListener::pairIndex(int idA, int idB) {
+    if (idA < 0 || idA >= COLLISION_ID_COUNT) {
+        idA = 0;
+    }
+    if (idB < 0 || idB >= COLLISION_ID_COUNT) {
+        idB = 0;
+    }
+    if (idA > idB) {
+        std::swap(idA, idB);
+    }
+    return static_cast<size_t>(idA * COLLISION_ID_COUNT + idB);
+}
+
+int LevelContactListener::collisionId(b2Fixture* fixture) {
+    void* data = fixture->GetBody()->GetUserData();
+    return data ? static_cast<PhysicalObject*>(data)->getCollisionId() : 0;
+}
+
+const char* LevelContactListener::getCollisionIdName(int id) {
+    switch (id) {
+        case Game::PLAYER_ID:
+            return "player";
+        case Game::GROUND_ID:
+            return "ground";
+        case Game::FLAG_ID:
+            return "flag";
+        case Game::DOOR_ID:
+            return "door";
+        case Game::BOT_ID:
+            return "bot";
+        case Game::PROJECTILE_ID:
+            return "projectile";
+        case Game::WEAPON_ID:
+            return "weapon";
+        default:
+            return "none";
+    }
+}
+
+void LevelContactListener::reset() {
+    m_a = m_b = nullptr;
+    m_player = nullptr;
+}
+
 void LevelContactListener::BeginContact(b2Contact* contact) {
+    ++m_contactCounts[pairIndex(collisionId(contact->GetFixtureA()),
+                                collisionId(contact->GetFixtureB()))];
+
     void* a = contact->GetFixtureA()->GetBody()->GetUserData();
     void* b = contact->GetFixtureB()->GetBody()->GetUserData();
     if (a == nullptr || b == nullptr) {
@@ -118,6 +170,12 @@ void LevelContactListener::collidedBotPlayer(Player* player, Bot* bot) {
 }
 
 void LevelContactListener::EndContact(b2Contact* contact) {
+    uint32_t& count = m_contactCounts[pairIndex(collisionId(contact->GetFixtureA()),
+                                                collisionId(contact->GetFixtureB()))];
+    if (count > 0) {
+        --count;
+    }
+
     void* a = contact->GetFixtureA()->GetBody()->GetUserData();
     void* b = contact->GetFixtureB()->GetBody()->GetUserData();
     if (a == nullptr || b == nullptr) {
@@ -242,12 +300,13 @@ void LevelContactListener::meleeWithCooldown(Player* attacking, Player* hurt) {
         return;
     }
 
-    Uint32 ticks = SDL_GetTicks();
+    Uint32 ticks = Clock::ticks();
     if (ticks > attacking->nextMeleeTick()) {
         SoundManager::getInstance().playHit();
         attacking->resetMeleeTick(ticks);
 
-        uint32_t damage = 15u + static_cast<uint32_t>(Random::getInt(0, 10));
+        Random& random = EngineContext::current().getEngine().getGame()->getRandom();
+        uint32_t damage = 15u + static_cast<uint32_t>(random.getInt(0, 10));
         hurt->addDamage(damage, attacking);
     }
 }
@@ -283,34 +342,48 @@ void LevelContactListener::collisionWithProjectile(Projectile* projectile,
                                                    b2Contact* contact) {
     Expects(projectile != nullptr && obj != nullptr && contact != nullptr);
 
+    if (projectileHit(projectile->getUser(), projectile->getDamage(), obj)) {
+        projectile->getGun()->removeProjectile(projectile);
+        // projectiles without an owner must not push players around
+        if (obj->getCollisionId() == Game::PLAYER_ID && projectile->getUser() == nullptr) {
+            contact->SetEnabled(false);
+        }
+    } else if (obj->getCollisionId() == Game::PLAYER_ID) {
+        contact->SetEnabled(false);
+    }
+}
+
+bool LevelContactListener::projectileHit(Player* user, uint32_t damage, PhysicalObject* obj) {
+    Expects(obj != nullptr);
+
     // If a projectile collides with an player (no friendly fire)
     if (obj->getCollisionId() == Game::PLAYER_ID) {
         Player* player = dynamic_cast<Player*>(obj);
 
-        if (projectile->getUser() == nullptr) {
-            projectile->getGun()->removeProjectile(projectile);
-            contact->SetEnabled(false);
-        } else if (projectile->getUser()->getTeam() != player->getTeam()) {
+        if (user == nullptr) {
+            return true;
+        }
+        if (user->getTeam() != player->getTeam()) {
             SoundManager::getInstance().playDamage();
-            player->addDamage(projectile->getDamage());
-            projectile->getUser()->alterScore(PlayerScoreFrom::SCORE_PROJECTILE);
-            projectile->getGun()->removeProjectile(projectile);
-        } else {
-            contact->SetEnabled(false);
+            player->addDamage(damage);
+            user->alterScore(PlayerScoreFrom::SCORE_PROJECTILE);
+            return true;
         }
+        return false;
     }
     // If a projectile collides with the ground
     if (obj->getCollisionId() == Game::GROUND_ID) {
-        projectile->getGun()->removeProjectile(projectile);
+        return true;
     }
     // if a projectile collides with a bot
     if (obj->getCollisionId() == Game::BOT_ID) {
-        if (projectile->getUser() != nullptr) {
-            projectile->getUser()->alterScore(PlayerScoreFrom::SCORE_BOT);
+        if (user != nullptr) {
+            user->alterScore(PlayerScoreFrom::SCORE_BOT);
         }
-        projectile->getGun()->removeProjectile(projectile);
         collidedBotPlayer(nullptr, dynamic_cast<Bot*>(obj));
+        return true;
     }
+    return false;
 }
 
 void LevelContactListener::doorIgnoring(Door* door, Player* player, b2Contact* contact) {
@@ -7,6 +7,9 @@
 #ifndef ENGINE_PHYSICS_LEVELCONTACTLISTENER_HPP
 #define ENGINE_PHYSICS_LEVELCONTACTLISTENER_HPP
 
+#include <array>
+#include <cstdint>
+
 #include <Box2D/Box2D.h>
 
 namespace ctb {
@@ -69,7 +72,49 @@ class LevelContactListener : public b2ContactListener {
      */
     virtual void update();
 
+    /// Drops all pending joint and door events, e.g. when the level is reset
+    void reset();
+
+    /**
+     * @brief Applies the damage and score rules of a projectile hitting a PhysicalObject.
+     *        Used for projectile bodies and for hitscan shots.
+     *
+     * @param user the player who fired the shot (may be null)
+     * @param damage the damage of the shot
+     * @param obj the object which was hit
+     *
+     * @return true if the shot stops at obj, false if it passes through (e.g. team mates)
+     */
+    bool projectileHit(Player* user, uint32_t damage, PhysicalObject* obj);
+
+    /// Number of distinct collision ids (0 is used for bodies without user data)
+    static constexpr int COLLISION_ID_COUNT = 8;
+
+    /**
+     * @brief Returns the number of currently touching contacts between two kinds of objects
+     *
+     * @param idA collision id of the first object (e.g. Game::PLAYER_ID)
+     * @param idB collision id of the second object
+     *
+     * @return the number of touching contacts, the order of the ids does not matter
+     */
+    uint32_t getContactCount(int idA, int idB) const {
+        return m_contactCounts[pairIndex(idA, idB)];
+    }
+
+    /// Returns a readable name of a collision id
+    static const char* getCollisionIdName(int id);
+
    private:
+    /// Returns the index of the given pair of collision ids in m_contactCounts
+    static size_t pairIndex(int idA, int idB);
+
+    /// Returns the collision id of the body of a fixture
+    static int collisionId(b2Fixture* fixture);
+
+    /// Touching contacts by pair of collision ids
+    std::array<uint32_t, COLLISION_ID_COUNT * COLLISION_ID_COUNT> m_contactCounts{};
+
     /**
      * @brief What should happen, if an player reaches the right door with the banana?
      *
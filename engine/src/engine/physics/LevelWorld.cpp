@@ -4,18 +4,211 @@
 // This file is licensed under the MIT license; see LICENSE file in the root of this
 // project for details.
 
-#include "engine/physics/LevelWorld.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <gsl/gsl>
+
 #include "engine/physics/LevelContactListener.hpp"
+#include "engine/physics/LevelWorld.hpp"
+#include "engine/physics/PhysicalObject.hpp"
 
 namespace ctb {
 namespace engine {
 
+namespace {
+/// Weight of the newest step in the moving average
+constexpr float32 kAverageWeight = 0.05f;
+
+float32 blend(float32 average, float32 value) {
+    return average + kAverageWeight * (value - average);
+}
+
+/// Creates a copy of body with all its fixtures in world
+b2Body* copyBody(b2World& world, const b2Body* body) {
+    b2BodyDef def;
+    def.type = body->GetType();
+    def.position = body->GetPosition();
+    def.angle = body->GetAngle();
+    def.linearVelocity = body->GetLinearVelocity();
+    def.angularVelocity = body->GetAngularVelocity();
+    def.linearDamping = body->GetLinearDamping();
+    def.angularDamping = body->GetAngularDamping();
+    def.allowSleep = body->IsSleepingAllowed();
+    def.awake = body->IsAwake();
+    def.fixedRotation = body->IsFixedRotation();
+    def.bullet = body->IsBullet();
+    def.active = body->IsActive();
+    def.userData = body->GetUserData();
+    def.gravityScale = body->GetGravityScale();
+    b2Body* copy = world.CreateBody(&def);
+
+    // fixtures are prepended to the list, so they are created in reverse to keep its order
+    std::vector<const b2Fixture*> fixtures;
+    for (const b2Fixture* fixture = body->GetFixtureList(); fixture; fixture = fixture->GetNext()) {
+        fixtures.push_back(fixture);
+    }
+    for (auto it = fixtures.rbegin(); it != fixtures.rend(); ++it) {
+        b2FixtureDef fixtureDef;
+        fixtureDef.shape = (*it)->GetShape();
+        fixtureDef.userData = (*it)->GetUserData();
+        fixtureDef.friction = (*it)->GetFriction();
+        fixtureDef.restitution = (*it)->GetRestitution();
+        fixtureDef.density = (*it)->GetDensity();
+        fixtureDef.isSensor = (*it)->IsSensor();
+        fixtureDef.filter = (*it)->GetFilterData();
+        copy->CreateFixture(&fixtureDef);
+    }
+    return copy;
+}
+
+/// Creates a copy of the revolute joint between the given bodies in world
+void copyJoint(b2World& world, b2Joint* joint, b2Body* bodyA, b2Body* bodyB) {
+    if (joint->GetType() != e_revoluteJoint) {
+        throw std::logic_error("Only revolute joints can be copied");
+    }
+    auto* revolute = static_cast<b2RevoluteJoint*>(joint);
+    b2RevoluteJointDef def;
+    def.bodyA = bodyA;
+    def.bodyB = bodyB;
+    def.collideConnected = revolute->GetCollideConnected();
+    def.userData = revolute->GetUserData();
+    def.localAnchorA = revolute->GetLocalAnchorA();
+    def.localAnchorB = revolute->GetLocalAnchorB();
+    def.referenceAngle = revolute->GetReferenceAngle();
+    def.enableLimit = revolute->IsLimitEnabled();
+    def.lowerAngle = revolute->GetLowerLimit();
+    def.upperAngle = revolute->GetUpperLimit();
+    def.enableMotor = revolute->IsMotorEnabled();
+    def.motorSpeed = revolute->GetMotorSpeed();
+    def.maxMotorTorque = revolute->GetMaxMotorTorque();
+    world.CreateJoint(&def);
+}
+}  // namespace
+
 LevelWorld::LevelWorld(const b2Vec2& gravity) {
     m_listener = new LevelContactListener;
     m_world = new b2World(gravity);
     m_world->SetContactListener(m_listener);
 }
 
+void LevelWorld::step(float32 timeStep, int32 velocityIterations, int32 positionIterations) {
+    m_world->Step(timeStep, velocityIterations, positionIterations);
+
+    const b2Profile& p = m_world->GetProfile();
+    b2Profile& avg = m_stats.average;
+    if (m_stats.steps == 0) {
+        avg = p;
+    } else {
+        avg.step = blend(avg.step, p.step);
+        avg.collide = blend(avg.collide, p.collide);
+        avg.solve = blend(avg.solve, p.solve);
+        avg.solveInit = blend(avg.solveInit, p.solveInit);
+        avg.solveVelocity = blend(avg.solveVelocity, p.solveVelocity);
+        avg.solvePosition = blend(avg.solvePosition, p.solvePosition);
+        avg.broadphase = blend(avg.broadphase, p.broadphase);
+        avg.solveTOI = blend(avg.solveTOI, p.solveTOI);
+    }
+    m_stats.last = p;
+    ++m_stats.steps;
+    m_stats.bodyCount = m_world->GetBodyCount();
+    m_stats.contactCount = m_world->GetContactCount();
+    m_stats.proxyCount = m_world->GetProxyCount();
+    m_stats.treeHeight = m_world->GetTreeHeight();
+
+    if (m_rebuilt) {
+        // report the contacts of the new positions now, a rebuild would detect them silently
+        m_world->Step(0.0f, 0, 0);
+    }
+}
+
+void LevelWorld::rebuild(const std::vector<const b2Body*>& order) {
+    Expects(!m_world->IsLocked());
+
+    std::vector<b2Body*> bodies;
+    std::unordered_set<const b2Body*> ordered(order.begin(), order.end());
+    for (b2Body* body = m_world->GetBodyList(); body; body = body->GetNext()) {
+        if (body->GetType() == b2_staticBody && ordered.count(body) == 0) {
+            bodies.push_back(body);
+        }
+    }
+    // bodies are prepended to the list as well
+    std::reverse(bodies.begin(), bodies.end());
+    for (const b2Body* body : order) {
+        if (body->GetWorld() == m_world) {
+            bodies.push_back(const_cast<b2Body*>(body));
+        }
+    }
+
+    auto* world = new b2World(m_world->GetGravity());
+    std::unordered_map<const b2Body*, size_t> indices;
+    std::vector<b2Body*> copies;
+    for (b2Body* body : bodies) {
+        indices[body] = copies.size();
+        copies.push_back(copyBody(*world, body));
+    }
+
+    // the joints in the order of their bodies, not in the order they happened to be created in
+    std::vector<b2Joint*> joints;
+    for (b2Joint* joint = m_world->GetJointList(); joint; joint = joint->GetNext()) {
+        if (indices.count(joint->GetBodyA()) != 0 && indices.count(joint->GetBodyB()) != 0) {
+            joints.push_back(joint);
+        }
+    }
+    std::sort(joints.begin(), joints.end(), [&indices](b2Joint* a, b2Joint* b) {
+        return std::make_pair(indices[a->GetBodyA()], indices[a->GetBodyB()]) <
+               std::make_pair(indices[b->GetBodyA()], indices[b->GetBodyB()]);
+    });
+    for (b2Joint* joint : joints) {
+        copyJoint(*world, joint, copies[indices[joint->GetBodyA()]],
+                  copies[indices[joint->GetBodyB()]]);
+    }
+
+    // detect the contacts without reporting them, they were reported in the old world
+    world->Step(0.0f, 0, 0);
+    world->SetContactListener(m_listener);
+
+    for (b2Body* body = m_world->GetBodyList(); body; body = body->GetNext()) {
+        if (body->GetUserData()) {
+            auto it = indices.find(body);
+            static_cast<PhysicalObject*>(body->GetUserData())
+                ->replaceBody(body, it != indices.end() ? copies[it->second] : nullptr);
+        }
+    }
+    delete m_world;
+    m_world = world;
+    m_rebuilt = true;
+}
+
+void LevelWorld::printStats(std::ostream& os) const {
+    const b2Profile& avg = m_stats.average;
+    // the format of the caller's stream is restored at the end
+    const std::ios::fmtflags flags = os.flags();
+    const std::streamsize precision = os.precision();
+    os << std::fixed << std::setprecision(3) << "physics: step " << avg.step << "ms (collide "
+       << avg.collide << ", solve " << avg.solve << ", broadphase " << avg.broadphase
+       << ", toi " << avg.solveTOI << "), bodies " << m_stats.bodyCount << ", contacts "
+       << m_stats.contactCount << ", proxies " << m_stats.proxyCount << ", tree height "
+       << m_stats.treeHeight << "\n";
+
+    os << "touching contacts:";
+    for (int a = 0; a < LevelContactListener::COLLISION_ID_COUNT; ++a) {
+        for (int b = a; b < LevelContactListener::COLLISION_ID_COUNT; ++b) {
+            uint32_t count = m_listener->getContactCount(a, b);
+            if (count > 0) {
+                os << " " << LevelContactListener::getCollisionIdName(a) << "/"
+                   << LevelContactListener::getCollisionIdName(b) << "=" << count;
+            }
+        }
+    }
+    os << std::endl;
+    os.flags(flags);
+    os.precision(precision);
+}
+
 LevelWorld::~LevelWorld() {
     delete m_listener;
     delete m_world;
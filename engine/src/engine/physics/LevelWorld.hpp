@@ -7,6 +7,10 @@
 #ifndef ENGINE_PHYSICS_LEVELWORLD_HPP
 #define ENGINE_PHYSICS_LEVELWORLD_HPP
 
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
 #include <Box2D/Box2D.h>
 
 namespace ctb {
@@ -14,6 +18,20 @@ namespace engine {
 
 class LevelContactListener;
 
+/// Statistics about the physics simulation of a LevelWorld
+struct PhysicsStats {
+    /// Timings of the last step in ms
+    b2Profile last{};
+    /// Exponential moving average of the step timings in ms
+    b2Profile average{};
+    /// Number of steps done so far
+    uint32_t steps{0};
+    int32 bodyCount{0};
+    int32 contactCount{0};
+    int32 proxyCount{0};
+    int32 treeHeight{0};
+};
+
 /// Level world information
 class LevelWorld {
    public:
@@ -31,11 +49,41 @@ class LevelWorld {
     /// Return the level contact listener
     LevelContactListener* getListener() const { return m_listener; }
 
+    /// \brief Steps the world and records the physics statistics.
+    ///
+    /// \param timeStep The amount of time to simulate.
+    /// \param velocityIterations Iterations of the velocity constraint solver.
+    /// \param positionIterations Iterations of the position constraint solver.
+    void step(float32 timeStep, int32 velocityIterations, int32 positionIterations);
+
+    /// \brief Replaces the world by a copy without contacts, so the simulation continues the same
+    /// way whatever happened in the world before, e.g. after restoring a snapshot.
+    ///
+    /// The static bodies which are not in order (the level geometry) are copied first, in their
+    /// creation order, then the bodies in order. Other dynamic bodies belong to removed objects
+    /// and are dropped. The contacts are detected again without
+    /// reporting them; from then on they are also updated at the end of every step, so a
+    /// rebuild only misses the contacts of bodies moved between two steps. The owners of the
+    /// bodies are updated with PhysicalObject::replaceBody(). The world must not be locked.
+    ///
+    /// \param order the bodies in the order of a snapshot, the ones of other worlds are skipped
+    void rebuild(const std::vector<const b2Body*>& order);
+
+    /// Returns the statistics of the simulation
+    const PhysicsStats& getStats() const { return m_stats; }
+
+    /// Writes the statistics including the touching contacts per pair type to os
+    void printStats(std::ostream& os) const;
+
    private:
     // Box2d world
     b2World* m_world{nullptr};
     /// the contact listener of this world
     LevelContactListener* m_listener{nullptr};
+    /// the statistics of this world
+    PhysicsStats m_stats;
+    /// whether the world was rebuilt, the contacts are updated after every step from then on
+    bool m_rebuilt{false};
 };
 
 }  // namespace engine
@@ -32,6 +32,16 @@ class PhysicalObject {
      */
     virtual void addToWorld(b2World& world, Kinematics& kinematics) = 0;
 
+    /**
+     * @brief Called for every body of this object when its world is rebuilt, see
+     *        LevelWorld::rebuild(). Objects that keep pointers to their bodies have to update them.
+     *
+     * @param body the old body, it is destroyed after all objects were called
+     * @param copy the body which replaces it, with the same fixtures and joints in the same
+     *             order, or null if the body was dropped
+     */
+    virtual void replaceBody(b2Body* /*body*/, b2Body* /*copy*/) {}
+
     /**
      * @brief Sets the collision ID of this object, on which it can be identified in the
      * ContactListener
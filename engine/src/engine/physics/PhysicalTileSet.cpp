@@ -11,10 +11,10 @@
 namespace ctb {
 namespace engine {
 
-PhysicalTileSet::PhysicalTileSet(parser::TilesetConfig& layc,
-                                 parser::LevelConfig* levc,
-                                 bool flipped)
-    : TilesetRenderable(layc, levc, flipped) {}
+PhysicalTileSet::PhysicalTileSet(const DynamicTilestore* tiles,
+                                 const LevelView& view,
+                                 SDL_Texture* tilesheet)
+    : TilesetRenderable(tiles, view, tilesheet) {}
 
 void PhysicalTileSet::addToWorld(b2World& world, Kinematics& kinematics) {
     b2BodyDef boxdef;
@@ -61,7 +61,7 @@ void PhysicalTileSet::addToWorld(b2World& world, Kinematics& kinematics) {
         float32 y_ground = convertToWorldCoordinate(i * m_tiles->getTileHeight() + 0.1);
 
         for (int j = 0; j < m_tiles->getWidth(); j++) {
-            if (m_tiles->get(j, i)) {
+            if (tile(j, i)) {
                 // compute temporary end Point
                 end = float32(j * m_tiles->getTileWidth());
 
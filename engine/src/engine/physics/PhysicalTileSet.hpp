@@ -21,11 +21,11 @@ class PhysicalTileSet : public PhysicalObject, public TilesetRenderable {
     /**
      * @brief Constructor
      *
-     * @param layc TileSet configuration data
-     * @param levc Level configuration data
-     * @param flipped Should the TileSet be vertical reflected
+     * @param tiles the tiles of the layer as parsed
+     * @param view the level, the tiles are reflected if it is flipped
+     * @param tilesheet the texture of the tilesheet, it isn't destroyed with the tileset
      */
-    PhysicalTileSet(parser::TilesetConfig& layc, parser::LevelConfig* levc, bool flipped);
+    PhysicalTileSet(const DynamicTilestore* tiles, const LevelView& view, SDL_Texture* tilesheet);
 
     /**
      * @brief adds a physical representation for every tile and ground shapes to the world
@@ -0,0 +1,84 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#include <stdexcept>
+
+#include "engine/core/Game.hpp"
+#include "engine/replay/InputRecorder.hpp"
+#include "engine/replay/ReplayRecorder.hpp"
+#include "engine/scene/Player.hpp"
+#include "engine/util/Clock.hpp"
+
+namespace ctb {
+namespace engine {
+
+InputRecorder::InputRecorder(const std::string& path)
+    : m_file(path, std::ios::binary | std::ios::trunc) {
+    if (!m_file) {
+        throw std::runtime_error("Cannot open input recording \"" + path + "\".");
+    }
+}
+
+void InputRecorder::begin(Game& game) {
+    deregister();
+    m_game = &game;
+    m_match = InputMatch();
+    m_match.configHash = replayConfigHash(game.getConfig());
+    m_match.seed = game.getSeed();
+    m_match.clock = Clock::ticks();
+
+    std::vector<Player*> players = game.getL2RPlayers();
+    players.insert(players.end(), game.getR2LPlayers().begin(), game.getR2LPlayers().end());
+    for (size_t i = 0; i < players.size() && i < INPUT_END_PLAYER; ++i) {
+        Player* player = players[i];
+        m_match.players.push_back(
+            {static_cast<uint8_t>(player->getTeam() == Team::L2R ? 0 : 1),
+             player->getConfigIndex()});
+        if (player->getInput() == nullptr) {
+            continue;
+        }
+        auto index = static_cast<uint8_t>(i);
+        InputHandler handler = [this, index](InputType type, Input*, bool state, float angle) {
+            // the players ignore the inputs while the game is paused
+            if (isRecordedInput(type) && m_game->getGameState() == GameState::Running) {
+                m_match.events.push_back({static_cast<uint32_t>(m_game->getTick()), index,
+                                          type, state, angle});
+            }
+        };
+        m_handlers.push_back({player->getInput(), player->getInput()->register_handler(handler)});
+    }
+}
+
+void InputRecorder::end(Game& game) {
+    if (&game != m_game) {
+        return;
+    }
+    deregister();
+    m_match.ticks = static_cast<uint32_t>(game.getTick());
+    m_match.checksum = game.checksum();
+    m_game = nullptr;
+
+    std::vector<uint8_t> buffer;
+    writeInputMatch(m_match, buffer);
+    m_file.write(reinterpret_cast<const char*>(buffer.data()),
+                 static_cast<std::streamsize>(buffer.size()));
+    m_file.flush();
+    ++m_matches;
+}
+
+void InputRecorder::deregister() {
+    for (auto& handler : m_handlers) {
+        handler.first->deregister_handler(handler.second);
+    }
+    m_handlers.clear();
+}
+
+InputRecorder::~InputRecorder() {
+    deregister();
+}
+
+}  // namespace engine
+}  // namespace ctb
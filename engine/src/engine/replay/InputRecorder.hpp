@@ -0,0 +1,69 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_REPLAY_INPUTRECORDER_HPP
+#define ENGINE_REPLAY_INPUTRECORDER_HPP
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "engine/input/Input.hpp"
+#include "engine/replay/InputRecording.hpp"
+
+namespace ctb {
+namespace engine {
+
+class Game;
+
+/**
+ * @brief Records the gameplay input events of all players of the games of an engine into an
+ *        input recording, one match per game. Together with the seed of the game, they
+ *        determine the whole match, so ReplayInputs simulate it again.
+ */
+class InputRecorder {
+   public:
+    /**
+     * @brief Constructor, truncates the file
+     *
+     * @throws runtime_error if the file can't be opened
+     */
+    explicit InputRecorder(const std::string& path);
+    InputRecorder(const InputRecorder&) = delete;
+    InputRecorder& operator=(const InputRecorder&) = delete;
+
+    /// Starts recording the inputs of the players of game, called when the game starts
+    void begin(Game& game);
+
+    /// Writes the match of game if it was recorded, called before the game is deleted
+    void end(Game& game);
+
+    /// Returns the number of written matches
+    uint32_t getMatches() const { return m_matches; }
+
+    /// Destructor
+    ~InputRecorder();
+
+   private:
+    /// Deregisters the handlers from the inputs
+    void deregister();
+
+    std::ofstream m_file;
+
+    /// the recorded game
+    Game* m_game{nullptr};
+    InputMatch m_match;
+    /// the inputs with the ids of the handlers registered at them
+    std::vector<std::pair<Input*, uint64_t>> m_handlers;
+    uint32_t m_matches{0};
+};
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_REPLAY_INPUTRECORDER_HPP
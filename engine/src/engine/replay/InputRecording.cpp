@@ -0,0 +1,117 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#include <stdexcept>
+#include <utility>
+
+#include <gsl/gsl>
+
+#include "engine/replay/InputRecording.hpp"
+#include "engine/util/ByteStream.hpp"
+
+namespace ctb {
+namespace engine {
+
+bool isRecordedInput(InputType type) {
+    switch (type) {
+        case InputType::INPUT_LEFT:
+        case InputType::INPUT_RIGHT:
+        case InputType::INPUT_AIM_VERT:
+        case InputType::INPUT_SHOOT:
+        case InputType::INPUT_JUMP:
+        case InputType::INPUT_HEAL:
+        case InputType::INPUT_TAUNT:
+        case InputType::INPUT_DROP_WEAPON:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void writeInputMatch(const InputMatch& match, std::vector<uint8_t>& out) {
+    Expects(match.players.size() < INPUT_END_PLAYER);
+    ByteWriter writer(out);
+    writer.writeU32(INPUT_MAGIC);
+    writer.writeU8(INPUT_VERSION);
+    writer.writeU64(match.configHash);
+    writer.writeU32(match.seed);
+    writer.writeU32(match.clock);
+    writer.writeU8(static_cast<uint8_t>(match.players.size()));
+    for (const InputPlayer& player : match.players) {
+        writer.writeU8(player.team);
+        writer.writeVarU32(player.configIndex);
+    }
+
+    uint32_t tick = 0;
+    for (const InputEvent& event : match.events) {
+        Expects(event.tick >= tick && event.player < match.players.size());
+        writer.writeVarU32(event.tick - tick);
+        tick = event.tick;
+        writer.writeU8(event.player);
+        writer.writeU8(static_cast<uint8_t>(event.type));
+        writer.writeBool(event.state);
+        if (event.type == InputType::INPUT_AIM_VERT) {
+            writer.writeFloat(event.angle);
+        }
+    }
+    Expects(match.ticks >= tick);
+    writer.writeVarU32(match.ticks - tick);
+    writer.writeU8(INPUT_END_PLAYER);
+    writer.writeU64(match.checksum);
+}
+
+std::vector<InputMatch> readInputMatches(const uint8_t* data, size_t size) {
+    std::vector<InputMatch> matches;
+    ByteReader reader(data, size);
+    while (!reader.atEnd()) {
+        if (reader.readU32() != INPUT_MAGIC || reader.readU8() != INPUT_VERSION) {
+            throw std::runtime_error("No input recording of this version");
+        }
+        InputMatch match;
+        match.configHash = reader.readU64();
+        match.seed = reader.readU32();
+        match.clock = reader.readU32();
+        match.players.resize(reader.readU8());
+        for (InputPlayer& player : match.players) {
+            player.team = reader.readU8();
+            player.configIndex = reader.readVarU32();
+            if (player.team > 1) {
+                throw std::runtime_error("Invalid team in input recording");
+            }
+        }
+
+        uint32_t tick = 0;
+        for (;;) {
+            tick += reader.readVarU32();
+            uint8_t player = reader.readU8();
+            if (player == INPUT_END_PLAYER) {
+                break;
+            }
+            uint8_t type = reader.readU8();
+            InputEvent event;
+            event.tick = tick;
+            event.player = player;
+            event.type = static_cast<InputType>(type);
+            event.state = reader.readBool();
+            if (player >= match.players.size() ||
+                type > static_cast<uint8_t>(InputType::INPUT_TEAM_2) ||
+                !isRecordedInput(event.type)) {
+                throw std::runtime_error("Invalid event in input recording");
+            }
+            if (event.type == InputType::INPUT_AIM_VERT) {
+                event.angle = reader.readFloat();
+            }
+            match.events.push_back(event);
+        }
+        match.ticks = tick;
+        match.checksum = reader.readU64();
+        matches.push_back(std::move(match));
+    }
+    return matches;
+}
+
+}  // namespace engine
+}  // namespace ctb
@@ -0,0 +1,96 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_REPLAY_INPUTRECORDING_HPP
+#define ENGINE_REPLAY_INPUTRECORDING_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "engine/input/Input.hpp"
+
+namespace ctb {
+namespace engine {
+
+/**
+ * An input recording is a sequence of matches, each:
+ *   INPUT_MAGIC u32, INPUT_VERSION u8, config hash u64, seed u32, clock u32,
+ *   player count u8 and per player its team u8 (0 L2R, 1 R2L) and config index (variable length)
+ * followed by the events in the order they happened, each:
+ *   tick relative to the previous event (variable length), player u8, type u8, state bool and
+ *   for INPUT_AIM_VERT the angle as float
+ * and the end: tick relative to the last event, INPUT_END_PLAYER and the checksum u64 of the
+ * game at that tick.
+ */
+
+/// First bytes of every match ("CTBI")
+constexpr uint32_t INPUT_MAGIC = 0x49425443;
+
+/// Format version of the input recordings
+constexpr uint8_t INPUT_VERSION = 1;
+
+/// Player index of the end of a match
+constexpr uint8_t INPUT_END_PLAYER = 255;
+
+/// An input event of a player
+struct InputEvent {
+    /// the number of ticks the game had simulated when the event happened
+    uint32_t tick{0};
+    uint8_t player{0};
+    InputType type{InputType::INPUT_LEFT};
+    bool state{false};
+    /// only valid for INPUT_AIM_VERT
+    float angle{0};
+
+    bool operator==(const InputEvent& other) const {
+        return tick == other.tick && player == other.player && type == other.type &&
+               state == other.state && angle == other.angle;
+    }
+};
+
+/// A player of a recorded match
+struct InputPlayer {
+    /// 0 L2R, 1 R2L
+    uint8_t team{0};
+    /// index of the player config
+    uint32_t configIndex{0};
+};
+
+/// The inputs of all players of a match
+struct InputMatch {
+    /// identifies the game config, see replayConfigHash
+    uint64_t configHash{0};
+    uint32_t seed{0};
+    /// Clock::ticks() when the game started, the timers of the game depend on it
+    uint32_t clock{0};
+    /// the players in the order of the game, L2R first
+    std::vector<InputPlayer> players;
+    /// the events sorted by tick
+    std::vector<InputEvent> events;
+    /// the number of simulated ticks at the end of the recording
+    uint32_t ticks{0};
+    /// Game::checksum() after the last tick, to verify a replay simulated the same match
+    uint64_t checksum{0};
+};
+
+/// Returns if events of type are recorded: the gameplay inputs, not pause or menu inputs
+bool isRecordedInput(InputType type);
+
+/// Appends a match to out
+void writeInputMatch(const InputMatch& match, std::vector<uint8_t>& out);
+
+/**
+ * @brief Reads all matches of an input recording
+ *
+ * @throws runtime_error if the data is no input recording of this version
+ */
+std::vector<InputMatch> readInputMatches(const uint8_t* data, size_t size);
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_REPLAY_INPUTRECORDING_HPP
@@ -0,0 +1,141 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+
+#include <parser/LevelConfig.hpp>
+
+#include "engine/Engine.hpp"
+#include "engine/Window.hpp"
+#include "engine/core/Game.hpp"
+#include "engine/core/Level.hpp"
+#include "engine/replay/ReplayPlayer.hpp"
+#include "engine/replay/ReplayRecorder.hpp"
+#include "engine/replay/ReplayStream.hpp"
+#include "engine/scene/Player.hpp"
+#include "engine/util/Clock.hpp"
+
+namespace ctb {
+namespace engine {
+
+namespace {
+/// Maximum wall clock time in ms caught up after a long frame, the rest is skipped
+constexpr uint32_t kMaxCatchUp = 1000;
+}  // namespace
+
+ReplayPlayer::ReplayPlayer(Engine& engine, const std::string& path, double startSeconds)
+    : m_engine(engine),
+      m_mirror(engine),
+      m_configHash(replayConfigHash(engine.getGameConfig())),
+      m_lastTime(SDL_GetTicks()) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Cannot open replay file \"" + path + "\".");
+    }
+    m_data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    m_reader = new ReplayReader(m_data.data(), m_data.size());
+    if (!nextRecording()) {
+        throw std::runtime_error("The replay file \"" + path + "\" has no recording.");
+    }
+
+    if (startSeconds > 0) {
+        auto skipped = static_cast<uint32_t>(std::lround(startSeconds * 1000 / Clock::FIXED_STEP));
+        uint32_t target = m_reader->getState().tick + skipped;
+        // the scores are part of every keyframe, so only the frames after it are needed
+        m_reader->seek(target);
+        applyEvents();
+        while (m_reader->getState().tick < target && m_reader->nextFrame()) {
+            applyEvents();
+        }
+        m_mirror.apply(m_reader->getState());
+    }
+}
+
+bool ReplayPlayer::nextRecording() {
+    for (;;) {
+        if (!m_reader->nextRecording()) {
+            return false;
+        }
+        const ReplayHeader& header = m_reader->getHeader();
+        if (header.configHash != m_configHash) {
+            throw std::runtime_error("The replay was recorded with another game file.");
+        }
+        // an empty recording, e.g. of a game stopped in the start menu
+        if (!m_reader->nextFrame()) {
+            continue;
+        }
+
+        m_mirror.start(header.seed, m_reader->getState());
+        Game* game = m_mirror.getGame();
+        bool sameLevels = static_cast<size_t>(game->getLevelCount()) == header.levels.size();
+        for (int i = 0; sameLevels && i < game->getLevelCount(); ++i) {
+            ReplayLevel played{game->getLevelConfig(i)->getLevelFilename(),
+                               game->isLevelFlipped(i)};
+            sameLevels = played == header.levels[static_cast<size_t>(i)];
+        }
+        if (!sameLevels) {
+            throw std::runtime_error("The replay was recorded with other levels.");
+        }
+        applyEvents();
+        m_mirror.apply(m_reader->getState());
+        return true;
+    }
+}
+
+void ReplayPlayer::applyEvents() {
+    for (const ReplayEvent& event : m_reader->getEvents()) {
+        if (event.type == ReplayEventType::Score) {
+            Player* player = m_mirror.getPlayer(event.entity);
+            if (player != nullptr) {
+                player->setScore(event.value);
+            }
+        } else if (Window::isVerbose()) {
+            std::cout << "replay: " << (event.value == 0 ? "L2R" : "R2L") << " won" << std::endl;
+        }
+    }
+}
+
+void ReplayPlayer::update() {
+    if (m_finished) {
+        return;
+    }
+    uint32_t now = SDL_GetTicks();
+    m_pending = std::min(m_pending + (now - m_lastTime), kMaxCatchUp);
+    m_lastTime = now;
+
+    bool advanced = false;
+    while (m_pending >= Clock::FIXED_STEP) {
+        m_pending -= Clock::FIXED_STEP;
+        if (m_reader->nextFrame()) {
+            applyEvents();
+            advanced = true;
+            continue;
+        }
+        // the events of the end frame, then the next game
+        applyEvents();
+        if (!nextRecording()) {
+            m_finished = true;
+            return;
+        }
+        advanced = false;
+    }
+    // only the last of several due frames is displayed
+    if (advanced) {
+        m_mirror.apply(m_reader->getState());
+    }
+}
+
+ReplayPlayer::~ReplayPlayer() {
+    delete m_reader;
+}
+
+}  // namespace engine
+}  // namespace ctb
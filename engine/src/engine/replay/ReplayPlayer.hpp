@@ -0,0 +1,80 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_REPLAY_REPLAYPLAYER_HPP
+#define ENGINE_REPLAY_REPLAYPLAYER_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "engine/net/MirrorGame.hpp"
+
+namespace ctb {
+namespace engine {
+
+class Engine;
+class ReplayReader;
+
+/**
+ * @brief Displays the recordings of a replay file one after another in real time. The games
+ *        are not simulated, their players, bots and the flag are moved to the recorded states
+ *        by a MirrorGame.
+ */
+class ReplayPlayer {
+   public:
+    /**
+     * @brief Loads the file and displays its first recording
+     *
+     * @param engine        the engine to create the games with
+     * @param path          the replay file
+     * @param startSeconds  the first recording starts at this time of the game
+     *
+     * @throws runtime_error if the file can't be read or was recorded with another game file
+     */
+    ReplayPlayer(Engine& engine, const std::string& path, double startSeconds = 0);
+    ReplayPlayer(const ReplayPlayer&) = delete;
+    ReplayPlayer& operator=(const ReplayPlayer&) = delete;
+
+    /// Displays the frames that are due since the last update
+    void update();
+
+    /// Returns if all recordings were displayed
+    bool isFinished() const { return m_finished; }
+
+    /// Destructor, stops the game
+    ~ReplayPlayer();
+
+   private:
+    /**
+     * @brief Starts the display of the next recording
+     *
+     * @return false if there is none
+     * @throws runtime_error if the recording doesn't match the game file
+     */
+    bool nextRecording();
+
+    /// Applies the events of the current frame
+    void applyEvents();
+
+    Engine& m_engine;
+    std::vector<uint8_t> m_data;
+    ReplayReader* m_reader{nullptr};
+    MirrorGame m_mirror;
+    /// the config hash of the game file of the engine
+    uint64_t m_configHash;
+
+    /// wall clock time of the last update in ms
+    uint32_t m_lastTime;
+    /// wall clock time since the last displayed frame in ms
+    uint32_t m_pending{0};
+    bool m_finished{false};
+};
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_REPLAY_REPLAYPLAYER_HPP
@@ -0,0 +1,157 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <stdexcept>
+
+#include <parser/GameConfig.hpp>
+#include <parser/LevelConfig.hpp>
+#include <parser/PlayerConfig.hpp>
+
+#include "engine/core/Game.hpp"
+#include "engine/core/Level.hpp"
+#include "engine/net/WorldCapture.hpp"
+#include "engine/replay/ReplayRecorder.hpp"
+#include "engine/scene/Player.hpp"
+#include "engine/util/Checksum.hpp"
+
+namespace ctb {
+namespace engine {
+
+namespace {
+using SteadyClock = std::chrono::steady_clock;
+
+void addString(Checksum& hash, const std::string& value) {
+    hash.add(static_cast<uint64_t>(value.size()));
+    hash.add(reinterpret_cast<const uint8_t*>(value.data()), value.size());
+}
+
+/// Returns a score as event value, larger scores are clamped
+uint32_t scoreValue(uint64_t score) {
+    return static_cast<uint32_t>(
+        std::min<uint64_t>(score, std::numeric_limits<uint32_t>::max()));
+}
+}  // namespace
+
+constexpr size_t ReplayRecorder::FLUSH_SIZE;
+
+uint64_t replayConfigHash(parser::GameConfig* config) {
+    Checksum hash;
+    // a multimap iterates in a fixed order: by type and within a type in the order of the file
+    for (auto& entry : config->getLevels()) {
+        parser::LevelConfig* level = entry.second;
+        addString(hash, level->getLevelFilename());
+        hash.add(static_cast<uint64_t>(level->getLevelType()));
+        hash.add(static_cast<uint64_t>(level->getPixelWidth()));
+        hash.add(static_cast<uint64_t>(level->getPixelHeight()));
+    }
+    for (parser::PlayerConfig* player : config->getPlayers()) {
+        addString(hash, player->getName());
+        hash.add(static_cast<uint64_t>(player->getFrameWidth()));
+        hash.add(static_cast<uint64_t>(player->getFrameHeight()));
+        hash.add(static_cast<uint64_t>(player->getNumFrames()));
+    }
+    return hash.value();
+}
+
+ReplayRecorder::ReplayRecorder(const std::string& path)
+    : m_file(path, std::ios::binary | std::ios::trunc), m_writer(m_buffer) {
+    if (!m_file) {
+        throw std::runtime_error("Cannot open replay file \"" + path + "\".");
+    }
+}
+
+void ReplayRecorder::record(Game& game) {
+    if (&game != m_game) {
+        finish();
+        m_game = &game;
+        m_lastTick = game.getTick();
+        m_won = false;
+    }
+    // ticks are only simulated while the game runs
+    if (m_won || game.getTick() <= m_lastTick) {
+        return;
+    }
+    auto start = SteadyClock::now();
+    m_lastTick = game.getTick();
+    if (!m_writer.isRecording()) {
+        begin();
+    }
+
+    captureWorldState(game, m_players, static_cast<uint32_t>(m_lastTick), m_state);
+    m_events.clear();
+    bool keyframe = m_writer.isNextKeyframe();
+    for (size_t i = 0; i < m_players.size(); ++i) {
+        uint64_t score = m_players[i]->getScore();
+        if (keyframe || score != m_scores[i]) {
+            m_events.push_back({ReplayEventType::Score, static_cast<uint16_t>(i),
+                                scoreValue(score)});
+            m_scores[i] = score;
+        }
+    }
+    m_writer.writeFrame(m_state, m_events);
+
+    if (game.isFinished()) {
+        m_events.clear();
+        m_events.push_back({ReplayEventType::Winner, WorldState::NO_ENTITY,
+                            game.getWinner() == Team::L2R ? 0u : 1u});
+        m_writer.endRecording(m_events);
+        m_won = true;
+        flush();
+    } else if (m_buffer.size() >= FLUSH_SIZE) {
+        flush();
+    }
+    m_seconds += std::chrono::duration<double>(SteadyClock::now() - start).count();
+}
+
+void ReplayRecorder::begin() {
+    ReplayHeader header;
+    header.configHash = replayConfigHash(m_game->getConfig());
+    header.seed = m_game->getSeed();
+    for (int i = 0; i < m_game->getLevelCount(); ++i) {
+        header.levels.push_back(
+            {m_game->getLevelConfig(i)->getLevelFilename(), m_game->isLevelFlipped(i)});
+    }
+    m_writer.beginRecording(header);
+
+    // the ids of a MirrorGame: the L2R players first, like the order of startGame
+    m_players = m_game->getL2RPlayers();
+    m_players.insert(m_players.end(), m_game->getR2LPlayers().begin(),
+                     m_game->getR2LPlayers().end());
+    m_scores.assign(m_players.size(), 0);
+    ++m_recordings;
+}
+
+void ReplayRecorder::finish() {
+    if (m_writer.isRecording()) {
+        // a game stopped before it was won
+        m_events.clear();
+        m_writer.endRecording(m_events);
+    }
+    flush();
+    m_game = nullptr;
+    m_players.clear();
+}
+
+void ReplayRecorder::flush() {
+    if (m_buffer.empty()) {
+        return;
+    }
+    m_file.write(reinterpret_cast<const char*>(m_buffer.data()),
+                 static_cast<std::streamsize>(m_buffer.size()));
+    m_file.flush();
+    m_written += m_buffer.size();
+    m_buffer.clear();
+}
+
+ReplayRecorder::~ReplayRecorder() {
+    finish();
+}
+
+}  // namespace engine
+}  // namespace ctb
@@ -0,0 +1,107 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_REPLAY_REPLAYRECORDER_HPP
+#define ENGINE_REPLAY_REPLAYRECORDER_HPP
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "engine/net/WorldState.hpp"
+#include "engine/replay/ReplayStream.hpp"
+
+namespace ctb {
+namespace parser {
+class GameConfig;
+}
+
+namespace engine {
+
+class Game;
+class Player;
+
+/**
+ * @brief Hashes what a replay depends on besides the seed: the level files and the player
+ *        sprites of the game config
+ */
+uint64_t replayConfigHash(parser::GameConfig* config);
+
+/**
+ * @brief Records every simulated tick of the games of an engine into a replay file, one
+ *        recording per game.
+ */
+class ReplayRecorder {
+   public:
+    /**
+     * @brief Constructor, truncates the file
+     *
+     * @throws runtime_error if the file can't be opened
+     */
+    explicit ReplayRecorder(const std::string& path);
+    ReplayRecorder(const ReplayRecorder&) = delete;
+    ReplayRecorder& operator=(const ReplayRecorder&) = delete;
+
+    /**
+     * @brief Records the current tick of game, if it was simulated since the last call. A new
+     *        game starts a new recording, the recording of a finished game ends with its winner.
+     */
+    void record(Game& game);
+
+    /// Ends the recording of the current game, e.g. because it is deleted, and writes the file
+    void finish();
+
+    /// Returns the number of recorded frames, keyframes and games
+    uint64_t getFrames() const { return m_writer.getFrames(); }
+    uint64_t getKeyframes() const { return m_writer.getKeyframes(); }
+    uint32_t getRecordings() const { return m_recordings; }
+
+    /// Returns the number of bytes recorded so far
+    uint64_t getBytes() const { return m_written + m_buffer.size(); }
+
+    /// Returns the time spent recording in seconds
+    double getSeconds() const { return m_seconds; }
+
+    /// Destructor, finishes the recording
+    ~ReplayRecorder();
+
+    /// The buffer is written to the file when it is larger than this
+    static constexpr size_t FLUSH_SIZE = 64 * 1024;
+
+   private:
+    /// Starts the recording of m_game
+    void begin();
+
+    /// Writes the buffer to the file
+    void flush();
+
+    std::ofstream m_file;
+    std::vector<uint8_t> m_buffer;
+    uint64_t m_written{0};
+    ReplayWriter m_writer;
+
+    /// the recorded game
+    Game* m_game{nullptr};
+    uint64_t m_lastTick{0};
+    /// if the recording of m_game ended with its winner
+    bool m_won{false};
+    /// the players of m_game by entity id and their last recorded scores
+    std::vector<Player*> m_players;
+    std::vector<uint64_t> m_scores;
+
+    /// the state and events of a frame, their memory is reused
+    WorldState m_state;
+    std::vector<ReplayEvent> m_events;
+
+    uint32_t m_recordings{0};
+    double m_seconds{0};
+};
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_REPLAY_REPLAYRECORDER_HPP
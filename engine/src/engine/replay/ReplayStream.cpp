@@ -0,0 +1,231 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include <gsl/gsl>
+
+#include "engine/replay/ReplayStream.hpp"
+#include "engine/util/ByteStream.hpp"
+
+namespace ctb {
+namespace engine {
+
+constexpr uint32_t ReplayWriter::KEYFRAME_INTERVAL;
+
+void ReplayWriter::beginRecording(const ReplayHeader& header) {
+    Expects(!m_recording && header.levels.size() <= 255);
+    ByteWriter out(m_out);
+    out.writeU32(REPLAY_MAGIC);
+    out.writeU8(REPLAY_VERSION);
+    out.writeU64(header.configHash);
+    out.writeU32(header.seed);
+    out.writeU8(static_cast<uint8_t>(header.levels.size()));
+    for (const ReplayLevel& level : header.levels) {
+        out.writeString(level.file);
+        out.writeBool(level.flipped);
+    }
+    m_recording = true;
+    m_frames = 0;
+}
+
+void ReplayWriter::writeFrame(const WorldState& state, const std::vector<ReplayEvent>& events) {
+    Expects(m_recording && (m_frames == 0 || state.tick > m_previous.tick));
+    bool keyframe = isNextKeyframe();
+    write(keyframe ? REPLAY_KEYFRAME : 0, events, &state);
+    m_previous = state;
+    ++m_frames;
+    ++m_totalFrames;
+    if (keyframe) {
+        ++m_keyframes;
+    }
+}
+
+void ReplayWriter::endRecording(const std::vector<ReplayEvent>& events) {
+    Expects(m_recording);
+    write(REPLAY_END, events, nullptr);
+    m_recording = false;
+}
+
+void ReplayWriter::write(uint8_t flags,
+                         const std::vector<ReplayEvent>& events,
+                         const WorldState* state) {
+    m_frame.clear();
+    ByteWriter frame(m_frame);
+    frame.writeU8(flags);
+    frame.writeVarU32(static_cast<uint32_t>(events.size()));
+    for (const ReplayEvent& event : events) {
+        frame.writeU8(static_cast<uint8_t>(event.type));
+        frame.writeVarU32(event.entity);
+        frame.writeVarU32(event.value);
+    }
+    if (state != nullptr) {
+        const WorldState* baseline = (flags & REPLAY_KEYFRAME) != 0 ? nullptr : &m_previous;
+        writeWorldState(baseline, *state, frame, std::numeric_limits<size_t>::max());
+    }
+
+    // the size first, so readers can skip frames without decoding them
+    ByteWriter out(m_out);
+    out.writeVarU32(static_cast<uint32_t>(m_frame.size()));
+    m_out.insert(m_out.end(), m_frame.begin(), m_frame.end());
+}
+
+bool ReplayReader::nextRecording() {
+    if (m_started) {
+        // skip the rest of the current recording
+        while (nextFrame()) {
+        }
+    }
+    if (m_position >= m_size) {
+        return false;
+    }
+
+    ByteReader in(m_data + m_position, m_size - m_position);
+    if (in.readU32() != REPLAY_MAGIC || in.readU8() != REPLAY_VERSION) {
+        throw std::runtime_error("No replay of this version");
+    }
+    m_header.configHash = in.readU64();
+    m_header.seed = in.readU32();
+    m_header.levels.resize(in.readU8());
+    for (ReplayLevel& level : m_header.levels) {
+        level.file = in.readString();
+        level.flipped = in.readBool();
+    }
+    m_position += in.position();
+    m_firstFrame = m_position;
+    m_started = true;
+    m_ended = false;
+    m_hasState = false;
+    m_events.clear();
+    m_flags = 0;
+    return true;
+}
+
+bool ReplayReader::nextFrame() {
+    if (!m_started || m_ended) {
+        return false;
+    }
+    if (!readFrame(m_position)) {
+        m_ended = true;
+        // the events of the end frame, e.g. the winner
+        std::swap(m_events, m_incomingEvents);
+        m_flags = m_incomingFlags;
+        return false;
+    }
+    std::swap(m_state, m_incoming);
+    std::swap(m_events, m_incomingEvents);
+    m_flags = m_incomingFlags;
+    m_hasState = true;
+    return true;
+}
+
+bool ReplayReader::seek(uint32_t tick) {
+    if (!m_started) {
+        return false;
+    }
+    // only the keyframes are decoded, the other frames are skipped by their size
+    bool hadState = m_hasState;
+    size_t keyframe = m_size;
+    size_t position = m_firstFrame;
+    for (;;) {
+        size_t start = position;
+        size_t payload;
+        size_t size;
+        if (!frameAt(position, payload, size) || (m_data[payload] & REPLAY_END) != 0) {
+            break;
+        }
+        position = payload + size;
+        if ((m_data[payload] & REPLAY_KEYFRAME) == 0) {
+            continue;
+        }
+        size_t next = start;
+        m_hasState = false;
+        if (!readFrame(next) || m_incoming.tick > tick) {
+            break;
+        }
+        keyframe = start;
+    }
+    if (keyframe == m_size) {
+        m_hasState = hadState;
+        return false;
+    }
+
+    m_position = keyframe;
+    m_ended = false;
+    m_hasState = false;
+    return nextFrame();
+}
+
+bool ReplayReader::frameAt(size_t position, size_t& payload, size_t& size) const {
+    if (position >= m_size) {
+        return false;
+    }
+    try {
+        ByteReader in(m_data + position, m_size - position);
+        size = in.readVarU32();
+        payload = position + in.position();
+    } catch (const std::runtime_error&) {
+        return false;
+    }
+    // a frame has at least its flags and event count, a truncated one is ignored
+    return size >= 2 && size <= m_size - payload;
+}
+
+bool ReplayReader::readFrame(size_t& position) {
+    m_incomingFlags = 0;
+    m_incomingEvents.clear();
+    size_t payload;
+    size_t size;
+    if (!frameAt(position, payload, size)) {
+        return false;
+    }
+    try {
+        ByteReader in(m_data + payload, size);
+        m_incomingFlags = in.readU8();
+        uint32_t count = in.readVarU32();
+        if (count > size) {
+            throw std::runtime_error("Invalid replay frame");
+        }
+        for (uint32_t i = 0; i < count; ++i) {
+            ReplayEvent event;
+            uint8_t type = in.readU8();
+            uint32_t entity = in.readVarU32();
+            if (type > static_cast<uint8_t>(ReplayEventType::Winner) ||
+                entity > WorldState::NO_ENTITY) {
+                throw std::runtime_error("Invalid replay event");
+            }
+            event.type = static_cast<ReplayEventType>(type);
+            event.entity = static_cast<uint16_t>(entity);
+            event.value = in.readVarU32();
+            m_incomingEvents.push_back(event);
+        }
+        if ((m_incomingFlags & REPLAY_END) != 0) {
+            position = payload + size;
+            return false;
+        }
+
+        bool keyframe = (m_incomingFlags & REPLAY_KEYFRAME) != 0;
+        if (!keyframe && !m_hasState) {
+            throw std::runtime_error("Replay frame without previous frame");
+        }
+        readWorldState(keyframe ? nullptr : &m_state, in, m_incoming);
+        if (!in.atEnd()) {
+            throw std::runtime_error("Invalid replay frame");
+        }
+    } catch (const std::runtime_error&) {
+        // a damaged frame ends the recording like a truncated one
+        m_incomingFlags = 0;
+        m_incomingEvents.clear();
+        return false;
+    }
+    position = payload + size;
+    return true;
+}
+
+}  // namespace engine
+}  // namespace ctb
@@ -0,0 +1,218 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_REPLAY_REPLAYSTREAM_HPP
+#define ENGINE_REPLAY_REPLAYSTREAM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "engine/net/WorldState.hpp"
+
+namespace ctb {
+namespace engine {
+
+/**
+ * A replay file is a sequence of recordings, one per game. A recording starts with a header:
+ *   REPLAY_MAGIC u32, REPLAY_VERSION u8, config hash u64, seed u32,
+ *   level count u8 and per level its file name (string) and if it is flipped (bool)
+ * followed by frames, each a variable length size and:
+ *   flags u8       REPLAY_KEYFRAME, REPLAY_END
+ *   event count, per event its type u8, entity and value, all variable length
+ *   the state as written by writeWorldState, relative to the previous frame unless it is a
+ *   keyframe, missing in the REPLAY_END frame
+ * A recording without REPLAY_END frame, e.g. of a crashed game, ends with the last complete
+ * frame.
+ */
+
+/// First bytes of every recording ("CTBR")
+constexpr uint32_t REPLAY_MAGIC = 0x52425443;
+
+/// Format version of the recordings
+constexpr uint8_t REPLAY_VERSION = 1;
+
+/// Frame flags
+constexpr uint8_t REPLAY_KEYFRAME = 1;
+constexpr uint8_t REPLAY_END = 2;
+
+/// Things that happened in a tick that are not part of the world state
+enum class ReplayEventType : uint8_t {
+    /// the score of the player entity changed to value
+    Score,
+    /// the team value (0 L2R, 1 R2L) won, only in the REPLAY_END frame
+    Winner
+};
+
+/// Something that happened in a tick
+struct ReplayEvent {
+    ReplayEventType type{ReplayEventType::Score};
+    uint16_t entity{0};
+    uint32_t value{0};
+
+    bool operator==(const ReplayEvent& other) const {
+        return type == other.type && entity == other.entity && value == other.value;
+    }
+};
+
+/// A level of a recorded game
+struct ReplayLevel {
+    /// file name of the level config
+    std::string file;
+    bool flipped{false};
+
+    bool operator==(const ReplayLevel& other) const {
+        return file == other.file && flipped == other.flipped;
+    }
+
+    bool operator!=(const ReplayLevel& other) const { return !(*this == other); }
+};
+
+/// What is needed to display a recording
+struct ReplayHeader {
+    /// identifies the game config, see replayConfigHash
+    uint64_t configHash{0};
+    /// the seed of the game, it determines the levels
+    uint32_t seed{0};
+    /// the levels in the order of the game, to detect a game file with the same hash
+    std::vector<ReplayLevel> levels;
+};
+
+/**
+ * @brief Appends recordings to a buffer. Every frame is written relative to the previous
+ *        one, every KEYFRAME_INTERVAL frames a keyframe is written completely, so playback can
+ *        start there.
+ */
+class ReplayWriter {
+   public:
+    /// Number of frames from one keyframe to the next
+    static constexpr uint32_t KEYFRAME_INTERVAL = 200;
+
+    /// Constructor, out has to outlive the writer
+    explicit ReplayWriter(std::vector<uint8_t>& out) : m_out(out) {}
+
+    /// Starts a recording, the last one has to be ended
+    void beginRecording(const ReplayHeader& header);
+
+    /**
+     * @brief Appends a frame to the recording
+     *
+     * @param state     the state of the frame, with a later tick than the previous frame
+     * @param events    what happened since the previous frame
+     */
+    void writeFrame(const WorldState& state, const std::vector<ReplayEvent>& events);
+
+    /// Ends the recording with the given events, e.g. the winner
+    void endRecording(const std::vector<ReplayEvent>& events);
+
+    /// Returns if a recording was started and not ended
+    bool isRecording() const { return m_recording; }
+
+    /// Returns if the next frame is written as keyframe
+    bool isNextKeyframe() const { return m_frames % KEYFRAME_INTERVAL == 0; }
+
+    /// Returns the number of written frames and keyframes
+    uint64_t getFrames() const { return m_totalFrames; }
+    uint64_t getKeyframes() const { return m_keyframes; }
+
+   private:
+    /// Appends a frame, state may be nullptr in the end frame
+    void write(uint8_t flags, const std::vector<ReplayEvent>& events, const WorldState* state);
+
+    std::vector<uint8_t>& m_out;
+    bool m_recording{false};
+    /// frames of the current recording
+    uint32_t m_frames{0};
+    uint64_t m_totalFrames{0};
+    uint64_t m_keyframes{0};
+    WorldState m_previous;
+    /// the frame being written, its memory is reused
+    std::vector<uint8_t> m_frame;
+};
+
+/**
+ * @brief Reads the recordings written by a ReplayWriter
+ */
+class ReplayReader {
+   public:
+    /// Constructor, the data has to outlive the reader
+    ReplayReader(const uint8_t* data, size_t size) : m_data(data), m_size(size) {}
+
+    /**
+     * @brief Skips the rest of the current recording and reads the header of the next one
+     *
+     * @return false if there is no further recording
+     * @throws runtime_error if the data is no recording of this version
+     */
+    bool nextRecording();
+
+    /// Returns the header of the current recording
+    const ReplayHeader& getHeader() const { return m_header; }
+
+    /**
+     * @brief Reads the next frame of the current recording
+     *
+     * @return false at the end of the recording, the state of the last frame is kept then
+     */
+    bool nextFrame();
+
+    /**
+     * @brief Jumps to the last keyframe of the current recording at or before tick and reads
+     *        it. The frames up to tick follow with nextFrame.
+     *
+     * @return false if the first frame is later than tick
+     */
+    bool seek(uint32_t tick);
+
+    /// Returns the state of the last read frame
+    const WorldState& getState() const { return m_state; }
+
+    /// Returns the events of the last read frame, a keyframe has the score of every player
+    const std::vector<ReplayEvent>& getEvents() const { return m_events; }
+
+    /// Returns if the last read frame is a keyframe
+    bool isKeyframe() const { return (m_flags & REPLAY_KEYFRAME) != 0; }
+
+   private:
+    /// Finds the payload of the frame at position, returns false if there is no complete frame
+    bool frameAt(size_t position, size_t& payload, size_t& size) const;
+
+    /**
+     * @brief Reads the frame at position relative to m_state into m_incoming and moves
+     *        position behind it
+     *
+     * @return false at the end of the recording, the events of the end frame are read then
+     */
+    bool readFrame(size_t& position);
+
+    const uint8_t* m_data;
+    size_t m_size;
+
+    ReplayHeader m_header;
+    bool m_started{false};
+    /// offset of the first frame of the current recording
+    size_t m_firstFrame{0};
+    /// offset of the next frame
+    size_t m_position{0};
+    /// if the end of the current recording was read
+    bool m_ended{false};
+
+    WorldState m_state;
+    /// if m_state belongs to the current recording
+    bool m_hasState{false};
+    /// the frame being read, swapped into m_state if it is used
+    WorldState m_incoming;
+    uint8_t m_flags{0};
+    uint8_t m_incomingFlags{0};
+    std::vector<ReplayEvent> m_events;
+    std::vector<ReplayEvent> m_incomingEvents;
+};
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_REPLAY_REPLAYSTREAM_HPP
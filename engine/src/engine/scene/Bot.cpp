@@ -4,93 +4,52 @@
 // This file is licensed under the MIT license; see LICENSE file in the root of this
 // project for details.
 
-#include <cmath>
-#include <limits>
+#include <gsl/gsl>
 
-#include <boost/foreach.hpp>
-#include <boost/range/join.hpp>
-#include <parser/BotConfig.hpp>
-#include <parser/GameConfig.hpp>
-
-#include "engine/Engine.hpp"
-#include "engine/Window.hpp"
-#include "engine/core/GC.hpp"
-#include "engine/core/Game.hpp"
 #include "engine/core/Level.hpp"
+#include "engine/core/NavGraph.hpp"
+#include "engine/core/Snapshot.hpp"
 #include "engine/scene/Bot.hpp"
 #include "engine/scene/Player.hpp"
-#include "engine/scene/Ufo.hpp"
-#include "engine/scene/Zombie.hpp"
 
 namespace ctb {
 namespace engine {
-namespace {
-using ctb::parser::BotConfig;
-using ctb::parser::GameConfig;
-}  // namespace
 
 Bot::Bot(SDL_Texture* texture,
          int animationWidth,
          int animationHeight,
          int animationCount,
          Level* level)
-    : ActingRenderable(texture, animationWidth, animationHeight, animationCount), m_deleted(false) {
+    : ActingRenderable(texture, animationWidth, animationHeight, animationCount) {
     m_level = level;
-}
-
-Bot* Bot::createBot(b2World& world, const std::string& type, Vector2dT pos, Level* level) {
-    GameConfig* gconf = Window::getEngine().getGame()->getConfig();
-
-    Bot* bot = nullptr;
-    BotConfig* conf = getBotConfig(gconf, type);
-    if (!conf) {
-        return nullptr;
-    }
-    std::string filename = conf->getFilename();
-    if (type == "zombie") {
-        bot = new Zombie(Window::getWindow().loadTexture(filename), 32, 64, 1, level);
-    } else if (type == "ufo") {
-        bot = new Ufo(Window::getWindow().loadTexture(getBotConfig(gconf, "ufo")->getFilename()),
-                      56, 48, 5, level);
-    } else {
-        return nullptr;
-    }
-    if (!bot) {
-        return nullptr;
-    }
-
-    ActingKinematics k;
-    k.setId(Game::BOT_ID);
-    k.setCategory(Level::BOT_CAT);
-    k.setMask(Level::GROUND_CAT | Level::PLAYER_CAT | Level::PROJECTILE_CAT);
-
-    bot->setPosition(pos);
-    bot->addToWorld(world, k);
-    return bot;
-}
-
-BotConfig* Bot::getBotConfig(GameConfig* gconf, const std::string& name) {
-    auto& vec = gconf->getBots();
-    auto it =
-        std::find_if(vec.begin(), vec.end(), [name](BotConfig* c) { return c->getName() == name; });
-    if (it == vec.end()) {
-        return nullptr;
-    }
-    return *it;
+    // the texture belongs to the prefab of the bot
+    m_ownsTexture = false;
 }
 
 void Bot::run() {
-    Game* game = Window::getEngine().getGame();
-    std::vector<Player*> t1 = game->getR2LPlayers();
-    std::vector<Player*> t2 = game->getL2RPlayers();
-
-    Player* player = nullptr;
-    float distance = std::numeric_limits<float>::infinity();
-    for (Player* a : boost::join(t1, t2)) {
-        float current_distance = getDistance(a);
-        if (current_distance < distance) {
-            distance = current_distance;
-            player = a;
+    Player* player = m_level->getSpatialIndex().nearestPlayer(worldPosition());
+
+    m_hasPath = false;
+    if (player && usesNavigation()) {
+        NavGraph& nav = m_level->getNavGraph();
+        int start = nav.nodeAtPixel(x() + animationWidth() / 2, y() + animationHeight() - 1);
+        int goal = nav.nodeAtPixel(player->x() + player->animationWidth() / 2,
+                                   player->y() + player->animationHeight() - 1);
+        const NavGraph::Link* link = nav.nextLink(start, goal);
+        if (link) {
+            m_hasPath = true;
+            const NavGraph::Node& target = nav.getNode(link->to);
+            int targetX = target.x * nav.getTileWidth() + nav.getTileWidth() / 2;
+            int centerX = x() + animationWidth() / 2;
+            if (targetX < centerX) {
+                moveLeft();
+            } else if (targetX > centerX) {
+                moveRight();
+            }
+            if (link->type == NavGraph::LinkType::Jump) {
+                jump();
+            }
+            return;
         }
     }
 
@@ -104,33 +63,39 @@ void Bot::run() {
     }
 }
 
-float Bot::getDistance(Player* player) {
-    if (player) {
-        return std::sqrt(
-            std::pow(
-                static_cast<float>(std::fabs(player->worldPosition().x - this->worldPosition().x)),
-                2.0f) +
-            std::pow(
-                static_cast<float>(std::fabs(player->worldPosition().y - this->worldPosition().y)),
-                2.0f));
-    }
-    return std::numeric_limits<float>::infinity();
+void Bot::saveState(SnapshotWriter& out) const {
+    ActingRenderable::saveState(out);
+    out.writeU8(static_cast<uint8_t>(m_tier));
+}
+
+void Bot::restoreState(SnapshotReader& in) {
+    ActingRenderable::restoreState(in);
+    m_tier = static_cast<SimulationTier>(in.readU8());
 }
 
 void Bot::prepareDelete() {
-    if (!m_deleted) {
-        m_level->deleteBot(this);
-        GC::add(this);
-        m_deleted = true;
-    }
+    m_level->deleteBot(this);
 }
 
 Level* Bot::getLevel() {
     return m_level;
 }
 
+void Bot::setSimulationTier(SimulationTier tier) {
+    if (m_body) {
+        if (tier == SimulationTier::Dormant && m_body->IsAwake()) {
+            // also catches bodies that were woken up by a contact
+            m_body->SetAwake(false);
+        } else if (m_tier == SimulationTier::Dormant && tier != SimulationTier::Dormant) {
+            m_body->SetAwake(true);
+        }
+    }
+    m_tier = tier;
+}
+
 Bot::~Bot() {
     if (m_body) {
+        Expects(!m_body->GetWorld()->IsLocked());
         m_body->GetWorld()->DestroyBody(m_body);
         m_body = nullptr;
     }
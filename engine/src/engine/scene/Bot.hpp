@@ -7,26 +7,33 @@
 #ifndef ENGINE_SCENE_BOT_HPP
 #define ENGINE_SCENE_BOT_HPP
 
+#include "engine/core/Prefabs.hpp"
+#include "engine/core/SlotMap.hpp"
 #include "engine/graphics/ActingRenderable.hpp"
 #include "engine/util/Vector2d.hpp"
 
 namespace ctb {
-namespace parser {
-class BotConfig;
-class GameConfig;
-}  // namespace parser
-
 namespace engine {
 class Player;
 class Level;
 
+/// How detailed a bot is simulated, depending on its distance to the camera
+enum class SimulationTier {
+    /// Full AI and physics every tick
+    Full,
+    /// AI is only ticked every few frames
+    Reduced,
+    /// The body is put to sleep and no AI runs
+    Dormant
+};
+
 /// Parent Class for all Bots
 class Bot : public ActingRenderable {
    public:
     /**
      * @brief Create new Bot
      *
-     * @param texture         the texture of the bot
+     * @param texture         the texture of the bot, shared by all bots of its type
      * @param animationWidth  the width of each animation
      * @param animationHeight the height of each animation
      * @param animationCount  the number of animation
@@ -41,43 +48,66 @@ class Bot : public ActingRenderable {
     /// Destructor
     ~Bot() override;
 
-    /**
-     * @brief static method for creating a bot and spawning it
-     *
-     * @parma world the world where the bot shall be spawned
-     * @param type  the bot type to be spawned
-     * @param pos   the position where it should be spawned
-     * @param level the level the bot should be spawned in
-     *
-     * @return      A pointer to the created bot
-     */
-    static Bot* createBot(b2World& world, const std::string& type, Vector2dT pos, Level* level);
-
-    /**
-     * @brief static method for getting the corresponding BotConfig to name from gconf
-     *
-     * @param gconf The config to be searched in
-     * @param name  The name to be searched for
-     * @return      A pointer to the BotConfig or nullptr if none was found
-     */
-    static parser::BotConfig* getBotConfig(parser::GameConfig* gconf, const std::string& name);
-
+    /// Removes the bot from its level, which deletes it after the next physics step. Calling
+    /// this more than once is harmless.
     void prepareDelete();
 
     virtual void collideWithPlayer(Player* player) = 0;
 
+    /// Returns the id of the prefab this bot was created from, which is its type
+    PrefabId getPrefab() const { return m_prefab; }
+
+    /// Sets the prefab this bot was created from, only Prefabs does this
+    void setPrefab(PrefabId prefab) { m_prefab = prefab; }
+
+    /// Writes the body and the simulation tier to the snapshot
+    void saveState(SnapshotWriter& out) const override;
+
+    /// Restores the state written by saveState
+    void restoreState(SnapshotReader& in) override;
+
     Level* getLevel();
 
+    /// Returns the handle of this bot in its level
+    Handle<Bot> getHandle() const { return m_handle; }
+
+    /// Sets the handle of this bot, only the level does this
+    void setHandle(Handle<Bot> handle) { m_handle = handle; }
+
+    /**
+     * @brief Sets the simulation tier of this bot. Dormant bots are put to sleep and are
+     *        woken up again when they are promoted.
+     *
+     * @param tier the new tier
+     */
+    void setSimulationTier(SimulationTier tier);
+
+    /// Returns the current simulation tier of this bot
+    SimulationTier getSimulationTier() const { return m_tier; }
+
    protected:
     Level* m_level;
 
-    bool m_deleted;
+    /// Handle in the level's bots, stale once the bot was removed
+    Handle<Bot> m_handle;
+
+    /// The prefab this bot was created from
+    PrefabId m_prefab{Prefabs::NONE};
+
+    /// The current simulation tier
+    SimulationTier m_tier{SimulationTier::Full};
+
+    /// Was a path to the target found in the last run()?
+    bool m_hasPath{false};
+
+    /// Returns if the AI of this bot should not run
+    bool isDormant() const { return m_tier == SimulationTier::Dormant; }
 
     /// Handles the running logic
     virtual void run();
 
-    /// Get the distance to the players
-    float getDistance(Player* player);
+    /// Returns if this bot walks along the level's navigation graph instead of a straight line
+    virtual bool usesNavigation() const { return false; }
 };
 
 }  // namespace engine
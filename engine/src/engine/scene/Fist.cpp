@@ -10,6 +10,7 @@
 
 #include "engine/Window.hpp"
 #include "engine/audio/SoundManager.hpp"
+#include "engine/core/Snapshot.hpp"
 #include "engine/scene/Fist.hpp"
 
 namespace ctb {
@@ -150,6 +151,24 @@ void Fist::clearJointList() {
     }
 }
 
+void Fist::saveState(SnapshotWriter& out) const {
+    PhysicalRenderable::saveState(out);
+    out.writeBool(m_use);
+}
+
+void Fist::restoreState(SnapshotReader& in) {
+    PhysicalRenderable::restoreState(in);
+    bool use = in.readBool();
+    if (use != m_use) {
+        // switches the collision mask as well
+        if (use) {
+            this->use();
+        } else {
+            unuse();
+        }
+    }
+}
+
 Fist::~Fist() {
     if (m_body) {
         for (auto& pair : m_representations) {
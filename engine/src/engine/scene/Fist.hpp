@@ -124,6 +124,12 @@ class Fist : public Weapon, public PhysicalRenderable {
      */
     void addToWorld(b2World& world, Kinematics& kinematics) override;
 
+    /// Writes the body and if the weapon is in use to the snapshot
+    void saveState(SnapshotWriter& out) const override;
+
+    /// Restores the state written by saveState, the user has to be set already
+    void restoreState(SnapshotReader& in) override;
+
     /**
      * @brief Destructor
      */
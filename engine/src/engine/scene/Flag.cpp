@@ -8,6 +8,7 @@
 #include "engine/Window.hpp"
 #include "engine/core/Game.hpp"
 #include "engine/core/Level.hpp"
+#include "engine/core/Snapshot.hpp"
 
 namespace ctb {
 namespace engine {
@@ -23,5 +24,15 @@ void Flag::addToThisWorld(b2World& world) {
     PhysicalRenderable::addToWorld(world, k);
 }
 
+void Flag::saveState(SnapshotWriter& out) const {
+    PhysicalRenderable::saveState(out);
+    out.writeBool(m_isInUse);
+}
+
+void Flag::restoreState(SnapshotReader& in) {
+    PhysicalRenderable::restoreState(in);
+    m_isInUse = in.readBool();
+}
+
 }  // namespace engine
 }  // namespace ctb
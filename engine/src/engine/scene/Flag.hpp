@@ -39,6 +39,12 @@ class Flag : public PhysicalRenderable {
     /// shorthand for setInUse(false)
     void setNotInUse() { m_isInUse = false; }
 
+    /// Writes the body and if the flag is in use to the snapshot, the joint is not written
+    void saveState(SnapshotWriter& out) const override;
+
+    /// Restores the state written by saveState
+    void restoreState(SnapshotReader& in) override;
+
     /// Destructor
     ~Flag() override = default;
 
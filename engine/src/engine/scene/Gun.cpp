@@ -4,40 +4,92 @@
 // This file is licensed under the MIT license; see LICENSE file in the root of this
 // project for details.
 
+#include <cmath>
 #include <iostream>
 #include <utility>
 
-#include "engine/Window.hpp"
+#include "engine/Engine.hpp"
+#include "engine/EngineContext.hpp"
 #include "engine/audio/SoundManager.hpp"
 #include "engine/core/Game.hpp"
 #include "engine/core/Level.hpp"
+#include "engine/core/Snapshot.hpp"
 #include "engine/scene/Gun.hpp"
+#include "engine/scene/Player.hpp"
 #include "engine/scene/Projectile.hpp"
+#include "engine/util/Clock.hpp"
 #include "engine/util/Vector2d.hpp"
 
 namespace ctb {
 namespace engine {
 
+namespace {
+
+/// Finds the closest fixture a projectile of the given user would collide with
+class ClosestHitCallback : public b2RayCastCallback {
+   public:
+    explicit ClosestHitCallback(Player* user) : m_user(user) {}
+
+    float32 ReportFixture(b2Fixture* fixture,
+                          const b2Vec2& point,
+                          const b2Vec2& /*normal*/,
+                          float32 fraction) override {
+        const b2Filter& filter = fixture->GetFilterData();
+        void* data = fixture->GetBody()->GetUserData();
+        if (data == nullptr || (filter.maskBits & Level::PROJECTILE_CAT) == 0 ||
+            (filter.categoryBits & (Level::GROUND_CAT | Level::PLAYER_CAT | Level::BOT_CAT)) == 0) {
+            return -1.0f;
+        }
+
+        PhysicalObject* obj = static_cast<PhysicalObject*>(data);
+        // no friendly fire, shots pass through team mates
+        if (obj->getCollisionId() == Game::PLAYER_ID && m_user != nullptr &&
+            dynamic_cast<Player*>(obj)->getTeam() == m_user->getTeam()) {
+            return -1.0f;
+        }
+
+        m_hit = obj;
+        m_point = point;
+        return fraction;
+    }
+
+    PhysicalObject* hit() const { return m_hit; }
+
+    const b2Vec2& point() const { return m_point; }
+
+   private:
+    Player* m_user;
+    PhysicalObject* m_hit{nullptr};
+    b2Vec2 m_point{0.0f, 0.0f};
+};
+
+}  // namespace
+
 Gun::Gun(SDL_Texture* texture,
          int animationWidth,
          int animationHeight,
          int animationCount,
-         std::string projectileTexturePath,
+         SDL_Texture* projectileTexture,
          int projectileAnimationHeight,
          int projectileAnimationWidth,
          int projectileAnimationCount,
          int cooldown,
          float projectileSpeed,
-         uint32_t projectileDamage)
+         uint32_t projectileDamage,
+         bool hitscan)
     : Fist(texture, animationWidth, animationHeight, animationCount),
-      m_projectileTexturePath(std::move(projectileTexturePath)),
+      m_projectileTexture(projectileTexture),
       m_projectileFrameHeight(projectileAnimationHeight),
       m_projectileFrameWidth(projectileAnimationWidth),
       m_projectileNumFrames(projectileAnimationCount),
       m_angle(0),
       m_cooldown(cooldown),
       m_projectileSpeed(projectileSpeed),
-      m_projectileDamage(projectileDamage) {}
+      m_projectileDamage(projectileDamage),
+      m_hitscan(hitscan) {
+    // the textures belong to the prefab of the gun
+    m_ownsTexture = false;
+}
 
 bool Gun::isDropable() {
     return true;
@@ -57,7 +109,7 @@ void Gun::unuse() {
 
 void Gun::update() {
     if (inUse() && m_reloadCount < kMagazineCount) {
-        int ticks = static_cast<int>(SDL_GetTicks());
+        int ticks = static_cast<int>(Clock::ticks());
         if (m_ammo == 0) {
             m_ammo = kMagazineCapacity;
             m_reloadStartTime = ticks;
@@ -65,40 +117,74 @@ void Gun::update() {
         } else if (m_reloadStartTime + kReloadDelay - ticks < 0 &&
                    m_lastShot + m_cooldown - ticks < 0) {
             SoundManager::getInstance().playPew();
-            Projectile* projectile = new Projectile(
-                Window::getWindow().loadTexture(m_projectileTexturePath), m_projectileFrameWidth,
-                m_projectileFrameHeight, m_projectileNumFrames, this, m_projectileDamage);
-
-            Kinematics kinematics;
-            kinematics.setDensity(5.0f);
-            kinematics.setCategory(Level::PROJECTILE_CAT);
-            kinematics.setMask(Level::GROUND_CAT | Level::PLAYER_CAT | Level::BOT_CAT);
-            kinematics.setId(Game::PROJECTILE_ID);
-
-            projectile->addToWorld(*m_body->GetWorld(), kinematics, m_body->GetPosition().x,
-                                   m_body->GetPosition().y, m_angle, m_projectileSpeed);
-
-            m_projectiles.push_back(projectile);
-            m_lastShot = static_cast<int>(SDL_GetTicks());
+            // above the projectile limit of the quality, shots hit without a body
+            uint32_t limit = EngineContext::current().getEngine().getQuality().projectileLimit;
+            if (m_hitscan || (limit > 0 && m_projectiles.size() >= limit)) {
+                shootHitscan();
+            } else {
+                shootProjectile();
+            }
+            m_lastShot = static_cast<int>(Clock::ticks());
             --m_ammo;
         }
     }
 
-    for (Projectile* projectile : m_deleteProjectiles) {
-        auto it = std::find(m_projectiles.begin(), m_projectiles.end(), projectile);
-        if (it != m_projectiles.end()) {
-            delete projectile;
-            m_projectiles.erase(it);
-        }
-    }
-    m_deleteProjectiles.clear();
+    m_deleteProjectiles.flush();
 
-    for (Projectile* projectile : m_projectiles) {
+    // projectiles leaving the level remove themselves, which moves the last one to i
+    const std::vector<Projectile*>& projectiles = m_projectiles.objects();
+    for (size_t i = 0; i < projectiles.size();) {
+        Projectile* projectile = projectiles[i];
         projectile->update();
+        if (i < projectiles.size() && projectiles[i] == projectile) {
+            ++i;
+        }
     }
     Fist::update();
 }
 
+void Gun::shootProjectile() {
+    createProjectile(m_projectileSpeed);
+}
+
+Projectile* Gun::createProjectile(float32 speed) {
+    Projectile* projectile =
+        new Projectile(m_projectileTexture, m_projectileFrameWidth, m_projectileFrameHeight,
+                       m_projectileNumFrames, this, m_projectileDamage);
+
+    Kinematics kinematics;
+    kinematics.setDensity(5.0f);
+    kinematics.setCategory(Level::PROJECTILE_CAT);
+    kinematics.setMask(Level::GROUND_CAT | Level::PLAYER_CAT | Level::BOT_CAT);
+    kinematics.setId(Game::PROJECTILE_ID);
+
+    projectile->addToWorld(*m_body->GetWorld(), kinematics, m_body->GetPosition().x,
+                           m_body->GetPosition().y, m_angle, speed);
+
+    projectile->setHandle(m_projectiles.insert(projectile));
+    return projectile;
+}
+
+void Gun::shootHitscan() {
+    Level* level = EngineContext::current().getEngine().getGame()->getCurrentLevel();
+    b2Vec2 start = m_body->GetPosition();
+    // the same direction as the impulse of a projectile
+    b2Vec2 end = start + m_projectileSpeed * b2Vec2(static_cast<float32>(std::cos(m_angle)),
+                                                    static_cast<float32>(-std::sin(m_angle)));
+
+    ClosestHitCallback callback(m_user);
+    m_body->GetWorld()->RayCast(&callback, start, end);
+    if (callback.hit()) {
+        level->getWorld()->getListener()->projectileHit(m_user, m_projectileDamage,
+                                                        callback.hit());
+        end = callback.point();
+    }
+
+    m_tracerStart = start;
+    m_tracerEnd = end;
+    m_tracerUntil = Clock::ticks() + kTracerDuration;
+}
+
 void Gun::angleWeapon(double angle, Direction direction) {
     if (direction == Direction::Left) {
         m_angle = M_PI / 180 * (-angle + 180);
@@ -108,11 +194,23 @@ void Gun::angleWeapon(double angle, Direction direction) {
 }
 
 void Gun::render() {
-    for (Projectile* projectile : m_projectiles) {
+    for (Projectile* projectile : m_projectiles.objects()) {
         projectile->setOffset(m_offset);
         projectile->render();
     }
 
+    auto* renderer = EngineContext::current().getRenderer();
+    if (m_hitscan && Clock::ticks() < m_tracerUntil) {
+        Vector2dT from = Vector2dT(convertToScreenCoordinate(m_tracerStart.x),
+                                   convertToScreenCoordinate(m_tracerStart.y)) -
+                         m_offset + m_windowOffset;
+        Vector2dT to = Vector2dT(convertToScreenCoordinate(m_tracerEnd.x),
+                                 convertToScreenCoordinate(m_tracerEnd.y)) -
+                       m_offset + m_windowOffset;
+        SDL_SetRenderDrawColor(renderer, 255, 230, 120, 255);
+        SDL_RenderDrawLine(renderer, from.x, from.y, to.x, to.y);
+    }
+
     nextAnimation();
     Vector2dT position = computeTargetPosition();
 
@@ -123,7 +221,6 @@ void Gun::render() {
     target.w = m_targetRect.w;
     target.h = m_targetRect.h;
 
-    auto* renderer = Window::getWindow().renderer();
     if (m_angle * 180 / M_PI > 90) {
         SDL_RenderCopyEx(renderer, m_texture, &m_sourceRect, &target, -m_angle * 180 / M_PI + 180,
                          nullptr, SDL_FLIP_HORIZONTAL);
@@ -140,9 +237,48 @@ void Gun::drop(bool xVelocity) {
 }
 
 void Gun::removeProjectile(Projectile* projectile) {
-    if (std::find(m_deleteProjectiles.begin(), m_deleteProjectiles.end(), projectile) ==
-        m_deleteProjectiles.end()) {
-        m_deleteProjectiles.push_back(projectile);
+    // the handle is stale if the projectile was removed already, e.g. by two contacts
+    if (m_projectiles.erase(projectile->getHandle())) {
+        m_deleteProjectiles.push(projectile);
+    }
+}
+
+void Gun::saveState(SnapshotWriter& out) const {
+    Fist::saveState(out);
+    out.writeDouble(m_angle);
+    out.writeU32(static_cast<uint32_t>(m_ammo));
+    out.writeU32(static_cast<uint32_t>(m_reloadCount));
+    out.writeTime(static_cast<uint32_t>(m_lastShot));
+    out.writeTime(static_cast<uint32_t>(m_reloadStartTime));
+
+    out.writeU32(static_cast<uint32_t>(m_projectiles.size()));
+    for (Projectile* projectile : m_projectiles.objects()) {
+        projectile->saveState(out);
+    }
+}
+
+void Gun::restoreState(SnapshotReader& in) {
+    Fist::restoreState(in);
+    m_angle = in.readDouble();
+    m_ammo = in.readU32();
+    m_reloadCount = in.readU32();
+    m_lastShot = static_cast<int>(in.readTime());
+    m_reloadStartTime = static_cast<int>(in.readTime());
+
+    // the removed projectiles aren't part of the snapshot
+    m_deleteProjectiles.flush();
+    uint32_t count = in.readU32();
+    const std::vector<Projectile*>& projectiles = m_projectiles.objects();
+    while (projectiles.size() > count) {
+        Projectile* projectile = projectiles.back();
+        m_projectiles.erase(projectile->getHandle());
+        delete projectile;
+    }
+    while (projectiles.size() < count) {
+        createProjectile(0.0f);
+    }
+    for (Projectile* projectile : projectiles) {
+        projectile->restoreState(in);
     }
 }
 
@@ -151,13 +287,11 @@ Gun::~Gun() {
 }
 
 void Gun::removeAllProjectiles() {
-    for (auto& projectile : m_projectiles) {
-        if (projectile) {
-            delete projectile;
-            projectile = nullptr;
-        }
+    for (Projectile* projectile : m_projectiles.objects()) {
+        delete projectile;
     }
     m_projectiles.clear();
+    m_deleteProjectiles.flush();
 }
 
 }  // namespace engine
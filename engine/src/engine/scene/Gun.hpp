@@ -15,6 +15,9 @@
 
 #include <SDL.h>
 
+#include "engine/core/DestroyQueue.hpp"
+#include "engine/core/Prefabs.hpp"
+#include "engine/core/SlotMap.hpp"
 #include "engine/scene/Fist.hpp"
 
 namespace ctb {
@@ -30,28 +33,31 @@ class Gun : public Fist {
     /**
      * @brief Constructor
      *
-     * @param texture which should be rendered
+     * @param texture which should be rendered, it isn't destroyed with the gun
      * @param animationWidth of the texture
      * @param animationHeight of the texture
      * @param animationCount of the texture
-     * @param projectileTexturePath Path to texture of the projectile, that should be shot
+     * @param projectileTexture texture of the projectiles, shared by all of them
      * @param projectileAnimationHeight frame-height of the projectile texture
      * @param projectileAnimationWidth frame-width of the projectile texture
      * @param cooldown sleep interval for the shooting rate
-     * @param projectileSpeed speed of the shot projectile
+     * @param projectileSpeed speed of the shot projectile. For hitscan guns this is the
+     *                        length of the ray in world coordinates.
      * @param projectileDamage damage, that should be produced by a shot projectile
+     * @param hitscan resolve shots with a ray cast instead of spawning projectile bodies
      */
     Gun(SDL_Texture* texture,
         int animationWidth,
         int animationHeight,
         int animationCount,
-        std::string projectileTexturePath,
+        SDL_Texture* projectileTexture,
         int projectileAnimationHeight,
         int projectileAnimationWidth,
         int projectileAnimationCount,
         int cooldown,
         float projectileSpeed,
-        uint32_t projectileDamage);
+        uint32_t projectileDamage,
+        bool hitscan = false);
 
     /**
      * @brief Returns, if this weapon is dropable
@@ -105,8 +111,15 @@ class Gun : public Fist {
     /// Returns  the angle of this weapon
     virtual double getAngle() { return m_angle; }
 
+    /// Returns the id of the prefab this gun was created from
+    PrefabId getPrefab() const { return m_prefab; }
+
+    /// Sets the prefab this gun was created from, only Prefabs does this
+    void setPrefab(PrefabId prefab) { m_prefab = prefab; }
+
     /**
-     * @brief Removes a given projectile, which was shot by this weapon
+     * @brief Removes a given projectile, which was shot by this weapon. It is deleted with
+     *        the next update, removing it again before is ignored.
      *
      * @param projectile which should be removed.
      *                   It must be shot by this weapon
@@ -118,6 +131,12 @@ class Gun : public Fist {
      */
     void removeAllProjectiles();
 
+    /// Writes the weapon state, the magazine and all projectiles to the snapshot
+    void saveState(SnapshotWriter& out) const override;
+
+    /// Restores the state written by saveState, projectiles are reused or created as needed
+    void restoreState(SnapshotReader& in) override;
+
     /**
      * @brief Destructor
      */
@@ -133,14 +152,33 @@ class Gun : public Fist {
     /// Maximal magazine count
     static constexpr size_t kMagazineCount{7};
 
+    /// How long the tracer of a hitscan shot is visible in ms
+    static constexpr Uint32 kTracerDuration{60};
+
+    /// Spawns a projectile body for one shot
+    void shootProjectile();
+
+    /**
+     * @brief Creates a projectile at the gun and adds it to the projectiles of this gun
+     *
+     * @param speed the initial speed in the direction of the gun
+     */
+    Projectile* createProjectile(float32 speed);
+
+    /// Resolves one shot with a ray cast and applies its damage immediately
+    void shootHitscan();
+
     /// List of projectiles, which were shot by this gun
-    std::vector<Projectile*> m_projectiles;
+    SlotMap<Projectile> m_projectiles;
 
     /// List of projectiles, which should be deleted in the next update call
-    std::vector<Projectile*> m_deleteProjectiles;
+    DestroyQueue<Projectile> m_deleteProjectiles;
+
+    /// Texture of the projectiles, which were shot by this gun
+    SDL_Texture* m_projectileTexture;
 
-    /// Path to the texture for the projetiles, which were shot by this gun
-    std::string m_projectileTexturePath;
+    /// The prefab this gun was created from
+    PrefabId m_prefab{Prefabs::NONE};
 
     /// Height of the texture
     int m_projectileFrameHeight;
@@ -174,6 +212,16 @@ class Gun : public Fist {
 
     /// Magazine reload start time
     int m_reloadStartTime{0};
+
+    /// Resolve shots with ray casts instead of projectile bodies?
+    bool m_hitscan;
+
+    /// Start and end of the last hitscan shot in world coordinates
+    b2Vec2 m_tracerStart{0.0f, 0.0f};
+    b2Vec2 m_tracerEnd{0.0f, 0.0f};
+
+    /// The tracer is rendered until this tick
+    Uint32 m_tracerUntil{0};
 };
 
 }  // namespace engine
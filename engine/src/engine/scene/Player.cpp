@@ -6,25 +6,33 @@
 
 #include <cmath>
 #include <iostream>
+#include <stdexcept>
 
 #include <SDL.h>
 
 #include "engine/Engine.hpp"
+#include "engine/EngineContext.hpp"
 #include "engine/Window.hpp"
 #include "engine/audio/SoundManager.hpp"
-#include "engine/core/GC.hpp"
 #include "engine/core/Game.hpp"
+#include "engine/core/Snapshot.hpp"
 #include "engine/input/Input.hpp"
 #include "engine/scene/Fist.hpp"
 #include "engine/scene/Flag.hpp"
 #include "engine/scene/Gun.hpp"
 #include "engine/scene/Player.hpp"
+#include "engine/util/Clock.hpp"
 #include "engine/util/Random.hpp"
 #include "engine/util/Vector2d.hpp"
 
 namespace ctb {
 namespace engine {
 
+namespace {
+/// Type of the weapon of a player in a snapshot
+enum class WeaponType : uint8_t { None, Fist, Gun };
+}  // namespace
+
 Player::Player(Team team,
                SDL_Texture* texture,
                int animationWidth,
@@ -70,14 +78,6 @@ void Player::deregisterInput() {
 }
 
 void Player::render() {
-    if (m_left) {
-        moveLeft();
-    }
-
-    if (m_right) {
-        moveRight();
-    }
-
     nextAnimation();
     if (onGround()) {
         playStepSound();
@@ -99,8 +99,8 @@ void Player::render() {
     }
 
     // Render current animation frame
-    SDL_RenderCopyEx(Window::getWindow().renderer(), m_texture, &m_sourceRect, &target, 0, nullptr,
-                     flip);
+    SDL_RenderCopyEx(EngineContext::current().getRenderer(), m_texture, &m_sourceRect, &target, 0,
+                     nullptr, flip);
 
     if (m_weapon) {
         m_weapon->setOffset(m_offset);
@@ -108,7 +108,7 @@ void Player::render() {
     }
 }
 
-void Player::renderStatic(Vector2dT& pos) {
+void Player::renderStatic(Vector2dT& pos, float scale) {
     SDL_Rect source, target;
 
     source.x = 0;
@@ -118,14 +118,23 @@ void Player::renderStatic(Vector2dT& pos) {
 
     target.x = pos.x;
     target.y = pos.y;
-    target.w = m_animationWidth;
-    target.h = m_animationHeight;
+    target.w = static_cast<int>(static_cast<float>(m_animationWidth) * scale);
+    target.h = static_cast<int>(static_cast<float>(m_animationHeight) * scale);
 
     // Render current animation frame
-    SDL_RenderCopy(Window::getWindow().renderer(), m_texture, &source, &target);
+    SDL_RenderCopy(EngineContext::current().getRenderer(), m_texture, &source, &target);
 }
 
 void Player::update() {
+    // movement is part of the simulation, so it also happens if nothing is rendered
+    if (m_left) {
+        moveLeft();
+    }
+
+    if (m_right) {
+        moveRight();
+    }
+
     if (m_weapon && !m_dropWeaponOnUpdate) {
         m_weapon->update();
     }
@@ -134,8 +143,6 @@ void Player::update() {
         m_dropWeaponOnUpdate = false;
         dropWeapon();
     }
-
-    ActingRenderable::update();
 }
 
 void Player::setHasFlag(bool b) {
@@ -167,7 +174,7 @@ void Player::addToWorld(b2World& world, ActingKinematics& kinematics) {
 }
 
 void Player::heal() {
-    Uint32 ticks = SDL_GetTicks();
+    Uint32 ticks = Clock::ticks();
     if (ticks > m_cooldownHeal && m_health < 100) {
         m_cooldownHeal = ticks + 10000;  // reset to ticks + 10 sec;
         m_health = std::min(m_health + kHpPerHeal, 100u);
@@ -180,7 +187,8 @@ void Player::addDamage(uint32_t damage, Player* damageFrom) {
         return;
     }
     if (damage == 0) {
-        damage = 10u + static_cast<uint32_t>(Random::getInt(0, 5));
+        Random& random = EngineContext::current().getEngine().getGame()->getRandom();
+        damage = 10u + static_cast<uint32_t>(random.getInt(0, 5));
     }
 
     // If player is dying
@@ -214,12 +222,12 @@ void Player::doorReached() {
     if (!alive()) {
         return;
     }
-    Window::getEngine().getGame()->nextLevel(m_team);
+    EngineContext::current().getEngine().getGame()->nextLevel(m_team);
     alterScore(PlayerScoreFrom::SCORE_DOOR);
 }
 
 void Player::alterScore(PlayerScoreFrom from) {
-    static uint64_t respawnCost = 50;
+    constexpr uint64_t respawnCost = 50;
 
     switch (from) {
         case PlayerScoreFrom::SCORE_PLAYER:
@@ -272,7 +280,7 @@ void Player::nextAnimation() {
     Uint32 ticks = SDL_GetTicks();
     float time = static_cast<float>(ticks - m_lastTick);
 
-    if (time > static_cast<float>(m_animationDuration)) {
+    if (time > static_cast<float>(animationDuration())) {
         handleJumpAnimations();
 
         if (isHealing() && !m_healingAnimationDone) {
@@ -338,7 +346,8 @@ void Player::jump() {
 }
 
 void Player::handleInput(InputType type, Input* /*input*/, bool state, float angle) {
-    if (Window::getEngine().getGame()->getGameState() != GameState::Running || !alive()) {
+    if (EngineContext::current().getEngine().getGame()->getGameState() != GameState::Running ||
+        !alive()) {
         return;
     }
 
@@ -459,8 +468,8 @@ void Player::collectWeapon(Fist* weapon) {
             return;
         }
 
-        // Free current weapon and destroy box2d body.
-        GC::add(m_weapon);
+        // Free current weapon and destroy box2d body after the physics step.
+        m_game->getCurrentLevel()->destroyWeapon(m_weapon);
         m_weapon = nullptr;
     }
 
@@ -479,12 +488,16 @@ void Player::dropWeapon() {
             m_game->getCurrentLevel()->dropWeapon(m_weapon);
 
         } else {
-            GC::add(m_weapon);
+            m_game->getCurrentLevel()->destroyWeapon(m_weapon);
         }
         m_weapon = nullptr;
     }
 
-    m_weapon = new Fist(nullptr, 30, 24, 1);
+    equipWeapon(new Fist(nullptr, 30, 24, 1));
+}
+
+void Player::equipWeapon(Fist* weapon) {
+    m_weapon = weapon;
 
     Kinematics k(0.5f, 0.5f, 0.2f);
     k.setDensity(0.0f);
@@ -495,5 +508,80 @@ void Player::dropWeapon() {
 
     m_weapon->setUser(this);
 }
+
+void Player::saveState(SnapshotWriter& out) const {
+    ActingRenderable::saveState(out);
+    out.writeBool(m_right);
+    out.writeBool(m_left);
+    out.writeU64(m_score);
+    out.writeU8(static_cast<uint8_t>(m_currAnimation));
+    out.writeBool(m_running);
+    out.writeBool(m_shooting);
+    out.writeU32(m_health);
+    out.writeBool(m_hasFlag);
+    out.writeU8(static_cast<uint8_t>(m_direction));
+    out.writeTime(m_cooldownHeal);
+    out.writeBool(m_healingAnimationDone);
+    out.writeBool(m_dropWeaponOnUpdate);
+    out.writeTime(m_nextMeleeTick);
+    out.writeFloat(m_angle);
+
+    WeaponType type = WeaponType::None;
+    if (m_weapon) {
+        type = dynamic_cast<Gun*>(m_weapon) ? WeaponType::Gun : WeaponType::Fist;
+    }
+    out.writeU8(static_cast<uint8_t>(type));
+    if (type == WeaponType::Gun) {
+        out.writeU16(static_cast<Gun*>(m_weapon)->getPrefab());
+    }
+    if (m_weapon) {
+        m_weapon->saveState(out);
+    }
+}
+
+void Player::restoreState(SnapshotReader& in) {
+    ActingRenderable::restoreState(in);
+    m_right = in.readBool();
+    m_left = in.readBool();
+    m_score = in.readU64();
+    m_currAnimation = static_cast<PlayerAnimation>(in.readU8());
+    m_running = in.readBool();
+    m_shooting = in.readBool();
+    m_health = in.readU32();
+    m_hasFlag = in.readBool();
+    m_direction = static_cast<Direction>(in.readU8());
+    m_cooldownHeal = in.readTime();
+    m_healingAnimationDone = in.readBool();
+    m_dropWeaponOnUpdate = in.readBool();
+    m_nextMeleeTick = in.readTime();
+    m_angle = in.readFloat();
+
+    auto type = static_cast<WeaponType>(in.readU8());
+    PrefabId prefab = type == WeaponType::Gun ? in.readU16() : Prefabs::NONE;
+    WeaponType current = WeaponType::None;
+    PrefabId currentPrefab = Prefabs::NONE;
+    if (m_weapon) {
+        auto* gun = dynamic_cast<Gun*>(m_weapon);
+        current = gun ? WeaponType::Gun : WeaponType::Fist;
+        currentPrefab = gun ? gun->getPrefab() : Prefabs::NONE;
+    }
+    if (type != current || prefab != currentPrefab) {
+        delete m_weapon;
+        m_weapon = nullptr;
+        if (type == WeaponType::Fist) {
+            equipWeapon(new Fist(nullptr, 30, 24, 1));
+        } else if (type == WeaponType::Gun) {
+            const Prefabs& prefabs = EngineContext::current().getEngine().getPrefabs();
+            if (prefab >= prefabs.getWeaponCount()) {
+                throw std::runtime_error("Snapshot contains an unknown weapon type: " +
+                                         std::to_string(prefab));
+            }
+            equipWeapon(prefabs.createWeapon(prefab));
+        }
+    }
+    if (m_weapon) {
+        m_weapon->restoreState(in);
+    }
+}
 }  // namespace engine
 }  // namespace ctb
@@ -14,6 +14,7 @@
 #include "engine/input/Input.hpp"
 #include "engine/menu/PauseMenu.hpp"
 #include "engine/physics/ActingKinematics.hpp"
+#include "engine/util/Clock.hpp"
 #include "engine/util/Vector2d.hpp"
 
 namespace ctb {
@@ -90,11 +91,12 @@ class Player : public ActingRenderable {
      * @brief Render this object on a given position
      *
      * @param pos screen coordinate, on which this object should be rendered
+     * @param scale size of the rendered frame relative to the animation size
      */
-    virtual void renderStatic(Vector2dT& pos);
+    virtual void renderStatic(Vector2dT& pos, float scale = 1.0f);
 
     /**
-     * @brief Update the current position, changed by the new step of the b2World
+     * @brief Moves the player and updates its weapon. The position is synced by the level.
      */
     void update() override;
 
@@ -156,6 +158,9 @@ class Player : public ActingRenderable {
      */
     void alterScore(PlayerScoreFrom from);
 
+    /// Sets the score without any effects, e.g. to display a recorded game
+    void setScore(uint64_t score) { m_score = score; }
+
     /**
      * @brief signal, that this player has reached a door
      */
@@ -168,6 +173,9 @@ class Player : public ActingRenderable {
      */
     uint32_t getHealth() { return m_health; }
 
+    /// Sets the health without any effects, e.g. to display a state received over the network
+    void setHealth(uint32_t health) { m_health = health; }
+
     /**
      * @brief Set the team of this player
      *
@@ -182,6 +190,13 @@ class Player : public ActingRenderable {
      */
     Team getTeam() { return m_team; }
 
+    /// Returns the look of this player, the index of its player config plus the number of
+    /// player configs per palette swap, see PlayerSprites
+    uint32_t getConfigIndex() const { return m_configIndex; }
+
+    /// Sets the look of this player, see PlayerSprites
+    void setConfigIndex(uint32_t index) { m_configIndex = index; }
+
     /**
      * @brief Return the weapon of this player
      *
@@ -201,6 +216,12 @@ class Player : public ActingRenderable {
      */
     void dropWeapon();
 
+    /// Writes the body, health, score, timers and the weapon of this player to the snapshot
+    void saveState(SnapshotWriter& out) const override;
+
+    /// Restores the state written by saveState, the weapon is replaced if its type differs
+    void restoreState(SnapshotReader& in) override;
+
     /**
      * @brief Returns, if this player has the flag
      *
@@ -252,7 +273,7 @@ class Player : public ActingRenderable {
      *
      * @return is this player in a healing process?
      */
-    bool isHealing() { return SDL_GetTicks() < m_cooldownHeal; }
+    bool isHealing() { return Clock::ticks() < m_cooldownHeal; }
 
     /**
      * @brief Returns the next melee-tick
@@ -291,6 +312,9 @@ class Player : public ActingRenderable {
      */
     void heal();
 
+    /// Adds the weapon to the world of this player and takes it into use
+    void equipWeapon(Fist* weapon);
+
     /**
      * @brief Get to the next animation of the texture
      */
@@ -356,6 +380,9 @@ class Player : public ActingRenderable {
     /// The team
     Team m_team;
 
+    /// the look, index of the player config in the game config and palette swap
+    uint32_t m_configIndex{0};
+
     /// Has this player the flag?
     bool m_hasFlag;
 
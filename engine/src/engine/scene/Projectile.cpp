@@ -4,8 +4,11 @@
 // This file is licensed under the MIT license; see LICENSE file in the root of this
 // project for details.
 
+#include <gsl/gsl>
+
 #include "engine/scene/Projectile.hpp"
 #include "engine/Window.hpp"
+#include "engine/core/Snapshot.hpp"
 #include "engine/scene/Gun.hpp"
 
 namespace ctb {
@@ -21,6 +24,8 @@ Projectile::Projectile(SDL_Texture* texture,
       m_gun(gun),
       m_user(nullptr),
       m_damage(damage) {
+    // the texture is shared by all projectiles of the gun
+    m_ownsTexture = false;
     if (m_gun) {
         m_user = m_gun->getUser();
     }
@@ -93,8 +98,19 @@ void Projectile::update() {
     PhysicalRenderable::update();
 }
 
+void Projectile::saveState(SnapshotWriter& out) const {
+    out.writePlayer(m_user);
+    PhysicalRenderable::saveState(out);
+}
+
+void Projectile::restoreState(SnapshotReader& in) {
+    m_user = in.readPlayer();
+    PhysicalRenderable::restoreState(in);
+}
+
 Projectile::~Projectile() {
     if (m_body) {
+        Expects(!m_body->GetWorld()->IsLocked());
         m_body->GetWorld()->DestroyBody(m_body);
         m_body = nullptr;
     }
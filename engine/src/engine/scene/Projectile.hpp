@@ -7,6 +7,7 @@
 #ifndef ENGINE_SCENE_PROJECTILE_HPP
 #define ENGINE_SCENE_PROJECTILE_HPP
 
+#include "engine/core/SlotMap.hpp"
 #include "engine/graphics/PhysicalRenderable.hpp"
 
 namespace ctb {
@@ -47,6 +48,18 @@ class Projectile : public PhysicalRenderable {
 
     inline uint32_t getDamage() const { return m_damage; }
 
+    /// Writes the shooter and the body to the snapshot
+    void saveState(SnapshotWriter& out) const override;
+
+    /// Restores the state written by saveState
+    void restoreState(SnapshotReader& in) override;
+
+    /// Returns the handle of this projectile in its gun
+    Handle<Projectile> getHandle() const { return m_handle; }
+
+    /// Sets the handle of this projectile, only the gun does this
+    void setHandle(Handle<Projectile> handle) { m_handle = handle; }
+
     /// Destructor
     ~Projectile() override;
 
@@ -56,6 +69,8 @@ class Projectile : public PhysicalRenderable {
     Player* m_user;
 
     uint32_t m_damage;
+    /// Handle in the gun's projectiles, stale once the projectile was removed
+    Handle<Projectile> m_handle;
 };
 
 }  // namespace engine
@@ -8,7 +8,8 @@
 
 #include <SDL.h>
 
-#include "engine/Window.hpp"
+#include "engine/Engine.hpp"
+#include "engine/EngineContext.hpp"
 #include "engine/core/Camera.hpp"
 #include "engine/core/Game.hpp"
 #include "engine/scene/Ufo.hpp"
@@ -26,14 +27,16 @@ Ufo::Ufo(SDL_Texture* texture,
 
 void Ufo::collideWithPlayer(Player* player) {
     if (player) {
-        player->addDamage(static_cast<uint32_t>(Random::getInt(12, 45)));
+        Random& random = EngineContext::current().getEngine().getGame()->getRandom();
+        player->addDamage(static_cast<uint32_t>(random.getInt(12, 45)));
     }
     prepareDelete();
 }
 
 void Ufo::update() {
-    Bot::update();
-    Bot::run();
+    if (!isDormant()) {
+        Bot::run();
+    }
     m_body->SetGravityScale(0.0f);
 }
 
@@ -4,9 +4,12 @@
 // This file is licensed under the MIT license; see LICENSE file in the root of this
 // project for details.
 
+#include "engine/EngineContext.hpp"
 #include "engine/scene/Zombie.hpp"
-#include "engine/Window.hpp"
+#include "engine/Engine.hpp"
 #include "engine/core/Game.hpp"
+#include "engine/core/Snapshot.hpp"
+#include "engine/util/Clock.hpp"
 #include "engine/util/Random.hpp"
 
 namespace ctb {
@@ -18,25 +21,28 @@ Zombie::Zombie(SDL_Texture* texture,
                int animationCount,
                Level* level)
     : Bot(texture, animationWidth, animationHeight, animationCount, level) {
-    m_lastTicks = SDL_GetTicks();
+    m_lastTicks = Clock::ticks();
 }
 
 void Zombie::collideWithPlayer(Player* player) {
     if (player) {
-        player->addDamage(static_cast<uint32_t>(Random::getInt(10, 18)));
+        Random& random = EngineContext::current().getEngine().getGame()->getRandom();
+        player->addDamage(static_cast<uint32_t>(random.getInt(10, 18)));
     }
     prepareDelete();
 }
 
 void Zombie::update() {
-    Bot::update();
-    Bot::run();
-    if (m_body->GetLinearVelocity().LengthSquared() < 0.5f) {
-        jump();
+    if (!isDormant()) {
+        Bot::run();
+        // stuck without a known path, try to get over the obstacle
+        if (!m_hasPath && m_body->GetLinearVelocity().LengthSquared() < 0.5f) {
+            jump();
+        }
     }
 
     Camera& cam = m_level->getCamera();
-    Uint32 ticks = SDL_GetTicks();
+    Uint32 ticks = Clock::ticks();
     if (y() + animationHeight() < cam.minY() || y() > cam.maxY() ||
         x() + animationWidth() < cam.minX() || x() > cam.maxX()) {
         // delete bots after 10 seconds
@@ -48,5 +54,15 @@ void Zombie::update() {
     }
 }
 
+void Zombie::saveState(SnapshotWriter& out) const {
+    Bot::saveState(out);
+    out.writeTime(m_lastTicks);
+}
+
+void Zombie::restoreState(SnapshotReader& in) {
+    Bot::restoreState(in);
+    m_lastTicks = in.readTime();
+}
+
 }  // namespace engine
 }  // namespace ctb
@@ -35,11 +35,20 @@ class Zombie : public Bot {
 
     void collideWithPlayer(Player* player) override;
 
+    /// Writes the bot state and the despawn timer to the snapshot
+    void saveState(SnapshotWriter& out) const override;
+
+    /// Restores the state written by saveState
+    void restoreState(SnapshotReader& in) override;
+
     void addToThisWorld(b2World& world);
 
     /// Destructor
     virtual ~Zombie() {}
 
+   protected:
+    bool usesNavigation() const override { return true; }
+
    private:
     Uint32 m_lastTicks;
 };
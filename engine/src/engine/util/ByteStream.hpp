@@ -0,0 +1,184 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_UTIL_BYTESTREAM_HPP
+#define ENGINE_UTIL_BYTESTREAM_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ctb {
+namespace engine {
+
+/**
+ * @brief Appends values to a byte buffer in little endian order, independent of the platform.
+ *        Floats are stored by their bit pattern, so they are restored exactly.
+ */
+class ByteWriter {
+   public:
+    /// Constructor, the values are appended to buffer
+    explicit ByteWriter(std::vector<uint8_t>& buffer) : m_buffer(buffer) {}
+
+    void writeU8(uint8_t value) { m_buffer.push_back(value); }
+
+    void writeU16(uint16_t value) { writeBytes(value, 2); }
+
+    void writeU32(uint32_t value) { writeBytes(value, 4); }
+
+    void writeU64(uint64_t value) { writeBytes(value, 8); }
+
+    void writeI32(int32_t value) { writeU32(static_cast<uint32_t>(value)); }
+
+    void writeBool(bool value) { writeU8(value ? 1 : 0); }
+
+    void writeFloat(float value) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        writeU32(bits);
+    }
+
+    void writeDouble(double value) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        writeU64(bits);
+    }
+
+    /// Writes value in 1 to 5 bytes, 7 bits per byte, small values need fewer bytes
+    void writeVarU32(uint32_t value) {
+        while (value >= 0x80) {
+            m_buffer.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        m_buffer.push_back(static_cast<uint8_t>(value));
+    }
+
+    /// Writes value zigzag encoded as writeVarU32, values close to 0 need fewer bytes
+    void writeVarI32(int32_t value) {
+        auto bits = static_cast<uint32_t>(value);
+        writeVarU32((bits << 1) ^ (value < 0 ? 0xFFFFFFFFu : 0u));
+    }
+
+    /// Writes the length and the characters of the string
+    void writeString(const std::string& value) {
+        writeU32(static_cast<uint32_t>(value.size()));
+        m_buffer.insert(m_buffer.end(), value.begin(), value.end());
+    }
+
+    /// Returns the number of bytes in the buffer
+    size_t size() const { return m_buffer.size(); }
+
+   private:
+    void writeBytes(uint64_t value, int count) {
+        for (int i = 0; i < count; ++i) {
+            m_buffer.push_back(static_cast<uint8_t>(value >> (8 * i)));
+        }
+    }
+
+    std::vector<uint8_t>& m_buffer;
+};
+
+/**
+ * @brief Reads the values written by a ByteWriter in the same order.
+ *
+ * @throws runtime_error if a value is read beyond the end of the data
+ */
+class ByteReader {
+   public:
+    /// Constructor, the data has to outlive the reader
+    ByteReader(const uint8_t* data, size_t size) : m_data(data), m_size(size) {}
+
+    /// Constructor, the buffer has to outlive the reader
+    explicit ByteReader(const std::vector<uint8_t>& buffer)
+        : ByteReader(buffer.data(), buffer.size()) {}
+
+    uint8_t readU8() {
+        require(1);
+        return m_data[m_position++];
+    }
+
+    uint16_t readU16() { return static_cast<uint16_t>(readBytes(2)); }
+
+    uint32_t readU32() { return static_cast<uint32_t>(readBytes(4)); }
+
+    uint64_t readU64() { return readBytes(8); }
+
+    int32_t readI32() { return static_cast<int32_t>(readU32()); }
+
+    bool readBool() { return readU8() != 0; }
+
+    float readFloat() {
+        uint32_t bits = readU32();
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    double readDouble() {
+        uint64_t bits = readU64();
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    uint32_t readVarU32() {
+        uint32_t value = 0;
+        for (int shift = 0; shift < 35; shift += 7) {
+            uint8_t byte = readU8();
+            value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+        throw std::runtime_error("Invalid variable length integer");
+    }
+
+    int32_t readVarI32() {
+        uint32_t bits = readVarU32();
+        return static_cast<int32_t>((bits >> 1) ^ (0u - (bits & 1)));
+    }
+
+    std::string readString() {
+        uint32_t length = readU32();
+        require(length);
+        std::string value(reinterpret_cast<const char*>(m_data + m_position), length);
+        m_position += length;
+        return value;
+    }
+
+    /// Returns if all data was read
+    bool atEnd() const { return m_position == m_size; }
+
+    /// Returns the number of bytes read so far
+    size_t position() const { return m_position; }
+
+   private:
+    void require(size_t count) const {
+        if (m_size - m_position < count) {
+            throw std::runtime_error("Unexpected end of data");
+        }
+    }
+
+    uint64_t readBytes(int count) {
+        require(static_cast<size_t>(count));
+        uint64_t value = 0;
+        for (int i = 0; i < count; ++i) {
+            value |= static_cast<uint64_t>(m_data[m_position++]) << (8 * i);
+        }
+        return value;
+    }
+
+    const uint8_t* m_data;
+    size_t m_size;
+    size_t m_position{0};
+};
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_UTIL_BYTESTREAM_HPP
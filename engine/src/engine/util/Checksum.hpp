@@ -0,0 +1,55 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_UTIL_CHECKSUM_HPP
+#define ENGINE_UTIL_CHECKSUM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace ctb {
+namespace engine {
+
+/// A cheap 64 bit FNV-1a hash used to compare the simulation state of two runs
+class Checksum {
+   public:
+    /// Adds an integer
+    void add(uint64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            m_value ^= (value >> (i * 8)) & 0xFFu;
+            m_value *= PRIME;
+        }
+    }
+
+    /// Adds a float by its bit pattern, so even the smallest difference changes the hash
+    void add(float value) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        add(static_cast<uint64_t>(bits));
+    }
+
+    /// Adds a sequence of bytes
+    void add(const uint8_t* data, size_t size) {
+        for (size_t i = 0; i < size; ++i) {
+            m_value ^= data[i];
+            m_value *= PRIME;
+        }
+    }
+
+    /// Returns the current hash
+    uint64_t value() const { return m_value; }
+
+   private:
+    static constexpr uint64_t PRIME = 1099511628211u;
+
+    uint64_t m_value{14695981039346656037u};
+};
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_UTIL_CHECKSUM_HPP
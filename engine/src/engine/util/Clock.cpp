@@ -0,0 +1,50 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#include <SDL.h>
+
+#include "engine/EngineContext.hpp"
+#include "engine/util/Clock.hpp"
+
+namespace ctb {
+namespace engine {
+
+constexpr uint32_t Clock::FIXED_STEP;
+
+void Clock::setFixedStep(bool enabled) {
+    EngineContext& context = EngineContext::current();
+    context.m_fixedStep = enabled;
+    context.m_ticks = 0;
+}
+
+bool Clock::isFixedStep() {
+    return EngineContext::current().m_fixedStep;
+}
+
+uint32_t Clock::ticks() {
+    const EngineContext& context = EngineContext::current();
+    if (context.m_fixedStep) {
+        return context.m_ticks;
+    }
+    return SDL_GetTicks();
+}
+
+void Clock::step() {
+    EngineContext& context = EngineContext::current();
+    if (context.m_fixedStep) {
+        context.m_ticks += FIXED_STEP;
+    }
+}
+
+void Clock::restore(uint32_t ticks) {
+    EngineContext& context = EngineContext::current();
+    if (context.m_fixedStep) {
+        context.m_ticks = ticks;
+    }
+}
+
+}  // namespace engine
+}  // namespace ctb
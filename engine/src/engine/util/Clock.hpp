@@ -0,0 +1,47 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_UTIL_CLOCK_HPP
+#define ENGINE_UTIL_CLOCK_HPP
+
+#include <cstdint>
+
+namespace ctb {
+namespace engine {
+
+/**
+ * @brief The time source of all gameplay timers (cooldowns, reloads, respawns).
+ *
+ * By default this is the SDL wall clock. In fixed step mode the time only advances by
+ * FIXED_STEP per simulation tick, so a run does not depend on the frame rate. The time and
+ * the mode belong to the current EngineContext.
+ */
+class Clock {
+   public:
+    /// Length of one tick in fixed step mode in ms (1 / Level::PHYSICALTIMESTEPFREQUENCE)
+    static constexpr uint32_t FIXED_STEP = 25;
+
+    /// Enables or disables fixed step mode and resets the time
+    static void setFixedStep(bool enabled);
+
+    /// Returns if fixed step mode is enabled
+    static bool isFixedStep();
+
+    /// Returns the current game time in ms
+    static uint32_t ticks();
+
+    /// Advances the game time by one tick, does nothing if fixed step mode is disabled
+    static void step();
+
+    /// Sets the game time, e.g. when restoring a snapshot, does nothing if fixed step mode is
+    /// disabled
+    static void restore(uint32_t ticks);
+};
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_UTIL_CLOCK_HPP
@@ -7,6 +7,10 @@
 #ifndef ENGINE_UTIL_COLOR_HPP
 #define ENGINE_UTIL_COLOR_HPP
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
 namespace ctb {
 namespace engine {
 
@@ -32,6 +36,41 @@ class Color {
     uint8_t b;
 };
 
+/// Rotates the hue of colors by a fixed angle and keeps their luminance, like the hue-rotate
+/// filter of CSS. Grays stay unchanged.
+class HueRotation {
+   public:
+    /// Constructor with the angle in degrees
+    explicit HueRotation(float degrees) {
+        float angle = degrees * 3.14159265f / 180.0f;
+        float c = std::cos(angle);
+        float s = std::sin(angle);
+        // a rotation around the gray axis of the luminance weighted RGB space
+        const float matrix[9] = {
+            0.213f + c * 0.787f - s * 0.213f, 0.715f - c * 0.715f - s * 0.715f,
+            0.072f - c * 0.072f + s * 0.928f, 0.213f - c * 0.213f + s * 0.143f,
+            0.715f + c * 0.285f + s * 0.140f, 0.072f - c * 0.072f - s * 0.283f,
+            0.213f - c * 0.213f - s * 0.787f, 0.715f - c * 0.715f + s * 0.715f,
+            0.072f + c * 0.928f + s * 0.072f};
+        std::copy(matrix, matrix + 9, m_matrix);
+    }
+
+    /// Returns the rotated color
+    Color apply(const Color& color) const {
+        return Color(channel(0, color), channel(3, color), channel(6, color));
+    }
+
+   private:
+    /// Returns the channel of a rotated color whose matrix row starts at index
+    uint8_t channel(int index, const Color& color) const {
+        float value = m_matrix[index] * color.r + m_matrix[index + 1] * color.g +
+                      m_matrix[index + 2] * color.b;
+        return static_cast<uint8_t>(std::min(std::max(value + 0.5f, 0.0f), 255.0f));
+    }
+
+    float m_matrix[9];
+};
+
 }  // namespace engine
 }  // namespace ctb
 
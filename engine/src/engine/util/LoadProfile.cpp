@@ -0,0 +1,64 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#include <algorithm>
+
+#include <gsl/gsl>
+
+#include "engine/util/LoadProfile.hpp"
+
+namespace ctb {
+namespace engine {
+
+namespace {
+/// Number of ranges bucketSizeFor aims for
+constexpr size_t kBucketCount = 10;
+
+/// Returns the given percentile of the sorted values (nearest rank)
+float percentile(const std::vector<float>& sorted, double p) {
+    auto rank = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(rank, sorted.size() - 1)];
+}
+}  // namespace
+
+LoadProfile::LoadProfile(size_t bucketSize) : m_bucketSize(bucketSize) {
+    Expects(bucketSize > 0);
+}
+
+size_t LoadProfile::bucketSizeFor(size_t maxLoad) {
+    return std::max<size_t>((maxLoad + kBucketCount - 1) / kBucketCount, 1);
+}
+
+void LoadProfile::add(size_t load, float millis) {
+    m_frames[load - load % m_bucketSize].push_back(millis);
+}
+
+std::vector<LoadProfile::Bucket> LoadProfile::getBuckets() const {
+    std::vector<Bucket> buckets;
+    for (auto& frames : m_frames) {
+        std::vector<float> sorted = frames.second;
+        std::sort(sorted.begin(), sorted.end());
+        buckets.push_back({frames.first, sorted.size(), percentile(sorted, 0.5),
+                           percentile(sorted, 0.95), percentile(sorted, 0.99), sorted.back()});
+    }
+    return buckets;
+}
+
+void LoadProfile::print(std::ostream& out) const {
+    std::vector<Bucket> buckets = getBuckets();
+    out << '[';
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        const Bucket& bucket = buckets[i];
+        out << (i > 0 ? ",\n    " : "\n    ") << "{\"from\": " << bucket.load
+            << ", \"to\": " << bucket.load + m_bucketSize - 1 << ", \"frames\": " << bucket.frames
+            << ", \"p50\": " << bucket.p50 << ", \"p95\": " << bucket.p95
+            << ", \"p99\": " << bucket.p99 << ", \"max\": " << bucket.max << "}";
+    }
+    out << (buckets.empty() ? "]" : "\n  ]");
+}
+
+}  // namespace engine
+}  // namespace ctb
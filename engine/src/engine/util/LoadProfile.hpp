@@ -0,0 +1,68 @@
+// This file is part of CaptureTheBanana++.
+//
+// Copyright (c) 2018 the CaptureTheBanana++ contributors (see CONTRIBUTORS.md)
+// This file is licensed under the MIT license; see LICENSE file in the root of this
+// project for details.
+
+#ifndef ENGINE_UTIL_LOADPROFILE_HPP
+#define ENGINE_UTIL_LOADPROFILE_HPP
+
+#include <cstddef>
+#include <map>
+#include <ostream>
+#include <vector>
+
+namespace ctb {
+namespace engine {
+
+/**
+ * @brief Collects frame times by the load they were measured at, e.g. the number of bots,
+ *        and reports their percentiles per range of loads. It shows how a frame time grows
+ *        with the load.
+ */
+class LoadProfile {
+   public:
+    /// The frame times of a range of loads
+    struct Bucket {
+        /// the smallest load of the range
+        size_t load;
+        size_t frames;
+        float p50;
+        float p95;
+        float p99;
+        float max;
+    };
+
+    /**
+     * @brief Constructor
+     *
+     * @param bucketSize    number of loads per range, at least 1
+     */
+    explicit LoadProfile(size_t bucketSize);
+
+    /// Returns a bucket size that splits loads up to maxLoad into about ten ranges
+    static size_t bucketSizeFor(size_t maxLoad);
+
+    /// Adds the duration of a frame in ms measured at the given load
+    void add(size_t load, float millis);
+
+    /// Returns the ranges with at least one frame, ordered by load
+    std::vector<Bucket> getBuckets() const;
+
+    /// Returns if no frame was added
+    bool empty() const { return m_frames.empty(); }
+
+    /// Writes the buckets as JSON array to out
+    void print(std::ostream& out) const;
+
+   private:
+    size_t m_bucketSize;
+
+    /// the frame times by the smallest load of their range
+    std::map<size_t, std::vector<float>> m_frames;
+};
+
+}  // namespace engine
+}  // namespace ctb
+
+#endif  // ENGINE_UTIL_LOADPROFILE_HPP
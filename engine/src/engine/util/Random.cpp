@@ -4,22 +4,50 @@
 // This file is licensed under the MIT license; see LICENSE file in the root of this
 // project for details.
 
-#include <random>
+#include <gsl/gsl>
 
 #include "engine/util/Random.hpp"
 
 namespace ctb {
 namespace engine {
 
+constexpr uint64_t Random::GAMEPLAY_STREAM;
+constexpr uint64_t Random::COSMETIC_STREAM;
+
+uint32_t Random::bounded(uint32_t range) {
+    // Lemire's multiply and shift with rejection of the biased low values
+    uint64_t m = static_cast<uint64_t>(next()) * range;
+    auto low = static_cast<uint32_t>(m);
+    if (low < range) {
+        uint32_t threshold = (0u - range) % range;
+        while (low < threshold) {
+            m = static_cast<uint64_t>(next()) * range;
+            low = static_cast<uint32_t>(m);
+        }
+    }
+    return static_cast<uint32_t>(m >> 32u);
+}
+
 int Random::getInt(int from, int to) {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(from, to);
-    return dis(gen);
+    Expects(from <= to);
+    auto range = static_cast<uint32_t>(static_cast<int64_t>(to) - from + 1);
+    // a range of 0 means all 2^32 values
+    uint32_t offset = range == 0 ? next() : bounded(range);
+    return static_cast<int>(static_cast<int64_t>(from) + offset);
+}
+
+void Random::fill(int* out, size_t count, int from, int to) {
+    Expects(out != nullptr || count == 0);
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = getInt(from, to);
+    }
 }
 
-bool Random::getBool() {
-    return getInt(0, 1) == 1;
+void Random::fill(float* out, size_t count) {
+    Expects(out != nullptr || count == 0);
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = getFloat();
+    }
 }
 
 }  // namespace engine
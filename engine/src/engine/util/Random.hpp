@@ -7,16 +7,93 @@
 #ifndef ENGINE_UTIL_RANDOM_HPP
 #define ENGINE_UTIL_RANDOM_HPP
 
+#include <cstddef>
+#include <cstdint>
+
 namespace ctb {
 namespace engine {
 
+/**
+ * @brief A small and fast seedable random generator (PCG32, XSH-RR variant).
+ *
+ * The state is 16 bytes and no system calls are made. Generators with the same seed but a
+ * different stream produce independent sequences. The results only depend on the seed, not on
+ * the standard library, so runs are reproducible on all platforms.
+ */
 class Random {
    public:
+    /// Stream of all random decisions that influence the game state
+    static constexpr uint64_t GAMEPLAY_STREAM = 1;
+
+    /// Stream for everything else (music, effects), so it can't change the game state
+    static constexpr uint64_t COSMETIC_STREAM = 2;
+
+    /**
+     * @brief Constructor
+     *
+     * @param seed      the seed
+     * @param stream    the stream of the sequence
+     */
+    explicit Random(uint64_t seed, uint64_t stream = GAMEPLAY_STREAM) { this->seed(seed, stream); }
+
+    /// restarts the generator with the given seed and stream
+    void seed(uint64_t seed, uint64_t stream = GAMEPLAY_STREAM) {
+        m_state = 0;
+        m_increment = (stream << 1u) | 1u;
+        next();
+        m_state += seed;
+        next();
+    }
+
+    /// returns the next 32 random bits
+    uint32_t next() {
+        uint64_t old = m_state;
+        m_state = old * 6364136223846793005u + m_increment;
+        auto xorshifted = static_cast<uint32_t>(((old >> 18u) ^ old) >> 27u);
+        auto rot = static_cast<uint32_t>(old >> 59u);
+        return (xorshifted >> rot) | (xorshifted << ((32u - rot) & 31u));
+    }
+
     /// returns a random int in [from, to]
-    static int getInt(int from, int to);
+    int getInt(int from, int to);
 
     /// returns a random true or false
-    static bool getBool();
+    bool getBool() { return (next() & 1u) == 1u; }
+
+    /// returns a random float in [0, 1)
+    float getFloat() { return static_cast<float>(next() >> 8u) * (1.0f / 16777216.0f); }
+
+    /**
+     * @brief Fills an array with random ints in [from, to]
+     *
+     * @param out   the array to fill
+     * @param count the number of values
+     * @param from  the lower bound
+     * @param to    the upper bound (inclusive)
+     */
+    void fill(int* out, size_t count, int from, int to);
+
+    /// Fills an array with random floats in [0, 1)
+    void fill(float* out, size_t count);
+
+    /// Returns the internal state, see setState()
+    uint64_t getState() const { return m_state; }
+
+    /// Returns the stream increment, see setState()
+    uint64_t getIncrement() const { return m_increment; }
+
+    /// Continues the sequence of a generator with the given state and increment
+    void setState(uint64_t state, uint64_t increment) {
+        m_state = state;
+        m_increment = increment;
+    }
+
+   private:
+    /// returns an unbiased random number in [0, range)
+    uint32_t bounded(uint32_t range);
+
+    uint64_t m_state{0};
+    uint64_t m_increment{0};
 };
 
 }  // namespace engine
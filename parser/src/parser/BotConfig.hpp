@@ -23,6 +23,9 @@ class BotConfig {
     /// setter for m_name
     inline void setName(std::string name) { m_name = name; }
 
+    /// setter for m_behaviour
+    inline void setBehaviour(std::string behaviour) { m_behaviour = behaviour; }
+
     /// setter for m_numFrames
     inline void setNumFrames(int numFrames) { m_numFrames = numFrames; }
 
@@ -38,6 +41,9 @@ class BotConfig {
     /// getter for m_name
     inline std::string getName() { return m_name; }
 
+    /// getter for m_behaviour, the name if no behaviour is set
+    inline std::string getBehaviour() { return m_behaviour.empty() ? m_name : m_behaviour; }
+
     /// getter for m_numFrames
     inline int getNumFrames() { return m_numFrames; }
 
@@ -54,7 +60,10 @@ class BotConfig {
     /// the name of the bot
     std::string m_name;
 
-    /// number of frames
+    /// how the bot acts, e.g. "zombie" or "ufo", empty for the behaviour of the same name
+    std::string m_behaviour;
+
+    /// number of frames, 0 for the frames of the behaviour
     int m_numFrames{0};
 
     /// frame width
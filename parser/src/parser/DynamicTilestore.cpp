@@ -70,7 +70,7 @@ void DynamicTilestore::decreaseWidth() {
     m_width--;
 }
 
-int DynamicTilestore::getWidth() {
+int DynamicTilestore::getWidth() const {
     return m_width;
 }
 
@@ -97,15 +97,15 @@ void DynamicTilestore::decreaseHeight() {
     m_height--;
 }
 
-int DynamicTilestore::getHeight() {
+int DynamicTilestore::getHeight() const {
     return m_height;
 }
 
-int DynamicTilestore::getTileHeight() {
+int DynamicTilestore::getTileHeight() const {
     return m_tileHeight;
 }
 
-int DynamicTilestore::getTileWidth() {
+int DynamicTilestore::getTileWidth() const {
     return m_tileWidth;
 }
 
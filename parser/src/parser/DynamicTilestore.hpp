@@ -64,7 +64,7 @@ class DynamicTilestore {
     /// \brief delivers the width of this tileset
     ///
     /// \return int width of full tilestore in tiles
-    int getWidth();
+    int getWidth() const;
 
     /// \brief sets the height of this tileset
     void setHeight(int height);
@@ -78,17 +78,17 @@ class DynamicTilestore {
     /// \brief delivers the height of this tileset
     ///
     /// \return int height of full tilestore in tiles
-    int getHeight();
+    int getHeight() const;
 
     /// \brief delivers the height of one tile
     ///
     /// \return int height of one tile
-    int getTileHeight();
+    int getTileHeight() const;
 
     /// \brief delivers the width of one tile
     ///
     /// \return int width of one tile
-    int getTileWidth();
+    int getTileWidth() const;
 
     /// \brief flips this tilestore horizontaly
     ///         1 0 4 1 5       5 1 4 0 1
@@ -65,6 +65,7 @@ GameConfig* parseGame(const std::string& file) {
         BotConfig* bc = new BotConfig();
         bc->setFilename(dir + bot.second.get("<xmlattr>.filename", ""));
         bc->setName(bot.second.get("name", ""));
+        bc->setBehaviour(bot.second.get("behaviour", ""));
         bc->setNumFrames(bot.second.get<int>("num_frames", 0));
         bc->setFrameWidth(bot.second.get<int>("frame_width", 0));
         bc->setFrameHeight(bot.second.get<int>("frame_height", 0));
@@ -78,8 +79,9 @@ GameConfig* parseGame(const std::string& file) {
         float damage = weapon.second.get<float>("damage", 0.0);
         std::string special = weapon.second.get("special", "");
         std::string projectile = weapon.second.get("projectile", "");
+        bool hitscan = weapon.second.get<bool>("hitscan", false);
         config->getWeapons().push_back(
-            new WeaponConfig(filename, name, range, as, damage, special, projectile));
+            new WeaponConfig(filename, name, range, as, damage, special, projectile, hitscan));
     }
     for (const ptree::value_type& proj : pt.get_child("game.projectiles")) {
         std::string name = proj.second.get("<xmlattr>.name", "");
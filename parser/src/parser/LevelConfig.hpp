@@ -52,6 +52,11 @@ class TypeSpawn {
     /// \return common::Vector2d& spawn position in an vector
     inline common::Vector2d& getPosition() { return m_position; }
 
+    /// \brief delivers the position of this spawn
+    ///
+    /// \return const common::Vector2d& spawn position in an vector
+    inline const common::Vector2d& getPosition() const { return m_position; }
+
     /// \brief sets the type of elements that can spawn here
     ///
     /// \param type additional information like bottype, or weapontype
@@ -59,8 +64,8 @@ class TypeSpawn {
 
     /// \brief delivers the type of this spawn
     ///
-    /// \return std::string type of this as a string
-    inline std::string getType() { return m_type; }
+    /// \return const std::string& type of this as a string
+    inline const std::string& getType() const { return m_type; }
 
     virtual ~TypeSpawn() = default;
 
@@ -92,6 +97,9 @@ class LevelConfig {
     /// \return std::vector<LayerConfig>& reference to vector with pointers to all layers
     inline std::vector<TilesetConfig>& getTilesets() { return m_tilesets; }
 
+    /// \brief delivers vector with all layers
+    inline const std::vector<TilesetConfig>& getTilesets() const { return m_tilesets; }
+
     /// \brief adds a background layer to the config
     ///         takes the ownership of the layer
     ///
@@ -106,6 +114,9 @@ class LevelConfig {
     /// backgrounds
     inline std::vector<BackgroundConfig>& getBackgrounds() { return m_backgrounds; }
 
+    /// \brief delivers vector with all backgrounds
+    inline const std::vector<BackgroundConfig>& getBackgrounds() const { return m_backgrounds; }
+
     /// \brief sets type of this level
     ///
     /// \param levelType new type of level
@@ -114,34 +125,7 @@ class LevelConfig {
     /// \brief delivers type of this level
     ///
     /// \return LevelType type of this level
-    inline LevelType getLevelType() { return m_type; }
-
-    void flipPoints() {
-        // doors
-        common::Vector2d tmp = m_doorL;
-        m_doorL = m_doorR;
-        m_doorR = tmp;
-        m_doorL.x = m_width - m_doorL.x - 1;
-        m_doorR.x = m_width - m_doorR.x - 1;
-
-        // flag spawn
-        m_flagSpawn.x = m_width - m_flagSpawn.x - 1;
-
-        // player spawns
-        std::reverse(m_playerSpawns.begin(), m_playerSpawns.end());
-
-        // bot spawns
-        for (size_t i = 0; i < m_botSpawns.size(); i++) {
-            auto& pos = m_botSpawns[i].getPosition();
-            pos.x = m_width - pos.x - 1;
-        }
-
-        // weapon spawns
-        for (size_t i = 0; i < m_weaponSpawns.size(); i++) {
-            auto& pos = m_weaponSpawns[i].getPosition();
-            pos.x = m_width - pos.x - 1;
-        }
-    }
+    inline LevelType getLevelType() const { return m_type; }
 
     /// \brief sets left door position
     ///
@@ -157,6 +141,9 @@ class LevelConfig {
     /// \return common::Vector2d& reference to the location of the left door
     inline common::Vector2d& getDoorL() { return m_doorL; }
 
+    /// \brief delivers position of left door
+    inline const common::Vector2d& getDoorL() const { return m_doorL; }
+
     /// \brief sets right door position
     ///
     /// \param x x-position
@@ -171,6 +158,9 @@ class LevelConfig {
     /// \return common::Vector2d& reference to the location of the right door
     inline common::Vector2d& getDoorR() { return m_doorR; }
 
+    /// \brief delivers position of right door
+    inline const common::Vector2d& getDoorR() const { return m_doorR; }
+
     /// \brief sets flag spawn position
     ///
     /// \param x x-position
@@ -185,8 +175,11 @@ class LevelConfig {
     /// \return common::Vector2d& reference to the location of the flag spawn
     inline common::Vector2d& getFlagSpawn() { return m_flagSpawn; }
 
+    /// \brief delivers position of flag spawn
+    inline const common::Vector2d& getFlagSpawn() const { return m_flagSpawn; }
+
     /// util function for tile to world coordinates
-    common::Vector2d toWorld(common::Vector2d pos) {
+    common::Vector2d toWorld(common::Vector2d pos) const {
         pos.x *= m_tileWidth;
         pos.y *= m_tileWidth;
         return pos;
@@ -245,6 +238,11 @@ class LevelConfig {
     /// y3}
     inline std::vector<std::vector<uint32_t>>& getPlayerSpawns() { return m_playerSpawns; }
 
+    /// \brief delivers player spawns for all x coordinates
+    inline const std::vector<std::vector<uint32_t>>& getPlayerSpawns() const {
+        return m_playerSpawns;
+    }
+
     /// \brief adds bot spawn to this level config
     ///
     /// \param spawn spawn to be added
@@ -255,6 +253,9 @@ class LevelConfig {
     /// \return std::vector<TypeSpawn>& vector with pointers to all bot spawns inside
     inline std::vector<TypeSpawn>& getBotSpawns() { return m_botSpawns; }
 
+    /// \brief delivers spawn positions for bots
+    inline const std::vector<TypeSpawn>& getBotSpawns() const { return m_botSpawns; }
+
     /// \brief adds weapon spawn to this level config
     ///
     /// \param spawn spawn to be added
@@ -265,6 +266,9 @@ class LevelConfig {
     /// \return std::vector<TypeSpawn*>& vector with pointers to all weapon spawns inside
     inline std::vector<TypeSpawn>& getWeaponSpawns() { return m_weaponSpawns; }
 
+    /// \brief delivers spawn positions for weapons
+    inline const std::vector<TypeSpawn>& getWeaponSpawns() const { return m_weaponSpawns; }
+
     /// \brief sets gravitation
     ///
     /// \param gravitation new gravitation
@@ -278,7 +282,7 @@ class LevelConfig {
     /// \brief delivers gravity
     ///
     /// \return float gravitation of this level
-    inline float getGravitation() { return m_gravitation; }
+    inline float getGravitation() const { return m_gravitation; }
 
     /// \brief sets tileset file
     ///
@@ -288,12 +292,12 @@ class LevelConfig {
     /// \brief delivers filename of tileset
     ///
     /// \return std::string filename of tileset
-    inline std::string getTilesheetFilename() { return m_absolutePath + m_tilesheetFilename; }
+    inline std::string getTilesheetFilename() const { return m_absolutePath + m_tilesheetFilename; }
 
     /// \brief delivers filename of tileset
     ///
     /// \return std::string filename of tileset
-    inline std::string getRelativeTilesheetFilename() { return m_tilesheetFilename; }
+    inline std::string getRelativeTilesheetFilename() const { return m_tilesheetFilename; }
 
     /// \brief sets the width of tiles
     ///
@@ -303,7 +307,7 @@ class LevelConfig {
     /// \brief delivers width of tiles
     ///
     /// \return int width of tiles
-    inline int getTileWidth() { return m_tileWidth; }
+    inline int getTileWidth() const { return m_tileWidth; }
 
     /// \brief sets the height of tiles
     ///
@@ -313,7 +317,7 @@ class LevelConfig {
     /// \brief delivers height of tiles
     ///
     /// \return int htight of tiles
-    inline int getTileHeight() { return m_tileHeight; }
+    inline int getTileHeight() const { return m_tileHeight; }
 
     /// \brief sets the offset between tiles
     ///
@@ -323,7 +327,7 @@ class LevelConfig {
     /// \brief delivers offset between tiles in the tilesheet
     ///
     /// \return int offset between tiles
-    inline int getTileOffset() { return m_tileOffset; }
+    inline int getTileOffset() const { return m_tileOffset; }
 
     /// \brief sets the amount of tiles per row
     ///
@@ -333,7 +337,7 @@ class LevelConfig {
     /// \brief delivers amount of tiles per row
     ///
     /// \return int tiles per row
-    inline int getTilesPerRow() { return m_tilesPerRow; }
+    inline int getTilesPerRow() const { return m_tilesPerRow; }
 
     /// \brief sets the max id of tiles
     ///
@@ -343,7 +347,7 @@ class LevelConfig {
     /// \brief delivers the max id of tiles
     ///
     /// \return int max id
-    inline int getMaxTileId() { return m_maxTileId; }
+    inline int getMaxTileId() const { return m_maxTileId; }
 
     /// \brief sets width of level
     ///
@@ -359,10 +363,10 @@ class LevelConfig {
     /// \brief delivers width ov level in tiles
     ///
     /// \return int width
-    inline int getWidth() { return m_width; }
+    inline int getWidth() const { return m_width; }
 
     /// get width in pixels
-    inline int getPixelWidth() { return m_width * m_tileWidth; }
+    inline int getPixelWidth() const { return m_width * m_tileWidth; }
 
     /// \brief sets height of level
     ///
@@ -372,10 +376,10 @@ class LevelConfig {
     /// \brief delivers height ov level in tiles
     ///
     /// \return int height
-    inline int getHeight() { return m_height; }
+    inline int getHeight() const { return m_height; }
 
     /// get height in pixels
-    inline int getPixelHeight() { return m_height * m_tileHeight; }
+    inline int getPixelHeight() const { return m_height * m_tileHeight; }
 
     /// \brief sets the relative level filename from game file
     ///
@@ -385,7 +389,7 @@ class LevelConfig {
     /// \brief gets the level filename
     ///
     /// \return relative filename from game file
-    inline std::string getLevelFilename() { return m_levelFilename; }
+    inline std::string getLevelFilename() const { return m_levelFilename; }
 
     /// \brief sets the absolute path to parent directory of level.xml
     ///         ignores absolute paths of backgroundConfigs
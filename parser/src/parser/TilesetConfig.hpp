@@ -42,7 +42,7 @@ class TilesetConfig {
     /// \brief delivers layer of this layer
     ///
     /// \return int layer
-    inline int getLayer() { return m_layer; }
+    inline int getLayer() const { return m_layer; }
 
     /// \brief sets the friction of players movving on tiles
     ///
@@ -52,7 +52,7 @@ class TilesetConfig {
     /// \brief delivers friction for players walking on tiles of this layer
     ///
     /// \return float friction of players
-    inline float getFriction() { return m_friction; }
+    inline float getFriction() const { return m_friction; }
 
     /// \brief sets whether or not bots collide with tiles of this layer
     ///
@@ -62,7 +62,7 @@ class TilesetConfig {
     /// \brief delivers whether or not tiles of this layer collide with bots
     ///
     /// \return bool true if bots collide with tiles of this layer
-    inline bool canCollideBots() { return m_collideBots; }
+    inline bool canCollideBots() const { return m_collideBots; }
 
     /// \brief sets whether or not projectiles collide with tiles of this layer
     ///
@@ -74,7 +74,7 @@ class TilesetConfig {
     /// \brief delivers whether or not tiles of this layer collide with projectiles
     ///
     /// \return bool true if projectiles collide with tiles of this layer
-    inline bool canCollideProjectiles() { return m_collideProjectiles; }
+    inline bool canCollideProjectiles() const { return m_collideProjectiles; }
 
     /// \brief sets whether or not players collide with tiles of this layer
     ///
@@ -84,7 +84,7 @@ class TilesetConfig {
     /// \brief delivers whether or not tiles of this layer collide with players
     ///
     /// \return bool true if players collide with tiles of this layer
-    inline bool canCollidePlayers() { return m_collidePlayers; }
+    inline bool canCollidePlayers() const { return m_collidePlayers; }
 
     /// \brief sets tile arrangement
     ///         the format looks like this: 2 3 12 4 2 34
@@ -97,8 +97,8 @@ class TilesetConfig {
     /// \brief delivers arrangement of tile ids
     ///         the format looks like this: 2 3 12 4 2 34
     ///
-    /// \return std::string arrangement of tiles
-    inline std::string getTileArrangement() { return m_tileArrangement; }
+    /// \return const std::string& arrangement of tiles
+    inline const std::string& getTileArrangement() const { return m_tileArrangement; }
 
     virtual ~TilesetConfig() = default;
 
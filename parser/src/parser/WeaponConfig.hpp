@@ -22,14 +22,16 @@ class WeaponConfig {
                  float as,
                  float damage,
                  std::string special,
-                 std::string projectile)
+                 std::string projectile,
+                 bool hitscan = false)
         : m_filename(std::move(filename)),
           m_name(std::move(name)),
           m_range(range),
           m_attackspeed(as),
           m_damage(damage),
           m_special(std::move(special)),
-          m_projectile(std::move(projectile)) {}
+          m_projectile(std::move(projectile)),
+          m_hitscan(hitscan) {}
 
     inline std::string getFilename() { return m_filename; }
     inline std::string getName() { return m_name; }
@@ -38,6 +40,8 @@ class WeaponConfig {
     inline float getDamage() { return m_damage; }
     inline std::string getSpecial() { return m_special; }
     inline std::string getProjectile() { return m_projectile; }
+    /// Hitscan weapons resolve their shots with a ray cast instead of a projectile body
+    inline bool isHitscan() { return m_hitscan; }
 
    private:
     std::string m_filename;
@@ -47,6 +51,7 @@ class WeaponConfig {
     float m_damage;
     std::string m_special;
     std::string m_projectile;
+    bool m_hitscan;
 };
 
 }  // namespace parser
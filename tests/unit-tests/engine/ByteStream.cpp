@@ -0,0 +1,94 @@
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <catch.hpp>
+#include <engine/util/ByteStream.hpp>
+
+using ctb::engine::ByteReader;
+using ctb::engine::ByteWriter;
+
+TEST_CASE("ByteStream values are read back in the order they were written") {
+    std::vector<uint8_t> buffer;
+    ByteWriter out(buffer);
+    out.writeU8(200);
+    out.writeU16(0xBEEF);
+    out.writeU32(0xDEADBEEF);
+    out.writeU64(0x0123456789ABCDEFull);
+    out.writeI32(-42);
+    out.writeBool(true);
+    out.writeFloat(-0.1f);
+    out.writeDouble(std::numeric_limits<double>::denorm_min());
+    out.writeString("banana");
+    out.writeString("");
+    REQUIRE(out.size() == buffer.size());
+
+    ByteReader in(buffer);
+    REQUIRE(in.readU8() == 200);
+    REQUIRE(in.readU16() == 0xBEEF);
+    REQUIRE(in.readU32() == 0xDEADBEEF);
+    REQUIRE(in.readU64() == 0x0123456789ABCDEFull);
+    REQUIRE(in.readI32() == -42);
+    REQUIRE(in.readBool());
+    REQUIRE(in.readFloat() == -0.1f);
+    REQUIRE(in.readDouble() == std::numeric_limits<double>::denorm_min());
+    REQUIRE(in.readString() == "banana");
+    REQUIRE(in.readString().empty());
+    REQUIRE(in.atEnd());
+}
+
+TEST_CASE("ByteStream uses little endian order") {
+    std::vector<uint8_t> buffer;
+    ByteWriter(buffer).writeU32(0x04030201);
+    REQUIRE(buffer == std::vector<uint8_t>{1, 2, 3, 4});
+}
+
+TEST_CASE("ByteReader throws at the end of the data") {
+    std::vector<uint8_t> buffer;
+    ByteWriter out(buffer);
+    out.writeU16(1);
+    out.writeU32(100);  // length of a string without characters
+
+    ByteReader in(buffer);
+    REQUIRE(in.readU16() == 1);
+    REQUIRE_THROWS_AS(in.readString(), std::runtime_error);
+
+    ByteReader truncated(buffer.data(), 2);
+    REQUIRE_THROWS_AS(truncated.readU32(), std::runtime_error);
+    REQUIRE(truncated.readU16() == 1);
+    REQUIRE(truncated.atEnd());
+}
+
+TEST_CASE("ByteStream variable length integers use fewer bytes for small values") {
+    std::vector<uint8_t> buffer;
+    ByteWriter out(buffer);
+    out.writeVarU32(0);
+    out.writeVarU32(127);
+    REQUIRE(buffer.size() == 2);
+    out.writeVarU32(128);
+    REQUIRE(buffer.size() == 4);
+    out.writeVarU32(std::numeric_limits<uint32_t>::max());
+    REQUIRE(buffer.size() == 9);
+    out.writeVarI32(-1);
+    out.writeVarI32(63);
+    REQUIRE(buffer.size() == 11);
+    out.writeVarI32(std::numeric_limits<int32_t>::min());
+    out.writeVarI32(std::numeric_limits<int32_t>::max());
+
+    ByteReader in(buffer);
+    REQUIRE(in.readVarU32() == 0);
+    REQUIRE(in.readVarU32() == 127);
+    REQUIRE(in.readVarU32() == 128);
+    REQUIRE(in.readVarU32() == std::numeric_limits<uint32_t>::max());
+    REQUIRE(in.readVarI32() == -1);
+    REQUIRE(in.readVarI32() == 63);
+    REQUIRE(in.readVarI32() == std::numeric_limits<int32_t>::min());
+    REQUIRE(in.readVarI32() == std::numeric_limits<int32_t>::max());
+    REQUIRE(in.atEnd());
+
+    const uint8_t invalid[] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01};
+    ByteReader tooLong(invalid, sizeof(invalid));
+    REQUIRE_THROWS_AS(tooLong.readVarU32(), std::runtime_error);
+}
@@ -0,0 +1,39 @@
+#include <cstdlib>
+
+#include <catch.hpp>
+#include <engine/util/Color.hpp>
+
+using ctb::engine::Color;
+using ctb::engine::HueRotation;
+
+namespace {
+/// Returns whether two colors differ by at most one per channel
+bool near(const Color& a, const Color& b) {
+    return std::abs(a.r - b.r) <= 1 && std::abs(a.g - b.g) <= 1 && std::abs(a.b - b.b) <= 1;
+}
+}  // namespace
+
+TEST_CASE("A full hue rotation keeps the colors") {
+    Color colors[] = {Color(255, 0, 0), Color(12, 200, 99), Color(30, 60, 240)};
+    for (float degrees : {0.0f, 360.0f}) {
+        HueRotation rotation(degrees);
+        for (const Color& color : colors) {
+            REQUIRE(near(rotation.apply(color), color));
+        }
+    }
+}
+
+TEST_CASE("A hue rotation keeps grays") {
+    HueRotation rotation(137.508f);
+    for (int value : {0, 64, 128, 255}) {
+        auto channel = static_cast<uint8_t>(value);
+        Color gray(channel, channel, channel);
+        REQUIRE(near(rotation.apply(gray), gray));
+    }
+}
+
+TEST_CASE("Red rotated by a third turn becomes green") {
+    Color rotated = HueRotation(120.0f).apply(Color(255, 0, 0));
+    REQUIRE(rotated.g > 2 * rotated.r);
+    REQUIRE(rotated.g > 2 * rotated.b);
+}
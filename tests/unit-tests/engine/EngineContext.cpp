@@ -0,0 +1,95 @@
+#include <thread>
+#include <vector>
+
+#include <catch.hpp>
+#include <engine/EngineContext.hpp>
+#include <engine/Object.hpp>
+#include <engine/core/GC.hpp>
+#include <engine/util/Clock.hpp>
+
+using ctb::engine::Clock;
+using ctb::engine::EngineContext;
+using ctb::engine::GC;
+using ctb::engine::Object;
+
+namespace {
+/// Counts its deletions
+class Counted : public Object {
+   public:
+    explicit Counted(int& deleted) : m_deleted(deleted) {}
+    ~Counted() override { ++m_deleted; }
+
+   private:
+    int& m_deleted;
+};
+}  // namespace
+
+TEST_CASE("A bound context has its own clock") {
+    EngineContext& main = EngineContext::current();
+    REQUIRE(&main == &EngineContext::main());
+
+    EngineContext context;
+    {
+        EngineContext::Binding binding(context);
+        REQUIRE(&EngineContext::current() == &context);
+        Clock::setFixedStep(true);
+        Clock::step();
+        Clock::step();
+        REQUIRE(Clock::ticks() == 2 * Clock::FIXED_STEP);
+    }
+    REQUIRE(&EngineContext::current() == &main);
+    REQUIRE_FALSE(Clock::isFixedStep());
+
+    SECTION("Bindings nest") {
+        EngineContext inner;
+        EngineContext::Binding outerBinding(context);
+        {
+            EngineContext::Binding innerBinding(inner);
+            REQUIRE_FALSE(Clock::isFixedStep());
+        }
+        REQUIRE(Clock::ticks() == 2 * Clock::FIXED_STEP);
+    }
+}
+
+TEST_CASE("Contexts on different threads don't share state") {
+    const int threads = 4;
+    const uint32_t steps = 10000;
+    std::vector<uint32_t> ticks(threads, 0);
+    std::vector<int> deleted(threads, 0);
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threads; ++i) {
+        workers.emplace_back([&, i]() {
+            EngineContext context;
+            EngineContext::Binding binding(context);
+            Clock::setFixedStep(true);
+            for (uint32_t step = 0; step < steps; ++step) {
+                Clock::step();
+                GC::add(new Counted(deleted[static_cast<size_t>(i)]));
+                if (step % 100 == 0) {
+                    GC::execute();
+                }
+            }
+            ticks[static_cast<size_t>(i)] = Clock::ticks();
+            GC::execute();
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    for (int i = 0; i < threads; ++i) {
+        REQUIRE(ticks[static_cast<size_t>(i)] == steps * Clock::FIXED_STEP);
+        REQUIRE(deleted[static_cast<size_t>(i)] == static_cast<int>(steps));
+    }
+}
+
+TEST_CASE("Objects queued in a context are deleted with it") {
+    int deleted = 0;
+    {
+        EngineContext context;
+        EngineContext::Binding binding(context);
+        GC::add(new Counted(deleted));
+        GC::add(new Counted(deleted));
+        REQUIRE(deleted == 0);
+    }
+    REQUIRE(deleted == 2);
+}
@@ -0,0 +1,67 @@
+#include <catch.hpp>
+#include <engine/core/LevelView.hpp>
+#include <parser/LevelConfig.hpp>
+
+using ctb::engine::LevelView;
+using ctb::engine::Vector2dT;
+using ctb::parser::LevelConfig;
+using ctb::parser::TypeSpawn;
+
+namespace {
+/// A level 10 tiles wide with a point of every kind
+LevelConfig makeConfig() {
+    LevelConfig config;
+    config.setWidth(10);
+    config.setHeight(6);
+    config.setTileWidth(32);
+    config.setTileHeight(32);
+    config.setDoorL(1, 4);
+    config.setDoorR(9, 3);
+    config.setFlagSpawn(4, 2);
+    TypeSpawn bot(2, 5, "zombie");
+    config.addBotSpawn(bot);
+    config.addWeaponSpawn(TypeSpawn(7, 1, "gun"));
+    return config;
+}
+
+bool equal(const Vector2dT& a, const Vector2dT& b) {
+    return a.x == b.x && a.y == b.y;
+}
+}  // namespace
+
+TEST_CASE("An unflipped level view shows the config") {
+    LevelConfig config = makeConfig();
+    LevelView view(&config, false);
+
+    REQUIRE(equal(view.getDoorL(), Vector2dT(1, 4)));
+    REQUIRE(equal(view.getDoorR(), Vector2dT(9, 3)));
+    REQUIRE(equal(view.getFlagSpawn(), Vector2dT(4, 2)));
+    REQUIRE(equal(view.getBotSpawn(0), Vector2dT(2, 5)));
+    REQUIRE(equal(view.toWorld(view.getFlagSpawn()), Vector2dT(128, 64)));
+}
+
+TEST_CASE("A flipped level view mirrors the config") {
+    LevelConfig config = makeConfig();
+    LevelView view(&config, true);
+
+    // the doors swap sides
+    REQUIRE(equal(view.getDoorL(), Vector2dT(0, 3)));
+    REQUIRE(equal(view.getDoorR(), Vector2dT(8, 4)));
+    REQUIRE(equal(view.getFlagSpawn(), Vector2dT(5, 2)));
+    REQUIRE(view.getBotSpawnCount() == 1);
+    REQUIRE(equal(view.getBotSpawn(0), Vector2dT(7, 5)));
+    REQUIRE(view.getBotSpawnType(0) == "zombie");
+    REQUIRE(equal(view.getWeaponSpawn(0), Vector2dT(2, 1)));
+    REQUIRE(view.getWeaponSpawnType(0) == "gun");
+
+    SECTION("The config is not changed") {
+        REQUIRE(equal(config.getDoorL(), Vector2dT(1, 4)));
+        REQUIRE(equal(config.getBotSpawns()[0].getPosition(), Vector2dT(2, 5)));
+    }
+
+    SECTION("Mirroring twice changes nothing") {
+        for (int x = 0; x < config.getWidth(); ++x) {
+            REQUIRE(view.mirrorX(view.mirrorX(x)) == x);
+        }
+    }
+}
@@ -0,0 +1,38 @@
+#include <sstream>
+#include <vector>
+
+#include <catch.hpp>
+#include <engine/util/LoadProfile.hpp>
+
+using ctb::engine::LoadProfile;
+
+TEST_CASE("Frame times are grouped by ranges of loads") {
+    LoadProfile profile(10);
+    REQUIRE(profile.empty());
+    for (int i = 1; i <= 100; ++i) {
+        profile.add(3, static_cast<float>(i));
+        profile.add(25, 1000.0f);
+    }
+    profile.add(9, 0.5f);
+
+    std::vector<LoadProfile::Bucket> buckets = profile.getBuckets();
+    REQUIRE(buckets.size() == 2);
+    REQUIRE(buckets[0].load == 0);
+    REQUIRE(buckets[0].frames == 101);
+    REQUIRE(buckets[0].p50 == 50.0f);
+    REQUIRE(buckets[0].p99 == 99.0f);
+    REQUIRE(buckets[0].max == 100.0f);
+    REQUIRE(buckets[1].load == 20);
+    REQUIRE(buckets[1].p50 == 1000.0f);
+
+    std::ostringstream out;
+    profile.print(out);
+    REQUIRE(out.str().find("\"from\": 20, \"to\": 29") != std::string::npos);
+}
+
+TEST_CASE("The bucket size splits the loads into about ten ranges") {
+    REQUIRE(LoadProfile::bucketSizeFor(0) == 1);
+    REQUIRE(LoadProfile::bucketSizeFor(5) == 1);
+    REQUIRE(LoadProfile::bucketSizeFor(5000) == 500);
+    REQUIRE(LoadProfile::bucketSizeFor(5001) == 501);
+}
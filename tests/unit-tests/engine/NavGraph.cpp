@@ -0,0 +1,137 @@
+#include <string>
+#include <vector>
+
+#include <catch.hpp>
+#include <engine/core/NavGraph.hpp>
+#include <parser/DynamicTilestore.hpp>
+
+using ctb::DynamicTilestore;
+using ctb::engine::NavGraph;
+
+namespace {
+/// Builds a tilestore from rows of '#' (solid) and '.' (empty)
+DynamicTilestore makeTiles(const std::vector<std::string>& rows) {
+    DynamicTilestore tiles(static_cast<int>(rows.front().size()), static_cast<int>(rows.size()),
+                           32, 32);
+    for (size_t y = 0; y < rows.size(); ++y) {
+        for (size_t x = 0; x < rows[y].size(); ++x) {
+            tiles.set(static_cast<int>(x), static_cast<int>(y), rows[y][x] == '#' ? 1 : 0);
+        }
+    }
+    return tiles;
+}
+
+/// Follows nextLink from start to goal and returns the number of links
+int walk(NavGraph& graph, int start, int goal, int& jumps) {
+    int links = 0;
+    jumps = 0;
+    while (const NavGraph::Link* link = graph.nextLink(start, goal)) {
+        if (link->type == NavGraph::LinkType::Jump) {
+            ++jumps;
+        }
+        start = link->to;
+        if (++links > 100) {
+            break;
+        }
+    }
+    return start == goal ? links : -1;
+}
+}  // namespace
+
+TEST_CASE("Navigation graph nodes") {
+    DynamicTilestore tiles = makeTiles({
+        "......",
+        "......",
+        "..#...",
+        "######",
+    });
+    NavGraph graph;
+    graph.build({&tiles}, 2, 2, 3);
+
+    REQUIRE(graph.nodeAt(0, 2) != NavGraph::NO_NODE);
+    REQUIRE(graph.nodeAt(2, 1) != NavGraph::NO_NODE);
+    REQUIRE(graph.nodeAt(2, 2) == NavGraph::NO_NODE);
+    REQUIRE(graph.nodeAt(0, 1) == NavGraph::NO_NODE);
+    REQUIRE(graph.nodeCount() == 6);
+
+    // feet inside the ground and a bit above it both map to the floor below
+    REQUIRE(graph.nodeAtPixel(16, 95) == graph.nodeAt(0, 2));
+    REQUIRE(graph.nodeAtPixel(16, 40) == graph.nodeAt(0, 2));
+}
+
+TEST_CASE("Navigation graph of a flipped level") {
+    DynamicTilestore tiles = makeTiles({
+        "......",
+        "......",
+        "#.....",
+        "######",
+    });
+    NavGraph graph;
+    graph.build({&tiles}, 2, 2, 3, true);
+
+    REQUIRE(graph.nodeAt(5, 1) != NavGraph::NO_NODE);
+    REQUIRE(graph.nodeAt(5, 2) == NavGraph::NO_NODE);
+    REQUIRE(graph.nodeAt(0, 2) != NavGraph::NO_NODE);
+    REQUIRE(graph.nodeAt(0, 1) == NavGraph::NO_NODE);
+    REQUIRE(graph.nodeCount() == 6);
+}
+
+TEST_CASE("Navigation over a wall") {
+    DynamicTilestore tiles = makeTiles({
+        "........",
+        "........",
+        "........",
+        "...##...",
+        "...##...",
+        "########",
+    });
+    NavGraph graph;
+
+    SECTION("Jumpable") {
+        graph.build({&tiles}, 2, 2, 3);
+        int jumps = 0;
+        int links = walk(graph, graph.nodeAt(0, 4), graph.nodeAt(7, 4), jumps);
+        REQUIRE(links > 0);
+        REQUIRE(jumps == 1);
+
+        std::vector<const NavGraph::Link*> path;
+        REQUIRE(graph.findPath(graph.nodeAt(0, 4), graph.nodeAt(7, 4), path));
+        REQUIRE(static_cast<int>(path.size()) == links);
+        REQUIRE(path.back()->to == graph.nodeAt(7, 4));
+    }
+
+    SECTION("Too high") {
+        graph.build({&tiles}, 2, 1, 3);
+        int jumps = 0;
+        REQUIRE(walk(graph, graph.nodeAt(0, 4), graph.nodeAt(7, 4), jumps) == -1);
+        REQUIRE(graph.nextLink(graph.nodeAt(0, 4), graph.nodeAt(7, 4)) == nullptr);
+
+        // falling down is still possible
+        REQUIRE(walk(graph, graph.nodeAt(3, 2), graph.nodeAt(7, 4), jumps) > 0);
+        REQUIRE(jumps == 0);
+    }
+}
+
+TEST_CASE("Navigation cache is shared between starts") {
+    DynamicTilestore tiles = makeTiles({
+        "..........",
+        "..........",
+        "##########",
+    });
+    NavGraph graph;
+    graph.build({&tiles}, 2, 1, 2);
+
+    int goal = graph.nodeAt(9, 1);
+    const NavGraph::Link* first = graph.nextLink(graph.nodeAt(0, 1), goal);
+    REQUIRE(first != nullptr);
+    REQUIRE(first->type == NavGraph::LinkType::Walk);
+    REQUIRE(first->to == graph.nodeAt(1, 1));
+
+    // the middle of the path was cached by the first query
+    const NavGraph::Link* middle = graph.nextLink(graph.nodeAt(5, 1), goal);
+    REQUIRE(middle != nullptr);
+    REQUIRE(middle->to == graph.nodeAt(6, 1));
+
+    REQUIRE(graph.nextLink(goal, goal) == nullptr);
+    REQUIRE(graph.nextLink(NavGraph::NO_NODE, goal) == nullptr);
+}
@@ -0,0 +1,81 @@
+#include <sstream>
+
+#include <catch.hpp>
+#include <engine/core/QualityGovernor.hpp>
+
+using ctb::engine::QualityGovernor;
+
+namespace {
+/// Adds frames of the same duration and returns how often the level changed
+int addFrames(QualityGovernor& governor, uint32_t frames, float millis) {
+    int changes = 0;
+    for (uint32_t i = 0; i < frames; ++i) {
+        changes += governor.addFrame(millis) ? 1 : 0;
+    }
+    return changes;
+}
+}  // namespace
+
+TEST_CASE("The quality is lowered while frames are over budget") {
+    QualityGovernor governor(10.0f, true);
+    REQUIRE(governor.getLevel() == 0);
+    REQUIRE(governor.getQuality().projectileLimit == 0);
+
+    // a single hitch doesn't change the median
+    governor.addFrame(500.0f);
+    REQUIRE(addFrames(governor, QualityGovernor::FRAME_WINDOW, 9.0f) == 0);
+
+    // every level is measured for a full window before the next one
+    REQUIRE(addFrames(governor, QualityGovernor::FRAME_WINDOW, 20.0f) == 1);
+    REQUIRE(governor.getLevel() == 1);
+    REQUIRE(addFrames(governor, 10 * QualityGovernor::FRAME_WINDOW, 20.0f) ==
+            static_cast<int>(governor.getMaxLevel()) - 1);
+    REQUIRE(governor.getLevel() == governor.getMaxLevel());
+    REQUIRE(governor.getQuality().backgroundLayers == 1);
+    REQUIRE(governor.getQuality().spawnDivisor > 1);
+    REQUIRE(governor.getQuality().projectileLimit > 0);
+
+    std::ostringstream out;
+    governor.print(out);
+    REQUIRE(out.str().find("\"from\": 0, \"to\": 1") != std::string::npos);
+}
+
+TEST_CASE("The quality is restored with hysteresis") {
+    QualityGovernor governor(10.0f, true);
+    addFrames(governor, QualityGovernor::FRAME_WINDOW, 20.0f);
+    REQUIRE(governor.getLevel() == 1);
+
+    // just below the budget isn't enough headroom
+    QualityGovernor tight(10.0f, true);
+    addFrames(tight, QualityGovernor::FRAME_WINDOW, 20.0f);
+    REQUIRE(addFrames(tight, 10 * QualityGovernor::RESTORE_FRAMES, 9.0f) == 0);
+    REQUIRE(tight.getLevel() == 1);
+
+    // the headroom is counted once the window of the new level is full
+    const uint32_t restore = QualityGovernor::FRAME_WINDOW + QualityGovernor::RESTORE_FRAMES - 1;
+    REQUIRE(addFrames(governor, restore - 1, 5.0f) == 0);
+    REQUIRE(governor.addFrame(5.0f));
+    REQUIRE(governor.getLevel() == 0);
+
+    SECTION("A level lowered right after its restore waits longer") {
+        addFrames(governor, QualityGovernor::FRAME_WINDOW, 20.0f);
+        REQUIRE(governor.getLevel() == 1);
+        REQUIRE(addFrames(governor, restore, 5.0f) == 0);
+        REQUIRE(addFrames(governor, QualityGovernor::RESTORE_FRAMES, 5.0f) == 1);
+        REQUIRE(governor.getLevel() == 0);
+        REQUIRE(governor.getDecisions().size() == 4);
+    }
+}
+
+TEST_CASE("Without gameplay only the looks are lowered") {
+    QualityGovernor governor(10.0f, false);
+    addFrames(governor, 10 * QualityGovernor::FRAME_WINDOW, 100.0f);
+    REQUIRE(governor.getLevel() == governor.getMaxLevel());
+    REQUIRE(governor.getQuality().spawnDivisor == 1);
+    REQUIRE(governor.getQuality().projectileLimit == 0);
+    REQUIRE(governor.getQuality().animationSlowdown > 1);
+
+    QualityGovernor disabled(0.0f, true);
+    REQUIRE_FALSE(disabled.isEnabled());
+    REQUIRE(addFrames(disabled, 10 * QualityGovernor::FRAME_WINDOW, 100.0f) == 0);
+}
@@ -0,0 +1,68 @@
+#include <vector>
+
+#include <catch.hpp>
+#include <engine/util/Random.hpp>
+
+using ctb::engine::Random;
+
+TEST_CASE("Random sequences depend only on seed and stream") {
+    Random a(42);
+    Random b(42);
+    Random c(42, Random::COSMETIC_STREAM);
+    Random d(43);
+
+    bool differentStream = false;
+    bool differentSeed = false;
+    for (int i = 0; i < 100; ++i) {
+        uint32_t value = a.next();
+        REQUIRE(value == b.next());
+        differentStream = differentStream || value != c.next();
+        differentSeed = differentSeed || value != d.next();
+    }
+    REQUIRE(differentStream);
+    REQUIRE(differentSeed);
+
+    SECTION("Reseeding restarts the sequence") {
+        Random e(7);
+        uint32_t first = e.next();
+        e.next();
+        e.seed(7);
+        REQUIRE(e.next() == first);
+    }
+}
+
+TEST_CASE("Random ints stay in range") {
+    Random random(1);
+    std::vector<int> counts(6, 0);
+    for (int i = 0; i < 6000; ++i) {
+        int value = random.getInt(10, 15);
+        REQUIRE(value >= 10);
+        REQUIRE(value <= 15);
+        ++counts[static_cast<size_t>(value - 10)];
+    }
+    for (int count : counts) {
+        REQUIRE(count > 800);
+    }
+
+    REQUIRE(random.getInt(3, 3) == 3);
+    REQUIRE(random.getInt(-5, -5) == -5);
+
+    SECTION("Batch fill matches single draws") {
+        Random other(1);
+        Random batch(1);
+        int values[16];
+        batch.fill(values, 16, -3, 3);
+        for (int value : values) {
+            REQUIRE(value == other.getInt(-3, 3));
+        }
+    }
+
+    SECTION("Floats") {
+        float values[100];
+        random.fill(values, 100);
+        for (float value : values) {
+            REQUIRE(value >= 0.0f);
+            REQUIRE(value < 1.0f);
+        }
+    }
+}
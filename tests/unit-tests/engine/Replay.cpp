@@ -0,0 +1,265 @@
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <catch.hpp>
+#include <engine/input/ReplayInput.hpp>
+#include <engine/net/WorldState.hpp>
+#include <engine/replay/InputRecording.hpp>
+#include <engine/replay/ReplayStream.hpp>
+
+using ctb::engine::EntityKind;
+using ctb::engine::EntityState;
+using ctb::engine::Input;
+using ctb::engine::InputEvent;
+using ctb::engine::InputHandler;
+using ctb::engine::InputMatch;
+using ctb::engine::InputType;
+using ctb::engine::ReplayInput;
+using ctb::engine::ReplayEvent;
+using ctb::engine::ReplayEventType;
+using ctb::engine::ReplayHeader;
+using ctb::engine::ReplayReader;
+using ctb::engine::ReplayWriter;
+using ctb::engine::WorldState;
+
+namespace {
+
+/// Four players running back and forth, the flag and bots that appear and vanish
+WorldState makeWorld(uint32_t tick) {
+    WorldState state;
+    state.tick = tick;
+    state.level = static_cast<uint8_t>(tick / 4000 % 5);
+    state.flagHolder = tick % 600 < 200 ? WorldState::NO_ENTITY : tick / 600 % 4;
+    for (uint16_t id = 0; id < 4; ++id) {
+        EntityState player;
+        player.id = id;
+        player.variant = static_cast<uint8_t>(id);
+        player.x = EntityState::quantize(300.0f * id + static_cast<float>(tick % 400) * 2.5f);
+        player.y = EntityState::quantize(400.0f - static_cast<float>(tick % 30));
+        player.frame = static_cast<uint8_t>(tick / 4 % 8);
+        player.health = static_cast<uint8_t>(100 - tick / 10 % 100);
+        player.flags = (tick / 400 + id) % 2 == 0 ? EntityState::FACING_LEFT : 0;
+        state.entities.push_back(player);
+    }
+    EntityState flag;
+    flag.id = 256;
+    flag.kind = EntityKind::Flag;
+    flag.x = EntityState::quantize(640.0f + static_cast<float>(tick % 600));
+    flag.y = EntityState::quantize(300.0f);
+    state.entities.push_back(flag);
+    for (uint16_t bot = 0; bot < 6; ++bot) {
+        // every bot exists for 300 of 500 ticks
+        if ((tick + bot * 80) % 500 < 300) {
+            EntityState entity;
+            entity.id = static_cast<uint16_t>(1024 + bot);
+            entity.kind = EntityKind::Bot;
+            entity.variant = bot % 2;
+            entity.x = EntityState::quantize(150.0f * bot + static_cast<float>(tick % 100));
+            entity.y = EntityState::quantize(200.0f);
+            entity.frame = static_cast<uint8_t>(tick / 5 % 4);
+            state.entities.push_back(entity);
+        }
+    }
+    return state;
+}
+
+ReplayHeader makeHeader(uint32_t seed) {
+    ReplayHeader header;
+    header.configHash = 0x0123456789ABCDEFu;
+    header.seed = seed;
+    header.levels = {{"start.xml", false}, {"a.xml", false}, {"center.xml", false},
+                     {"a.xml", true},      {"start.xml", true}};
+    return header;
+}
+
+/// Records the ticks first to last with a score event every 100 ticks
+void record(ReplayWriter& writer, uint32_t seed, uint32_t first, uint32_t last) {
+    writer.beginRecording(makeHeader(seed));
+    for (uint32_t tick = first; tick <= last; ++tick) {
+        std::vector<ReplayEvent> events;
+        if (tick % 100 == 0) {
+            events.push_back({ReplayEventType::Score, static_cast<uint16_t>(tick / 100 % 4),
+                              tick});
+        }
+        writer.writeFrame(makeWorld(tick), events);
+    }
+    writer.endRecording({{ReplayEventType::Winner, WorldState::NO_ENTITY, 1}});
+}
+
+}  // namespace
+
+TEST_CASE("Replay recordings are read back frame by frame") {
+    std::vector<uint8_t> data;
+    ReplayWriter writer(data);
+    record(writer, 7, 1, 450);
+    record(writer, 8, 1, 20);
+    REQUIRE(writer.getFrames() == 470);
+    REQUIRE(writer.getKeyframes() == 4);
+
+    ReplayReader reader(data.data(), data.size());
+    REQUIRE(reader.nextRecording());
+    REQUIRE(reader.getHeader().seed == 7);
+    REQUIRE(reader.getHeader().configHash == makeHeader(7).configHash);
+    REQUIRE(reader.getHeader().levels == makeHeader(7).levels);
+    for (uint32_t tick = 1; tick <= 450; ++tick) {
+        REQUIRE(reader.nextFrame());
+        REQUIRE(reader.getState() == makeWorld(tick));
+        REQUIRE(reader.isKeyframe() == (tick % ReplayWriter::KEYFRAME_INTERVAL == 1));
+        REQUIRE(reader.getEvents().size() == (tick % 100 == 0 ? 1u : 0u));
+    }
+    REQUIRE(!reader.nextFrame());
+    REQUIRE(reader.getEvents().size() == 1);
+    REQUIRE(reader.getEvents()[0].type == ReplayEventType::Winner);
+    REQUIRE(reader.getEvents()[0].value == 1);
+    // the state of the last frame is kept
+    REQUIRE(reader.getState().tick == 450);
+
+    REQUIRE(reader.nextRecording());
+    REQUIRE(reader.getHeader().seed == 8);
+    REQUIRE(reader.nextFrame());
+    REQUIRE(reader.getState() == makeWorld(1));
+    // the rest of the recording is skipped
+    REQUIRE(!reader.nextRecording());
+}
+
+TEST_CASE("Replay seeks to the keyframe before a tick") {
+    std::vector<uint8_t> data;
+    ReplayWriter writer(data);
+    record(writer, 7, 1, 1000);
+
+    ReplayReader reader(data.data(), data.size());
+    REQUIRE(reader.nextRecording());
+    REQUIRE(!reader.seek(0));
+
+    REQUIRE(reader.seek(750));
+    REQUIRE(reader.isKeyframe());
+    REQUIRE(reader.getState() == makeWorld(601));
+    while (reader.getState().tick < 750) {
+        REQUIRE(reader.nextFrame());
+    }
+    REQUIRE(reader.getState() == makeWorld(750));
+
+    // back to an earlier keyframe and on to the end
+    REQUIRE(reader.seek(150));
+    REQUIRE(reader.getState() == makeWorld(1));
+    uint32_t frames = 0;
+    while (reader.nextFrame()) {
+        ++frames;
+    }
+    REQUIRE(frames == 999);
+    REQUIRE(reader.getState() == makeWorld(1000));
+}
+
+TEST_CASE("Replay of a crashed game ends with its last complete frame") {
+    std::vector<uint8_t> data;
+    ReplayWriter writer(data);
+    writer.beginRecording(makeHeader(3));
+    for (uint32_t tick = 1; tick <= 50; ++tick) {
+        writer.writeFrame(makeWorld(tick), {});
+    }
+    size_t complete = data.size();
+    writer.writeFrame(makeWorld(51), {});
+    data.resize(complete + 3);
+
+    ReplayReader reader(data.data(), data.size());
+    REQUIRE(reader.nextRecording());
+    uint32_t frames = 0;
+    while (reader.nextFrame()) {
+        ++frames;
+    }
+    REQUIRE(frames == 50);
+    REQUIRE(reader.getState() == makeWorld(50));
+
+    std::vector<uint8_t> garbage(32, 0xAB);
+    ReplayReader invalid(garbage.data(), garbage.size());
+    REQUIRE_THROWS_AS(invalid.nextRecording(), std::runtime_error);
+}
+
+TEST_CASE("Replay of a match of ten minutes takes a few MB") {
+    std::vector<uint8_t> data;
+    ReplayWriter writer(data);
+    // 40 ticks per second
+    record(writer, 1, 1, 24000);
+    REQUIRE(data.size() < 2 * 1024 * 1024);
+
+    ReplayReader reader(data.data(), data.size());
+    REQUIRE(reader.nextRecording());
+    REQUIRE(reader.seek(23999));
+    while (reader.nextFrame()) {
+    }
+    REQUIRE(reader.getState() == makeWorld(24000));
+}
+
+TEST_CASE("Input recordings are read back match by match") {
+    InputMatch first;
+    first.configHash = 42;
+    first.seed = 7;
+    first.clock = 12345;
+    first.players = {{0, 0}, {0, 1}, {1, 2}, {1, 3}};
+    first.events = {{0, 0, InputType::INPUT_RIGHT, true, 0.0f},
+                    {0, 2, InputType::INPUT_LEFT, true, 0.0f},
+                    {3, 1, InputType::INPUT_AIM_VERT, false, -37.5f},
+                    {900, 3, InputType::INPUT_JUMP, true, 0.0f},
+                    {900, 3, InputType::INPUT_JUMP, false, 0.0f}};
+    first.ticks = 1200;
+    first.checksum = 0xFEDCBA9876543210u;
+    InputMatch second;
+    second.seed = 8;
+    second.players = {{0, 0}};
+    second.ticks = 10;
+
+    std::vector<uint8_t> data;
+    ctb::engine::writeInputMatch(first, data);
+    ctb::engine::writeInputMatch(second, data);
+    std::vector<InputMatch> matches = ctb::engine::readInputMatches(data.data(), data.size());
+    REQUIRE(matches.size() == 2);
+    REQUIRE(matches[0].configHash == 42);
+    REQUIRE(matches[0].clock == 12345);
+    REQUIRE(matches[0].players.size() == 4);
+    REQUIRE(matches[0].players[2].team == 1);
+    REQUIRE(matches[0].players[3].configIndex == 3);
+    REQUIRE(matches[0].events == first.events);
+    REQUIRE(matches[0].ticks == 1200);
+    REQUIRE(matches[0].checksum == first.checksum);
+    REQUIRE(matches[1].seed == 8);
+    REQUIRE(matches[1].events.empty());
+    REQUIRE(matches[1].ticks == 10);
+
+    data.pop_back();
+    REQUIRE_THROWS_AS(ctb::engine::readInputMatches(data.data(), data.size()),
+                      std::runtime_error);
+}
+
+TEST_CASE("ReplayInput emits the events of a player in their tick") {
+    InputMatch match;
+    match.players = {{0, 0}, {1, 0}};
+    match.events = {{0, 1, InputType::INPUT_RIGHT, true, 0.0f},
+                    {2, 0, InputType::INPUT_SHOOT, true, 0.0f},
+                    {2, 1, InputType::INPUT_AIM_VERT, false, 20.0f},
+                    {2, 1, InputType::INPUT_RIGHT, false, 0.0f},
+                    {5, 1, InputType::INPUT_JUMP, true, 0.0f}};
+    match.ticks = 6;
+
+    ReplayInput input(match, 1);
+    std::vector<std::pair<uint32_t, InputType>> emitted;
+    uint32_t tick = 0;
+    InputHandler handler = [&](InputType type, Input*, bool, float angle) {
+        emitted.push_back({tick, type});
+        if (type == InputType::INPUT_AIM_VERT) {
+            REQUIRE(angle == 20.0f);
+        }
+    };
+    input.register_handler(handler);
+    for (; tick < match.ticks; ++tick) {
+        input.pollInput(nullptr);
+    }
+    std::vector<std::pair<uint32_t, InputType>> expected = {
+        {0, InputType::INPUT_RIGHT},
+        {2, InputType::INPUT_AIM_VERT},
+        {2, InputType::INPUT_RIGHT},
+        {5, InputType::INPUT_JUMP}};
+    REQUIRE(emitted == expected);
+    REQUIRE(input.isFinished());
+}
@@ -0,0 +1,336 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <catch.hpp>
+#include <engine/Engine.hpp>
+#include <engine/EngineContext.hpp>
+#include <engine/Window.hpp>
+#include <engine/audio/SoundManager.hpp>
+#include <engine/core/GC.hpp>
+#include <engine/core/Game.hpp>
+#include <engine/gui/Font.hpp>
+#include <engine/net/ConditionedTransport.hpp>
+#include <engine/net/LoopbackTransport.hpp>
+#include <engine/net/NetworkGame.hpp>
+#include <engine/net/RollbackSession.hpp>
+#include <engine/util/Clock.hpp>
+#include <parser/GameConfig.hpp>
+
+using ctb::engine::Clock;
+using ctb::engine::ConditionedTransport;
+using ctb::engine::Engine;
+using ctb::engine::EngineContext;
+using ctb::engine::Font;
+using ctb::engine::GC;
+using ctb::engine::InputFrame;
+using ctb::engine::LinkConditions;
+using ctb::engine::LoopbackLink;
+using ctb::engine::NetworkGame;
+using ctb::engine::PacketQueue;
+using ctb::engine::RollbackGame;
+using ctb::engine::RollbackSession;
+using ctb::engine::SoundManager;
+using ctb::engine::WindowArguments;
+
+namespace {
+
+/// Two players walking on a line, every tick mixes their positions into a hash
+class LineGame : public RollbackGame {
+   public:
+    void saveState(std::vector<uint8_t>& state) override {
+        state.resize(sizeof(m_state));
+        std::memcpy(state.data(), &m_state, sizeof(m_state));
+    }
+
+    void loadState(const std::vector<uint8_t>& state, const InputFrame* /*previous*/) override {
+        REQUIRE(state.size() == sizeof(m_state));
+        std::memcpy(&m_state, state.data(), sizeof(m_state));
+    }
+
+    void advance(const InputFrame* inputs, bool resimulating) override {
+        for (int player = 0; player < 2; ++player) {
+            const InputFrame& input = inputs[player];
+            m_state.position[player] += (input.buttons & 1) - (input.buttons >> 1 & 1) + input.aim;
+            m_state.position[player] += m_drift;
+            m_state.hash = m_state.hash * 31 + static_cast<uint64_t>(m_state.position[player]);
+        }
+        if (m_history.size() <= m_state.tick) {
+            m_history.resize(m_state.tick + 1);
+        }
+        m_history[m_state.tick] = m_state.hash;
+        ++m_state.tick;
+        m_resimulated += resimulating ? 1 : 0;
+    }
+
+    /// the hash after every tick, as last simulated
+    std::vector<uint64_t> m_history;
+    uint32_t m_resimulated{0};
+    /// added to every step, to simulate a different game than the remote peer
+    int32_t m_drift{0};
+
+   private:
+    struct State {
+        uint32_t tick{0};
+        int32_t position[2]{0, 0};
+        // the session hashes the raw state, so it must not contain undefined padding
+        uint32_t padding{0};
+        uint64_t hash{17};
+    } m_state;
+};
+
+/// Returns an input that changes every few ticks
+InputFrame inputOf(uint32_t peer, uint32_t tick) {
+    uint32_t phase = (tick / (5 + peer * 2)) * 2654435761u + peer;
+    InputFrame input;
+    input.buttons = static_cast<uint16_t>(phase >> 7 & 3);
+    input.aim = static_cast<int8_t>(static_cast<int>(phase >> 11 & 7) - 3);
+    return input;
+}
+
+/// Runs two sessions for frames frames and checks that both simulated the same ticks
+void play(const LinkConditions& conditions, uint32_t frames, uint32_t inputDelay) {
+    LoopbackLink link;
+    ConditionedTransport firstTransport(link.first(), conditions, 1);
+    ConditionedTransport secondTransport(link.second(), conditions, 2);
+    LineGame firstGame;
+    LineGame secondGame;
+    RollbackSession first(firstGame, firstTransport, 2, 1u, 42, inputDelay);
+    RollbackSession second(secondGame, secondTransport, 2, 2u, 42, inputDelay);
+
+    for (uint32_t frame = 0; frame < frames; ++frame) {
+        InputFrame input = inputOf(0, frame);
+        first.advanceFrame(&input);
+        input = inputOf(1, frame);
+        second.advanceFrame(&input);
+    }
+
+    // the simulated ticks with the inputs of both players known to both peers
+    uint32_t confirmed = std::min({first.getConfirmedTick(), second.getConfirmedTick(),
+                                   first.getTick(), second.getTick()});
+    REQUIRE(confirmed > frames / 2);
+    for (uint32_t tick = 0; tick < confirmed; ++tick) {
+        REQUIRE(firstGame.m_history[tick] == secondGame.m_history[tick]);
+    }
+    REQUIRE(first.getStats().desyncs == 0);
+    REQUIRE(second.getStats().desyncs == 0);
+    REQUIRE(first.getStats().invalidPackets == 0);
+    REQUIRE(first.getStats().maxRollback <= RollbackSession::MAX_ROLLBACK);
+    REQUIRE(firstGame.m_resimulated == first.getStats().resimulatedTicks);
+}
+
+/**
+ * @brief A network game of the shipped resources in its own engine context, so two peers can
+ *        run in one thread. It remembers the checksum of the game after every tick.
+ */
+class GamePeer : public RollbackGame {
+   public:
+    explicit GamePeer(uint32_t seed) {
+        EngineContext::Binding binding(m_context);
+        m_context.createSoftwareRenderer(640, 360);
+        Clock::setFixedStep(true);
+
+        WindowArguments args;
+        args.path = CTB_RES_DIR "/game.xml";
+        m_engine = new Engine(args);
+        m_context.setEngine(m_engine);
+        SoundManager::init(m_engine->getGameConfig(), false);
+        Font::loadFonts(m_engine->getGameConfig()->getFontsFolder());
+        m_game = new NetworkGame(*m_engine, m_engine->newGame(seed));
+    }
+
+    EngineContext& getContext() { return m_context; }
+
+    void saveState(std::vector<uint8_t>& state) override {
+        m_game->saveState(state);
+        // the number of simulated ticks is the last four bytes
+        for (uint32_t shift = 0; shift < 32; shift += 8) {
+            state.push_back(static_cast<uint8_t>(m_tick >> shift));
+        }
+    }
+
+    void loadState(const std::vector<uint8_t>& state, const InputFrame* previous) override {
+        std::vector<uint8_t> snapshot(state.begin(), state.end() - 4);
+        m_game->loadState(snapshot, previous);
+        m_tick = 0;
+        for (uint32_t shift = 0; shift < 32; shift += 8) {
+            m_tick |= static_cast<uint32_t>(state[state.size() - 4 + shift / 8]) << shift;
+        }
+    }
+
+    void advance(const InputFrame* inputs, bool resimulating) override {
+        m_game->advance(inputs, resimulating);
+        if (m_history.size() <= m_tick) {
+            m_history.resize(m_tick + 1);
+        }
+        m_history[m_tick] = m_game->getGame()->checksum();
+        ++m_tick;
+    }
+
+    ~GamePeer() override {
+        EngineContext::Binding binding(m_context);
+        delete m_game;
+        // the objects of the game still need the engine when they are deleted
+        GC::execute();
+        m_context.setEngine(nullptr);
+        delete m_engine;
+    }
+
+    /// the checksum after every tick, as last simulated
+    std::vector<uint64_t> m_history;
+
+   private:
+    EngineContext m_context;
+    Engine* m_engine;
+    NetworkGame* m_game;
+    uint32_t m_tick{0};
+};
+
+/// Returns an input of a real game that walks, jumps, shoots and aims
+InputFrame gameInputOf(uint32_t peer, uint32_t tick) {
+    uint32_t phase = (tick / (7 + peer * 4)) * 2654435761u + peer;
+    InputFrame input;
+    // bit 0 is left, bit 1 right, bit 2 shoot and bit 3 jump, see NETWORK_BUTTONS
+    input.buttons = static_cast<uint16_t>((phase >> 7 & 1) != 0 ? 1u : 2u);
+    input.buttons = static_cast<uint16_t>(input.buttons | (phase >> 9 & 3) << 2);
+    input.aim = static_cast<int8_t>(static_cast<int>(phase >> 12 & 127) - 63);
+    return input;
+}
+
+}  // namespace
+
+TEST_CASE("PacketQueue pops due packets in the order they were pushed") {
+    PacketQueue queue;
+    uint8_t packet[ctb::engine::MAX_PACKET_SIZE];
+    for (uint8_t i = 0; i < 3; ++i) {
+        packet[0] = i;
+        REQUIRE(queue.push(packet, 1, i == 1 ? 5 : 2));
+    }
+    REQUIRE(queue.pop(packet, 1) == 0);
+    REQUIRE(queue.pop(packet, 4) == 1);
+    REQUIRE(packet[0] == 0);
+    REQUIRE(queue.pop(packet, 4) == 1);
+    REQUIRE(packet[0] == 2);
+    REQUIRE(queue.pop(packet, 4) == 0);
+    REQUIRE(queue.pop(packet, 5) == 1);
+    REQUIRE(packet[0] == 1);
+
+    for (size_t i = 0; i < PacketQueue::CAPACITY; ++i) {
+        REQUIRE(queue.push(packet, 1, 0));
+    }
+    REQUIRE_FALSE(queue.push(packet, 1, 0));
+    REQUIRE(queue.size() == PacketQueue::CAPACITY);
+}
+
+TEST_CASE("RollbackSession keeps both peers in sync on a perfect link") {
+    play(LinkConditions(), 500, 2);
+}
+
+TEST_CASE("RollbackSession keeps both peers in sync with latency, jitter and loss") {
+    LinkConditions conditions;
+    conditions.latency = 3;
+    conditions.jitter = 2;
+    conditions.loss = 0.2f;
+    play(conditions, 2000, 1);
+}
+
+TEST_CASE("RollbackSession rolls back mispredicted inputs") {
+    LinkConditions conditions;
+    conditions.latency = 4;
+    LoopbackLink link;
+    ConditionedTransport firstTransport(link.first(), conditions, 1);
+    ConditionedTransport secondTransport(link.second(), conditions, 2);
+    LineGame firstGame;
+    LineGame secondGame;
+    RollbackSession first(firstGame, firstTransport, 2, 1u, 7, 0);
+    RollbackSession second(secondGame, secondTransport, 2, 2u, 7, 0);
+
+    for (uint32_t frame = 0; frame < 200; ++frame) {
+        InputFrame input = inputOf(0, frame);
+        first.advanceFrame(&input);
+        input = inputOf(1, frame);
+        second.advanceFrame(&input);
+    }
+    REQUIRE(first.getStats().rollbacks > 0);
+    REQUIRE(first.getStats().resimulatedTicks >= first.getStats().rollbacks);
+    REQUIRE(first.getStats().desyncs == 0);
+    REQUIRE(second.getStats().desyncs == 0);
+}
+
+TEST_CASE("RollbackSession ignores packets of other sessions") {
+    LoopbackLink link;
+    LineGame firstGame;
+    LineGame secondGame;
+    RollbackSession first(firstGame, link.first(), 2, 1u, 1);
+    RollbackSession second(secondGame, link.second(), 2, 2u, 2);
+
+    InputFrame input;
+    for (uint32_t frame = 0; frame < 20; ++frame) {
+        first.advanceFrame(&input);
+        second.advanceFrame(&input);
+    }
+    REQUIRE(first.getStats().packetsReceived == 0);
+    REQUIRE(first.getStats().invalidPackets > 0);
+    // without remote inputs, the session stalls after MAX_ROLLBACK predicted ticks
+    REQUIRE(first.getStats().stalls > 0);
+    REQUIRE(first.getTick() == 2 + RollbackSession::MAX_ROLLBACK);
+}
+
+TEST_CASE("RollbackSession detects desyncs") {
+    LoopbackLink link;
+    LineGame firstGame;
+    LineGame secondGame;
+    secondGame.m_drift = 1;
+    RollbackSession first(firstGame, link.first(), 2, 1u, 3);
+    RollbackSession second(secondGame, link.second(), 2, 2u, 3);
+
+    InputFrame input;
+    for (uint32_t frame = 0; frame < 100; ++frame) {
+        first.advanceFrame(&input);
+        second.advanceFrame(&input);
+    }
+    REQUIRE(first.getStats().desyncs > 0);
+    REQUIRE(second.getStats().desyncs > 0);
+}
+
+TEST_CASE("RollbackSession keeps two real games in sync with latency and loss") {
+    LinkConditions conditions;
+    conditions.latency = 3;
+    conditions.jitter = 2;
+    conditions.loss = 0.2f;
+    LoopbackLink link;
+    ConditionedTransport firstTransport(link.first(), conditions, 1);
+    ConditionedTransport secondTransport(link.second(), conditions, 2);
+    GamePeer firstGame(1234);
+    GamePeer secondGame(1234);
+    RollbackSession first(firstGame, firstTransport, NetworkGame::PLAYER_COUNT, 1u, 1234, 1);
+    RollbackSession second(secondGame, secondTransport, NetworkGame::PLAYER_COUNT, 2u, 1234, 1);
+
+    const uint32_t frames = 1200;
+    for (uint32_t frame = 0; frame < frames; ++frame) {
+        InputFrame input = gameInputOf(0, frame);
+        {
+            EngineContext::Binding binding(firstGame.getContext());
+            first.advanceFrame(&input);
+            GC::execute();
+        }
+        input = gameInputOf(1, frame);
+        {
+            EngineContext::Binding binding(secondGame.getContext());
+            second.advanceFrame(&input);
+            GC::execute();
+        }
+    }
+
+    uint32_t confirmed = std::min({first.getConfirmedTick(), second.getConfirmedTick(),
+                                   first.getTick(), second.getTick()});
+    REQUIRE(confirmed > frames / 2);
+    REQUIRE(first.getStats().rollbacks > 0);
+    REQUIRE(second.getStats().rollbacks > 0);
+    for (uint32_t tick = 0; tick < confirmed; ++tick) {
+        REQUIRE(firstGame.m_history[tick] == secondGame.m_history[tick]);
+    }
+    REQUIRE(first.getStats().desyncs == 0);
+    REQUIRE(second.getStats().desyncs == 0);
+}
@@ -0,0 +1,71 @@
+#include <catch.hpp>
+#include <engine/core/DestroyQueue.hpp>
+#include <engine/core/SlotMap.hpp>
+
+using ctb::engine::DestroyQueue;
+using ctb::engine::Handle;
+using ctb::engine::SlotMap;
+
+TEST_CASE("SlotMap handles resolve until their object is erased") {
+    int a = 1, b = 2, c = 3;
+    SlotMap<int> map;
+    Handle<int> ha = map.insert(&a);
+    Handle<int> hb = map.insert(&b);
+    Handle<int> hc = map.insert(&c);
+    REQUIRE(map.size() == 3);
+    REQUIRE(map.get(hb) == &b);
+
+    REQUIRE(map.erase(ha));
+    REQUIRE_FALSE(map.contains(ha));
+    REQUIRE(map.get(ha) == nullptr);
+    // the last object fills the gap, the other handles stay valid
+    REQUIRE(map.get(hb) == &b);
+    REQUIRE(map.get(hc) == &c);
+    REQUIRE(map.size() == 2);
+
+    SECTION("Erasing twice is a no-op") {
+        REQUIRE_FALSE(map.erase(ha));
+        REQUIRE(map.size() == 2);
+    }
+
+    SECTION("Freed slots are reused with a new generation") {
+        int d = 4;
+        Handle<int> hd = map.insert(&d);
+        REQUIRE(hd.index == ha.index);
+        REQUIRE(hd != ha);
+        REQUIRE(map.get(ha) == nullptr);
+        REQUIRE(map.get(hd) == &d);
+        REQUIRE(map.capacity() == 3);
+    }
+
+    SECTION("Clearing invalidates all handles") {
+        map.clear();
+        REQUIRE(map.empty());
+        REQUIRE(map.get(hb) == nullptr);
+        REQUIRE(map.get(hc) == nullptr);
+    }
+
+    REQUIRE_FALSE(map.contains(Handle<int>()));
+}
+
+namespace {
+struct Counted {
+    explicit Counted(int& deleted) : m_deleted(deleted) {}
+    ~Counted() { ++m_deleted; }
+    int& m_deleted;
+};
+}  // namespace
+
+TEST_CASE("DestroyQueue deletes the queued objects on flush") {
+    int deleted = 0;
+    DestroyQueue<Counted> queue;
+    queue.push(new Counted(deleted));
+    queue.push(new Counted(deleted));
+    queue.push(nullptr);
+    REQUIRE(queue.size() == 2);
+    REQUIRE(deleted == 0);
+
+    queue.flush();
+    REQUIRE(deleted == 2);
+    REQUIRE(queue.empty());
+}
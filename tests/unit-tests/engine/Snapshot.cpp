@@ -0,0 +1,77 @@
+#include <cstdint>
+#include <vector>
+
+#include <catch.hpp>
+#include <engine/Engine.hpp>
+#include <engine/EngineContext.hpp>
+#include <engine/Window.hpp>
+#include <engine/audio/SoundManager.hpp>
+#include <engine/core/GC.hpp>
+#include <engine/core/Game.hpp>
+#include <engine/core/PlayerSprites.hpp>
+#include <engine/gui/Font.hpp>
+#include <engine/util/Clock.hpp>
+#include <parser/GameConfig.hpp>
+
+using ctb::engine::Clock;
+using ctb::engine::Engine;
+using ctb::engine::EngineContext;
+using ctb::engine::Font;
+using ctb::engine::GC;
+using ctb::engine::Game;
+using ctb::engine::Player;
+using ctb::engine::SoundManager;
+using ctb::engine::Team;
+using ctb::engine::WindowArguments;
+
+namespace {
+/// Simulates the given number of fixed steps and returns the checksum after every one
+std::vector<uint64_t> advance(Game* game, int ticks) {
+    std::vector<uint64_t> checksums;
+    for (int i = 0; i < ticks; ++i) {
+        Clock::step();
+        game->update();
+        GC::execute();
+        checksums.push_back(game->checksum());
+    }
+    return checksums;
+}
+}  // namespace
+
+TEST_CASE("A restored snapshot continues like the uninterrupted game") {
+    EngineContext context;
+    EngineContext::Binding binding(context);
+    context.createSoftwareRenderer(640, 360);
+    Clock::setFixedStep(true);
+
+    WindowArguments args;
+    args.path = CTB_RES_DIR "/game.xml";
+    Engine engine(args);
+    context.setEngine(&engine);
+    SoundManager::init(engine.getGameConfig(), false);
+    Font::loadFonts(engine.getGameConfig()->getFontsFolder());
+
+    {
+        // players without input stand still, the bots and the physics still move
+        Game* game = engine.newGame(1234);
+        std::vector<Player*> players;
+        for (uint32_t i = 0; i < 4; ++i) {
+            Team team = i % 2 == 0 ? Team::L2R : Team::R2L;
+            players.push_back(engine.getPlayerSprites().createPlayer(team, i));
+        }
+        game->startGame(players);
+        advance(game, 120);
+
+        std::vector<uint8_t> snapshot;
+        game->saveSnapshot(snapshot);
+        const uint64_t tick = game->getTick();
+        std::vector<uint64_t> uninterrupted = advance(game, 300);
+
+        game->restoreSnapshot(snapshot);
+        REQUIRE(game->getTick() == tick);
+        REQUIRE(advance(game, 300) == uninterrupted);
+        engine.stopGame();
+    }
+    GC::execute();
+    context.setEngine(nullptr);
+}
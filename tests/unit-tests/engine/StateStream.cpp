@@ -0,0 +1,199 @@
+#include <cstdint>
+#include <vector>
+
+#include <catch.hpp>
+#include <engine/net/ConditionedTransport.hpp>
+#include <engine/net/LoopbackTransport.hpp>
+#include <engine/net/StateClient.hpp>
+#include <engine/net/StateServer.hpp>
+#include <engine/net/WorldState.hpp>
+#include <engine/util/ByteStream.hpp>
+
+using ctb::engine::ByteReader;
+using ctb::engine::ByteWriter;
+using ctb::engine::ConditionedTransport;
+using ctb::engine::EntityKind;
+using ctb::engine::EntityState;
+using ctb::engine::InputFrame;
+using ctb::engine::LinkConditions;
+using ctb::engine::LoopbackLink;
+using ctb::engine::StateClient;
+using ctb::engine::StateServer;
+using ctb::engine::WorldState;
+
+namespace {
+
+/// Players running back and forth and bots that appear and vanish
+WorldState makeWorld(uint32_t tick) {
+    WorldState state;
+    state.tick = tick;
+    state.level = static_cast<uint8_t>(2 + tick / 1000);
+    state.flagHolder = tick % 300 < 100 ? WorldState::NO_ENTITY : 1;
+    for (uint16_t id = 0; id < 8; ++id) {
+        EntityState player;
+        player.id = id;
+        player.variant = static_cast<uint8_t>(id % 3);
+        player.x = EntityState::quantize(100.0f * id + static_cast<float>(tick % 200) * 1.5f);
+        player.y = EntityState::quantize(400.0f - static_cast<float>(tick % 20));
+        player.frame = static_cast<uint8_t>(tick / 4 % 10);
+        player.health = static_cast<uint8_t>(100 - tick / 10 % 100);
+        player.flags = (tick / 200 + id) % 2 == 0 ? EntityState::FACING_LEFT : 0;
+        state.entities.push_back(player);
+    }
+    for (uint16_t bot = 0; bot < 20; ++bot) {
+        // every bot exists for 100 of 160 ticks
+        if ((tick + bot * 8) % 160 < 100) {
+            EntityState entity;
+            entity.id = static_cast<uint16_t>(100 + bot);
+            entity.kind = EntityKind::Bot;
+            entity.variant = bot % 2;
+            entity.x = EntityState::quantize(50.0f * bot + static_cast<float>(tick % 50));
+            entity.y = EntityState::quantize(200.0f);
+            state.entities.push_back(entity);
+        }
+    }
+    EntityState flag;
+    flag.id = 1000;
+    flag.kind = EntityKind::Flag;
+    flag.x = EntityState::quantize(640.25f);
+    flag.y = EntityState::quantize(300.0f);
+    state.entities.push_back(flag);
+    return state;
+}
+
+/// Writes state relative to baseline and returns the bytes
+std::vector<uint8_t> write(const WorldState* baseline, const WorldState& state) {
+    std::vector<uint8_t> buffer;
+    ByteWriter out(buffer);
+    REQUIRE(ctb::engine::writeWorldState(baseline, state, out, 4096) == state.entities.size());
+    return buffer;
+}
+
+}  // namespace
+
+TEST_CASE("WorldState is read back from a full and a delta encoding") {
+    WorldState first = makeWorld(90);
+    WorldState second = makeWorld(92);
+
+    std::vector<uint8_t> full = write(nullptr, second);
+    std::vector<uint8_t> delta = write(&first, second);
+    REQUIRE(delta.size() < full.size() / 2);
+
+    WorldState read;
+    ByteReader fullReader(full);
+    ctb::engine::readWorldState(nullptr, fullReader, read);
+    REQUIRE(fullReader.atEnd());
+    REQUIRE(read == second);
+
+    ByteReader deltaReader(delta);
+    ctb::engine::readWorldState(&first, deltaReader, read);
+    REQUIRE(deltaReader.atEnd());
+    REQUIRE(read == second);
+
+    // an unchanged entity takes 2 bytes, only the large gap before the flag's id takes 3
+    std::vector<uint8_t> same = write(&second, second);
+    REQUIRE(same.size() == 4 + 2 * second.entities.size() + 1);
+}
+
+TEST_CASE("WorldState leaves out the entities that don't fit") {
+    WorldState state = makeWorld(10);
+    std::vector<uint8_t> buffer;
+    ByteWriter out(buffer);
+    size_t written = ctb::engine::writeWorldState(nullptr, state, out, 100);
+    REQUIRE(written > 0);
+    REQUIRE(written < state.entities.size());
+    REQUIRE(buffer.size() <= 100);
+
+    WorldState read;
+    ByteReader in(buffer);
+    ctb::engine::readWorldState(nullptr, in, read);
+    REQUIRE(read.entities.size() == written);
+    REQUIRE(read.entities.back() == state.entities[written - 1]);
+}
+
+TEST_CASE("WorldState interpolates positions of entities in both states") {
+    WorldState from = makeWorld(100);
+    WorldState to = makeWorld(104);
+    WorldState middle;
+    ctb::engine::interpolate(from, to, 0.5f, middle);
+    REQUIRE(middle.tick == to.tick);
+    const EntityState* player = middle.find(3);
+    REQUIRE(player != nullptr);
+    REQUIRE(player->x == (from.find(3)->x + to.find(3)->x) / 2);
+    REQUIRE(player->frame == to.find(3)->frame);
+
+    ctb::engine::interpolate(from, to, 0.0f, middle);
+    REQUIRE(middle == from);
+}
+
+TEST_CASE("StateServer streams to several clients over lossy links") {
+    const uint32_t clientCount = 4;
+    const uint32_t ticks = 2000;
+    const uint32_t interval = 2;
+    LinkConditions conditions;
+    conditions.latency = 2;
+    conditions.jitter = 2;
+    conditions.loss = 0.1f;
+
+    StateServer server(1234);
+    std::vector<LoopbackLink*> links;
+    std::vector<ConditionedTransport*> transports;
+    std::vector<StateClient*> clients;
+    for (uint32_t i = 0; i < clientCount; ++i) {
+        links.push_back(new LoopbackLink());
+        transports.push_back(new ConditionedTransport(links.back()->first(), conditions, i));
+        REQUIRE(server.addClient(*transports.back()) == i);
+        clients.push_back(new StateClient(links.back()->second()));
+    }
+
+    WorldState sampled;
+    for (uint32_t tick = 0; tick < ticks; ++tick) {
+        for (uint32_t i = 0; i < clientCount; ++i) {
+            InputFrame input;
+            input.buttons = static_cast<uint16_t>(tick + i);
+            clients[i]->receive();
+            clients[i]->sendInput(input);
+        }
+        server.receive();
+        if (tick % interval == 0) {
+            server.broadcast(makeWorld(tick));
+        }
+        for (StateClient* client : clients) {
+            // render three intervals behind the latest state
+            if (client->isConnected()) {
+                REQUIRE(client->sample(client->getLatest()->tick - 3.0 * interval, sampled));
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < clientCount; ++i) {
+        REQUIRE(server.isConnected(i));
+        REQUIRE(server.getInput(i).buttons != 0);
+        REQUIRE(clients[i]->getSeed() == 1234);
+        REQUIRE(clients[i]->getPlayer() == i);
+
+        // the latest state arrived unchanged
+        const WorldState* latest = clients[i]->getLatest();
+        REQUIRE(latest != nullptr);
+        REQUIRE(*latest == makeWorld(latest->tick));
+        REQUIRE(latest->tick + 10 * interval >= ticks);
+        REQUIRE(clients[i]->getStats().invalidPackets == 0);
+
+        // with 40 ticks per second
+        double bytesPerSecond =
+            static_cast<double>(server.getBytesSent(i)) * 40.0 / static_cast<double>(ticks);
+        INFO("bytes per client per second: " << bytesPerSecond);
+        REQUIRE(bytesPerSecond < 4000.0);
+    }
+    const auto& stats = server.getStats();
+    REQUIRE(stats.snapshots == clientCount * ticks / interval);
+    // most snapshots are deltas despite the loss
+    REQUIRE(stats.fullSnapshots < stats.snapshots / 10);
+    REQUIRE(stats.truncatedSnapshots == 0);
+
+    for (uint32_t i = 0; i < clientCount; ++i) {
+        delete clients[i];
+        delete transports[i];
+        delete links[i];
+    }
+}